@@ -85,16 +85,36 @@ bcos::cppsdk::Sdk::UniquePtr SdkFactory::buildSdk(const std::string& _configFile
     return buildSdk(wsConfig, config->sendRpcRequestToHighestBlockNode());
 }
 
+SharedContext::Ptr SdkFactory::buildSharedContext(
+    std::size_t _ioThreadCount, std::size_t _threadPoolSize)
+{
+    m_sharedContext = std::make_shared<SharedContext>(_ioThreadCount, _threadPoolSize);
+    return m_sharedContext;
+}
+
 Service::Ptr SdkFactory::buildService(std::shared_ptr<bcos::boostssl::ws::WsConfig> _config)
 {
     auto groupInfoCodec = std::make_shared<bcos::group::JsonGroupInfoCodec>();
     auto groupInfoFactory = std::make_shared<bcos::group::GroupInfoFactory>();
-    auto service = std::make_shared<Service>(groupInfoCodec, groupInfoFactory, "SDK");
-    auto timerFactory = std::make_shared<timer::TimerFactory>();
+    auto service =
+        std::make_shared<Service>(groupInfoCodec, groupInfoFactory, "SDK", m_sharedContext);
     auto initializer = std::make_shared<WsInitializer>();
     initializer->setConfig(_config);
     initializer->initWsService(service);
-    service->setTimerFactory(timerFactory);
+    if (m_sharedContext)
+    {
+        // the executors built by the initializer are replaced by the shared ones, the routing
+        // tables and the handlers remain per instance
+        service->useSharedContext();
+
+        BCOS_LOG(INFO) << "[buildService]" << LOG_DESC("build service on the shared context")
+                       << LOG_KV("ioThreadCount", m_sharedContext->ioThreadCount())
+                       << LOG_KV("threadPoolSize", m_sharedContext->threadPoolSize());
+    }
+    else
+    {
+        service->setTimerFactory(std::make_shared<timer::TimerFactory>());
+    }
     service->registerMsgHandler(bcos::protocol::MessageType::BLOCK_NOTIFY,
         [service](
             std::shared_ptr<boostssl::MessageFace> _msg, std::shared_ptr<WsSession> _session) {
@@ -211,6 +231,13 @@ bcos::cppsdk::amop::AMOP::Ptr SdkFactory::buildAMOP(bcos::cppsdk::service::Servi
             amop->updateTopicsToRemote(_session);
         }
     });
+    _service->registerDisconnectHandler([amopWeakPtr](std::shared_ptr<WsSession> _session) {
+        auto amop = amopWeakPtr.lock();
+        if (amop)
+        {
+            amop->onDisconnect(_session);
+        }
+    });
     return amop;
 }
 
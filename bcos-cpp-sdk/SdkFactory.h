@@ -26,6 +26,7 @@
 #include <bcos-cpp-sdk/event/EventSub.h>
 #include <bcos-cpp-sdk/rpc/JsonRpcImpl.h>
 #include <bcos-cpp-sdk/ws/Service.h>
+#include <bcos-cpp-sdk/ws/SharedContext.h>
 #include <bcos-utilities/ThreadPool.h>
 
 namespace bcos
@@ -59,8 +60,18 @@ public:
     std::shared_ptr<bcos::boostssl::ws::WsConfig> config() const { return m_config; }
     void setConfig(std::shared_ptr<bcos::boostssl::ws::WsConfig> _config) { m_config = _config; }
 
+    // all the Sdk built after the shared context is set run on its io context and thread pool
+    bcos::cppsdk::service::SharedContext::Ptr sharedContext() const { return m_sharedContext; }
+    void setSharedContext(bcos::cppsdk::service::SharedContext::Ptr _sharedContext)
+    {
+        m_sharedContext = _sharedContext;
+    }
+    bcos::cppsdk::service::SharedContext::Ptr buildSharedContext(
+        std::size_t _ioThreadCount, std::size_t _threadPoolSize);
+
 private:
     std::shared_ptr<bcos::boostssl::ws::WsConfig> m_config;
+    bcos::cppsdk::service::SharedContext::Ptr m_sharedContext;
 };
 }  // namespace cppsdk
 }  // namespace bcos
\ No newline at end of file
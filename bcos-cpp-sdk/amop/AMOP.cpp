@@ -51,17 +51,41 @@ void AMOP::start()
 }
 void AMOP::stop()
 {
+    disableBatching();
+    AMOPTopicSync::Ptr topicSync;
+    {
+        std::lock_guard<std::mutex> lock(x_topicSync);
+        topicSync = m_topicSync;
+    }
+    if (topicSync)
+    {
+        topicSync->stop();
+    }
     AMOP_CLIENT(INFO) << LOG_BADGE("stop") << LOG_DESC("stop amop");
 }
 
 // subscribe topics
 void AMOP::subscribe(const std::set<std::string>& _topics)
 {
+    // the node routes by the exact topic, the filters are not sent to it
+    std::set<std::string> topics;
+    for (const auto& topic : _topics)
+    {
+        if (TopicTrie::isWildcard(topic))
+        {
+            AMOP_CLIENT(WARNING) << LOG_BADGE("subscribe")
+                                 << LOG_DESC("ignore the topic filter without callback")
+                                 << LOG_KV("topic", topic);
+            continue;
+        }
+        topics.insert(topic);
+    }
+
     // add topics to manager and update topics to server
-    auto result = m_topicManager->addTopics(_topics);
+    auto result = !topics.empty() && m_topicManager->addTopics(topics);
     if (result)
     {
-        updateTopicsToRemote();
+        topicSync()->onTopicsChanged(topics);
     }
 }
 
@@ -72,7 +96,7 @@ void AMOP::unsubscribe(const std::set<std::string>& _topics)
     auto result = m_topicManager->removeTopics(_topics);
     if (result)
     {
-        updateTopicsToRemote();
+        topicSync()->onTopicsChanged(_topics);
     }
 }
 
@@ -83,14 +107,46 @@ void AMOP::querySubTopics(std::set<std::string>& _topics)
     AMOP_CLIENT(INFO) << LOG_BADGE("querySubTopics") << LOG_KV("topics size", _topics.size());
 }
 
+void AMOP::publishTopicTrie(TopicTrie::ConstPtr _topicTrie)
+{
+    std::atomic_store_explicit(&m_topicTrie, std::move(_topicTrie), std::memory_order_release);
+}
+
+TopicTrie::ConstPtr AMOP::topicTrie() const
+{
+    return std::atomic_load_explicit(&m_topicTrie, std::memory_order_acquire);
+}
+
+void AMOP::addTopicCallback(const std::string& _topic, SubCallback _callback)
+{
+    boost::unique_lock<boost::shared_mutex> lock(x_topic2Callback);
+    m_topic2Callback[_topic] = _callback;
+    publishTopicTrie(topicTrie()->insert(_topic, _callback));
+}
+
+void AMOP::addTopicCallbacks(const std::unordered_map<std::string, SubCallback>& _topic2Callback)
+{
+    boost::unique_lock<boost::shared_mutex> lock(x_topic2Callback);
+    for (const auto& [topic, callback] : _topic2Callback)
+    {
+        m_topic2Callback[topic] = callback;
+    }
+    publishTopicTrie(TopicTrie::build(m_topic2Callback));
+
+    AMOP_CLIENT(INFO) << LOG_BADGE("addTopicCallbacks")
+                      << LOG_KV("topics size", _topic2Callback.size())
+                      << LOG_KV("total size", m_topic2Callback.size());
+}
+
 // subscribe topic with callback
 void AMOP::subscribe(const std::string& _topic, SubCallback _callback)
 {
-    auto r = m_topicManager->addTopic(_topic);
+    // the filter selects the callback locally, the topics it matches are subscribed exactly
+    auto r = !TopicTrie::isWildcard(_topic) && m_topicManager->addTopic(_topic);
     addTopicCallback(_topic, _callback);
     if (r)
     {
-        updateTopicsToRemote();
+        topicSync()->onTopicsChanged({_topic});
     }
 
     AMOP_CLIENT(INFO) << LOG_BADGE("subscribe") << LOG_DESC("subscribe topic with callback")
@@ -100,6 +156,36 @@ void AMOP::subscribe(const std::string& _topic, SubCallback _callback)
 //
 void AMOP::sendResponse(
     const std::string& _endPoint, const std::string& _seq, bcos::bytesConstRef _data)
+{
+    // the response of a message in a batch is sent with the others of the batch
+    if (_seq.find(AMOP_BATCH_SEQ_SEPARATOR) != std::string::npos)
+    {
+        std::weak_ptr<AMOP> weakAMOP = weak_from_this();
+        auto r = m_batchResponder->respond(_seq, _data,
+            [weakAMOP](const std::string& _endPoint, const std::string& _seq,
+                bcos::bytesConstRef _envelope) {
+                auto amop = weakAMOP.lock();
+                if (amop)
+                {
+                    amop->sendResponseMessage(_endPoint, _seq, _envelope);
+                }
+            });
+        if (!r)
+        {
+            // the seq is local to the batch, the node knows nothing about it
+            AMOP_CLIENT(WARNING) << LOG_BADGE("sendResponse")
+                                 << LOG_DESC("drop the response of the batch expired or unknown")
+                                 << LOG_KV("endPoint", _endPoint) << LOG_KV("seq", _seq)
+                                 << LOG_KV("dataSize", _data.size());
+        }
+        return;
+    }
+
+    sendResponseMessage(_endPoint, _seq, _data);
+}
+
+void AMOP::sendResponseMessage(
+    const std::string& _endPoint, const std::string& _seq, bcos::bytesConstRef _data)
 {
     auto msg = m_messageFactory->buildMessage();
     msg->setSeq(_seq);
@@ -109,12 +195,57 @@ void AMOP::sendResponse(
     m_service->asyncSendMessageByEndPoint(_endPoint, msg);
 }
 
-// publish message
-void AMOP::publish(
-    const std::string& _topic, bcos::bytesConstRef _data, uint32_t _timeout, PubCallback _callback)
+void AMOP::enableBatching(AMOPPublishBatcher::Settings _settings)
+{
+    std::weak_ptr<AMOP> weakAMOP = weak_from_this();
+    auto batcher = std::make_shared<AMOPPublishBatcher>(
+        _settings,
+        [weakAMOP](const std::string& _topic, std::shared_ptr<bytes> _envelope, uint32_t _timeout,
+            PubCallback _callback) {
+            auto amop = weakAMOP.lock();
+            if (!amop)
+            {
+                return;
+            }
+            auto sendMsg = amop->buildRequestMessage(_topic, AMOP_BATCH_VERSION,
+                bcos::ref(*_envelope), bcos::cppsdk::amop::MessageType::AMOP_REQUEST);
+            amop->m_topicStats->onSent(_topic, 0, 1, false);
+            amop->sendRequestMessage(sendMsg, _timeout, _callback);
+        },
+        m_messageFactory);
+    batcher->start();
+
+    AMOPPublishBatcher::Ptr oldBatcher;
+    {
+        std::lock_guard<std::mutex> lock(x_batcher);
+        oldBatcher = m_batcher;
+        m_batcher = batcher;
+    }
+    if (oldBatcher)
+    {
+        oldBatcher->stop();
+    }
+}
+
+void AMOP::disableBatching()
+{
+    AMOPPublishBatcher::Ptr batcher;
+    {
+        std::lock_guard<std::mutex> lock(x_batcher);
+        batcher.swap(m_batcher);
+    }
+    if (batcher)
+    {
+        batcher->stop();
+    }
+}
+
+std::shared_ptr<MessageFace> AMOP::buildRequestMessage(const std::string& _topic, uint32_t _version,
+    bcos::bytesConstRef _data, uint16_t _packetType)
 {
     auto request = m_requestFactory->buildRequest();
     request->setTopic(_topic);
+    request->setVersion(_version);
     request->setData(_data);
 
     auto buffer = std::make_shared<bytes>();
@@ -122,15 +253,15 @@ void AMOP::publish(
 
     auto sendMsg = m_messageFactory->buildMessage();
     sendMsg->setSeq(m_messageFactory->newSeq());
-    sendMsg->setPacketType(bcos::cppsdk::amop::MessageType::AMOP_REQUEST);
+    sendMsg->setPacketType(_packetType);
     sendMsg->setPayload(buffer);
+    return sendMsg;
+}
 
-    auto sendBuffer = std::make_shared<bytes>();
-    sendMsg->encode(*sendBuffer);
-
-    AMOP_CLIENT(TRACE) << LOG_BADGE("publish") << LOG_DESC("publish message")
-                       << LOG_KV("topic", _topic);
-    m_service->asyncSendMessage(sendMsg, bcos::boostssl::ws::Options(_timeout),
+void AMOP::sendRequestMessage(
+    std::shared_ptr<MessageFace> _msg, uint32_t _timeout, PubCallback _callback)
+{
+    m_service->asyncSendMessage(_msg, bcos::boostssl::ws::Options(_timeout),
         [_callback](Error::Ptr _error, std::shared_ptr<bcos::boostssl::MessageFace> _msg,
             std::shared_ptr<bcos::boostssl::ws::WsSession> _session) {
             auto wsMessage = std::dynamic_pointer_cast<WsMessage>(_msg);
@@ -152,52 +283,551 @@ void AMOP::publish(
         });
 }
 
-// broadcast message
-void AMOP::broadcast(const std::string& _topic, bcos::bytesConstRef _data)
+// publish message
+void AMOP::publish(
+    const std::string& _topic, bcos::bytesConstRef _data, uint32_t _timeout, PubCallback _callback)
 {
-    auto request = m_requestFactory->buildRequest();
-    request->setTopic(_topic);
-    request->setData(_data);
+    auto batcher = publishBatcher();
+    if (batcher && batcher->publish(_topic, _data, _timeout, _callback))
+    {
+        m_topicStats->onSent(_topic, _data.size(), 0, true);
+        return;
+    }
 
-    auto buffer = std::make_shared<bytes>();
-    request->encode(*buffer);
+    if (m_chunkSize > 0 && _data.size() > m_chunkSize)
+    {
+        publishChunked(_topic, _data, _timeout, _callback);
+        return;
+    }
 
-    auto sendMsg = m_messageFactory->buildMessage();
-    sendMsg->setSeq(m_messageFactory->newSeq());
-    sendMsg->setPacketType(bcos::cppsdk::amop::MessageType::AMOP_BROADCAST);
-    sendMsg->setPayload(buffer);
+    auto sendMsg = buildRequestMessage(
+        _topic, 0, _data, bcos::cppsdk::amop::MessageType::AMOP_REQUEST);
+    m_topicStats->onSent(_topic, _data.size(), 1, true);
+
+    AMOP_CLIENT(TRACE) << LOG_BADGE("publish") << LOG_DESC("publish message")
+                       << LOG_KV("topic", _topic);
+    sendRequestMessage(sendMsg, _timeout, _callback);
+}
+
+// broadcast message
+void AMOP::broadcast(const std::string& _topic, bcos::bytesConstRef _data)
+{
+    if (m_chunkSize > 0 && _data.size() > m_chunkSize)
+    {
+        broadcastChunked(_topic, _data);
+        return;
+    }
 
-    auto sendBuffer = std::make_shared<bytes>();
-    sendMsg->encode(*sendBuffer);
+    auto sendMsg = buildRequestMessage(
+        _topic, 0, _data, bcos::cppsdk::amop::MessageType::AMOP_BROADCAST);
+    m_topicStats->onSent(_topic, _data.size(), 1, true);
 
     AMOP_CLIENT(TRACE) << LOG_BADGE("broadcast") << LOG_DESC("broadcast message")
                        << LOG_KV("topic", _topic);
     m_service->broadcastMessage(sendMsg);
 }
 
+std::shared_ptr<MessageFace> AMOP::buildChunkMessage(const std::string& _topic,
+    uint64_t _transferId, bcos::bytesConstRef _data, uint32_t _chunkSize, uint32_t _index,
+    uint16_t _packetType)
+{
+    AMOPChunkHeader header;
+    header.transferId = _transferId;
+    header.index = _index;
+    header.count = (uint32_t)((_data.size() + _chunkSize - 1) / _chunkSize);
+    header.totalSize = _data.size();
+    header.offset = (uint64_t)_index * _chunkSize;
+
+    auto fragmentSize = std::min<uint64_t>(_chunkSize, _data.size() - header.offset);
+    bytes chunk;
+    chunk.reserve(AMOPChunkHeader::SIZE + fragmentSize);
+    header.encode(chunk);
+    chunk.insert(chunk.end(), _data.begin() + header.offset,
+        _data.begin() + header.offset + fragmentSize);
+
+    m_topicStats->onSent(_topic, fragmentSize, 1, header.index + 1 == header.count);
+    return buildRequestMessage(_topic, AMOP_CHUNK_VERSION, bcos::ref(chunk), _packetType);
+}
+
+void AMOP::publishChunked(
+    const std::string& _topic, bcos::bytesConstRef _data, uint32_t _timeout, PubCallback _callback)
+{
+    auto publish = std::make_shared<AMOPChunkedPublish>();
+    publish->topic = _topic;
+    publish->data = std::make_shared<bytes>(_data.begin(), _data.end());
+    publish->transferId = newTransferId();
+    publish->chunkSize = m_chunkSize;
+    publish->count = (uint32_t)((_data.size() + m_chunkSize - 1) / m_chunkSize);
+    publish->timeout = _timeout;
+    publish->callback = _callback;
+
+    AMOP_CLIENT(DEBUG) << LOG_BADGE("publishChunked") << LOG_KV("topic", _topic)
+                       << LOG_KV("transferId", publish->transferId)
+                       << LOG_KV("size", _data.size()) << LOG_KV("count", publish->count);
+    sendChunks(publish);
+}
+
+void AMOP::sendChunks(AMOPChunkedPublish::Ptr _publish)
+{
+    std::vector<uint32_t> indexes;
+    bool sendLast = false;
+    {
+        std::lock_guard<std::mutex> lock(_publish->x_state);
+        if (_publish->finished)
+        {
+            return;
+        }
+        while (_publish->nextIndex + 1 < _publish->count && _publish->inflight < m_chunkWindow)
+        {
+            indexes.push_back(_publish->nextIndex++);
+            _publish->inflight++;
+        }
+        if (_publish->nextIndex + 1 == _publish->count && _publish->acked + 1 == _publish->count)
+        {
+            _publish->nextIndex++;
+            _publish->finished = true;
+            sendLast = true;
+        }
+    }
+
+    auto data = bcos::ref(*_publish->data);
+    std::weak_ptr<AMOP> weakAMOP = weak_from_this();
+    for (auto index : indexes)
+    {
+        auto msg = buildChunkMessage(_publish->topic, _publish->transferId, data,
+            _publish->chunkSize, index, bcos::cppsdk::amop::MessageType::AMOP_REQUEST);
+        m_service->asyncSendMessage(msg, bcos::boostssl::ws::Options(_publish->timeout),
+            [weakAMOP, _publish](Error::Ptr _error,
+                std::shared_ptr<bcos::boostssl::MessageFace> _msg,
+                std::shared_ptr<bcos::boostssl::ws::WsSession> _session) {
+                auto amop = weakAMOP.lock();
+                if (!amop)
+                {
+                    return;
+                }
+                amop->onChunkAck(_publish, _error, _msg, _session);
+            });
+    }
+
+    if (sendLast)
+    {
+        // the response of the last fragment is the response of the publish
+        auto msg = buildChunkMessage(_publish->topic, _publish->transferId, data,
+            _publish->chunkSize, _publish->count - 1,
+            bcos::cppsdk::amop::MessageType::AMOP_REQUEST);
+        sendRequestMessage(msg, _publish->timeout, _publish->callback);
+    }
+}
+
+void AMOP::onChunkAck(AMOPChunkedPublish::Ptr _publish, Error::Ptr _error,
+    std::shared_ptr<bcos::boostssl::MessageFace> _msg,
+    std::shared_ptr<bcos::boostssl::ws::WsSession> _session)
+{
+    auto wsMessage = std::dynamic_pointer_cast<WsMessage>(_msg);
+    if (!_error && wsMessage && wsMessage->status() != 0)
+    {
+        _error = std::make_shared<Error>(wsMessage->status(),
+            std::string(wsMessage->payload()->begin(), wsMessage->payload()->end()));
+    }
+    else if (!_error && wsMessage && wsMessage->payload() && !wsMessage->payload()->empty())
+    {
+        // the ack of the fragment is empty, the reason of the rejection otherwise
+        _error = std::make_shared<Error>(
+            -1, "chunk rejected: " + std::string(wsMessage->payload()->begin(),
+                                         wsMessage->payload()->end()));
+    }
+
+    if (_error)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_publish->x_state);
+            if (_publish->finished)
+            {
+                return;
+            }
+            _publish->finished = true;
+        }
+
+        AMOP_CLIENT(WARNING) << LOG_BADGE("publishChunked") << LOG_DESC("send fragment failed")
+                             << LOG_KV("topic", _publish->topic)
+                             << LOG_KV("transferId", _publish->transferId)
+                             << LOG_KV("errorCode", _error->errorCode())
+                             << LOG_KV("errorMessage", _error->errorMessage());
+        _publish->callback(_error, wsMessage, _session);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_publish->x_state);
+        _publish->inflight--;
+        _publish->acked++;
+    }
+    sendChunks(_publish);
+}
+
+void AMOP::broadcastChunked(const std::string& _topic, bcos::bytesConstRef _data)
+{
+    auto transferId = newTransferId();
+    auto count = (uint32_t)((_data.size() + m_chunkSize - 1) / m_chunkSize);
+
+    AMOP_CLIENT(DEBUG) << LOG_BADGE("broadcastChunked") << LOG_KV("topic", _topic)
+                       << LOG_KV("transferId", transferId) << LOG_KV("size", _data.size())
+                       << LOG_KV("count", count);
+
+    // the fragments are queued one message each, other messages are sent between them
+    for (uint32_t index = 0; index < count; ++index)
+    {
+        auto msg = buildChunkMessage(_topic, transferId, _data, m_chunkSize, index,
+            bcos::cppsdk::amop::MessageType::AMOP_BROADCAST);
+        m_service->broadcastMessage(msg);
+    }
+}
+
+void AMOP::subscribeStream(const std::string& _topic, AMOPStreamCallback _callback)
+{
+    {
+        boost::unique_lock<boost::shared_mutex> lock(x_topic2StreamCallback);
+        m_topic2StreamCallback[_topic] = _callback;
+    }
+
+    auto r = m_topicManager->addTopic(_topic);
+    if (r)
+    {
+        topicSync()->onTopicsChanged({_topic});
+    }
+
+    AMOP_CLIENT(INFO) << LOG_BADGE("subscribeStream") << LOG_KV("topic", _topic)
+                      << LOG_KV("r", r);
+}
+
+AMOPStreamCallback AMOP::getStreamCallbackByTopic(const std::string& _topic) const
+{
+    boost::shared_lock<boost::shared_mutex> lock(x_topic2StreamCallback);
+    auto it = m_topic2StreamCallback.find(_topic);
+    if (it == m_topic2StreamCallback.end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+void AMOP::setExecutor(const std::string& _topic, AMOPExecutor::Ptr _executor)
+{
+    boost::unique_lock<boost::shared_mutex> lock(x_executors);
+    if (_executor)
+    {
+        m_topic2Executor[_topic] = _executor;
+    }
+    else
+    {
+        m_topic2Executor.erase(_topic);
+    }
+    m_hasExecutors = !m_topic2Executor.empty() || m_defaultExecutor;
+
+    AMOP_CLIENT(INFO) << LOG_BADGE("setExecutor") << LOG_KV("topic", _topic)
+                      << LOG_KV("executor", _executor ? _executor->settings().name : "");
+}
+
+void AMOP::setDefaultExecutor(AMOPExecutor::Ptr _executor)
+{
+    boost::unique_lock<boost::shared_mutex> lock(x_executors);
+    m_defaultExecutor = _executor;
+    m_hasExecutors = !m_topic2Executor.empty() || m_defaultExecutor;
+}
+
+AMOPExecutor::Ptr AMOP::getExecutorByTopic(const std::string& _topic) const
+{
+    if (!m_hasExecutors)
+    {
+        return nullptr;
+    }
+
+    boost::shared_lock<boost::shared_mutex> lock(x_executors);
+    auto it = m_topic2Executor.find(_topic);
+    return it != m_topic2Executor.end() ? it->second : m_defaultExecutor;
+}
+
+bool AMOP::dispatch(const std::string& _topic, const std::string& _endPoint,
+    const std::string& _seq, bcos::bytesConstRef _data,
+    std::shared_ptr<bcos::boostssl::ws::WsSession> _session, std::shared_ptr<void> _owner)
+{
+    // the trie is held until the callback returns
+    auto trie = topicTrie();
+    auto callback = trie->match(_topic);
+    if (!callback && m_callback)
+    {
+        callback = &m_callback;
+    }
+    if (!callback)
+    {
+        return false;
+    }
+
+    auto executor = getExecutorByTopic(_topic);
+    if (!executor)
+    {
+        (*callback)(nullptr, _endPoint, _seq, _data, _session);
+        return true;
+    }
+
+    // the callback is copied for it may run after the amop destroyed
+    auto ok = executor->execute(_topic, _data,
+        [callback = *callback, _endPoint, _seq, _data, _session, _owner = std::move(_owner)]() {
+            callback(nullptr, _endPoint, _seq, _data, _session);
+        });
+    if (!ok)
+    {
+        m_topicStats->onDropped(_topic);
+        AMOP_CLIENT(WARNING) << LOG_BADGE("dispatch") << LOG_DESC("dropped by the executor")
+                             << LOG_KV("topic", _topic) << LOG_KV("endpoint", _endPoint)
+                             << LOG_KV("seq", _seq);
+    }
+    return true;
+}
+
+void AMOP::onRecvBatch(std::shared_ptr<bcos::protocol::AMOPRequest> _request,
+    const std::string& _seq, std::shared_ptr<bcos::boostssl::ws::WsSession> _session,
+    std::shared_ptr<bcos::boostssl::MessageFace> _msg)
+{
+    auto topic = _request->topic();
+    auto endPoint = _session->endPoint();
+
+    std::vector<bcos::bytesConstRef> messages;
+    if (!AMOPBatchEnvelope::decode(_request->data(), messages))
+    {
+        m_topicStats->onDropped(topic);
+        AMOP_CLIENT(WARNING) << LOG_BADGE("onRecvBatch") << LOG_DESC("invalid amop batch")
+                             << LOG_KV("topic", topic) << LOG_KV("endpoint", endPoint)
+                             << LOG_KV("seq", _seq);
+        return;
+    }
+    m_topicStats->onRecv(topic, 0, 1, false);
+
+    auto trie = topicTrie();
+    if (!trie->match(topic) && !m_callback)
+    {
+        AMOP_CLIENT(WARNING) << LOG_BADGE("onRecvBatch")
+                             << LOG_DESC("there has no callback register for the topic")
+                             << LOG_KV("topic", topic) << LOG_KV("count", messages.size());
+        return;
+    }
+
+    // registered before the callbacks, they may respond at once
+    m_batchResponder->addBatch(endPoint, _seq, (uint32_t)messages.size());
+    for (uint32_t i = 0; i < messages.size(); ++i)
+    {
+        m_topicStats->onRecv(topic, messages[i].size(), 0, true);
+        dispatch(topic, endPoint, AMOPBatchEnvelope::messageSeq(_seq, i), messages[i], _session,
+            _msg);
+    }
+}
+
+void AMOP::onRecvChunk(std::shared_ptr<bcos::protocol::AMOPRequest> _request,
+    const std::string& _seq, std::shared_ptr<bcos::boostssl::ws::WsSession> _session,
+    bool _broadcast)
+{
+    auto topic = _request->topic();
+    auto endPoint = _session->endPoint();
+
+    AMOPChunkHeader header;
+    bcos::bytesConstRef fragment;
+    std::string reason;
+    AMOPChunkReassembler::Result result = AMOPChunkReassembler::Result::Rejected;
+    if (!header.decode(_request->data(), fragment))
+    {
+        reason = "invalid chunk header";
+    }
+    else
+    {
+        m_topicStats->onRecv(topic, fragment.size(), 1, false);
+
+        auto streamCallback = getStreamCallbackByTopic(topic);
+        AMOPChunkReassembler::DeliverFunc deliver;
+        if (streamCallback)
+        {
+            deliver = [streamCallback, endPoint, _seq, _session](
+                          const AMOPChunkFragment& _fragment) {
+                streamCallback(nullptr, endPoint, _seq, _fragment, _session);
+            };
+        }
+        else
+        {
+            std::weak_ptr<AMOP> weakAMOP = weak_from_this();
+            deliver = [weakAMOP, topic, endPoint, _seq, _session](
+                          const AMOPChunkFragment& _fragment) {
+                auto amop = weakAMOP.lock();
+                if (!amop)
+                {
+                    return;
+                }
+                if (!amop->dispatch(topic, endPoint, _seq, bcos::ref(*_fragment.data), _session,
+                        _fragment.data))
+                {
+                    AMOP_CLIENT(WARNING) << LOG_BADGE("onRecvChunk")
+                                         << LOG_DESC("there has no callback register for the topic")
+                                         << LOG_KV("topic", topic);
+                }
+            };
+        }
+
+        result = m_chunkReassembler->append(header, fragment, streamCallback != nullptr,
+            std::move(deliver), reason);
+    }
+
+    if (result == AMOPChunkReassembler::Result::Completed)
+    {
+        m_topicStats->onRecv(topic, 0, 0, true);
+        return;
+    }
+
+    if (result == AMOPChunkReassembler::Result::Rejected)
+    {
+        m_topicStats->onDropped(topic);
+        AMOP_CLIENT(WARNING) << LOG_BADGE("onRecvChunk") << LOG_DESC("reject the fragment")
+                             << LOG_KV("topic", topic) << LOG_KV("endpoint", endPoint)
+                             << LOG_KV("seq", _seq) << LOG_KV("transferId", header.transferId)
+                             << LOG_KV("index", header.index) << LOG_KV("reason", reason);
+    }
+
+    // ack the fragments except the last one of the publish, the last one is responded by the
+    // subscriber, the publisher fails on the timeout if the last one is rejected
+    if (!_broadcast && header.index + 1 < header.count)
+    {
+        sendResponse(endPoint, _seq,
+            result == AMOPChunkReassembler::Result::Rejected ?
+                bcos::bytesConstRef((const byte*)reason.data(), reason.size()) :
+                bcos::bytesConstRef());
+    }
+}
 
 void AMOP::updateTopicsToRemote()
 {
+    auto topicSync = this->topicSync();
     auto ss = m_service->sessions();
     for (auto session : ss)
     {
-        updateTopicsToRemote(session);
+        topicSync->resync(session->endPoint());
     }
 }
 
 void AMOP::updateTopicsToRemote(std::shared_ptr<bcos::boostssl::ws::WsSession> _session)
 {
-    std::string request = m_topicManager->toJson();
+    topicSync()->resync(_session->endPoint());
+}
+
+void AMOP::onDisconnect(std::shared_ptr<bcos::boostssl::ws::WsSession> _session)
+{
+    topicSync()->onDisconnect(_session->endPoint());
+}
+
+void AMOP::setTopicSync(AMOPTopicSync::Settings _settings)
+{
+    auto topicSync = buildTopicSync(_settings);
+    AMOPTopicSync::Ptr oldTopicSync;
+    {
+        std::lock_guard<std::mutex> lock(x_topicSync);
+        oldTopicSync = m_topicSync;
+        m_topicSync = topicSync;
+    }
+    if (oldTopicSync)
+    {
+        oldTopicSync->stop();
+    }
+    // the versions of the old one are unknown to the new one
+    if (m_service)
+    {
+        updateTopicsToRemote();
+    }
+}
+
+AMOPTopicSync::Ptr AMOP::topicSync()
+{
+    std::lock_guard<std::mutex> lock(x_topicSync);
+    if (!m_topicSync)
+    {
+        m_topicSync = buildTopicSync(AMOPTopicSync::Settings());
+    }
+    return m_topicSync;
+}
+
+AMOPTopicSync::Ptr AMOP::buildTopicSync(AMOPTopicSync::Settings _settings)
+{
+    std::weak_ptr<AMOP> weakAMOP = weak_from_this();
+    auto topicSync = std::make_shared<AMOPTopicSync>(
+        _settings, m_topicManager,
+        [weakAMOP](const std::string& _endPoint, const std::string& _request,
+            AMOPTopicSync::RespFunc _respFunc) {
+            auto amop = weakAMOP.lock();
+            if (amop)
+            {
+                amop->sendTopicSyncMessage(_endPoint, _request, _respFunc);
+            }
+        },
+        [weakAMOP]() {
+            std::vector<std::string> endPoints;
+            auto amop = weakAMOP.lock();
+            if (amop && amop->m_service)
+            {
+                for (const auto& session : amop->m_service->sessions())
+                {
+                    endPoints.push_back(session->endPoint());
+                }
+            }
+            return endPoints;
+        });
+    topicSync->start();
+    return topicSync;
+}
+
+void AMOP::sendTopicSyncMessage(
+    const std::string& _endPoint, const std::string& _request, AMOPTopicSync::RespFunc _respFunc)
+{
+    std::shared_ptr<bcos::boostssl::ws::WsSession> session;
+    for (const auto& s : m_service->sessions())
+    {
+        if (s->endPoint() == _endPoint)
+        {
+            session = s;
+            break;
+        }
+    }
+    if (!session)
+    {
+        AMOP_CLIENT(WARNING) << LOG_BADGE("sendTopicSyncMessage")
+                             << LOG_DESC("the session not found") << LOG_KV("endpoint", _endPoint);
+        if (_respFunc)
+        {
+            _respFunc(std::make_shared<Error>(-1, "the session not found"), "");
+        }
+        return;
+    }
+
     auto msg = m_messageFactory->buildMessage();
     msg->setSeq(m_messageFactory->newSeq());
     msg->setPacketType(bcos::cppsdk::amop::MessageType::AMOP_SUBTOPIC);
-    msg->setPayload(std::make_shared<bytes>(request.begin(), request.end()));
+    msg->setPayload(std::make_shared<bytes>(_request.begin(), _request.end()));
 
-    _session->asyncSendMessage(msg);
+    if (!_respFunc)
+    {
+        session->asyncSendMessage(msg);
+    }
+    else
+    {
+        session->asyncSendMessage(msg, bcos::boostssl::ws::Options(m_topicSyncTimeout),
+            [_respFunc](Error::Ptr _error, std::shared_ptr<boostssl::MessageFace> _msg,
+                std::shared_ptr<bcos::boostssl::ws::WsSession>) {
+                std::string response;
+                if (_msg && _msg->payload())
+                {
+                    response = std::string(_msg->payload()->begin(), _msg->payload()->end());
+                }
+                _respFunc(_error, response);
+            });
+    }
 
-    AMOP_CLIENT(INFO) << LOG_BADGE("updateTopicsToRemote")
-                      << LOG_DESC("send subscribe message to server")
-                      << LOG_KV("endpoint", _session->endPoint()) << LOG_KV("topics", request);
+    AMOP_CLIENT(DEBUG) << LOG_BADGE("sendTopicSyncMessage")
+                       << LOG_DESC("send subscribe message to server")
+                       << LOG_KV("endpoint", _endPoint) << LOG_KV("size", _request.size());
 }
 
 void AMOP::onRecvAMOPRequest(std::shared_ptr<boostssl::MessageFace> _msg,
@@ -214,22 +844,25 @@ void AMOP::onRecvAMOPRequest(std::shared_ptr<boostssl::MessageFace> _msg,
                              << LOG_KV("endpoint", _session->endPoint()) << LOG_KV("seq", seq);
         return;
     }
-    auto topic = request->topic();
-    // AMOP_CLIENT(INFO) << LOG_DESC("onRecvAMOPRequest")
-    //                         << LOG_KV("endpoint", _session->endPoint())
-    //                         << LOG_KV("data size", data->size());
-
-    auto callback = getCallbackByTopic(topic);
-    if (!callback && m_callback)
+    if (request->version() == AMOP_CHUNK_VERSION)
     {
-        callback = m_callback;
+        onRecvChunk(request, seq, _session, false);
+        return;
     }
 
-    if (callback)
+    if (request->version() == AMOP_BATCH_VERSION)
     {
-        callback(nullptr, _session->endPoint(), seq, request->data(), _session);
+        onRecvBatch(request, seq, _session, _msg);
+        return;
     }
-    else
+
+    auto topic = request->topic();
+    m_topicStats->onRecv(topic, request->data().size(), 1, true);
+    // AMOP_CLIENT(INFO) << LOG_DESC("onRecvAMOPRequest")
+    //                         << LOG_KV("endpoint", _session->endPoint())
+    //                         << LOG_KV("data size", data->size());
+
+    if (!dispatch(topic, _session->endPoint(), seq, request->data(), _session, _msg))
     {
         AMOP_CLIENT(WARNING) << LOG_BADGE("onRecvAMOPRequest")
                              << LOG_DESC("there has no callback register for the topic")
@@ -261,23 +894,20 @@ void AMOP::onRecvAMOPBroadcast(std::shared_ptr<boostssl::MessageFace> _msg,
         return;
     }
 
+    if (request->version() == AMOP_CHUNK_VERSION)
+    {
+        onRecvChunk(request, seq, _session, true);
+        return;
+    }
+
     auto topic = request->topic();
+    m_topicStats->onRecv(topic, request->data().size(), 1, true);
 
     AMOP_CLIENT(DEBUG) << LOG_BADGE("onRecvAMOPBroadcast")
                        << LOG_KV("endpoint", _session->endPoint()) << LOG_KV("seq", seq)
                        << LOG_KV("data size", request->data().size());
 
-    auto callback = getCallbackByTopic(topic);
-    if (!callback && m_callback)
-    {
-        callback = m_callback;
-    }
-
-    if (callback)
-    {
-        callback(nullptr, _session->endPoint(), seq, request->data(), _session);
-    }
-    else
+    if (!dispatch(topic, _session->endPoint(), seq, request->data(), _session, _msg))
     {
         AMOP_CLIENT(WARNING) << LOG_BADGE("onRecvAMOPBroadcast")
                              << LOG_DESC("there has no callback register for the topic")
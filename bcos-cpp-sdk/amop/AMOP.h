@@ -22,9 +22,19 @@
 #include <bcos-boostssl/interfaces/MessageFace.h>
 #include <bcos-boostssl/websocket/Common.h>
 #include <bcos-boostssl/websocket/WsService.h>
+#include <bcos-cpp-sdk/amop/AMOPBatch.h>
+#include <bcos-cpp-sdk/amop/AMOPChunk.h>
+#include <bcos-cpp-sdk/amop/AMOPExecutor.h>
 #include <bcos-cpp-sdk/amop/AMOPInterface.h>
 #include <bcos-cpp-sdk/amop/AMOPRequest.h>
+#include <bcos-cpp-sdk/amop/AMOPTopicStats.h>
+#include <bcos-cpp-sdk/amop/AMOPTopicSync.h>
 #include <bcos-cpp-sdk/amop/TopicManager.h>
+#include <bcos-cpp-sdk/amop/TopicTrie.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <random>
 #include <unordered_map>
 
 namespace bcos
@@ -33,7 +43,7 @@ namespace cppsdk
 {
 namespace amop
 {
-class AMOP : public AMOPInterface
+class AMOP : public AMOPInterface, public std::enable_shared_from_this<AMOP>
 {
 public:
     using Ptr = std::shared_ptr<AMOP>;
@@ -46,16 +56,18 @@ public:
     virtual void stop() override;
 
 public:
-    // subscribe topics
+    // subscribe topics, the topic filters are ignored
     virtual void subscribe(const std::set<std::string>& _topics) override;
     // subscribe topics
     virtual void unsubscribe(const std::set<std::string>& _topics) override;
-    // subscribe topic with callback
+    // subscribe topic with callback, the topic may be a filter with "+" or "#" levels, see
+    // TopicTrie. NOTE: the node routes the messages by the exact topic, so the filter is kept
+    // locally and only selects the callback of the messages of the topics subscribed exactly
     virtual void subscribe(const std::string& _topic, SubCallback _callback) override;
-    // publish message
+    // publish message, chunked if larger than the chunk size
     virtual void publish(const std::string& _topic, bcos::bytesConstRef _data, uint32_t timeout,
         PubCallback _callback) override;
-    // broadcast message
+    // broadcast message, chunked if larger than the chunk size
     virtual void broadcast(const std::string& _topic, bcos::bytesConstRef _data) override;
     //
     virtual void sendResponse(
@@ -66,8 +78,18 @@ public:
     virtual void setSubCallback(SubCallback _callback) override { m_callback = _callback; }
     virtual SubCallback subCallback() const { return m_callback; }
 
+    // the full sync of the topics to all the sessions
     void updateTopicsToRemote();
+    // the full sync of the topics to the session, called on the handshake
     void updateTopicsToRemote(std::shared_ptr<bcos::boostssl::ws::WsSession> _session);
+    void onDisconnect(std::shared_ptr<bcos::boostssl::ws::WsSession> _session);
+
+    // sync the topic changes as the deltas coalesced for the batch delay, see AMOPTopicSync.
+    // NOTE: the incremental sync requires the nodes supporting it
+    void setTopicSync(AMOPTopicSync::Settings _settings);
+    AMOPTopicSync::Ptr topicSync();
+    uint32_t topicSyncTimeout() const { return m_topicSyncTimeout; }
+    void setTopicSyncTimeout(uint32_t _timeout) { m_topicSyncTimeout = _timeout; }
 
 public:
     void onRecvAMOPRequest(std::shared_ptr<bcos::boostssl::MessageFace> _msg,
@@ -108,23 +130,105 @@ public:
         m_service = _service;
     }
 
-    void addTopicCallback(const std::string& _topic, SubCallback _callback)
+    // the messages larger than the chunk size are sent in fragments of the chunk size with at
+    // most _window fragments of a publish in flight, 0 for disabled. NOTE: the node delivers each
+    // fragment of a publish to one subscriber of the topic, so the chunked publish requires the
+    // topic subscribed by one client, the chunked broadcast has no such limit
+    void setChunkSize(uint32_t _chunkSize, uint32_t _window = 4)
+    {
+        m_chunkSize = _chunkSize;
+        m_chunkWindow = std::max<uint32_t>(_window, 1);
+    }
+    uint32_t chunkSize() const { return m_chunkSize; }
+    uint32_t chunkWindow() const { return m_chunkWindow; }
+
+    // coalesce the small messages published to the same topic into batches, the subscriber
+    // unbatches them and responds each message with its own seq. NOTE: the subscriber should be
+    // of the sdk version supporting it
+    void enableBatching(AMOPPublishBatcher::Settings _settings);
+    void disableBatching();
+    AMOPPublishBatcher::Ptr publishBatcher() const
+    {
+        std::lock_guard<std::mutex> lock(x_batcher);
+        return m_batcher;
+    }
+    AMOPBatchResponder::Ptr batchResponder() const { return m_batchResponder; }
+
+    // the chunked messages of the topic are delivered to the callback as a stream of fragments
+    // instead of reassembled as a whole, the messages not chunked are delivered as usual
+    void subscribeStream(const std::string& _topic, AMOPStreamCallback _callback);
+
+    AMOPChunkReassembler::Ptr chunkReassembler() const { return m_chunkReassembler; }
+    // take effect before the first chunked message received
+    void setChunkReassembler(AMOPChunkReassembler::Ptr _chunkReassembler)
     {
-        boost::unique_lock<boost::shared_mutex> lock(x_topic2Callback);
-        m_topic2Callback[_topic] = _callback;
+        m_chunkReassembler = _chunkReassembler;
     }
 
-    SubCallback getCallbackByTopic(const std::string& _topic)
+    // the throughput of each topic
+    AMOPTopicStats::Ptr topicStats() const { return m_topicStats; }
+
+    // the callbacks of the topic are executed on the executor instead of the receiving thread,
+    // nullptr to remove, the executor can be shared by a group of topics
+    void setExecutor(const std::string& _topic, AMOPExecutor::Ptr _executor);
+    // the executor of the topics without their own executor
+    void setDefaultExecutor(AMOPExecutor::Ptr _executor);
+    AMOPExecutor::Ptr getExecutorByTopic(const std::string& _topic) const;
+
+    void addTopicCallback(const std::string& _topic, SubCallback _callback);
+    // add the callbacks with the trie rebuilt once
+    void addTopicCallbacks(const std::unordered_map<std::string, SubCallback>& _topic2Callback);
+
+    SubCallback getCallbackByTopic(const std::string& _topic) const
     {
-        boost::shared_lock<boost::shared_mutex> lock(x_topic2Callback);
-        auto it = m_topic2Callback.find(_topic);
-        if (it == m_topic2Callback.end())
-        {
-            return nullptr;
-        }
-        return it->second;
+        auto trie = topicTrie();
+        auto callback = trie->match(_topic);
+        return callback ? *callback : nullptr;
     }
 
+    // the current snapshot of the topic filters, an atomic load of the trie published
+    TopicTrie::ConstPtr topicTrie() const;
+
+private:
+    std::shared_ptr<bcos::boostssl::MessageFace> buildRequestMessage(const std::string& _topic,
+        uint32_t _version, bcos::bytesConstRef _data, uint16_t _packetType);
+    void sendRequestMessage(std::shared_ptr<bcos::boostssl::MessageFace> _msg,
+        uint32_t _timeout, PubCallback _callback);
+
+    void sendResponseMessage(
+        const std::string& _endPoint, const std::string& _seq, bcos::bytesConstRef _data);
+    AMOPTopicSync::Ptr buildTopicSync(AMOPTopicSync::Settings _settings);
+    void sendTopicSyncMessage(const std::string& _endPoint, const std::string& _request,
+        AMOPTopicSync::RespFunc _respFunc);
+    void onRecvBatch(std::shared_ptr<bcos::protocol::AMOPRequest> _request,
+        const std::string& _seq, std::shared_ptr<bcos::boostssl::ws::WsSession> _session,
+        std::shared_ptr<bcos::boostssl::MessageFace> _msg);
+
+    // call the callback of the topic inline or on its executor, _owner keeps _data alive until
+    // the callback returns, return false if no callback registered
+    bool dispatch(const std::string& _topic, const std::string& _endPoint, const std::string& _seq,
+        bcos::bytesConstRef _data, std::shared_ptr<bcos::boostssl::ws::WsSession> _session,
+        std::shared_ptr<void> _owner);
+
+    void publishChunked(const std::string& _topic, bcos::bytesConstRef _data, uint32_t _timeout,
+        PubCallback _callback);
+    void broadcastChunked(const std::string& _topic, bcos::bytesConstRef _data);
+    std::shared_ptr<bcos::boostssl::MessageFace> buildChunkMessage(const std::string& _topic,
+        uint64_t _transferId, bcos::bytesConstRef _data, uint32_t _chunkSize, uint32_t _index,
+        uint16_t _packetType);
+    void sendChunks(AMOPChunkedPublish::Ptr _publish);
+    void onChunkAck(AMOPChunkedPublish::Ptr _publish, Error::Ptr _error,
+        std::shared_ptr<bcos::boostssl::MessageFace> _msg,
+        std::shared_ptr<bcos::boostssl::ws::WsSession> _session);
+    void onRecvChunk(std::shared_ptr<bcos::protocol::AMOPRequest> _request,
+        const std::string& _seq, std::shared_ptr<bcos::boostssl::ws::WsSession> _session,
+        bool _broadcast);
+    AMOPStreamCallback getStreamCallbackByTopic(const std::string& _topic) const;
+    uint64_t newTransferId() { return m_transferIdBase + m_transferIdCounter.fetch_add(1); }
+
+    // NOTE: called with x_topic2Callback held
+    void publishTopicTrie(TopicTrie::ConstPtr _topicTrie);
+
 private:
     SubCallback m_callback;
     std::shared_ptr<TopicManager> m_topicManager;
@@ -134,6 +238,35 @@ private:
     mutable boost::shared_mutex x_topic2Callback;
     std::unordered_map<std::string, SubCallback> m_topic2Callback;
 
+    // the trie published by the writers of m_topic2Callback, loaded and stored atomically
+    TopicTrie::ConstPtr m_topicTrie = std::make_shared<TopicTrie>();
+
+    uint32_t m_chunkSize = 0;
+    uint32_t m_chunkWindow = 4;
+    // the transfer ids of the chunked messages, random base for the senders not colliding
+    uint64_t m_transferIdBase = ((uint64_t)std::random_device{}() << 32) | std::random_device{}();
+    std::atomic<uint64_t> m_transferIdCounter{0};
+    AMOPChunkReassembler::Ptr m_chunkReassembler = std::make_shared<AMOPChunkReassembler>();
+
+    mutable std::mutex x_batcher;
+    AMOPPublishBatcher::Ptr m_batcher;
+    AMOPBatchResponder::Ptr m_batchResponder = std::make_shared<AMOPBatchResponder>();
+
+    mutable boost::shared_mutex x_topic2StreamCallback;
+    std::unordered_map<std::string, AMOPStreamCallback> m_topic2StreamCallback;
+
+    AMOPTopicStats::Ptr m_topicStats = std::make_shared<AMOPTopicStats>();
+
+    mutable std::mutex x_topicSync;
+    AMOPTopicSync::Ptr m_topicSync;
+    uint32_t m_topicSyncTimeout = 10000;
+
+    // the lookup is skipped until an executor set
+    std::atomic<bool> m_hasExecutors{false};
+    mutable boost::shared_mutex x_executors;
+    std::unordered_map<std::string, AMOPExecutor::Ptr> m_topic2Executor;
+    AMOPExecutor::Ptr m_defaultExecutor;
+
     std::shared_ptr<bcos::boostssl::ws::WsService> m_service;
 };
 }  // namespace amop
@@ -0,0 +1,360 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file AMOPBatch.cpp
+ * @author: octopus
+ * @date 2023-03-29
+ */
+
+#include <bcos-cpp-sdk/amop/AMOPBatch.h>
+#include <bcos-cpp-sdk/amop/Common.h>
+#include <bcos-utilities/BoostLog.h>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::amop;
+
+static void writeUint32(byte* _data, uint32_t _value)
+{
+    _data[0] = (byte)(_value >> 24);
+    _data[1] = (byte)(_value >> 16);
+    _data[2] = (byte)(_value >> 8);
+    _data[3] = (byte)_value;
+}
+
+static uint32_t readUint32(const byte* _data)
+{
+    return ((uint32_t)_data[0] << 24) | ((uint32_t)_data[1] << 16) | ((uint32_t)_data[2] << 8) |
+           (uint32_t)_data[3];
+}
+
+void AMOPBatchEnvelope::begin(bcos::bytes& _buffer)
+{
+    _buffer.resize(_buffer.size() + 4, 0);
+}
+
+void AMOPBatchEnvelope::append(bcos::bytes& _buffer, bcos::bytesConstRef _message)
+{
+    auto offset = _buffer.size();
+    _buffer.resize(offset + 4);
+    writeUint32(_buffer.data() + offset, (uint32_t)_message.size());
+    _buffer.insert(_buffer.end(), _message.begin(), _message.end());
+}
+
+void AMOPBatchEnvelope::finish(bcos::bytes& _buffer, uint32_t _count)
+{
+    writeUint32(_buffer.data(), _count);
+}
+
+void AMOPBatchEnvelope::encode(const std::vector<bcos::bytes>& _messages, bcos::bytes& _buffer)
+{
+    begin(_buffer);
+    for (const auto& message : _messages)
+    {
+        append(_buffer, bcos::ref(message));
+    }
+    finish(_buffer, (uint32_t)_messages.size());
+}
+
+bool AMOPBatchEnvelope::decode(
+    bcos::bytesConstRef _data, std::vector<bcos::bytesConstRef>& _messages)
+{
+    if (_data.size() < 4)
+    {
+        return false;
+    }
+
+    auto count = readUint32(_data.data());
+    // each message takes 4 bytes at least
+    if (count > (_data.size() - 4) / 4)
+    {
+        return false;
+    }
+
+    _messages.clear();
+    _messages.reserve(count);
+    std::size_t offset = 4;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (offset + 4 > _data.size())
+        {
+            return false;
+        }
+        auto length = readUint32(_data.data() + offset);
+        offset += 4;
+        if (length > _data.size() - offset)
+        {
+            return false;
+        }
+        _messages.emplace_back(_data.data() + offset, length);
+        offset += length;
+    }
+    return offset == _data.size();
+}
+
+std::string AMOPBatchEnvelope::messageSeq(const std::string& _seq, uint32_t _index)
+{
+    return _seq + AMOP_BATCH_SEQ_SEPARATOR + std::to_string(_index);
+}
+
+bool AMOPBatchEnvelope::parseMessageSeq(
+    const std::string& _messageSeq, std::string& _seq, uint32_t& _index)
+{
+    auto pos = _messageSeq.rfind(AMOP_BATCH_SEQ_SEPARATOR);
+    if (pos == std::string::npos || pos + 1 == _messageSeq.size())
+    {
+        return false;
+    }
+
+    try
+    {
+        _index = (uint32_t)std::stoul(_messageSeq.substr(pos + 1));
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+    _seq = _messageSeq.substr(0, pos);
+    return true;
+}
+
+void AMOPPublishBatcher::start()
+{
+    if (m_timer)
+    {
+        return;
+    }
+
+    std::weak_ptr<AMOPPublishBatcher> weakBatcher = shared_from_this();
+    m_timer = std::make_shared<bcos::Timer>(m_settings.maxDelayMs, "amopBatcher");
+    m_timer->registerTimeoutHandler([weakBatcher]() {
+        auto batcher = weakBatcher.lock();
+        if (!batcher)
+        {
+            return;
+        }
+        batcher->flush();
+        batcher->m_timer->restart();
+    });
+    m_timer->start();
+
+    AMOP_CLIENT(INFO) << LOG_BADGE("AMOPPublishBatcher") << LOG_DESC("start")
+                      << LOG_KV("maxDelayMs", m_settings.maxDelayMs)
+                      << LOG_KV("maxMessages", m_settings.maxMessages)
+                      << LOG_KV("maxBytes", m_settings.maxBytes)
+                      << LOG_KV("maxMessageSize", m_settings.maxMessageSize);
+}
+
+void AMOPPublishBatcher::stop()
+{
+    if (m_timer)
+    {
+        m_timer->stop();
+    }
+    // send the batches left
+    flush(true);
+}
+
+bool AMOPPublishBatcher::publish(const std::string& _topic, bcos::bytesConstRef _data,
+    uint32_t _timeout, PubCallback _callback)
+{
+    if (_data.size() > m_settings.maxMessageSize)
+    {
+        return false;
+    }
+
+    Batch full;
+    {
+        std::lock_guard<std::mutex> lock(x_batches);
+        auto& batch = m_batches[_topic];
+        if (!batch.envelope)
+        {
+            batch.envelope = std::make_shared<bcos::bytes>();
+            batch.envelope->reserve(m_settings.maxBytes + m_settings.maxMessageSize + 8);
+            AMOPBatchEnvelope::begin(*batch.envelope);
+            batch.timeout = _timeout;
+            batch.createTime = std::chrono::steady_clock::now();
+        }
+
+        AMOPBatchEnvelope::append(*batch.envelope, _data);
+        batch.callbacks.push_back(std::move(_callback));
+        // the batch is sent with the shortest timeout of its messages
+        batch.timeout = std::min(batch.timeout, _timeout);
+
+        if (batch.callbacks.size() < m_settings.maxMessages &&
+            batch.envelope->size() < m_settings.maxBytes)
+        {
+            return true;
+        }
+
+        full = std::move(batch);
+        m_batches.erase(_topic);
+    }
+
+    send(_topic, std::move(full));
+    return true;
+}
+
+void AMOPPublishBatcher::flush(bool _all)
+{
+    std::vector<std::pair<std::string, Batch>> batches;
+    {
+        std::lock_guard<std::mutex> lock(x_batches);
+        auto expireTime =
+            std::chrono::steady_clock::now() - std::chrono::milliseconds(m_settings.maxDelayMs);
+        for (auto it = m_batches.begin(); it != m_batches.end();)
+        {
+            if (!_all && it->second.createTime > expireTime)
+            {
+                ++it;
+                continue;
+            }
+            batches.emplace_back(it->first, std::move(it->second));
+            it = m_batches.erase(it);
+        }
+    }
+
+    for (auto& [topic, batch] : batches)
+    {
+        send(topic, std::move(batch));
+    }
+}
+
+void AMOPPublishBatcher::send(const std::string& _topic, Batch _batch)
+{
+    AMOPBatchEnvelope::finish(*_batch.envelope, (uint32_t)_batch.callbacks.size());
+    m_sentBatches++;
+    m_sentMessages += _batch.callbacks.size();
+
+    auto callbacks = std::make_shared<std::vector<PubCallback>>(std::move(_batch.callbacks));
+    auto messageFactory = m_messageFactory;
+    m_send(_topic, _batch.envelope, _batch.timeout,
+        [callbacks, messageFactory](Error::Ptr _error, std::shared_ptr<WsMessage> _msg,
+            std::shared_ptr<WsSession> _session) {
+            onBatchResponse(*callbacks, messageFactory, _error, _msg, _session);
+        });
+}
+
+void AMOPPublishBatcher::onBatchResponse(const std::vector<PubCallback>& _callbacks,
+    std::shared_ptr<bcos::boostssl::ws::WsMessageFactory> _messageFactory,
+    bcos::Error::Ptr _error, std::shared_ptr<bcos::boostssl::ws::WsMessage> _msg,
+    std::shared_ptr<bcos::boostssl::ws::WsSession> _session)
+{
+    std::vector<bcos::bytesConstRef> responses;
+    if (!_error && (!_msg || !_msg->payload() ||
+                       !AMOPBatchEnvelope::decode(bcos::ref(*_msg->payload()), responses) ||
+                       responses.size() != _callbacks.size()))
+    {
+        _error = std::make_shared<Error>(-1, "invalid amop batch response");
+    }
+
+    if (_error)
+    {
+        AMOP_CLIENT(WARNING) << LOG_BADGE("AMOPPublishBatcher")
+                             << LOG_DESC("publish batch failed")
+                             << LOG_KV("count", _callbacks.size())
+                             << LOG_KV("errorCode", _error->errorCode())
+                             << LOG_KV("errorMessage", _error->errorMessage());
+        for (const auto& callback : _callbacks)
+        {
+            callback(_error, _msg, _session);
+        }
+        return;
+    }
+
+    for (std::size_t i = 0; i < _callbacks.size(); ++i)
+    {
+        auto msg = std::dynamic_pointer_cast<WsMessage>(_messageFactory->buildMessage());
+        msg->setSeq(_msg->seq());
+        msg->setPacketType(_msg->packetType());
+        msg->setPayload(std::make_shared<bcos::bytes>(responses[i].begin(), responses[i].end()));
+        _callbacks[i](nullptr, msg, _session);
+    }
+}
+
+void AMOPBatchResponder::addBatch(
+    const std::string& _endPoint, const std::string& _seq, uint32_t _count)
+{
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(x_batches);
+    // the batches never responded completely
+    for (auto it = m_batches.begin(); it != m_batches.end();)
+    {
+        if (now - it->second.createTime > std::chrono::milliseconds(m_timeoutMs))
+        {
+            AMOP_CLIENT(WARNING) << LOG_BADGE("AMOPBatchResponder")
+                                 << LOG_DESC("drop the batch not responded")
+                                 << LOG_KV("seq", it->first)
+                                 << LOG_KV("responded", it->second.respondedCount)
+                                 << LOG_KV("count", it->second.responses.size());
+            it = m_batches.erase(it);
+            continue;
+        }
+        ++it;
+    }
+
+    auto& batch = m_batches[_seq];
+    batch.endPoint = _endPoint;
+    batch.responses.resize(_count);
+    batch.responded.resize(_count, false);
+    batch.createTime = now;
+}
+
+bool AMOPBatchResponder::respond(
+    const std::string& _messageSeq, bcos::bytesConstRef _data, SendFunc _send)
+{
+    std::string seq;
+    uint32_t index = 0;
+    if (!AMOPBatchEnvelope::parseMessageSeq(_messageSeq, seq, index))
+    {
+        return false;
+    }
+
+    std::string endPoint;
+    bcos::bytes envelope;
+    {
+        std::lock_guard<std::mutex> lock(x_batches);
+        auto it = m_batches.find(seq);
+        if (it == m_batches.end() || index >= it->second.responses.size() ||
+            it->second.responded[index])
+        {
+            return false;
+        }
+
+        auto& batch = it->second;
+        batch.responses[index].assign(_data.begin(), _data.end());
+        batch.responded[index] = true;
+        batch.respondedCount++;
+        if (batch.respondedCount < batch.responses.size())
+        {
+            return true;
+        }
+
+        endPoint = batch.endPoint;
+        AMOPBatchEnvelope::encode(batch.responses, envelope);
+        m_batches.erase(it);
+    }
+
+    _send(endPoint, seq, bcos::ref(envelope));
+    return true;
+}
+
+std::size_t AMOPBatchResponder::pendingBatches() const
+{
+    std::lock_guard<std::mutex> lock(x_batches);
+    return m_batches.size();
+}
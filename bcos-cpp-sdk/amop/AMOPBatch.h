@@ -0,0 +1,182 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file AMOPBatch.h
+ * @author: octopus
+ * @date 2023-03-29
+ */
+#pragma once
+
+#include <bcos-boostssl/interfaces/MessageFace.h>
+#include <bcos-boostssl/websocket/WsMessage.h>
+#include <bcos-cpp-sdk/amop/AMOPInterface.h>
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/Timer.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace amop
+{
+// the version of the amop request carrying a batch of messages
+static const uint32_t AMOP_BATCH_VERSION = 2;
+// the seq of the message in a batch delivered to the subscriber: <seq of the batch>#<index>
+static const char AMOP_BATCH_SEQ_SEPARATOR = '#';
+
+/**
+ * @brief the envelope of the messages of a batch, big endian:
+ * count(4) | length(4) | message | length(4) | message ...
+ */
+class AMOPBatchEnvelope
+{
+public:
+    static void begin(bcos::bytes& _buffer);
+    static void append(bcos::bytes& _buffer, bcos::bytesConstRef _message);
+    // write the count in front of the envelope begun
+    static void finish(bcos::bytes& _buffer, uint32_t _count);
+
+    static void encode(const std::vector<bcos::bytes>& _messages, bcos::bytes& _buffer);
+    // the messages refer to the data
+    static bool decode(bcos::bytesConstRef _data, std::vector<bcos::bytesConstRef>& _messages);
+
+    static std::string messageSeq(const std::string& _seq, uint32_t _index);
+    // false if the seq is not of a message in a batch
+    static bool parseMessageSeq(
+        const std::string& _messageSeq, std::string& _seq, uint32_t& _index);
+};
+
+/**
+ * @brief coalesce the small messages published to the same topic into one request carrying the
+ * envelope of them, the batch is sent when it is full or after the max delay, the response of the
+ * batch is the envelope of the responses of the messages and is split to their callbacks
+ */
+class AMOPPublishBatcher : public std::enable_shared_from_this<AMOPPublishBatcher>
+{
+public:
+    using Ptr = std::shared_ptr<AMOPPublishBatcher>;
+    // send the envelope of the batch as one request
+    using SendFunc = std::function<void(const std::string& _topic,
+        std::shared_ptr<bcos::bytes> _envelope, uint32_t _timeout, PubCallback _callback)>;
+
+    struct Settings
+    {
+        uint32_t maxDelayMs = 2;
+        uint32_t maxMessages = 256;
+        uint32_t maxBytes = 64 * 1024;
+        // the larger messages are not batched
+        uint32_t maxMessageSize = 1024;
+    };
+
+    AMOPPublishBatcher(Settings _settings, SendFunc _send,
+        std::shared_ptr<bcos::boostssl::ws::WsMessageFactory> _messageFactory)
+      : m_settings(_settings), m_send(std::move(_send)), m_messageFactory(_messageFactory)
+    {}
+    ~AMOPPublishBatcher() { stop(); }
+
+public:
+    void start();
+    void stop();
+
+    // false if the message is too large to batch, the caller publishes it alone
+    bool publish(const std::string& _topic, bcos::bytesConstRef _data, uint32_t _timeout,
+        PubCallback _callback);
+    // send the batches older than the max delay, all the batches if _all
+    void flush(bool _all = false);
+
+    const Settings& settings() const { return m_settings; }
+    uint64_t sentBatches() const { return m_sentBatches.load(); }
+    uint64_t sentMessages() const { return m_sentMessages.load(); }
+
+    // split the response of the batch to the callbacks of the messages
+    static void onBatchResponse(const std::vector<PubCallback>& _callbacks,
+        std::shared_ptr<bcos::boostssl::ws::WsMessageFactory> _messageFactory,
+        bcos::Error::Ptr _error, std::shared_ptr<bcos::boostssl::ws::WsMessage> _msg,
+        std::shared_ptr<bcos::boostssl::ws::WsSession> _session);
+
+private:
+    struct Batch
+    {
+        std::shared_ptr<bcos::bytes> envelope;
+        std::vector<PubCallback> callbacks;
+        uint32_t timeout = 0;
+        std::chrono::steady_clock::time_point createTime;
+    };
+
+    void send(const std::string& _topic, Batch _batch);
+
+private:
+    Settings m_settings;
+    SendFunc m_send;
+    std::shared_ptr<bcos::boostssl::ws::WsMessageFactory> m_messageFactory;
+
+    std::mutex x_batches;
+    // topic => the batch filling
+    std::unordered_map<std::string, Batch> m_batches;
+
+    std::shared_ptr<bcos::Timer> m_timer;
+
+    std::atomic<uint64_t> m_sentBatches{0};
+    std::atomic<uint64_t> m_sentMessages{0};
+};
+
+/**
+ * @brief collect the responses of the messages of the batches received, the response of a batch
+ * is sent when all its messages responded
+ */
+class AMOPBatchResponder
+{
+public:
+    using Ptr = std::shared_ptr<AMOPBatchResponder>;
+    // send the envelope of the responses as the response of the batch
+    using SendFunc = std::function<void(
+        const std::string& _endPoint, const std::string& _seq, bcos::bytesConstRef _envelope)>;
+
+    explicit AMOPBatchResponder(int64_t _timeoutMs = 60000) : m_timeoutMs(_timeoutMs) {}
+
+public:
+    void addBatch(const std::string& _endPoint, const std::string& _seq, uint32_t _count);
+    // false if the batch is not found or the message responded already
+    bool respond(const std::string& _messageSeq, bcos::bytesConstRef _data, SendFunc _send);
+
+    std::size_t pendingBatches() const;
+
+private:
+    struct PendingBatch
+    {
+        std::string endPoint;
+        std::vector<bcos::bytes> responses;
+        std::vector<bool> responded;
+        uint32_t respondedCount = 0;
+        std::chrono::steady_clock::time_point createTime;
+    };
+
+private:
+    int64_t m_timeoutMs;
+    mutable std::mutex x_batches;
+    std::unordered_map<std::string, PendingBatch> m_batches;
+};
+
+}  // namespace amop
+}  // namespace cppsdk
+}  // namespace bcos
@@ -0,0 +1,384 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file AMOPChunk.cpp
+ * @author: octopus
+ * @date 2023-03-27
+ */
+
+#include <bcos-cpp-sdk/amop/AMOPChunk.h>
+#include <bcos-cpp-sdk/amop/Common.h>
+#include <bcos-utilities/BoostLog.h>
+#include <algorithm>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::amop;
+
+const std::size_t AMOPChunkHeader::SIZE;
+
+// the number of the rejected transfers remembered
+static const std::size_t AMOP_CHUNK_REJECTED_TRANSFERS = 1024;
+
+template <typename T>
+static void writeBigEndian(bcos::bytes& _buffer, T _value)
+{
+    for (int i = sizeof(T) - 1; i >= 0; --i)
+    {
+        _buffer.push_back((byte)(_value >> (i * 8)));
+    }
+}
+
+template <typename T>
+static T readBigEndian(const byte* _data)
+{
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+    {
+        value = (value << 8) | _data[i];
+    }
+    return value;
+}
+
+void AMOPChunkHeader::encode(bcos::bytes& _buffer) const
+{
+    writeBigEndian(_buffer, transferId);
+    writeBigEndian(_buffer, index);
+    writeBigEndian(_buffer, count);
+    writeBigEndian(_buffer, totalSize);
+    writeBigEndian(_buffer, offset);
+}
+
+bool AMOPChunkHeader::decode(bcos::bytesConstRef _data, bcos::bytesConstRef& _fragment)
+{
+    if (_data.size() < SIZE)
+    {
+        return false;
+    }
+
+    auto data = _data.data();
+    transferId = readBigEndian<uint64_t>(data);
+    index = readBigEndian<uint32_t>(data + 8);
+    count = readBigEndian<uint32_t>(data + 12);
+    totalSize = readBigEndian<uint64_t>(data + 16);
+    offset = readBigEndian<uint64_t>(data + 24);
+    _fragment = _data.getCroppedData(SIZE);
+
+    return count > 0 && index < count && offset <= totalSize &&
+           _fragment.size() <= totalSize - offset;
+}
+
+static uint64_t chunkCount(uint64_t _totalSize, uint64_t _chunkSize)
+{
+    return _totalSize / _chunkSize + (_totalSize % _chunkSize != 0 ? 1 : 0);
+}
+
+// the fragments are split by a fixed chunk size, the count, the offset and the size of the fragment
+// must agree with it, or the peer could make the count unrelated to the size of the message
+static bool checkChunkGeometry(const AMOPChunkHeader& _header, uint64_t _fragmentSize)
+{
+    if (_header.count == 0 || _header.index >= _header.count ||
+        _header.offset > _header.totalSize || _fragmentSize > _header.totalSize - _header.offset)
+    {
+        return false;
+    }
+    // each fragment carries one byte at least, except the empty message
+    if (_header.count > std::max<uint64_t>(_header.totalSize, 1))
+    {
+        return false;
+    }
+
+    if (_header.index + 1 < _header.count)
+    {
+        // the fragment except the last one is of the chunk size
+        return _fragmentSize > 0 && _header.offset == _header.index * _fragmentSize &&
+               _header.count == chunkCount(_header.totalSize, _fragmentSize);
+    }
+
+    // the last fragment ends the message
+    if (_header.offset + _fragmentSize != _header.totalSize)
+    {
+        return false;
+    }
+    if (_header.index == 0)
+    {
+        return true;
+    }
+    if (_header.offset % _header.index != 0)
+    {
+        return false;
+    }
+    auto chunkSize = _header.offset / _header.index;
+    return chunkSize > 0 && _fragmentSize <= chunkSize &&
+           _header.count == chunkCount(_header.totalSize, chunkSize);
+}
+
+AMOPChunkReassembler::Result AMOPChunkReassembler::append(const AMOPChunkHeader& _header,
+    bcos::bytesConstRef _fragment, bool _stream, DeliverFunc _deliver, std::string& _reason)
+{
+    if (!checkChunkGeometry(_header, _fragment.size()))
+    {
+        _reason = "invalid chunk header";
+        return Result::Rejected;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::shared_ptr<Transfer> transfer;
+    bool completed = false;
+    bool drainNow = false;
+    {
+        std::lock_guard<std::mutex> lock(x_transfers);
+        purgeExpiredUnsafe(now);
+
+        if (m_rejectedTransfers.count(_header.transferId))
+        {
+            _reason = "the chunked message is rejected";
+            return Result::Rejected;
+        }
+
+        auto it = m_transfers.find(_header.transferId);
+        if (it == m_transfers.end())
+        {
+            if (m_transfers.size() >= m_settings.maxTransfers)
+            {
+                return reject(_header.transferId, "too many chunked messages in progress", _reason);
+            }
+
+            if (_header.totalSize > m_settings.maxMessageSize)
+            {
+                return reject(_header.transferId, "the chunked message is too large", _reason);
+            }
+
+            transfer = std::make_shared<Transfer>();
+            transfer->totalSize = _header.totalSize;
+            transfer->count = _header.count;
+            transfer->stream = _stream;
+            if (!_stream)
+            {
+                // the whole message and the received flags are reserved at once
+                auto reserved = _header.totalSize + (_header.count + 7) / 8;
+                if (m_bufferedBytes + reserved > m_settings.maxBufferedBytes)
+                {
+                    return reject(_header.transferId, "the chunked message is too large", _reason);
+                }
+                transfer->buffer = std::make_shared<bcos::bytes>(_header.totalSize);
+                transfer->receivedFlags.resize(_header.count, false);
+                transfer->bufferedBytes = reserved;
+                m_bufferedBytes += reserved;
+            }
+            m_transfers[_header.transferId] = transfer;
+        }
+        else
+        {
+            transfer = it->second;
+            if (transfer->count != _header.count || transfer->totalSize != _header.totalSize)
+            {
+                return reject(_header.transferId, "inconsistent chunk header", _reason);
+            }
+        }
+        transfer->lastActive = now;
+
+        if (!transfer->stream)
+        {
+            if (transfer->receivedFlags[_header.index])
+            {
+                // duplicate
+                return Result::Incomplete;
+            }
+            transfer->receivedFlags[_header.index] = true;
+            transfer->received++;
+            std::copy(_fragment.begin(), _fragment.end(),
+                transfer->buffer->begin() + (std::ptrdiff_t)_header.offset);
+
+            if (transfer->received == transfer->count)
+            {
+                AMOPChunkFragment whole;
+                whole.transferId = _header.transferId;
+                whole.totalSize = transfer->totalSize;
+                whole.offset = 0;
+                whole.data = std::move(transfer->buffer);
+                whole.last = true;
+                transfer->ready.emplace_back(std::move(whole), std::move(_deliver));
+                completed = true;
+            }
+        }
+        else
+        {
+            if (_header.index < transfer->nextIndex || transfer->pending.count(_header.index))
+            {
+                // duplicate
+                return Result::Incomplete;
+            }
+
+            AMOPChunkFragment fragment;
+            fragment.transferId = _header.transferId;
+            fragment.totalSize = _header.totalSize;
+            fragment.offset = _header.offset;
+            fragment.data = std::make_shared<bcos::bytes>(_fragment.begin(), _fragment.end());
+            fragment.last = (_header.index + 1 == _header.count);
+
+            if (_header.index == transfer->nextIndex)
+            {
+                transfer->ready.emplace_back(std::move(fragment), std::move(_deliver));
+                transfer->nextIndex++;
+                // the buffered fragments following it
+                auto pendingIt = transfer->pending.begin();
+                while (pendingIt != transfer->pending.end() &&
+                       pendingIt->first == transfer->nextIndex)
+                {
+                    auto size = pendingIt->second.first.data->size();
+                    transfer->bufferedBytes -= size;
+                    m_bufferedBytes -= size;
+                    transfer->ready.push_back(std::move(pendingIt->second));
+                    transfer->nextIndex++;
+                    pendingIt = transfer->pending.erase(pendingIt);
+                }
+            }
+            else
+            {
+                if (m_bufferedBytes + _fragment.size() > m_settings.maxBufferedBytes)
+                {
+                    return reject(
+                        _header.transferId, "too many out of order fragments buffered", _reason);
+                }
+                transfer->bufferedBytes += _fragment.size();
+                m_bufferedBytes += _fragment.size();
+                transfer->pending.emplace(
+                    _header.index, std::make_pair(std::move(fragment), std::move(_deliver)));
+            }
+            completed = (transfer->nextIndex == transfer->count);
+        }
+
+        if (completed)
+        {
+            m_bufferedBytes -= transfer->bufferedBytes;
+            transfer->bufferedBytes = 0;
+            m_transfers.erase(_header.transferId);
+        }
+
+        if (!transfer->delivering && !transfer->ready.empty())
+        {
+            transfer->delivering = true;
+            drainNow = true;
+        }
+    }
+
+    if (drainNow)
+    {
+        drain(transfer);
+    }
+    return completed ? Result::Completed : Result::Incomplete;
+}
+
+AMOPChunkReassembler::Result AMOPChunkReassembler::reject(
+    uint64_t _transferId, const std::string& _reason, std::string& _outReason)
+{
+    auto it = m_transfers.find(_transferId);
+    if (it != m_transfers.end())
+    {
+        m_bufferedBytes -= it->second->bufferedBytes;
+        m_transfers.erase(it);
+    }
+
+    if (m_rejectedTransfers.insert(_transferId).second)
+    {
+        m_rejectedOrder.push_back(_transferId);
+        if (m_rejectedOrder.size() > AMOP_CHUNK_REJECTED_TRANSFERS)
+        {
+            m_rejectedTransfers.erase(m_rejectedOrder.front());
+            m_rejectedOrder.pop_front();
+        }
+        m_droppedTransfers++;
+    }
+
+    AMOP_CLIENT(WARNING) << LOG_BADGE("AMOPChunkReassembler") << LOG_DESC(_reason)
+                         << LOG_KV("transferId", _transferId)
+                         << LOG_KV("bufferedBytes", m_bufferedBytes);
+    _outReason = _reason;
+    return Result::Rejected;
+}
+
+void AMOPChunkReassembler::drain(std::shared_ptr<Transfer> _transfer)
+{
+    while (true)
+    {
+        std::deque<std::pair<AMOPChunkFragment, DeliverFunc>> ready;
+        {
+            std::lock_guard<std::mutex> lock(x_transfers);
+            if (_transfer->ready.empty())
+            {
+                _transfer->delivering = false;
+                return;
+            }
+            ready.swap(_transfer->ready);
+        }
+
+        for (auto& [fragment, deliver] : ready)
+        {
+            if (deliver)
+            {
+                deliver(fragment);
+            }
+        }
+    }
+}
+
+void AMOPChunkReassembler::purgeExpired()
+{
+    std::lock_guard<std::mutex> lock(x_transfers);
+    m_lastPurgeTime = std::chrono::steady_clock::time_point();
+    purgeExpiredUnsafe(std::chrono::steady_clock::now());
+}
+
+void AMOPChunkReassembler::purgeExpiredUnsafe(std::chrono::steady_clock::time_point _now)
+{
+    // at most once a second
+    if (_now - m_lastPurgeTime < std::chrono::seconds(1))
+    {
+        return;
+    }
+    m_lastPurgeTime = _now;
+
+    auto timeout = std::chrono::milliseconds(m_settings.timeoutMs);
+    for (auto it = m_transfers.begin(); it != m_transfers.end();)
+    {
+        if (_now - it->second->lastActive < timeout)
+        {
+            ++it;
+            continue;
+        }
+
+        AMOP_CLIENT(WARNING) << LOG_BADGE("AMOPChunkReassembler")
+                             << LOG_DESC("drop the chunked message timeout")
+                             << LOG_KV("transferId", it->first)
+                             << LOG_KV("count", it->second->count)
+                             << LOG_KV("totalSize", it->second->totalSize);
+        m_bufferedBytes -= it->second->bufferedBytes;
+        m_droppedTransfers++;
+        it = m_transfers.erase(it);
+    }
+}
+
+std::size_t AMOPChunkReassembler::transferCount() const
+{
+    std::lock_guard<std::mutex> lock(x_transfers);
+    return m_transfers.size();
+}
+
+uint64_t AMOPChunkReassembler::bufferedBytes() const
+{
+    std::lock_guard<std::mutex> lock(x_transfers);
+    return m_bufferedBytes;
+}
@@ -0,0 +1,196 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file AMOPChunk.h
+ * @author: octopus
+ * @date 2023-03-27
+ */
+#pragma once
+
+#include <bcos-cpp-sdk/amop/AMOPInterface.h>
+#include <bcos-utilities/Common.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace amop
+{
+// the version of the amop request carrying a fragment of a chunked message
+static const uint32_t AMOP_CHUNK_VERSION = 1;
+
+/**
+ * @brief the header in front of the data of each fragment, big endian:
+ * transferId(8) | index(4) | count(4) | totalSize(8) | offset(8)
+ */
+struct AMOPChunkHeader
+{
+    static const std::size_t SIZE = 32;
+
+    uint64_t transferId = 0;
+    uint32_t index = 0;
+    uint32_t count = 0;
+    uint64_t totalSize = 0;
+    uint64_t offset = 0;
+
+    void encode(bcos::bytes& _buffer) const;
+    // the fragment data follows the header
+    bool decode(bcos::bytesConstRef _data, bcos::bytesConstRef& _fragment);
+};
+
+struct AMOPChunkFragment
+{
+    uint64_t transferId = 0;
+    uint64_t totalSize = 0;
+    uint64_t offset = 0;
+    std::shared_ptr<bcos::bytes> data;
+    // the last fragment of the message
+    bool last = false;
+};
+
+// the fragments of the chunked message delivered in order
+using AMOPStreamCallback = std::function<void(bcos::Error::Ptr, const std::string& _endPoint,
+    const std::string& _seq, const AMOPChunkFragment& _fragment,
+    std::shared_ptr<bcos::boostssl::ws::WsSession> _session)>;
+
+/**
+ * @brief reassemble the fragments of the chunked messages, the whole message is buffered until
+ * completed, or the fragments are delivered as a stream once they are contiguous and only the out
+ * of order ones are buffered. The buffered bytes and the transfers in progress are bounded.
+ */
+class AMOPChunkReassembler
+{
+public:
+    using Ptr = std::shared_ptr<AMOPChunkReassembler>;
+    using DeliverFunc = std::function<void(const AMOPChunkFragment&)>;
+
+    struct Settings
+    {
+        // the max size of the chunked message, reassembled as a whole or delivered as a stream
+        uint64_t maxMessageSize = 64 * 1024 * 1024;
+        // the max bytes buffered by all the transfers
+        uint64_t maxBufferedBytes = 256 * 1024 * 1024;
+        std::size_t maxTransfers = 1024;
+        // the transfer without new fragment is dropped after the timeout
+        int64_t timeoutMs = 60000;
+    };
+
+    enum class Result
+    {
+        Incomplete,
+        Completed,
+        Rejected
+    };
+
+    AMOPChunkReassembler() : AMOPChunkReassembler(Settings()) {}
+    explicit AMOPChunkReassembler(Settings _settings) : m_settings(_settings) {}
+
+public:
+    // _deliver is called with the fragments made contiguous by this one in stream mode, or with
+    // the whole message when completed, the fragments of one transfer are never delivered
+    // concurrently
+    Result append(const AMOPChunkHeader& _header, bcos::bytesConstRef _fragment, bool _stream,
+        DeliverFunc _deliver, std::string& _reason);
+
+    // drop the transfers timeout
+    void purgeExpired();
+
+    std::size_t transferCount() const;
+    uint64_t bufferedBytes() const;
+    uint64_t droppedTransfers() const { return m_droppedTransfers.load(); }
+    const Settings& settings() const { return m_settings; }
+
+private:
+    struct Transfer
+    {
+        uint64_t totalSize = 0;
+        uint32_t count = 0;
+        bool stream = false;
+        std::chrono::steady_clock::time_point lastActive;
+
+        // the bytes accounted to the buffered bytes
+        uint64_t bufferedBytes = 0;
+
+        // whole mode
+        uint32_t received = 0;
+        std::vector<bool> receivedFlags;
+        std::shared_ptr<bcos::bytes> buffer;
+
+        // stream mode, the next index to deliver and the fragments out of order
+        uint32_t nextIndex = 0;
+        std::map<uint32_t, std::pair<AMOPChunkFragment, DeliverFunc>> pending;
+
+        std::deque<std::pair<AMOPChunkFragment, DeliverFunc>> ready;
+        bool delivering = false;
+    };
+
+    // NOTE: called with x_transfers held
+    Result reject(uint64_t _transferId, const std::string& _reason, std::string& _outReason);
+    void purgeExpiredUnsafe(std::chrono::steady_clock::time_point _now);
+    void drain(std::shared_ptr<Transfer> _transfer);
+
+private:
+    Settings m_settings;
+
+    mutable std::mutex x_transfers;
+    std::unordered_map<uint64_t, std::shared_ptr<Transfer>> m_transfers;
+    uint64_t m_bufferedBytes = 0;
+    std::chrono::steady_clock::time_point m_lastPurgeTime;
+    // the transfers rejected recently, the rest of their fragments are rejected at once
+    std::unordered_set<uint64_t> m_rejectedTransfers;
+    std::deque<uint64_t> m_rejectedOrder;
+
+    std::atomic<uint64_t> m_droppedTransfers{0};
+};
+
+/**
+ * @brief the state of a chunked publish, the fragments except the last one are sent with at most
+ * window in flight, the last one is sent after all the others acked and its response is the
+ * response of the publish
+ */
+struct AMOPChunkedPublish
+{
+    using Ptr = std::shared_ptr<AMOPChunkedPublish>;
+
+    std::string topic;
+    std::shared_ptr<bcos::bytes> data;
+    uint64_t transferId = 0;
+    uint32_t chunkSize = 0;
+    uint32_t count = 0;
+    uint32_t timeout = 0;
+    PubCallback callback;
+
+    std::mutex x_state;
+    uint32_t nextIndex = 0;
+    uint32_t inflight = 0;
+    uint32_t acked = 0;
+    bool finished = false;
+};
+
+}  // namespace amop
+}  // namespace cppsdk
+}  // namespace bcos
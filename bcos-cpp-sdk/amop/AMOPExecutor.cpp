@@ -0,0 +1,149 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file AMOPExecutor.cpp
+ * @author: octopus
+ * @date 2023-03-31
+ */
+
+#include <bcos-cpp-sdk/amop/AMOPExecutor.h>
+#include <bcos-cpp-sdk/amop/Common.h>
+#include <bcos-utilities/BoostLog.h>
+#include <boost/exception/diagnostic_information.hpp>
+#include <algorithm>
+#include <exception>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::amop;
+
+AMOPExecutor::AMOPExecutor(Settings _settings) : m_settings(std::move(_settings))
+{
+    m_settings.threadCount = std::max<std::size_t>(m_settings.threadCount, 1);
+    m_settings.queueCapacity = std::max<std::size_t>(m_settings.queueCapacity, 1);
+    for (std::size_t i = 0; i < m_settings.threadCount; ++i)
+    {
+        auto lane = std::make_shared<Lane>();
+        lane->worker = std::make_shared<bcos::ThreadPool>(m_settings.name, 1);
+        m_lanes.push_back(lane);
+    }
+
+    AMOP_CLIENT(INFO) << LOG_BADGE("AMOPExecutor") << LOG_DESC("create amop executor")
+                      << LOG_KV("name", m_settings.name)
+                      << LOG_KV("threadCount", m_settings.threadCount)
+                      << LOG_KV("queueCapacity", m_settings.queueCapacity)
+                      << LOG_KV("orderByKey", (bool)m_settings.keyExtractor)
+                      << LOG_KV("backpressure", (int)m_settings.backpressure);
+}
+
+bool AMOPExecutor::execute(
+    const std::string& _topic, bcos::bytesConstRef _data, std::function<void()> _task)
+{
+    if (m_stopped)
+    {
+        m_dropped++;
+        return false;
+    }
+
+    std::size_t hash = m_settings.keyExtractor ?
+                           std::hash<std::string>{}(m_settings.keyExtractor(_topic, _data)) :
+                           std::hash<std::string>{}(_topic);
+    auto lane = m_lanes[hash % m_lanes.size()];
+    {
+        std::unique_lock<std::mutex> lock(lane->x_queue);
+        if (lane->queued >= m_settings.queueCapacity)
+        {
+            if (m_settings.backpressure == Backpressure::Drop)
+            {
+                m_dropped++;
+                AMOP_CLIENT(DEBUG) << LOG_BADGE("AMOPExecutor") << LOG_DESC("drop for lane full")
+                                   << LOG_KV("name", m_settings.name) << LOG_KV("topic", _topic);
+                return false;
+            }
+
+            m_blocked++;
+            lane->cv.wait(lock, [this, &lane]() {
+                return m_stopped || lane->queued < m_settings.queueCapacity;
+            });
+            if (m_stopped)
+            {
+                m_dropped++;
+                return false;
+            }
+        }
+        lane->queued++;
+    }
+
+    lane->worker->enqueue([this, lane, task = std::move(_task)]() {
+        try
+        {
+            task();
+        }
+        catch (const std::exception& e)
+        {
+            AMOP_CLIENT(WARNING) << LOG_BADGE("AMOPExecutor") << LOG_DESC("callback exception")
+                                 << LOG_KV("name", m_settings.name)
+                                 << LOG_KV("error", std::string(e.what()));
+        }
+        catch (...)
+        {
+            // the slot of the lane is released and the worker keeps running on any exception
+            AMOP_CLIENT(WARNING)
+                << LOG_BADGE("AMOPExecutor") << LOG_DESC("callback exception")
+                << LOG_KV("name", m_settings.name)
+                << LOG_KV("error", boost::current_exception_diagnostic_information());
+        }
+        {
+            std::lock_guard<std::mutex> lock(lane->x_queue);
+            lane->queued--;
+            lane->cv.notify_one();
+        }
+        m_executed++;
+    });
+    return true;
+}
+
+void AMOPExecutor::stop()
+{
+    if (m_stopped.exchange(true))
+    {
+        return;
+    }
+
+    for (auto& lane : m_lanes)
+    {
+        {
+            std::lock_guard<std::mutex> lock(lane->x_queue);
+            lane->cv.notify_all();
+        }
+        // join the worker, the messages not executed are dropped
+        lane->worker->stop();
+    }
+
+    AMOP_CLIENT(INFO) << LOG_BADGE("AMOPExecutor") << LOG_DESC("stop amop executor")
+                      << LOG_KV("name", m_settings.name) << LOG_KV("executed", m_executed.load())
+                      << LOG_KV("dropped", m_dropped.load());
+}
+
+std::size_t AMOPExecutor::queued() const
+{
+    std::size_t queued = 0;
+    for (const auto& lane : m_lanes)
+    {
+        std::lock_guard<std::mutex> lock(lane->x_queue);
+        queued += lane->queued;
+    }
+    return queued;
+}
@@ -0,0 +1,109 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file AMOPExecutor.h
+ * @author: octopus
+ * @date 2023-03-31
+ */
+#pragma once
+
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/ThreadPool.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace amop
+{
+/**
+ * @brief execute the subscriber callbacks of the topics on single thread lanes, the messages of
+ * the same topic(or the same key if the key extractor set) are executed on the same lane in the
+ * receiving order, the messages of different topics or keys run in parallel. The queue of each
+ * lane is bounded, the receiving thread is blocked or the message is dropped when it is full.
+ * NOTE: the callback should not dispatch to its own lane with the Block backpressure
+ */
+class AMOPExecutor
+{
+public:
+    using Ptr = std::shared_ptr<AMOPExecutor>;
+    // the ordering key of the message
+    using KeyExtractor =
+        std::function<std::string(const std::string& _topic, bcos::bytesConstRef _data)>;
+
+    enum class Backpressure
+    {
+        // block the receiving thread until the lane has room
+        Block,
+        // drop the message
+        Drop
+    };
+
+    struct Settings
+    {
+        std::size_t threadCount = 4;
+        // the max messages queued of each lane
+        std::size_t queueCapacity = 10000;
+        Backpressure backpressure = Backpressure::Block;
+        // ordered by topic if not set
+        KeyExtractor keyExtractor;
+        std::string name = "t_amop_exec";
+    };
+
+    AMOPExecutor() : AMOPExecutor(Settings()) {}
+    explicit AMOPExecutor(Settings _settings);
+    ~AMOPExecutor() { stop(); }
+
+public:
+    // false if dropped for the lane full or the executor stopped
+    bool execute(const std::string& _topic, bcos::bytesConstRef _data, std::function<void()> _task);
+    void stop();
+
+    const Settings& settings() const { return m_settings; }
+    uint64_t executed() const { return m_executed.load(); }
+    uint64_t dropped() const { return m_dropped.load(); }
+    // the times the receiving thread blocked for the lane full
+    uint64_t blocked() const { return m_blocked.load(); }
+    std::size_t queued() const;
+
+private:
+    struct Lane
+    {
+        std::shared_ptr<bcos::ThreadPool> worker;
+        mutable std::mutex x_queue;
+        std::condition_variable cv;
+        std::size_t queued = 0;
+    };
+
+private:
+    Settings m_settings;
+    std::vector<std::shared_ptr<Lane>> m_lanes;
+    std::atomic<bool> m_stopped{false};
+
+    std::atomic<uint64_t> m_executed{0};
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<uint64_t> m_blocked{0};
+};
+
+}  // namespace amop
+}  // namespace cppsdk
+}  // namespace bcos
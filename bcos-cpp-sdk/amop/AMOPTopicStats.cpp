@@ -0,0 +1,112 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file AMOPTopicStats.cpp
+ * @author: octopus
+ * @date 2023-03-27
+ */
+
+#include <bcos-cpp-sdk/amop/AMOPTopicStats.h>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::amop;
+
+std::shared_ptr<AMOPTopicStats::Counters> AMOPTopicStats::counters(const std::string& _topic)
+{
+    {
+        boost::shared_lock<boost::shared_mutex> lock(x_counters);
+        auto it = m_counters.find(_topic);
+        if (it != m_counters.end())
+        {
+            return it->second;
+        }
+    }
+
+    boost::unique_lock<boost::shared_mutex> lock(x_counters);
+    auto& topicCounters = m_counters[_topic];
+    if (!topicCounters)
+    {
+        topicCounters = std::make_shared<Counters>();
+    }
+    return topicCounters;
+}
+
+void AMOPTopicStats::onSent(
+    const std::string& _topic, uint64_t _bytes, uint64_t _fragments, bool _message)
+{
+    auto topicCounters = counters(_topic);
+    topicCounters->sentBytes += _bytes;
+    topicCounters->sentFragments += _fragments;
+    topicCounters->sentMessages += (_message ? 1 : 0);
+}
+
+void AMOPTopicStats::onRecv(
+    const std::string& _topic, uint64_t _bytes, uint64_t _fragments, bool _message)
+{
+    auto topicCounters = counters(_topic);
+    topicCounters->recvBytes += _bytes;
+    topicCounters->recvFragments += _fragments;
+    topicCounters->recvMessages += (_message ? 1 : 0);
+}
+
+void AMOPTopicStats::onDropped(const std::string& _topic)
+{
+    counters(_topic)->droppedMessages++;
+}
+
+AMOPTopicThroughput AMOPTopicStats::toThroughput(const Counters& _counters)
+{
+    AMOPTopicThroughput throughput;
+    throughput.sentMessages = _counters.sentMessages.load();
+    throughput.sentFragments = _counters.sentFragments.load();
+    throughput.sentBytes = _counters.sentBytes.load();
+    throughput.recvMessages = _counters.recvMessages.load();
+    throughput.recvFragments = _counters.recvFragments.load();
+    throughput.recvBytes = _counters.recvBytes.load();
+    throughput.droppedMessages = _counters.droppedMessages.load();
+    throughput.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - _counters.startTime)
+                               .count();
+    return throughput;
+}
+
+AMOPTopicThroughput AMOPTopicStats::throughput(const std::string& _topic) const
+{
+    boost::shared_lock<boost::shared_mutex> lock(x_counters);
+    auto it = m_counters.find(_topic);
+    if (it == m_counters.end())
+    {
+        return AMOPTopicThroughput();
+    }
+    return toThroughput(*it->second);
+}
+
+std::unordered_map<std::string, AMOPTopicThroughput> AMOPTopicStats::throughput() const
+{
+    std::unordered_map<std::string, AMOPTopicThroughput> result;
+    boost::shared_lock<boost::shared_mutex> lock(x_counters);
+    for (const auto& [topic, topicCounters] : m_counters)
+    {
+        result[topic] = toThroughput(*topicCounters);
+    }
+    return result;
+}
+
+void AMOPTopicStats::reset()
+{
+    boost::unique_lock<boost::shared_mutex> lock(x_counters);
+    m_counters.clear();
+}
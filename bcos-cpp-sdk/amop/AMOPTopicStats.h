@@ -0,0 +1,97 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file AMOPTopicStats.h
+ * @author: octopus
+ * @date 2023-03-27
+ */
+#pragma once
+
+#include <boost/thread/thread.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace amop
+{
+struct AMOPTopicThroughput
+{
+    uint64_t sentMessages = 0;
+    uint64_t sentFragments = 0;
+    uint64_t sentBytes = 0;
+    uint64_t recvMessages = 0;
+    uint64_t recvFragments = 0;
+    uint64_t recvBytes = 0;
+    uint64_t droppedMessages = 0;
+    // the time since the first message of the topic
+    int64_t elapsedMs = 0;
+
+    double sentBytesPerSecond() const
+    {
+        return elapsedMs > 0 ? (double)sentBytes * 1000 / elapsedMs : 0;
+    }
+    double recvBytesPerSecond() const
+    {
+        return elapsedMs > 0 ? (double)recvBytes * 1000 / elapsedMs : 0;
+    }
+};
+
+// the messages and bytes sent and received of each topic
+class AMOPTopicStats
+{
+public:
+    using Ptr = std::shared_ptr<AMOPTopicStats>;
+
+public:
+    void onSent(const std::string& _topic, uint64_t _bytes, uint64_t _fragments, bool _message);
+    void onRecv(const std::string& _topic, uint64_t _bytes, uint64_t _fragments, bool _message);
+    void onDropped(const std::string& _topic);
+
+    AMOPTopicThroughput throughput(const std::string& _topic) const;
+    std::unordered_map<std::string, AMOPTopicThroughput> throughput() const;
+
+    void reset();
+
+private:
+    struct Counters
+    {
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        std::atomic<uint64_t> sentMessages{0};
+        std::atomic<uint64_t> sentFragments{0};
+        std::atomic<uint64_t> sentBytes{0};
+        std::atomic<uint64_t> recvMessages{0};
+        std::atomic<uint64_t> recvFragments{0};
+        std::atomic<uint64_t> recvBytes{0};
+        std::atomic<uint64_t> droppedMessages{0};
+    };
+
+    std::shared_ptr<Counters> counters(const std::string& _topic);
+    static AMOPTopicThroughput toThroughput(const Counters& _counters);
+
+private:
+    mutable boost::shared_mutex x_counters;
+    std::unordered_map<std::string, std::shared_ptr<Counters>> m_counters;
+};
+
+}  // namespace amop
+}  // namespace cppsdk
+}  // namespace bcos
@@ -0,0 +1,307 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file AMOPTopicSync.cpp
+ * @author: octopus
+ * @date 2023-04-03
+ */
+
+#include <bcos-cpp-sdk/amop/AMOPTopicSync.h>
+#include <bcos-cpp-sdk/amop/Common.h>
+#include <bcos-utilities/BoostLog.h>
+#include <json/json.h>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::amop;
+
+AMOPTopicSync::AMOPTopicSync(Settings _settings, TopicManager::Ptr _topicManager,
+    SendFunc _send, EndPointsFunc _endPoints)
+  : m_settings(_settings),
+    m_topicManager(_topicManager),
+    m_send(std::move(_send)),
+    m_endPoints(std::move(_endPoints)),
+    m_syncedTopics(_topicManager->topics())
+{}
+
+void AMOPTopicSync::start()
+{
+    if (m_timer || m_settings.batchDelayMs == 0)
+    {
+        return;
+    }
+
+    std::weak_ptr<AMOPTopicSync> weakSync = shared_from_this();
+    m_timer = std::make_shared<bcos::Timer>(m_settings.batchDelayMs, "amopTopicSync");
+    m_timer->registerTimeoutHandler([weakSync]() {
+        auto sync = weakSync.lock();
+        if (!sync)
+        {
+            return;
+        }
+        sync->flush();
+        sync->m_timer->restart();
+    });
+    m_timer->start();
+
+    AMOP_CLIENT(INFO) << LOG_BADGE("AMOPTopicSync") << LOG_DESC("start")
+                      << LOG_KV("incremental", m_settings.incremental)
+                      << LOG_KV("batchDelayMs", m_settings.batchDelayMs);
+}
+
+void AMOPTopicSync::stop()
+{
+    if (m_timer)
+    {
+        m_timer->stop();
+    }
+    flush();
+}
+
+void AMOPTopicSync::onTopicsChanged(const std::set<std::string>& _topics)
+{
+    {
+        std::lock_guard<std::mutex> lock(x_sync);
+        m_dirtyTopics.insert(_topics.begin(), _topics.end());
+    }
+    if (m_settings.batchDelayMs == 0)
+    {
+        flush();
+    }
+}
+
+void AMOPTopicSync::flush()
+{
+    std::vector<Request> requests;
+    {
+        std::lock_guard<std::mutex> lock(x_sync);
+        flushUnsafe(requests);
+    }
+    dispatch(requests);
+}
+
+void AMOPTopicSync::flushUnsafe(std::vector<Request>& _requests)
+{
+    if (m_dirtyTopics.empty())
+    {
+        return;
+    }
+
+    // the net changes, a topic added and removed during the delay is not sent
+    std::set<std::string> add;
+    std::set<std::string> remove;
+    for (const auto& topic : m_dirtyTopics)
+    {
+        auto subscribed = m_topicManager->hasTopic(topic);
+        auto synced = m_syncedTopics.count(topic) > 0;
+        if (subscribed && !synced)
+        {
+            add.insert(topic);
+            m_syncedTopics.insert(topic);
+        }
+        else if (!subscribed && synced)
+        {
+            remove.insert(topic);
+            m_syncedTopics.erase(topic);
+        }
+    }
+    m_dirtyTopics.clear();
+    if (add.empty() && remove.empty())
+    {
+        return;
+    }
+
+    auto baseVersion = m_version++;
+    std::shared_ptr<const std::string> delta;
+    for (const auto& endPoint : m_endPoints())
+    {
+        auto& state = m_endPoint2State[endPoint];
+        if (!m_settings.incremental || state.version != baseVersion)
+        {
+            sendFull(endPoint, state, _requests);
+            continue;
+        }
+
+        if (!delta)
+        {
+            delta = std::make_shared<const std::string>(
+                encodeDelta(baseVersion, m_version, add, remove));
+        }
+        state.version = m_version;
+        m_deltas++;
+        _requests.push_back(Request{endPoint, delta, m_version, false});
+    }
+
+    AMOP_CLIENT(DEBUG) << LOG_BADGE("AMOPTopicSync") << LOG_DESC("flush")
+                       << LOG_KV("version", m_version) << LOG_KV("add", add.size())
+                       << LOG_KV("remove", remove.size())
+                       << LOG_KV("topics", m_syncedTopics.size());
+}
+
+void AMOPTopicSync::resync(const std::string& _endPoint)
+{
+    std::vector<Request> requests;
+    {
+        std::lock_guard<std::mutex> lock(x_sync);
+        sendFull(_endPoint, m_endPoint2State[_endPoint], requests);
+    }
+    dispatch(requests);
+}
+
+void AMOPTopicSync::onDisconnect(const std::string& _endPoint)
+{
+    std::lock_guard<std::mutex> lock(x_sync);
+    m_endPoint2State.erase(_endPoint);
+}
+
+uint64_t AMOPTopicSync::version() const
+{
+    std::lock_guard<std::mutex> lock(x_sync);
+    return m_version;
+}
+
+uint64_t AMOPTopicSync::syncedVersion(const std::string& _endPoint) const
+{
+    std::lock_guard<std::mutex> lock(x_sync);
+    auto it = m_endPoint2State.find(_endPoint);
+    return it != m_endPoint2State.end() ? it->second.version : 0;
+}
+
+void AMOPTopicSync::dispatch(const std::vector<Request>& _requests)
+{
+    // NOTE: the requests of the concurrent flushes may be sent out of order, the endpoint
+    // responds the version mismatch to the delta out of order and is resynced then
+    for (const auto& request : _requests)
+    {
+        m_sentBytes += request.request->size();
+        if (!m_settings.incremental)
+        {
+            m_send(request.endPoint, *request.request, nullptr);
+            continue;
+        }
+
+        std::weak_ptr<AMOPTopicSync> weakSync = weak_from_this();
+        m_send(request.endPoint, *request.request,
+            [weakSync, endPoint = request.endPoint, version = request.version,
+                full = request.full](bcos::Error::Ptr _error, const std::string& _response) {
+                auto sync = weakSync.lock();
+                if (sync)
+                {
+                    sync->onResponse(endPoint, version, full, _error, _response);
+                }
+            });
+    }
+}
+
+void AMOPTopicSync::sendFull(
+    const std::string& _endPoint, EndPointState& _state, std::vector<Request>& _requests)
+{
+    _state.version = m_version;
+    _state.fullVersion = m_version;
+    m_fullSyncs++;
+    _requests.push_back(Request{_endPoint,
+        std::make_shared<const std::string>(encodeFull(m_syncedTopics, m_version)), m_version,
+        true});
+
+    AMOP_CLIENT(INFO) << LOG_BADGE("AMOPTopicSync") << LOG_DESC("full sync")
+                      << LOG_KV("endpoint", _endPoint) << LOG_KV("version", m_version)
+                      << LOG_KV("topics", m_syncedTopics.size());
+}
+
+void AMOPTopicSync::onResponse(const std::string& _endPoint, uint64_t _version, bool _full,
+    bcos::Error::Ptr _error, const std::string& _response)
+{
+    uint64_t version = 0;
+    if ((!_error || _error->errorCode() == 0) && decodeResponse(_response, version) &&
+        version == _version)
+    {
+        return;
+    }
+
+    std::vector<Request> requests;
+    {
+        std::lock_guard<std::mutex> lock(x_sync);
+        auto it = m_endPoint2State.find(_endPoint);
+        // the endpoint disconnected or the response of the messages before the last full sync
+        if (it == m_endPoint2State.end() || _version < it->second.fullVersion ||
+            (!_full && _version == it->second.fullVersion))
+        {
+            return;
+        }
+
+        AMOP_CLIENT(WARNING) << LOG_BADGE("AMOPTopicSync") << LOG_DESC("topics out of sync")
+                             << LOG_KV("endpoint", _endPoint) << LOG_KV("full", _full)
+                             << LOG_KV("version", _version) << LOG_KV("remoteVersion", version)
+                             << LOG_KV("errorCode", _error ? _error->errorCode() : 0);
+        if (_full)
+        {
+            // not resent at once for the endpoint may not support the sync, the next change is
+            // sent to it as a full sync
+            it->second.version = 0;
+            return;
+        }
+        sendFull(_endPoint, it->second, requests);
+    }
+    dispatch(requests);
+}
+
+std::string AMOPTopicSync::encodeFull(const std::set<std::string>& _topics, uint64_t _version)
+{
+    Json::Value jTopics(Json::arrayValue);
+    for (const auto& topic : _topics)
+    {
+        jTopics.append(topic);
+    }
+    Json::Value jReq;
+    jReq["topics"] = jTopics;
+    jReq["version"] = (Json::UInt64)_version;
+    Json::FastWriter writer;
+    return writer.write(jReq);
+}
+
+std::string AMOPTopicSync::encodeDelta(uint64_t _baseVersion, uint64_t _version,
+    const std::set<std::string>& _add, const std::set<std::string>& _remove)
+{
+    Json::Value jAdd(Json::arrayValue);
+    for (const auto& topic : _add)
+    {
+        jAdd.append(topic);
+    }
+    Json::Value jRemove(Json::arrayValue);
+    for (const auto& topic : _remove)
+    {
+        jRemove.append(topic);
+    }
+    Json::Value jReq;
+    jReq["baseVersion"] = (Json::UInt64)_baseVersion;
+    jReq["version"] = (Json::UInt64)_version;
+    jReq["add"] = jAdd;
+    jReq["remove"] = jRemove;
+    Json::FastWriter writer;
+    return writer.write(jReq);
+}
+
+bool AMOPTopicSync::decodeResponse(const std::string& _response, uint64_t& _version)
+{
+    Json::Value root;
+    Json::Reader jsonReader;
+    if (!jsonReader.parse(_response, root) || !root.isObject() || !root.isMember("version") ||
+        !root["version"].isUInt64())
+    {
+        return false;
+    }
+    _version = root["version"].asUInt64();
+    return true;
+}
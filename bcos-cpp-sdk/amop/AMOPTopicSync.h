@@ -0,0 +1,151 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file AMOPTopicSync.h
+ * @author: octopus
+ * @date 2023-04-03
+ */
+#pragma once
+
+#include <bcos-cpp-sdk/amop/TopicManager.h>
+#include <bcos-utilities/Error.h>
+#include <bcos-utilities/Timer.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace amop
+{
+/**
+ * @brief sync the topics subscribed to the endpoints with the AMOP_SUBTOPIC messages
+ * the full sync: {"topics":[...],"version":N}, the topic set of the endpoint is replaced
+ * the delta: {"baseVersion":B,"version":N,"add":[...],"remove":[...]}, applied by the endpoint
+ * only if its version is B, the endpoint responds {"version":V} with its version after that.
+ * The changes are coalesced for the batch delay and sent as one delta to the endpoints synced to
+ * the last version, the full sync is sent on connect, on the version mismatch and to the
+ * endpoints not synced. With the incremental sync disabled every change is a full sync without
+ * response expected, as the nodes not supporting the delta do.
+ */
+class AMOPTopicSync : public std::enable_shared_from_this<AMOPTopicSync>
+{
+public:
+    using Ptr = std::shared_ptr<AMOPTopicSync>;
+    using RespFunc = std::function<void(bcos::Error::Ptr _error, const std::string& _response)>;
+    // send the request to the endpoint, _respFunc is nullptr if no response expected
+    using SendFunc = std::function<void(
+        const std::string& _endPoint, const std::string& _request, RespFunc _respFunc)>;
+    // the endpoints connected
+    using EndPointsFunc = std::function<std::vector<std::string>()>;
+
+    struct Settings
+    {
+        // NOTE: the nodes should support the delta
+        bool incremental = false;
+        // the changes are coalesced for the delay, 0 for sent at once
+        uint32_t batchDelayMs = 0;
+    };
+
+    AMOPTopicSync(Settings _settings, TopicManager::Ptr _topicManager, SendFunc _send,
+        EndPointsFunc _endPoints);
+    ~AMOPTopicSync() { stop(); }
+
+public:
+    void start();
+    // the changes pending are sent
+    void stop();
+
+    // the topics of the topic manager changed
+    void onTopicsChanged(const std::set<std::string>& _topics);
+    // send the changes pending
+    void flush();
+    // the full sync to the endpoint, called on connect
+    void resync(const std::string& _endPoint);
+    void onDisconnect(const std::string& _endPoint);
+
+    const Settings& settings() const { return m_settings; }
+    uint64_t version() const;
+    // the version the endpoint synced to, 0 if not synced
+    uint64_t syncedVersion(const std::string& _endPoint) const;
+
+    uint64_t fullSyncs() const { return m_fullSyncs.load(); }
+    uint64_t deltas() const { return m_deltas.load(); }
+    uint64_t sentBytes() const { return m_sentBytes.load(); }
+
+    static std::string encodeFull(const std::set<std::string>& _topics, uint64_t _version);
+    static std::string encodeDelta(uint64_t _baseVersion, uint64_t _version,
+        const std::set<std::string>& _add, const std::set<std::string>& _remove);
+    static bool decodeResponse(const std::string& _response, uint64_t& _version);
+
+private:
+    struct EndPointState
+    {
+        // the version sent to the endpoint, 0 if not synced
+        uint64_t version = 0;
+        // the version of the last full sync
+        uint64_t fullVersion = 0;
+    };
+
+    // the request built with x_sync held and sent after x_sync released, for the send func may
+    // call back on the sending thread, e.g. the session not found
+    struct Request
+    {
+        std::string endPoint;
+        std::shared_ptr<const std::string> request;
+        uint64_t version = 0;
+        bool full = false;
+    };
+
+    // NOTE: called with x_sync held
+    void flushUnsafe(std::vector<Request>& _requests);
+    void sendFull(
+        const std::string& _endPoint, EndPointState& _state, std::vector<Request>& _requests);
+    // NOTE: called without x_sync held
+    void dispatch(const std::vector<Request>& _requests);
+    void onResponse(const std::string& _endPoint, uint64_t _version, bool _full,
+        bcos::Error::Ptr _error, const std::string& _response);
+
+private:
+    Settings m_settings;
+    TopicManager::Ptr m_topicManager;
+    SendFunc m_send;
+    EndPointsFunc m_endPoints;
+
+    mutable std::mutex x_sync;
+    // the topics changed since the last version
+    std::set<std::string> m_dirtyTopics;
+    // the topics of the last version
+    std::set<std::string> m_syncedTopics;
+    uint64_t m_version = 1;
+    std::unordered_map<std::string, EndPointState> m_endPoint2State;
+
+    std::shared_ptr<bcos::Timer> m_timer;
+
+    std::atomic<uint64_t> m_fullSyncs{0};
+    std::atomic<uint64_t> m_deltas{0};
+    std::atomic<uint64_t> m_sentBytes{0};
+};
+
+}  // namespace amop
+}  // namespace cppsdk
+}  // namespace bcos
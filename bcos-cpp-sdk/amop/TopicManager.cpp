@@ -54,6 +54,11 @@ bool TopicManager::removeTopics(const std::set<std::string>& _topics)
     }
     return removeCount > 0;
 }
+bool TopicManager::hasTopic(const std::string& _topic) const
+{
+    boost::shared_lock<boost::shared_mutex> lock(x_topics);
+    return m_topics.count(_topic) > 0;
+}
 std::set<std::string> TopicManager::topics() const
 {
     boost::shared_lock<boost::shared_mutex> lock(x_topics);
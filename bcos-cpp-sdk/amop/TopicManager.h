@@ -40,6 +40,7 @@ public:
     bool addTopics(const std::set<std::string>& _topics);
     bool removeTopic(const std::string& _topic);
     bool removeTopics(const std::set<std::string>& _topics);
+    bool hasTopic(const std::string& _topic) const;
     std::set<std::string> topics() const;
     std::string toJson();
 
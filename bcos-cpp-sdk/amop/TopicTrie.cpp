@@ -0,0 +1,180 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file TopicTrie.cpp
+ * @author: octopus
+ * @date 2023-03-24
+ */
+
+#include <bcos-cpp-sdk/amop/TopicTrie.h>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::amop;
+
+static const std::string_view TOPIC_LEVEL_SEPARATOR = "/";
+static const std::string_view TOPIC_SINGLE_LEVEL_WILDCARD = "+";
+static const std::string_view TOPIC_MULTI_LEVEL_WILDCARD = "#";
+
+// split the first level of the topic, _hasNext is false if it is the last level
+static std::string_view splitLevel(std::string_view _topic, std::string_view& _next, bool& _hasNext)
+{
+    auto pos = _topic.find(TOPIC_LEVEL_SEPARATOR);
+    _hasNext = (pos != std::string_view::npos);
+    _next = _hasNext ? _topic.substr(pos + 1) : std::string_view();
+    return _topic.substr(0, pos);
+}
+
+TopicTrie::TopicTrie() : m_root(std::make_shared<Node>()) {}
+
+TopicTrie::ConstPtr TopicTrie::build(
+    const std::unordered_map<std::string, SubCallback>& _topic2Callback)
+{
+    // the nodes are owned by the new trie only, build in place
+    auto trie = std::make_shared<TopicTrie>();
+    for (const auto& [filter, callback] : _topic2Callback)
+    {
+        auto node = trie->m_root.get();
+        std::string_view rest = filter;
+        bool hasLevel = true;
+        while (hasLevel)
+        {
+            std::string_view next;
+            auto level = splitLevel(rest, next, hasLevel);
+            auto it = node->children.find(level);
+            if (it == node->children.end())
+            {
+                it = node->children.emplace(std::string(level), std::make_shared<Node>()).first;
+            }
+            node = it->second.get();
+            rest = next;
+        }
+        node->callback = callback;
+    }
+    trie->m_size = _topic2Callback.size();
+    return trie;
+}
+
+TopicTrie::ConstPtr TopicTrie::insert(const std::string& _filter, SubCallback _callback) const
+{
+    bool inserted = false;
+    auto trie = std::make_shared<TopicTrie>();
+    trie->m_root = insertNode(m_root, _filter, true, std::move(_callback), inserted);
+    trie->m_size = m_size + (inserted ? 1 : 0);
+    return trie;
+}
+
+std::shared_ptr<TopicTrie::Node> TopicTrie::insertNode(const std::shared_ptr<Node>& _node,
+    std::string_view _rest, bool _hasLevel, SubCallback _callback, bool& _inserted)
+{
+    // copy the node on the path, the children are shared
+    auto node = _node ? std::make_shared<Node>(*_node) : std::make_shared<Node>();
+    if (!_hasLevel)
+    {
+        _inserted = !node->callback;
+        node->callback = std::move(_callback);
+        return node;
+    }
+
+    std::string_view next;
+    bool hasNext = false;
+    auto level = splitLevel(_rest, next, hasNext);
+    auto it = node->children.find(level);
+    if (it == node->children.end())
+    {
+        auto child = insertNode(nullptr, next, hasNext, std::move(_callback), _inserted);
+        node->children.emplace(std::string(level), std::move(child));
+    }
+    else
+    {
+        it->second = insertNode(it->second, next, hasNext, std::move(_callback), _inserted);
+    }
+    return node;
+}
+
+const SubCallback* TopicTrie::match(std::string_view _topic) const
+{
+    return matchNode(*m_root, _topic, true);
+}
+
+const SubCallback* TopicTrie::matchNode(const Node& _node, std::string_view _rest, bool _hasLevel)
+{
+    if (!_hasLevel)
+    {
+        if (_node.callback)
+        {
+            return &_node.callback;
+        }
+        // "a/#" matches "a"
+        auto it = _node.children.find(TOPIC_MULTI_LEVEL_WILDCARD);
+        if (it != _node.children.end() && it->second->callback)
+        {
+            return &it->second->callback;
+        }
+        return nullptr;
+    }
+
+    std::string_view next;
+    bool hasNext = false;
+    auto level = splitLevel(_rest, next, hasNext);
+
+    auto it = _node.children.find(level);
+    if (it != _node.children.end())
+    {
+        auto callback = matchNode(*it->second, next, hasNext);
+        if (callback)
+        {
+            return callback;
+        }
+    }
+
+    if (level != TOPIC_SINGLE_LEVEL_WILDCARD)
+    {
+        it = _node.children.find(TOPIC_SINGLE_LEVEL_WILDCARD);
+        if (it != _node.children.end())
+        {
+            auto callback = matchNode(*it->second, next, hasNext);
+            if (callback)
+            {
+                return callback;
+            }
+        }
+    }
+
+    it = _node.children.find(TOPIC_MULTI_LEVEL_WILDCARD);
+    if (it != _node.children.end() && it->second->callback)
+    {
+        return &it->second->callback;
+    }
+
+    return nullptr;
+}
+
+bool TopicTrie::isWildcard(std::string_view _filter)
+{
+    std::string_view rest = _filter;
+    bool hasLevel = true;
+    while (hasLevel)
+    {
+        std::string_view next;
+        auto level = splitLevel(rest, next, hasLevel);
+        if (level == TOPIC_SINGLE_LEVEL_WILDCARD || level == TOPIC_MULTI_LEVEL_WILDCARD)
+        {
+            return true;
+        }
+        rest = next;
+    }
+    return false;
+}
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file TopicTrie.h
+ * @author: octopus
+ * @date 2023-03-24
+ */
+#pragma once
+
+#include <bcos-cpp-sdk/amop/AMOPInterface.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace amop
+{
+/**
+ * @brief the immutable trie of the topic filters split by '/', a level of "+" matches any one
+ * level and a level of "#" at the end matches any remaining levels(including none), the other
+ * levels match literally. A match prefers the literal level, then "+", then "#" at each level.
+ * The insert copies the path of the filter only and shares the rest with the original trie.
+ */
+class TopicTrie
+{
+public:
+    using Ptr = std::shared_ptr<TopicTrie>;
+    using ConstPtr = std::shared_ptr<const TopicTrie>;
+
+    TopicTrie();
+
+public:
+    static ConstPtr build(const std::unordered_map<std::string, SubCallback>& _topic2Callback);
+
+    // a new trie with the callback of the filter added or replaced
+    ConstPtr insert(const std::string& _filter, SubCallback _callback) const;
+
+    // the callback of the filter matching the topic, nullptr if no filter matched, valid as long
+    // as the trie
+    const SubCallback* match(std::string_view _topic) const;
+
+    // the number of the filters
+    std::size_t size() const { return m_size; }
+
+    static bool isWildcard(std::string_view _filter);
+
+private:
+    struct Node
+    {
+        std::map<std::string, std::shared_ptr<Node>, std::less<>> children;
+        SubCallback callback;
+    };
+
+    static std::shared_ptr<Node> insertNode(const std::shared_ptr<Node>& _node,
+        std::string_view _rest, bool _hasLevel, SubCallback _callback, bool& _inserted);
+    static const SubCallback* matchNode(const Node& _node, std::string_view _rest, bool _hasLevel);
+
+private:
+    std::shared_ptr<Node> m_root;
+    std::size_t m_size = 0;
+};
+
+}  // namespace amop
+}  // namespace cppsdk
+}  // namespace bcos
@@ -0,0 +1,118 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventLog.h
+ * @author: octopus
+ * @date 2023-03-08
+ */
+
+#pragma once
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/Error.h>
+#include <json/value.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace event
+{
+/**
+ * @brief one event log of the event sub push, with the params decoded by the registered abi
+ */
+class EventLog
+{
+public:
+    using Ptr = std::shared_ptr<EventLog>;
+    using ConstPtr = std::shared_ptr<const EventLog>;
+
+public:
+    int64_t blockNumber() const { return m_blockNumber; }
+    void setBlockNumber(int64_t _blockNumber) { m_blockNumber = _blockNumber; }
+
+    const std::string& transactionHash() const { return m_transactionHash; }
+    void setTransactionHash(std::string _transactionHash)
+    {
+        m_transactionHash = std::move(_transactionHash);
+    }
+
+    int64_t transactionIndex() const { return m_transactionIndex; }
+    void setTransactionIndex(int64_t _transactionIndex) { m_transactionIndex = _transactionIndex; }
+
+    int64_t logIndex() const { return m_logIndex; }
+    void setLogIndex(int64_t _logIndex) { m_logIndex = _logIndex; }
+
+    const std::string& address() const { return m_address; }
+    void setAddress(std::string _address) { m_address = std::move(_address); }
+
+    const std::vector<std::string>& topics() const { return m_topics; }
+    void setTopics(std::vector<std::string> _topics) { m_topics = std::move(_topics); }
+
+    const std::string& data() const { return m_data; }
+    void setData(std::string _data) { m_data = std::move(_data); }
+
+    // the event matched in the abi, empty if topic0 is unknown
+    const std::string& eventName() const { return m_eventName; }
+    void setEventName(std::string _eventName) { m_eventName = std::move(_eventName); }
+
+    const std::string& eventSignature() const { return m_eventSignature; }
+    void setEventSignature(std::string _eventSignature)
+    {
+        m_eventSignature = std::move(_eventSignature);
+    }
+
+    // the decoded params in the order of the event inputs, the dynamic indexed params are kept as
+    // the topic because only the hash of them is logged
+    const Json::Value& params() const { return m_params; }
+    void setParams(Json::Value _params) { m_params = std::move(_params); }
+
+    const std::vector<std::string>& paramNames() const { return m_paramNames; }
+    void setParamNames(std::vector<std::string> _paramNames)
+    {
+        m_paramNames = std::move(_paramNames);
+    }
+
+    bool decoded() const { return !m_eventName.empty(); }
+
+private:
+    int64_t m_blockNumber = -1;
+    std::string m_transactionHash;
+    int64_t m_transactionIndex = -1;
+    int64_t m_logIndex = -1;
+    std::string m_address;
+    std::vector<std::string> m_topics;
+    std::string m_data;
+
+    std::string m_eventName;
+    std::string m_eventSignature;
+    Json::Value m_params;
+    std::vector<std::string> m_paramNames;
+};
+
+using EventLogs = std::vector<EventLog::Ptr>;
+
+/**
+ * @brief callback of the typed event sub, _status is the StatusCode of the push
+ */
+using EventLogCallback =
+    std::function<void(bcos::Error::Ptr _error, int32_t _status, const EventLogs& _logs)>;
+
+}  // namespace event
+}  // namespace cppsdk
+}  // namespace bcos
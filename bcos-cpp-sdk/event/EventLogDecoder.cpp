@@ -0,0 +1,223 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventLogDecoder.cpp
+ * @author: octopus
+ * @date 2023-03-08
+ */
+
+#include <bcos-cpp-sdk/event/Common.h>
+#include <bcos-cpp-sdk/event/EventLogDecoder.h>
+#include <bcos-cpp-sdk/utilities/Hex.h>
+#include <bcos-cpp-sdk/utilities/abi/ContractABIDefinitionFactory.h>
+#include <bcos-utilities/DataConvertUtility.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+#include <exception>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::abi;
+using namespace bcos::cppsdk::event;
+
+static int64_t jsonToInt64(const Json::Value& _jValue)
+{
+    if (_jValue.isString())
+    {
+        // hex or decimal string
+        return std::stoll(_jValue.asString(), nullptr, 0);
+    }
+    return _jValue.isNull() ? -1 : _jValue.asInt64();
+}
+
+EventLogDecoder::EventLogDecoder(const std::string& _abi, bcos::crypto::Hash::Ptr _hashImpl,
+    ContractABITypeCodecInterface::Ptr _codec)
+  : m_hashImpl(_hashImpl), m_codec(_codec)
+{
+    ContractABIDefinitionFactory factory;
+    m_contractABI = factory.buildABI(_abi);
+
+    for (const auto& [name, events] : m_contractABI->events())
+    {
+        for (const auto& event : events)
+        {
+            if (event->anonymous())
+            {
+                // no topic0 for anonymous events
+                continue;
+            }
+
+            EventEntry entry;
+            entry.event = event;
+            entry.signature = event->getMethodSignatureAsString();
+            entry.dataTemplate = factory.buildEvent(*event);
+
+            const auto& inputs = event->inputs();
+            entry.topicTemplates.resize(inputs.size());
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                entry.paramNames.push_back(inputs[i]->name());
+                if (!inputs[i]->indexed())
+                {
+                    continue;
+                }
+
+                auto helper = std::make_shared<NamedTypeHelper>(inputs[i]->type());
+                AbstractType::Ptr abstractType = factory.buildAbstractType(inputs[i], helper);
+                if (!abstractType->dynamicType())
+                {
+                    entry.topicTemplates[i] = abstractType;
+                }
+            }
+
+            auto topic = m_hashImpl
+                             ->hash(bcos::bytesConstRef(
+                                 (bcos::byte*)entry.signature.data(), entry.signature.size()))
+                             .hex();
+
+            EVENT_SUB(DEBUG) << LOG_BADGE("EventLogDecoder") << LOG_DESC("add event")
+                             << LOG_KV("signature", entry.signature) << LOG_KV("topic", topic);
+
+            m_topic2Event.emplace(normalizeTopic(topic), std::move(entry));
+        }
+    }
+}
+
+std::string EventLogDecoder::normalizeTopic(const std::string& _topic)
+{
+    std::string topic =
+        (_topic.compare(0, 2, "0x") == 0 || _topic.compare(0, 2, "0X") == 0) ? _topic.substr(2) :
+                                                                                _topic;
+    boost::algorithm::to_lower(topic);
+    return topic;
+}
+
+EventLogs EventLogDecoder::decodeLogs(const Json::Value& _jLogs) const
+{
+    EventLogs logs;
+    if (!_jLogs.isArray())
+    {
+        return logs;
+    }
+
+    logs.reserve(_jLogs.size());
+    for (Json::ArrayIndex i = 0; i < _jLogs.size(); ++i)
+    {
+        logs.push_back(decode(_jLogs[i]));
+    }
+    return logs;
+}
+
+EventLog::Ptr EventLogDecoder::decode(const Json::Value& _jLog) const
+{
+    /*
+    {
+        "address": "",
+        "blockNumber": 1,
+        "data": "0x",
+        "logIndex": 0,
+        "topics": [],
+        "transactionHash": "0x",
+        "transactionIndex": 0
+    }
+    */
+    auto log = std::make_shared<EventLog>();
+    log->setBlockNumber(jsonToInt64(_jLog["blockNumber"]));
+    log->setTransactionIndex(jsonToInt64(_jLog["transactionIndex"]));
+    log->setLogIndex(jsonToInt64(_jLog["logIndex"]));
+    log->setTransactionHash(_jLog["transactionHash"].asString());
+    log->setAddress(_jLog["address"].asString());
+    log->setData(_jLog["data"].asString());
+
+    std::vector<std::string> topics;
+    const auto& jTopics = _jLog["topics"];
+    if (jTopics.isArray())
+    {
+        topics.reserve(jTopics.size());
+        for (Json::ArrayIndex i = 0; i < jTopics.size(); ++i)
+        {
+            topics.push_back(jTopics[i].asString());
+        }
+    }
+
+    if (!topics.empty())
+    {
+        auto it = m_topic2Event.find(normalizeTopic(topics[0]));
+        if (it != m_topic2Event.end())
+        {
+            try
+            {
+                auto data = utilities::hexDecode(log->data());
+                decodeParams(it->second, topics, data, *log);
+            }
+            catch (const std::exception& e)
+            {
+                EVENT_SUB(WARNING) << LOG_BADGE("EventLogDecoder") << LOG_DESC("decode failed")
+                                   << LOG_KV("signature", it->second.signature)
+                                   << LOG_KV("transactionHash", log->transactionHash())
+                                   << LOG_KV("logIndex", log->logIndex())
+                                   << LOG_KV("error", boost::diagnostic_information(e));
+                log->setEventName("");
+                log->setParams(Json::Value());
+            }
+        }
+    }
+
+    log->setTopics(std::move(topics));
+    return log;
+}
+
+void EventLogDecoder::decodeParams(const EventEntry& _entry,
+    const std::vector<std::string>& _topics, const bcos::bytes& _data, EventLog& _log) const
+{
+    auto dataValue = _entry.dataTemplate->clone();
+    m_codec->deserialize(*dataValue, _data, 0);
+    auto jData = dataValue->toJson();
+
+    const auto& inputs = _entry.event->inputs();
+    Json::Value jParams(Json::arrayValue);
+    Json::ArrayIndex dataIndex = 0;
+    std::size_t topicIndex = 1;
+    for (std::size_t i = 0; i < inputs.size(); ++i)
+    {
+        if (!inputs[i]->indexed())
+        {
+            jParams.append(jData[dataIndex++]);
+            continue;
+        }
+
+        if (topicIndex >= _topics.size())
+        {
+            BOOST_THROW_EXCEPTION(std::runtime_error("missing topic of the indexed param"));
+        }
+
+        const auto& topic = _topics[topicIndex++];
+        const auto& topicTemplate = _entry.topicTemplates[i];
+        if (!topicTemplate)
+        {
+            jParams.append(topic);
+            continue;
+        }
+
+        auto topicValue = topicTemplate->clone();
+        m_codec->deserialize(*topicValue, utilities::hexDecode(topic), 0);
+        jParams.append(topicValue->toJson());
+    }
+
+    _log.setEventName(_entry.event->name());
+    _log.setEventSignature(_entry.signature);
+    _log.setParamNames(_entry.paramNames);
+    _log.setParams(std::move(jParams));
+}
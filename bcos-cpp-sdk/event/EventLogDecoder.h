@@ -0,0 +1,91 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventLogDecoder.h
+ * @author: octopus
+ * @date 2023-03-08
+ */
+
+#pragma once
+#include <bcos-cpp-sdk/event/EventLog.h>
+#include <bcos-cpp-sdk/utilities/abi/ContractABIDefinition.h>
+#include <bcos-cpp-sdk/utilities/abi/ContractABIType.h>
+#include <bcos-cpp-sdk/utilities/abi/ContractABITypeCodec.h>
+#include <bcos-crypto/interfaces/crypto/Hash.h>
+#include <json/value.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace event
+{
+/**
+ * @brief decode the event logs pushed by the node with the contract abi, the abi is parsed once
+ * and the topic0 => event lookup table is built in the constructor, so decode is reentrant
+ */
+class EventLogDecoder
+{
+public:
+    using Ptr = std::shared_ptr<EventLogDecoder>;
+    using ConstPtr = std::shared_ptr<const EventLogDecoder>;
+
+    EventLogDecoder(const std::string& _abi, bcos::crypto::Hash::Ptr _hashImpl,
+        bcos::cppsdk::abi::ContractABITypeCodecInterface::Ptr _codec);
+
+public:
+    // decode one log object of the push result
+    EventLog::Ptr decode(const Json::Value& _jLog) const;
+    // decode the "result" array of the push
+    EventLogs decodeLogs(const Json::Value& _jLogs) const;
+
+    std::size_t eventCount() const { return m_topic2Event.size(); }
+    bool hasEvent(const std::string& _topic0) const
+    {
+        return m_topic2Event.count(normalizeTopic(_topic0)) > 0;
+    }
+
+    // lowercase hex without the 0x prefix
+    static std::string normalizeTopic(const std::string& _topic);
+
+private:
+    struct EventEntry
+    {
+        bcos::cppsdk::abi::ContractABIMethodDefinition::Ptr event;
+        std::string signature;
+        std::vector<std::string> paramNames;
+        // the non-indexed params, decoded from data
+        bcos::cppsdk::abi::AbstractType::Ptr dataTemplate;
+        // input index => template of the static indexed param, nullptr for the dynamic ones
+        std::vector<bcos::cppsdk::abi::AbstractType::Ptr> topicTemplates;
+    };
+
+    void decodeParams(const EventEntry& _entry, const std::vector<std::string>& _topics,
+        const bcos::bytes& _data, EventLog& _log) const;
+
+private:
+    bcos::crypto::Hash::Ptr m_hashImpl;
+    bcos::cppsdk::abi::ContractABITypeCodecInterface::Ptr m_codec;
+    bcos::cppsdk::abi::ContractABIDefinition::Ptr m_contractABI;
+    // topic0 => event
+    std::unordered_map<std::string, EventEntry> m_topic2Event;
+};
+}  // namespace event
+}  // namespace cppsdk
+}  // namespace bcos
@@ -28,9 +28,13 @@
 #include <bcos-cpp-sdk/event/EventSubStatus.h>
 #include <bcos-utilities/Common.h>
 #include <json/reader.h>
+#include <json/writer.h>
+#include <boost/exception/diagnostic_information.hpp>
 #include <boost/thread/thread.hpp>
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <set>
 
 using namespace bcos;
 using namespace bcos::boostssl;
@@ -54,9 +58,20 @@ void EventSub::start()
     m_timer = std::make_shared<bcos::Timer>(m_config->reconnectPeriod(), "doLoop");
     m_timer->registerTimeoutHandler([this]() { doLoop(); });
     m_timer->start();
+
+    m_resubscribeLimiter = std::make_shared<bcos::ratelimiter::TokenBucketRateLimiter>(
+        m_resubscribeRate, m_resubscribeBurst);
+    m_resubscribeTimer =
+        std::make_shared<bcos::Timer>(m_resubscribeIntervalMs, "eventResubscribe");
+    m_resubscribeTimer->registerTimeoutHandler([this]() { resubscribeSuspendTasks(); });
+    m_resubscribeTimer->start();
+
     EVENT_SUB(INFO) << LOG_BADGE("start") << LOG_DESC("start event sub successfully")
                     << LOG_KV("sendMsgTimeout", m_config->sendMsgTimeout())
-                    << LOG_KV("reconnectPeriod", m_config->reconnectPeriod());
+                    << LOG_KV("reconnectPeriod", m_config->reconnectPeriod())
+                    << LOG_KV("resubscribeRate", m_resubscribeRate)
+                    << LOG_KV("resubscribeBurst", m_resubscribeBurst)
+                    << LOG_KV("resubscribeJitterMs", m_resubscribeJitterMs);
 }
 
 void EventSub::stop()
@@ -72,6 +87,10 @@ void EventSub::stop()
     {
         m_timer->stop();
     }
+    if (m_resubscribeTimer)
+    {
+        m_resubscribeTimer->stop();
+    }
 
     EVENT_SUB(INFO) << LOG_BADGE("stop") << LOG_DESC("stop event sub successfully");
 }
@@ -79,115 +98,130 @@ void EventSub::stop()
 void EventSub::doLoop()
 {
     m_timer->restart();
+    EVENT_SUB(INFO) << LOG_BADGE("doLoop") << LOG_DESC("event sub tasks report")
+                    << LOG_KV("working event sub count", m_tasks.workingTasksCount())
+                    << LOG_KV("suspend event sub count", m_tasks.suspendTasksCount())
+                    << LOG_KV("lastRecoveryTimeMs", m_lastRecoveryTimeMs.load());
+}
+
+void EventSub::resubscribeSuspendTasks()
+{
+    m_resubscribeTimer->restart();
+
+    auto now = std::chrono::steady_clock::now();
+    if (!m_tasks.suspendTasksCount())
+    {
+        reportRecovery(now);
+        return;
+    }
+
+    // jittered after the disconnection, the clients do not come back at the same time
+    if (now < m_resubscribeNotBefore.load())
+    {
+        return;
+    }
+
+    auto permits = m_resubscribeLimiter->availablePermits(now);
+    if (permits == 0)
     {
-        boost::shared_lock<boost::shared_mutex> lock(x_tasks);
-        EVENT_SUB(INFO) << LOG_BADGE("doLoop") << LOG_DESC("event sub tasks report")
-                        << LOG_KV("working event sub count", m_workingTasks.size())
-                        << LOG_KV("suspend event sub count", m_suspendTasks.size());
+        return;
     }
 
-    if (m_suspendTasksCount.load())
+    std::vector<EventSubTask::Ptr> tasks;
+    for (const auto& task : m_tasks.suspendTasksSnapshot(permits * 2))
     {
-        auto ss = m_service->sessions();
-        if (ss.empty())
+        if (tasks.size() >= permits)
         {
-            EVENT_SUB(INFO)
-                << LOG_BADGE("doLoop")
-                << LOG_DESC(
-                       "no active sessions available and discard resend suspend event sub tasks");
+            break;
         }
-        else
+        // resubscribed when the delivery queue drained
+        if (task->paused())
         {
-            boost::shared_lock<boost::shared_mutex> lock(x_tasks);
-            for (const auto& taskEntry : m_suspendTasks)
-            {
-                auto task = taskEntry.second;
-                std::string id = task->id();
-                if (!this->addWaitResp(id))
-                {
-                    continue;
-                }
+            continue;
+        }
+        if (!this->addWaitResp(task->id()))
+        {
+            continue;
+        }
+        tasks.push_back(task);
+    }
 
-                subscribeEvent(
-                    task, [id, this](Error::Ptr, const std::string&) { this->removeWaitResp(id); });
-            }
+    // group => the endpoints available, the resubscriptions are spread over them
+    std::unordered_map<std::string, std::vector<std::string>> group2EndPoints;
+    std::size_t sent = 0;
+    for (const auto& task : tasks)
+    {
+        auto id = task->id();
+        auto it = group2EndPoints.find(task->group());
+        if (it == group2EndPoints.end())
+        {
+            std::set<std::string> endPoints;
+            m_service->getEndPointsByGroup(task->group(), endPoints);
+            it = group2EndPoints
+                     .emplace(task->group(),
+                         std::vector<std::string>(endPoints.begin(), endPoints.end()))
+                     .first;
         }
+
+        if (it->second.empty() || !m_resubscribeLimiter->tryAcquire(1, now))
+        {
+            this->removeWaitResp(id);
+            continue;
+        }
+
+        task->setEndPoint(it->second[m_resubscribeRound++ % it->second.size()]);
+        subscribeEvent(
+            task, [id, this](Error::Ptr, const std::string&) { this->removeWaitResp(id); });
+        sent++;
     }
+
+    EVENT_SUB(DEBUG) << LOG_BADGE("resubscribeSuspendTasks")
+                     << LOG_DESC("resubscribe suspend event sub tasks") << LOG_KV("sent", sent)
+                     << LOG_KV("permits", permits)
+                     << LOG_KV("suspend event sub count", m_tasks.suspendTasksCount());
 }
 
-bool EventSub::addTask(EventSubTask::Ptr _task)
+void EventSub::reportRecovery(std::chrono::steady_clock::time_point _now)
 {
-    boost::unique_lock<boost::shared_mutex> lock(x_tasks);
-    removeSuspendTask(_task->id());
-    if (m_workingTasks.find(_task->id()) == m_workingTasks.end())
+    std::lock_guard<std::mutex> lock(x_recovery);
+    if (!m_recovering)
     {
-        m_workingTasks[_task->id()] = _task;
-        return true;
+        return;
     }
 
-    return false;
+    m_recovering = false;
+    m_lastRecoveryTimeMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(_now - m_recoveryStartTime).count();
+
+    EVENT_SUB(INFO) << LOG_BADGE("reportRecovery")
+                    << LOG_DESC("all the suspend event sub tasks resubscribed")
+                    << LOG_KV("timeToFullRecoveryMs", m_lastRecoveryTimeMs.load());
 }
 
-EventSubTask::Ptr EventSub::getTask(const std::string& _id, bool includeSuspendTask)
+bool EventSub::addTask(EventSubTask::Ptr _task)
 {
-    EventSubTask::Ptr task = nullptr;
+    return m_tasks.addTask(_task);
+}
 
-    boost::shared_lock<boost::shared_mutex> lock(x_tasks);
-    auto it = m_workingTasks.find(_id);
-    if (it != m_workingTasks.end())
+EventSubTask::Ptr EventSub::getTask(const std::string& _id, bool includeSuspendTask)
+{
+    auto task = m_tasks.getTask(_id, includeSuspendTask);
+    if (!task)
     {
-        task = it->second;
-
-        EVENT_SUB(TRACE) << LOG_BADGE("getTask") << LOG_DESC("event sub task is working")
+        EVENT_SUB(DEBUG) << LOG_BADGE("getTask") << LOG_DESC("cannot found event sub task")
                          << LOG_KV("id", _id);
     }
-    else if (includeSuspendTask)
-    {
-        auto innerIt = m_suspendTasks.find(_id);
-        if (innerIt != m_suspendTasks.end())
-        {
-            task = innerIt->second;
-
-            EVENT_SUB(TRACE) << LOG_BADGE("getTask") << LOG_DESC("event sub task suspend")
-                             << LOG_KV("id", _id);
-        }
-        else
-        {
-            EVENT_SUB(DEBUG) << LOG_BADGE("getTask") << LOG_DESC("cannot found event sub task")
-                             << LOG_KV("id", _id);
-        }
-    }
 
     return task;
 }
 
 EventSubTask::Ptr EventSub::getTaskAndRemove(const std::string& _id, bool includeSuspendTask)
 {
-    EventSubTask::Ptr task = nullptr;
-
-    boost::unique_lock<boost::shared_mutex> lock(x_tasks);
-    auto it = m_workingTasks.find(_id);
-    if (it != m_workingTasks.end())
-    {  // remove from m_workingTasks
-        task = it->second;
-        m_workingTasks.erase(it);
-
-        EVENT_SUB(TRACE) << LOG_BADGE("getTaskAndRemove") << LOG_DESC("event sub task is working")
-                         << LOG_KV("id", _id);
-    }
-    else if (includeSuspendTask)
+    auto task = m_tasks.getTaskAndRemove(_id, includeSuspendTask);
+    if (task)
     {
-        // remove from m_suspendTasks
-        auto innerIt = m_suspendTasks.find(_id);
-        if (innerIt != m_suspendTasks.end())
-        {
-            task = innerIt->second;
-            m_suspendTasksCount--;
-            m_suspendTasks.erase(innerIt);
-
-            EVENT_SUB(TRACE) << LOG_BADGE("getTaskAndRemove") << LOG_DESC("event sub task suspend")
-                             << LOG_KV("id", _id);
-        }
+        EVENT_SUB(TRACE) << LOG_BADGE("getTaskAndRemove") << LOG_DESC("remove event sub task")
+                         << LOG_KV("id", _id);
     }
 
     return task;
@@ -195,27 +229,12 @@ EventSubTask::Ptr EventSub::getTaskAndRemove(const std::string& _id, bool includ
 
 bool EventSub::addSuspendTask(EventSubTask::Ptr _task)
 {
-    if (m_suspendTasks.find(_task->id()) == m_suspendTasks.end())
-    {
-        m_suspendTasksCount++;
-        m_suspendTasks[_task->id()] = _task;
-        return true;
-    }
-
-    return false;
+    return m_tasks.addSuspendTask(_task);
 }
 
 bool EventSub::removeSuspendTask(const std::string& _id)
 {
-    // remove from suspendTasks
-    auto it = m_suspendTasks.find(_id);
-    if (it != m_suspendTasks.end())
-    {
-        m_suspendTasksCount--;
-        m_suspendTasks.erase(it);
-        return true;
-    }
-    return false;
+    return m_tasks.removeSuspendTask(_id);
 }
 
 std::size_t EventSub::suspendTasks(std::shared_ptr<WsSession> _session)
@@ -225,26 +244,32 @@ std::size_t EventSub::suspendTasks(std::shared_ptr<WsSession> _session)
         return 0;
     }
 
-    std::size_t count = 0;
+    // only the tasks of the session are visited
+    auto tasks = m_tasks.suspendTasks(_session->endPoint());
+    for (const auto& task : tasks)
+    {
+        EVENT_SUB(INFO) << LOG_BADGE("suspendTasks")
+                        << LOG_DESC("suspend event sub task for disconnection")
+                        << LOG_KV("id", task->id()) << LOG_KV("endPoint", _session->endPoint());
+        task->setSession(nullptr);
+    }
+    std::size_t count = tasks.size();
+
+    if (count > 0)
     {
-        boost::unique_lock<boost::shared_mutex> lock(x_tasks);
-        for (auto it = m_workingTasks.begin(); it != m_workingTasks.end();)
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(x_recovery);
+        if (!m_recovering)
         {
-            auto task = it->second;
-            auto s = task->session();
-            if (s && s->endPoint() != _session->endPoint())
-            {
-                ++it;
-                continue;
-            }
+            m_recovering = true;
+            m_recoveryStartTime = now;
+        }
 
-            EVENT_SUB(INFO) << LOG_BADGE("suspendTasks")
-                            << LOG_DESC("suspend event sub task for disconnection")
-                            << LOG_KV("id", task->id()) << LOG_KV("endPoint", _session->endPoint());
-            it = m_workingTasks.erase(it);
-            task->setSession(nullptr);
-            addSuspendTask(task);
-            count++;
+        std::uniform_int_distribution<int64_t> jitter(0, m_resubscribeJitterMs);
+        auto notBefore = now + std::chrono::milliseconds(jitter(m_random));
+        if (notBefore > m_resubscribeNotBefore.load())
+        {
+            m_resubscribeNotBefore.store(notBefore);
         }
     }
 
@@ -299,7 +324,17 @@ void EventSub::onRecvEventSubMessage(
     if (resp->status() == StatusCode::EndOfPush)
     {  // event sub end
         getTaskAndRemove(resp->id());
-        task->callback()(nullptr, strResp);
+        if (task->typed())
+        {
+            dispatchEventLogs(task, nullptr, resp->status(), Json::Value(Json::arrayValue));
+        }
+        else
+        {
+            deliver(task, -1, 0, true, [this, task, strResp]() {
+                task->callback()(nullptr, strResp);
+                removeCheckpoint(task);
+            });
+        }
 
         EVENT_SUB(INFO) << LOG_BADGE("onRecvEventSubMessage") << LOG_DESC("end of push")
                         << LOG_KV("id", task->id()) << LOG_KV("endpoint", _session->endPoint())
@@ -308,7 +343,18 @@ void EventSub::onRecvEventSubMessage(
     else if (resp->status() != StatusCode::Success)
     {  // event sub error
         getTaskAndRemove(resp->id());
-        task->callback()(nullptr, strResp);
+        if (task->typed())
+        {
+            dispatchEventLogs(task, std::make_shared<Error>(resp->status(), strResp),
+                resp->status(), Json::Value(Json::arrayValue));
+        }
+        else
+        {
+            deliver(task, -1, 0, true, [this, task, strResp]() {
+                task->callback()(nullptr, strResp);
+                removeCheckpoint(task);
+            });
+        }
 
         EVENT_SUB(INFO) << LOG_BADGE("onRecvEventSubMessage") << LOG_DESC("event sub error")
                         << LOG_KV("id", task->id()) << LOG_KV("endpoint", _session->endPoint())
@@ -316,21 +362,97 @@ void EventSub::onRecvEventSubMessage(
     }
     else
     {
-        // NOTE: update the latest blocknumber of event sub for network disconnect continue
-        auto jResp = resp->jResp();
+        if (task->paused())
+        {
+            // pushed before the server event sub stopped, pushed again after resumed
+            return;
+        }
+
+        auto queue = task->deliveryQueue();
+        if (queue && queue->policy() == DeliveryPolicy::Suspend && queue->full())
+        {
+            // the push is discarded before its logs are counted in the position
+            pauseTask(task);
+            return;
+        }
+
+        // NOTE: update the position of event sub for network disconnect continue, the logs
+        // received already are skipped when the position of the log is known
+        auto& jResult = resp->jResp()["result"];
         try
         {
             int64_t blockNumber = -1;
-            if (jResp["result"][0]["blockNumber"].isInt64())
+            int64_t transactionIndex = -1;
+            int64_t logIndex = -1;
+            std::size_t skipped = 0;
+            if (jResult.isArray() && !jResult.empty() && jResult[0].isMember("logIndex"))
+            {
+                Json::Value jLogs(Json::arrayValue);
+                for (auto& jLog : jResult)
+                {
+                    auto number = jLog.get("blockNumber", -1).asInt64();
+                    auto txIndex = jLog.get("transactionIndex", -1).asInt64();
+                    auto index = jLog.get("logIndex", -1).asInt64();
+                    if (!task->state()->advanceLogPosition(number, txIndex, index))
+                    {
+                        skipped++;
+                        continue;
+                    }
+
+                    blockNumber = number;
+                    transactionIndex = txIndex;
+                    logIndex = index;
+                    jLogs.append(std::move(jLog));
+                }
+                jResult.swap(jLogs);
+
+                if (skipped > 0 && jResult.empty())
+                {
+                    EVENT_SUB(DEBUG) << LOG_BADGE("onRecvEventSubMessage")
+                                     << LOG_DESC("skip the logs received already")
+                                     << LOG_KV("id", task->id()) << LOG_KV("skipped", skipped);
+                    return;
+                }
+
+                if (skipped > 0 && !task->typed())
+                {
+                    Json::FastWriter writer;
+                    strResp = writer.write(resp->jResp());
+                }
+            }
+            else
+            {
+                const auto& jConstResult = jResult;
+                if (jConstResult[0]["blockNumber"].isInt64())
+                {
+                    blockNumber = jConstResult[0]["blockNumber"].asInt64();
+                    task->state()->setCurrentBlockNumber(blockNumber);
+                }
+            }
+
+            if (task->typed())
             {
-                blockNumber = jResp["result"][0]["blockNumber"].asInt64();
-                task->state()->setCurrentBlockNumber(blockNumber);
+                // the DOM parsed above is handed over, no json text is delivered
+                dispatchEventLogs(task, nullptr, resp->status(), std::move(jResult));
+            }
+            else
+            {
+                auto store = m_checkpointStore;
+                deliver(task, blockNumber, jResult.size(), false,
+                    [task, strResp, store, blockNumber, transactionIndex, logIndex]() {
+                        task->callback()(nullptr, strResp);
+                        if (store && logIndex >= 0)
+                        {
+                            store->update(EventSubCheckpoint{task->id(), task->paramsHash(),
+                                blockNumber, transactionIndex, logIndex});
+                        }
+                    });
             }
-            task->callback()(nullptr, strResp);
 
             EVENT_SUB(TRACE) << LOG_BADGE("onRecvEventSubMessage") << LOG_DESC("event sub")
                              << LOG_KV("id", task->id()) << LOG_KV("endpoint", _session->endPoint())
-                             << LOG_KV("blockNumber", blockNumber) << LOG_KV("response", strResp);
+                             << LOG_KV("blockNumber", blockNumber) << LOG_KV("logIndex", logIndex)
+                             << LOG_KV("skipped", skipped) << LOG_KV("response", strResp);
         }
         catch (const std::exception& e)
         {
@@ -364,49 +486,67 @@ void EventSub::subscribeEvent(EventSubTask::Ptr _task, Callback _callback)
     EVENT_SUB(INFO) << LOG_BADGE("subscribeEvent") << LOG_DESC("subscribe event")
                     << LOG_KV("id", id) << LOG_KV("group", group) << LOG_KV("request", jsonReq);
 
-    m_service->asyncSendMessageByGroupAndNode(_task->group(), "", message, Options(),
-        [id, _task, _callback, this](Error::Ptr _error, std::shared_ptr<boostssl::MessageFace> _msg,
-            std::shared_ptr<WsSession> _session) {
-            if (_error && _error->errorCode() != 0)
-            {
-                EVENT_SUB(WARNING)
-                    << LOG_BADGE("subscribeEvent") << LOG_DESC("callback response error")
-                    << LOG_KV("id", id) << LOG_KV("errorCode", _error->errorCode())
-                    << LOG_KV("errorMessage", _error->errorMessage());
+    auto respFunc = [id, _task, _callback, this](Error::Ptr _error,
+                        std::shared_ptr<boostssl::MessageFace> _msg,
+                        std::shared_ptr<WsSession> _session) {
+        if (_error && _error->errorCode() != 0)
+        {
+            EVENT_SUB(WARNING)
+                << LOG_BADGE("subscribeEvent") << LOG_DESC("callback response error")
+                << LOG_KV("id", id) << LOG_KV("errorCode", _error->errorCode())
+                << LOG_KV("errorMessage", _error->errorMessage());
 
-                _callback(_error, "");
-                return;
-            }
+            _callback(_error, "");
+            return;
+        }
 
-            auto strResp = std::string(_msg->payload()->begin(), _msg->payload()->end());
-            auto resp = std::make_shared<EventSubResponse>();
-            if (!resp->fromJson(strResp))
-            {
-                EVENT_SUB(WARNING)
-                    << LOG_BADGE("subscribeEvent") << LOG_DESC("invalid subscribe event response")
-                    << LOG_KV("id", id) << LOG_KV("response", strResp);
-                _callback(nullptr, strResp);
-            }
-            else if (resp->status() != StatusCode::Success)
-            {
-                _callback(nullptr, strResp);
-                EVENT_SUB(WARNING)
-                    << LOG_BADGE("subscribeEvent") << LOG_DESC("callback response error")
-                    << LOG_KV("id", id) << LOG_KV("response", strResp);
-            }
-            else
-            {
-                // subscribe event successfully, set network session for unsubscribe
-                _task->setSession(_session);
+        auto strResp = std::string(_msg->payload()->begin(), _msg->payload()->end());
+        auto resp = std::make_shared<EventSubResponse>();
+        if (!resp->fromJson(strResp))
+        {
+            EVENT_SUB(WARNING)
+                << LOG_BADGE("subscribeEvent") << LOG_DESC("invalid subscribe event response")
+                << LOG_KV("id", id) << LOG_KV("response", strResp);
+            _callback(nullptr, strResp);
+        }
+        else if (resp->status() != StatusCode::Success)
+        {
+            _callback(nullptr, strResp);
+            EVENT_SUB(WARNING)
+                << LOG_BADGE("subscribeEvent") << LOG_DESC("callback response error")
+                << LOG_KV("id", id) << LOG_KV("response", strResp);
+        }
+        else
+        {
+            // subscribe event successfully, set network session for unsubscribe
+            _task->setSession(_session);
 
-                this->addTask(_task);
+            this->addTask(_task);
 
-                _callback(nullptr, strResp);
-                EVENT_SUB(INFO) << LOG_BADGE("subscribeEvent")
-                                << LOG_DESC("callback response success") << LOG_KV("id", id)
-                                << LOG_KV("response", strResp);
-            }
-        });
+            _callback(nullptr, strResp);
+            EVENT_SUB(INFO) << LOG_BADGE("subscribeEvent")
+                            << LOG_DESC("callback response success") << LOG_KV("id", id)
+                            << LOG_KV("response", strResp);
+        }
+    };
+
+    auto endPoint = _task->endPoint();
+    if (!endPoint.empty())
+    {
+        std::set<std::string> endPoints;
+        m_service->getEndPointsByGroup(group, endPoints);
+        if (endPoints.count(endPoint) > 0)
+        {
+            m_service->asyncSendMessageByEndPoint(endPoint, message, Options(), respFunc);
+            return;
+        }
+
+        EVENT_SUB(INFO) << LOG_BADGE("subscribeEvent")
+                        << LOG_DESC("the endpoint of the event sub is unavailable")
+                        << LOG_KV("id", id) << LOG_KV("endPoint", endPoint);
+    }
+
+    m_service->asyncSendMessageByGroupAndNode(group, "", message, Options(), respFunc);
 }
 
 std::string EventSub::subscribeEvent(
@@ -427,25 +567,400 @@ std::string EventSub::subscribeEvent(
 std::string EventSub::subscribeEvent(
     const std::string& _group, EventSubParams::Ptr _params, Callback _callback)
 {
-    // invalid request params string format
-    if (!_params->verifyParams())
+    return subscribeEvent(_group, _params, "", _callback);
+}
+
+std::string EventSub::subscribeEvent(const std::string& _group, EventSubParams::Ptr _params,
+    const std::string& _resumeToken, Callback _callback)
+{
+    Error::Ptr error = nullptr;
+    auto task = buildTask(_group, _params, _resumeToken, error);
+    if (!task)
     {
-        auto error = std::make_shared<Error>(-1, "params verification failure");
         _callback(error, "");
         return "";
     }
 
-    auto taskId = m_messagefactory->newSeq();
-    auto task = std::make_shared<EventSubTask>();
+    task->setCallback(_callback);
+
+    subscribeEvent(task, _callback);
+    return task->id();
+}
+
+std::string EventSub::subscribeEventWithId(const std::string& _group,
+    EventSubParams::Ptr _params, const std::string& _id, Callback _callback)
+{
+    if (_id.empty() || getTask(_id))
+    {
+        auto error = std::make_shared<Error>(-1, "the id of the event sub is empty or in use");
+        _callback(error, "");
+        return "";
+    }
+
+    Error::Ptr error = nullptr;
+    auto task = buildTask(_group, _params, "", error);
+    if (!task)
+    {
+        _callback(error, "");
+        return "";
+    }
+
+    task->setId(_id);
+    task->setCallback(_callback);
+
+    subscribeEvent(task, _callback);
+    return task->id();
+}
 
-    task->setId(taskId);
+std::string EventSub::subscribeEventByEndPoint(const std::string& _group,
+    EventSubParams::Ptr _params, const std::string& _endPoint, Callback _callback)
+{
+    Error::Ptr error = nullptr;
+    auto task = buildTask(_group, _params, "", error);
+    if (!task)
+    {
+        _callback(error, "");
+        return "";
+    }
+
+    task->setEndPoint(_endPoint);
+    task->setCallback(_callback);
+
+    subscribeEvent(task, _callback);
+    return task->id();
+}
+
+std::string EventSub::subscribeEvent(const std::string& _group, EventSubParams::Ptr _params,
+    EventLogDecoder::ConstPtr _decoder, EventLogCallback _callback,
+    const std::string& _resumeToken)
+{
+    if (!_decoder)
+    {
+        auto error = std::make_shared<Error>(-1, "the event log decoder is null");
+        _callback(error, -1, EventLogs());
+        return "";
+    }
+
+    Error::Ptr error = nullptr;
+    auto task = buildTask(_group, _params, _resumeToken, error);
+    if (!task)
+    {
+        _callback(error, -1, EventLogs());
+        return "";
+    }
+
+    task->setDecoder(_decoder);
+    task->setLogCallback(_callback);
+
+    // the subscribe response only reports the failure to the typed callback
+    Callback callback = [_callback](Error::Ptr _error, const std::string& _resp) {
+        if (_error && _error->errorCode() != 0)
+        {
+            _callback(_error, -1, EventLogs());
+            return;
+        }
+
+        auto resp = std::make_shared<EventSubResponse>();
+        if (!resp->fromJson(_resp))
+        {
+            auto error = std::make_shared<Error>(-1, "invalid subscribe event response");
+            _callback(error, -1, EventLogs());
+        }
+        else if (resp->status() != StatusCode::Success)
+        {
+            _callback(std::make_shared<Error>(resp->status(), _resp), resp->status(), EventLogs());
+        }
+    };
+    task->setCallback(callback);
+
+    subscribeEvent(task, callback);
+    return task->id();
+}
+
+EventSubTask::Ptr EventSub::buildTask(const std::string& _group, EventSubParams::Ptr _params,
+    const std::string& _resumeToken, Error::Ptr& _error)
+{
+    // invalid request params string format
+    if (!_params->verifyParams())
+    {
+        _error = std::make_shared<Error>(-1, "params verification failure");
+        return nullptr;
+    }
+
+    auto task = std::make_shared<EventSubTask>();
     task->setGroup(_group);
     task->setParams(_params);
-    task->setCallback(_callback);
     task->setState(std::make_shared<EventSubTaskState>());
+    if (m_checkpointStore)
+    {
+        task->setParamsHash(EventSubCheckpointStore::paramsHash(*_params));
+    }
 
-    subscribeEvent(task, _callback);
-    return taskId;
+    if (m_deliveryQueueCapacity > 0)
+    {
+        auto queue = std::make_shared<EventSubDeliveryQueue>(
+            m_deliveryQueueCapacity, m_deliveryPolicy, deliveryPool());
+        if (m_deliveryPolicy == DeliveryPolicy::Suspend)
+        {
+            auto weakTask = std::weak_ptr<EventSubTask>(task);
+            queue->setResumeHandler([this, weakTask]() {
+                auto task = weakTask.lock();
+                if (task)
+                {
+                    resumeTask(task);
+                }
+            });
+        }
+        task->setDeliveryQueue(queue);
+    }
+
+    if (_resumeToken.empty())
+    {
+        task->setId(m_messagefactory->newSeq());
+        return task;
+    }
+
+    // the resume token is the id of the event sub to be continued
+    if (getTask(_resumeToken))
+    {
+        _error = std::make_shared<Error>(-1, "the event sub of the resume token is running");
+        return nullptr;
+    }
+    task->setId(_resumeToken);
+
+    EventSubCheckpoint checkpoint;
+    if (!m_checkpointStore || !m_checkpointStore->get(_resumeToken, checkpoint))
+    {
+        EVENT_SUB(INFO) << LOG_BADGE("buildTask")
+                        << LOG_DESC("no checkpoint of the resume token, start from fromBlock")
+                        << LOG_KV("id", _resumeToken);
+        return task;
+    }
+
+    if (checkpoint.paramsHash != task->paramsHash())
+    {
+        EVENT_SUB(WARNING) << LOG_BADGE("buildTask")
+                           << LOG_DESC("the params mismatch the checkpoint of the resume token")
+                           << LOG_KV("id", _resumeToken)
+                           << LOG_KV("paramsHash", task->paramsHash())
+                           << LOG_KV("checkpointParamsHash", checkpoint.paramsHash);
+        _error =
+            std::make_shared<Error>(-1, "the params mismatch the checkpoint of the resume token");
+        return nullptr;
+    }
+
+    task->state()->setLogPosition(
+        checkpoint.blockNumber, checkpoint.transactionIndex, checkpoint.logIndex);
+
+    EVENT_SUB(INFO) << LOG_BADGE("buildTask") << LOG_DESC("resume event sub from checkpoint")
+                    << LOG_KV("id", _resumeToken) << LOG_KV("blockNumber", checkpoint.blockNumber)
+                    << LOG_KV("transactionIndex", checkpoint.transactionIndex)
+                    << LOG_KV("logIndex", checkpoint.logIndex);
+    return task;
+}
+
+void EventSub::removeCheckpoint(EventSubTask::Ptr _task)
+{
+    auto store = m_checkpointStore;
+    if (!store)
+    {
+        return;
+    }
+
+    if (_task->typed() && !_task->deliveryQueue())
+    {
+        // after the logs queued on the decode worker
+        decodeWorker(_task->id())->enqueue([store, _task]() { store->remove(_task->id()); });
+        return;
+    }
+
+    store->remove(_task->id());
+}
+
+std::shared_ptr<bcos::ThreadPool> EventSub::decodeWorker(const std::string& _id)
+{
+    std::call_once(m_decodeWorkersFlag, [this]() {
+        for (std::size_t i = 0; i < m_decodeWorkerCount; ++i)
+        {
+            m_decodeWorkers.push_back(std::make_shared<bcos::ThreadPool>("t_event_decode", 1));
+        }
+
+        EVENT_SUB(INFO) << LOG_BADGE("decodeWorker") << LOG_DESC("create event decode workers")
+                        << LOG_KV("count", m_decodeWorkerCount);
+    });
+
+    return m_decodeWorkers[std::hash<std::string>{}(_id) % m_decodeWorkers.size()];
+}
+
+void EventSub::dispatchEventLogs(
+    EventSubTask::Ptr _task, Error::Ptr _error, int32_t _status, Json::Value _jLogs)
+{
+    int64_t blockNumber =
+        _jLogs.empty() ? -1 : _jLogs[_jLogs.size() - 1].get("blockNumber", -1).asInt64();
+    std::size_t logCount = _jLogs.size();
+    auto jLogs = std::make_shared<Json::Value>(std::move(_jLogs));
+    auto store = m_checkpointStore;
+    auto decodeAndDeliver = [_task, _error, _status, jLogs, store]() {
+        EventLogs logs;
+        try
+        {
+            logs = _task->decoder()->decodeLogs(*jLogs);
+        }
+        catch (const std::exception& e)
+        {
+            EVENT_SUB(WARNING) << LOG_BADGE("dispatchEventLogs")
+                               << LOG_DESC("decode event logs failed") << LOG_KV("id", _task->id())
+                               << LOG_KV("error", boost::diagnostic_information(e));
+            _task->logCallback()(
+                std::make_shared<Error>(-1, "decode event logs failed"), _status, EventLogs());
+            return;
+        }
+
+        _task->logCallback()(_error, _status, logs);
+
+        if (!store)
+        {
+            return;
+        }
+
+        if (_status != StatusCode::Success)
+        {
+            store->remove(_task->id());
+        }
+        else if (!logs.empty() && logs.back()->logIndex() >= 0)
+        {
+            const auto& log = logs.back();
+            store->update(EventSubCheckpoint{_task->id(), _task->paramsHash(),
+                log->blockNumber(), log->transactionIndex(), log->logIndex()});
+        }
+    };
+
+    deliver(_task, blockNumber, logCount, _status != StatusCode::Success, decodeAndDeliver);
+}
+
+void EventSub::deliver(EventSubTask::Ptr _task, int64_t _blockNumber, std::size_t _logCount,
+    bool _control, std::function<void()> _deliver)
+{
+    auto queue = _task->deliveryQueue();
+    if (queue)
+    {
+        queue->push(_blockNumber, _logCount, std::move(_deliver), _control);
+        return;
+    }
+
+    if (_task->typed())
+    {
+        decodeWorker(_task->id())->enqueue(std::move(_deliver));
+        return;
+    }
+
+    _deliver();
+}
+
+std::shared_ptr<bcos::ThreadPool> EventSub::deliveryPool()
+{
+    std::call_once(m_deliveryPoolFlag, [this]() {
+        m_deliveryPool =
+            std::make_shared<bcos::ThreadPool>("t_event_deliver", m_deliveryThreadCount);
+
+        EVENT_SUB(INFO) << LOG_BADGE("deliveryPool") << LOG_DESC("create event delivery pool")
+                        << LOG_KV("threadCount", m_deliveryThreadCount);
+    });
+
+    return m_deliveryPool;
+}
+
+void EventSub::pauseTask(EventSubTask::Ptr _task)
+{
+    if (!_task->pause())
+    {
+        return;
+    }
+
+    auto queue = _task->deliveryQueue();
+    if (!queue->suspend())
+    {
+        // drained while pausing
+        resumeTask(_task);
+        return;
+    }
+
+    EVENT_SUB(INFO) << LOG_BADGE("pauseTask") << LOG_DESC("delivery queue full, pause event sub")
+                    << LOG_KV("id", _task->id())
+                    << LOG_KV("blockNumber", _task->state()->currentBlockNumber());
+
+    auto session = _task->session();
+    if (session)
+    {
+        sendUnsubscribeRequest(_task, session);
+    }
+}
+
+void EventSub::resumeTask(EventSubTask::Ptr _task)
+{
+    _task->resume();
+
+    // suspended for disconnection, resubscribed by doLoop
+    if (!_task->session() || !getTask(_task->id(), false))
+    {
+        return;
+    }
+
+    auto id = _task->id();
+    if (!addWaitResp(id))
+    {
+        return;
+    }
+
+    EVENT_SUB(INFO) << LOG_BADGE("resumeTask")
+                    << LOG_DESC("delivery queue drained, resume event sub") << LOG_KV("id", id)
+                    << LOG_KV("blockNumber", _task->state()->currentBlockNumber());
+
+    subscribeEvent(_task, [this, id, _task](Error::Ptr _error, const std::string& _resp) {
+        removeWaitResp(id);
+
+        auto resp = std::make_shared<EventSubResponse>();
+        if (!(_error && _error->errorCode() != 0) && resp->fromJson(_resp) &&
+            resp->status() == StatusCode::Success)
+        {
+            return;
+        }
+
+        // retried as the suspend task
+        if (m_tasks.suspendTask(id))
+        {
+            _task->setSession(nullptr);
+        }
+    });
+}
+
+bool EventSub::deliveryStats(const std::string& _id, EventSubDeliveryStats& _stats)
+{
+    auto task = getTask(_id);
+    if (!task || !task->deliveryQueue())
+    {
+        return false;
+    }
+
+    _stats = task->deliveryQueue()->stats();
+    return true;
+}
+
+std::unordered_map<std::string, EventSubDeliveryStats> EventSub::deliveryStats()
+{
+    auto tasks = m_tasks.workingTasksSnapshot();
+    auto suspendTasks = m_tasks.suspendTasksSnapshot();
+    tasks.insert(tasks.end(), suspendTasks.begin(), suspendTasks.end());
+
+    std::unordered_map<std::string, EventSubDeliveryStats> stats;
+    for (const auto& task : tasks)
+    {
+        if (task->deliveryQueue())
+        {
+            stats[task->id()] = task->deliveryQueue()->stats();
+        }
+    }
+    return stats;
 }
 
 void EventSub::unsubscribeEvent(const std::string& _id)
@@ -458,6 +973,12 @@ void EventSub::unsubscribeEvent(const std::string& _id)
         return;
     }
 
+    if (task->deliveryQueue())
+    {
+        task->deliveryQueue()->close();
+    }
+    removeCheckpoint(task);
+
     auto session = task->session();
     if (!session)
     {
@@ -466,9 +987,21 @@ void EventSub::unsubscribeEvent(const std::string& _id)
         return;
     }
 
+    // a paused task has been unsubscribed from the server already
+    if (task->paused())
+    {
+        return;
+    }
+
+    sendUnsubscribeRequest(task, session);
+}
+
+void EventSub::sendUnsubscribeRequest(EventSubTask::Ptr _task, std::shared_ptr<WsSession> _session)
+{
+    auto id = _task->id();
     auto request = std::make_shared<EventSubUnsubRequest>();
-    request->setId(_id);
-    request->setGroup(task->group());
+    request->setId(id);
+    request->setGroup(_task->group());
     auto strReq = request->generateJson();
 
     auto message = m_messagefactory->buildMessage();
@@ -476,14 +1009,14 @@ void EventSub::unsubscribeEvent(const std::string& _id)
     message->setPacketType(bcos::cppsdk::event::MessageType::EVENT_UNSUBSCRIBE);
     message->setPayload(std::make_shared<bytes>(strReq.begin(), strReq.end()));
 
-    session->asyncSendMessage(message, Options(),
-        [_id](Error::Ptr _error, std::shared_ptr<boostssl::MessageFace> _msg,
+    _session->asyncSendMessage(message, Options(),
+        [id](Error::Ptr _error, std::shared_ptr<boostssl::MessageFace> _msg,
             std::shared_ptr<WsSession>) {
             if (_error && _error->errorCode() != 0)
             {
                 EVENT_SUB(WARNING)
                     << LOG_BADGE("unsubscribeEvent") << LOG_DESC("callback response error")
-                    << LOG_KV("id", _id) << LOG_KV("errorCode", _error->errorCode())
+                    << LOG_KV("id", id) << LOG_KV("errorCode", _error->errorCode())
                     << LOG_KV("errorMessage", _error->errorMessage());
                 return;
             }
@@ -494,7 +1027,7 @@ void EventSub::unsubscribeEvent(const std::string& _id)
             {
                 EVENT_SUB(WARNING)
                     << LOG_BADGE("unsubscribeEvent") << LOG_DESC("callback invalid response")
-                    << LOG_KV("id", _id) << LOG_KV("response", strResp);
+                    << LOG_KV("id", id) << LOG_KV("response", strResp);
                 return;
             }
 
@@ -502,13 +1035,13 @@ void EventSub::unsubscribeEvent(const std::string& _id)
             {
                 EVENT_SUB(WARNING)
                     << LOG_BADGE("unsubscribeEvent") << LOG_DESC("callback response error")
-                    << LOG_KV("id", _id) << LOG_KV("status", resp->status())
+                    << LOG_KV("id", id) << LOG_KV("status", resp->status())
                     << LOG_KV("response", strResp);
             }
             else
             {
                 EVENT_SUB(INFO) << LOG_BADGE("unsubscribeEvent")
-                                << LOG_DESC("callback response success") << LOG_KV("id", _id)
+                                << LOG_DESC("callback response success") << LOG_KV("id", id)
                                 << LOG_KV("status", resp->status()) << LOG_KV("response", strResp);
             }
         });
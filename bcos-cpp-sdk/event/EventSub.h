@@ -21,13 +21,24 @@
 #pragma once
 #include <bcos-boostssl/websocket/WsConfig.h>
 #include <bcos-boostssl/websocket/WsService.h>
+#include <bcos-cpp-sdk/event/EventLogDecoder.h>
+#include <bcos-cpp-sdk/event/EventSubCheckpointStore.h>
+#include <bcos-cpp-sdk/event/EventSubDeliveryQueue.h>
 #include <bcos-cpp-sdk/event/EventSubInterface.h>
 #include <bcos-cpp-sdk/event/EventSubTask.h>
+#include <bcos-cpp-sdk/event/EventSubTaskRegistry.h>
+#include <bcos-cpp-sdk/utilities/TokenBucketRateLimiter.h>
 #include <bcos-cpp-sdk/ws/Service.h>
+#include <bcos-utilities/ThreadPool.h>
 #include <boost/thread/thread.hpp>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <random>
+#include <unordered_map>
 #include <utility>
 
 namespace bcos
@@ -50,6 +61,8 @@ public:
     virtual void stop() override;
 
     void doLoop();
+    // resubscribe the suspend tasks paced by the rate limiter
+    void resubscribeSuspendTasks();
 
     virtual std::string subscribeEvent(
         const std::string& _group, const std::string& _params, Callback _callback) override;
@@ -57,6 +70,27 @@ public:
         const std::string& _group, EventSubParams::Ptr _params, Callback _callback) override;
     virtual void unsubscribeEvent(const std::string& _id) override;
 
+    // continue the event sub of the resume token(the id returned by the previous subscribeEvent)
+    // from its checkpoint, start from fromBlock if no checkpoint found
+    std::string subscribeEvent(const std::string& _group, EventSubParams::Ptr _params,
+        const std::string& _resumeToken, Callback _callback);
+
+    // the event sub with the id given by the caller instead of a new one, so the caller can match
+    // the messages arriving before it returns, the id should be unique(e.g. from newSeq of the
+    // message factory) and the sub is never resumed from a checkpoint
+    std::string subscribeEventWithId(const std::string& _group, EventSubParams::Ptr _params,
+        const std::string& _id, Callback _callback);
+
+    // typed event sub, the logs are decoded with the abi of the decoder on the decode workers
+    // and delivered in push order
+    std::string subscribeEvent(const std::string& _group, EventSubParams::Ptr _params,
+        EventLogDecoder::ConstPtr _decoder, EventLogCallback _callback,
+        const std::string& _resumeToken = "");
+
+    // the event sub served by the endpoint, any endpoint of the group when it is unavailable
+    virtual std::string subscribeEventByEndPoint(const std::string& _group,
+        EventSubParams::Ptr _params, const std::string& _endPoint, Callback _callback);
+
 public:
     void subscribeEvent(EventSubTask::Ptr _task, Callback _callback);
 
@@ -72,18 +106,8 @@ public:
     bool addSuspendTask(EventSubTask::Ptr _task);
     bool removeSuspendTask(const std::string& _id);
 
-    bool removeWaitResp(const std::string& _id)
-    {
-        boost::lock_guard<boost::mutex> lock(x_waitRespTasks);
-        return 0 != m_waitRespTasks.erase(_id);
-    }
-
-    bool addWaitResp(const std::string& _id)
-    {
-        boost::lock_guard<boost::mutex> lock(x_waitRespTasks);
-        auto r = m_waitRespTasks.insert(_id);
-        return r.second;
-    }
+    bool removeWaitResp(const std::string& _id) { return m_tasks.removeWaitResp(_id); }
+    bool addWaitResp(const std::string& _id) { return m_tasks.addWaitResp(_id); }
 
     std::size_t suspendTasks(std::shared_ptr<bcos::boostssl::ws::WsSession> _session);
 
@@ -101,30 +125,128 @@ public:
     boostssl::ws::WsConfig::ConstPtr config() const { return m_config; }
     void setConfig(boostssl::ws::WsConfig::ConstPtr _config) { m_config = _config; }
 
-    uint32_t suspendTasksCount() const { return m_suspendTasksCount.load(); }
-    const std::unordered_map<std::string, EventSubTask::Ptr>& suspendTasks() const
+    // persist the progress of the event subs, take effect on the subs created after it is set
+    EventSubCheckpointStore::Ptr checkpointStore() const { return m_checkpointStore; }
+    void setCheckpointStore(EventSubCheckpointStore::Ptr _checkpointStore)
+    {
+        m_checkpointStore = _checkpointStore;
+    }
+
+    std::size_t decodeWorkerCount() const { return m_decodeWorkerCount; }
+    // take effect before the first typed event sub
+    void setDecodeWorkerCount(std::size_t _decodeWorkerCount)
+    {
+        m_decodeWorkerCount = std::max<std::size_t>(_decodeWorkerCount, 1);
+    }
+
+    // the bounded delivery queue of each event sub, take effect on the subs created after it is
+    // set, 0 for delivering on the receiving thread
+    std::size_t deliveryQueueCapacity() const { return m_deliveryQueueCapacity; }
+    DeliveryPolicy deliveryPolicy() const { return m_deliveryPolicy; }
+    void setDeliveryQueue(std::size_t _capacity, DeliveryPolicy _policy)
+    {
+        m_deliveryQueueCapacity = _capacity;
+        m_deliveryPolicy = _policy;
+    }
+
+    std::size_t deliveryThreadCount() const { return m_deliveryThreadCount; }
+    // take effect before the first delivery queue created
+    void setDeliveryThreadCount(std::size_t _deliveryThreadCount)
+    {
+        m_deliveryThreadCount = std::max<std::size_t>(_deliveryThreadCount, 1);
+    }
+
+    // the stats of the delivery queue, false if the event sub not found or no queue
+    bool deliveryStats(const std::string& _id, EventSubDeliveryStats& _stats);
+    // id => stats of all the event subs with the delivery queue
+    std::unordered_map<std::string, EventSubDeliveryStats> deliveryStats();
+
+    // the suspend tasks are resubscribed at most _rate per second with _burst at once, spread
+    // over the endpoints of the group, take effect before start
+    void setResubscribeRate(uint64_t _rate, uint64_t _burst)
+    {
+        m_resubscribeRate = _rate;
+        m_resubscribeBurst = _burst;
+    }
+    uint64_t resubscribeRate() const { return m_resubscribeRate; }
+    uint64_t resubscribeBurst() const { return m_resubscribeBurst; }
+    // the resubscription starts after a random delay in [0, _jitterMs] from the disconnection
+    void setResubscribeJitterMs(int64_t _jitterMs)
     {
-        return m_suspendTasks;
+        m_resubscribeJitterMs = std::max<int64_t>(_jitterMs, 0);
     }
-    const std::unordered_map<std::string, EventSubTask::Ptr>& workingtasks() const
+    int64_t resubscribeJitterMs() const { return m_resubscribeJitterMs; }
+
+    // the time from the first task suspended to all the tasks resubscribed of the last recovery
+    int64_t lastRecoveryTimeMs() const { return m_lastRecoveryTimeMs.load(); }
+    bool recovering() const
     {
-        return m_workingTasks;
+        std::lock_guard<std::mutex> lock(x_recovery);
+        return m_recovering;
     }
 
+    uint32_t suspendTasksCount() const { return m_tasks.suspendTasksCount(); }
+    uint32_t workingTasksCount() const { return m_tasks.workingTasksCount(); }
+    std::vector<EventSubTask::Ptr> suspendTasks() const { return m_tasks.suspendTasksSnapshot(); }
+    std::vector<EventSubTask::Ptr> workingtasks() const { return m_tasks.workingTasksSnapshot(); }
+
+private:
+    EventSubTask::Ptr buildTask(const std::string& _group, EventSubParams::Ptr _params,
+        const std::string& _resumeToken, Error::Ptr& _error);
+    void removeCheckpoint(EventSubTask::Ptr _task);
+    void dispatchEventLogs(
+        EventSubTask::Ptr _task, Error::Ptr _error, int32_t _status, Json::Value _jLogs);
+    std::shared_ptr<bcos::ThreadPool> decodeWorker(const std::string& _id);
+    std::shared_ptr<bcos::ThreadPool> deliveryPool();
+    void reportRecovery(std::chrono::steady_clock::time_point _now);
+
+    // deliver the push through the delivery queue of the task
+    void deliver(EventSubTask::Ptr _task, int64_t _blockNumber, std::size_t _logCount,
+        bool _control, std::function<void()> _deliver);
+    // stop the server event sub for the delivery queue full, resumed when the queue drained
+    void pauseTask(EventSubTask::Ptr _task);
+    void resumeTask(EventSubTask::Ptr _task);
+    void sendUnsubscribeRequest(
+        EventSubTask::Ptr _task, std::shared_ptr<bcos::boostssl::ws::WsSession> _session);
+
 private:
     bool m_running = false;
 
-    std::atomic<uint32_t> m_suspendTasksCount{0};
+    // the working and suspend tasks
+    EventSubTaskRegistry m_tasks;
+
+    // single thread workers for decoding the typed event sub, the task is bound to one worker by
+    // id so that the logs are delivered in order
+    std::size_t m_decodeWorkerCount = 4;
+    std::once_flag m_decodeWorkersFlag;
+    std::vector<std::shared_ptr<bcos::ThreadPool>> m_decodeWorkers;
 
-    mutable boost::shared_mutex x_tasks;
-    std::unordered_map<std::string, EventSubTask::Ptr> m_workingTasks;
-    std::unordered_map<std::string, EventSubTask::Ptr> m_suspendTasks;
+    EventSubCheckpointStore::Ptr m_checkpointStore;
 
-    mutable boost::mutex x_waitRespTasks;
-    std::set<std::string> m_waitRespTasks;
+    std::size_t m_deliveryQueueCapacity = 0;
+    DeliveryPolicy m_deliveryPolicy = DeliveryPolicy::Block;
+    // the queues are drained on the pool, one queue is drained by one thread at a time
+    std::size_t m_deliveryThreadCount = 4;
+    std::once_flag m_deliveryPoolFlag;
+    std::shared_ptr<bcos::ThreadPool> m_deliveryPool;
 
     // timer
     std::shared_ptr<bcos::Timer> m_timer;
+
+    uint64_t m_resubscribeRate = 200;
+    uint64_t m_resubscribeBurst = 50;
+    int64_t m_resubscribeJitterMs = 1000;
+    uint64_t m_resubscribeIntervalMs = 100;
+    std::shared_ptr<bcos::Timer> m_resubscribeTimer;
+    bcos::ratelimiter::TokenBucketRateLimiter::Ptr m_resubscribeLimiter;
+    std::atomic<std::chrono::steady_clock::time_point> m_resubscribeNotBefore{};
+    std::size_t m_resubscribeRound = 0;
+
+    mutable std::mutex x_recovery;
+    bool m_recovering = false;
+    std::chrono::steady_clock::time_point m_recoveryStartTime;
+    std::atomic<int64_t> m_lastRecoveryTimeMs{-1};
+    std::mt19937 m_random{std::random_device{}()};
     // message factory
     std::shared_ptr<bcos::boostssl::ws::WsMessageFactory> m_messagefactory;
     // websocket service
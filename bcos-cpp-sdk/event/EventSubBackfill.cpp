@@ -0,0 +1,515 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventSubBackfill.cpp
+ * @author: octopus
+ * @date 2023-03-15
+ */
+
+#include <bcos-cpp-sdk/event/Common.h>
+#include <bcos-cpp-sdk/event/EventSubBackfill.h>
+#include <bcos-cpp-sdk/event/EventSubResponse.h>
+#include <bcos-cpp-sdk/event/EventSubStatus.h>
+#include <json/writer.h>
+#include <set>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::event;
+
+void EventSubChunkReorder::append(std::size_t _chunk, Json::Value& _jLogs, Json::Value& _out)
+{
+    if (_chunk >= m_chunkCount || !_jLogs.isArray())
+    {
+        return;
+    }
+
+    if (_chunk == m_next)
+    {
+        for (auto& jLog : _jLogs)
+        {
+            _out.append(std::move(jLog));
+        }
+        return;
+    }
+
+    auto& buffered = m_buffered[_chunk];
+    for (auto& jLog : _jLogs)
+    {
+        buffered.append(std::move(jLog));
+    }
+    m_bufferedLogs += _jLogs.size();
+}
+
+void EventSubChunkReorder::complete(std::size_t _chunk, Json::Value& _out)
+{
+    if (_chunk >= m_chunkCount)
+    {
+        return;
+    }
+
+    m_completed[_chunk] = true;
+    while (m_next < m_chunkCount && m_completed[m_next])
+    {
+        ++m_next;
+        if (m_next >= m_chunkCount)
+        {
+            break;
+        }
+
+        auto& buffered = m_buffered[m_next];
+        m_bufferedLogs -= buffered.size();
+        for (auto& jLog : buffered)
+        {
+            _out.append(std::move(jLog));
+        }
+        buffered = Json::Value(Json::arrayValue);
+    }
+}
+
+std::vector<std::pair<int64_t, int64_t>> EventSubBackfill::splitRange(
+    int64_t _fromBlock, int64_t _toBlock, int64_t _chunkSize)
+{
+    std::vector<std::pair<int64_t, int64_t>> ranges;
+    if (_fromBlock < 0 || _toBlock < _fromBlock || _chunkSize <= 0)
+    {
+        return ranges;
+    }
+
+    for (int64_t from = _fromBlock; from <= _toBlock; from += _chunkSize)
+    {
+        ranges.emplace_back(from, std::min(from + _chunkSize - 1, _toBlock));
+    }
+    return ranges;
+}
+
+std::string EventSubBackfill::rewriteId(const Json::Value& _jResp, const std::string& _id)
+{
+    auto jResp = _jResp;
+    jResp["id"] = _id;
+    Json::FastWriter writer;
+    return writer.write(jResp);
+}
+
+std::string EventSubBackfill::subscribeEvent(
+    const std::string& _group, EventSubParams::Ptr _params, Callback _callback)
+{
+    if (!_params->verifyParams())
+    {
+        auto error = std::make_shared<Error>(-1, "params verification failure");
+        _callback(error, "");
+        return "";
+    }
+
+    auto job = std::make_shared<Job>();
+    job->id = m_eventSub->messageFactory()->newSeq();
+    job->group = _group;
+    job->params = _params;
+    job->callback = _callback;
+
+    auto service = m_eventSub->service();
+    std::set<std::string> endPoints;
+    service->getEndPointsByGroup(_group, endPoints);
+    job->endPoints.assign(endPoints.begin(), endPoints.end());
+
+    // the head of the history, the toBlock or the latest block known
+    int64_t head = _params->toBlock();
+    if (head < 0 && !service->getBlockNumber(_group, head))
+    {
+        head = -1;
+    }
+
+    auto ranges = splitRange(_params->fromBlock(), head, m_chunkSize);
+    if (ranges.size() <= 1)
+    {
+        // not worth splitting, served as one event sub
+        ranges.clear();
+        job->tailParams = _params;
+    }
+    else if (_params->toBlock() < 0)
+    {
+        job->tailParams = std::make_shared<EventSubParams>(*_params);
+        job->tailParams->setFromBlock(head + 1);
+    }
+
+    for (std::size_t i = 0; i < ranges.size(); ++i)
+    {
+        Chunk chunk;
+        chunk.fromBlock = ranges[i].first;
+        chunk.toBlock = ranges[i].second;
+        if (!job->endPoints.empty())
+        {
+            chunk.endPoint = job->endPoints[i % job->endPoints.size()];
+        }
+        job->chunks.push_back(std::move(chunk));
+    }
+    job->reorder = std::make_unique<EventSubChunkReorder>(job->chunks.size());
+
+    {
+        std::lock_guard<std::mutex> lock(x_jobs);
+        m_jobs[job->id] = job;
+    }
+
+    EVENT_SUB(INFO) << LOG_BADGE("EventSubBackfill") << LOG_DESC("subscribe event")
+                    << LOG_KV("id", job->id) << LOG_KV("group", _group)
+                    << LOG_KV("fromBlock", _params->fromBlock())
+                    << LOG_KV("toBlock", _params->toBlock()) << LOG_KV("head", head)
+                    << LOG_KV("chunks", job->chunks.size())
+                    << LOG_KV("endPoints", job->endPoints.size())
+                    << LOG_KV("tail", (job->tailParams != nullptr));
+
+    if (job->chunks.empty())
+    {
+        startTail(job);
+    }
+    else
+    {
+        launchChunks(job);
+    }
+
+    return job->id;
+}
+
+void EventSubBackfill::launchChunks(Job::Ptr _job)
+{
+    std::vector<std::size_t> chunks;
+    {
+        std::lock_guard<std::mutex> lock(_job->x_state);
+        if (_job->stopped)
+        {
+            return;
+        }
+
+        // the window starts from the chunk being delivered, the chunks finished ahead of it hold
+        // their slots with the logs buffered, so the buffered logs are bounded by the window
+        while (_job->nextChunk < _job->reorder->next() + m_maxParallelChunks &&
+               _job->nextChunk < _job->chunks.size())
+        {
+            chunks.push_back(_job->nextChunk++);
+        }
+    }
+
+    auto self = std::weak_ptr<EventSubBackfill>(shared_from_this());
+    for (auto index : chunks)
+    {
+        // fromBlock, toBlock and endPoint are not changed after the job is built
+        const auto& chunk = _job->chunks[index];
+        auto params = std::make_shared<EventSubParams>(*_job->params);
+        params->setFromBlock(chunk.fromBlock);
+        params->setToBlock(chunk.toBlock);
+
+        EVENT_SUB(DEBUG) << LOG_BADGE("EventSubBackfill") << LOG_DESC("subscribe chunk")
+                         << LOG_KV("id", _job->id) << LOG_KV("chunk", index)
+                         << LOG_KV("fromBlock", chunk.fromBlock) << LOG_KV("toBlock", chunk.toBlock)
+                         << LOG_KV("endPoint", chunk.endPoint);
+
+        auto subId = m_eventSub->subscribeEventByEndPoint(_job->group, params, chunk.endPoint,
+            [self, _job, index](Error::Ptr _error, const std::string& _resp) {
+                auto backfill = self.lock();
+                if (backfill)
+                {
+                    backfill->onChunkMessage(_job, index, _error, _resp);
+                }
+            });
+
+        bool stopped = false;
+        {
+            std::lock_guard<std::mutex> lock(_job->x_state);
+            _job->chunks[index].subId = subId;
+            stopped = _job->stopped;
+        }
+        if (stopped && !subId.empty())
+        {
+            m_eventSub->unsubscribeEvent(subId);
+        }
+    }
+}
+
+void EventSubBackfill::startTail(Job::Ptr _job)
+{
+    if (!_job->tailParams)
+    {
+        return;
+    }
+
+    auto self = std::weak_ptr<EventSubBackfill>(shared_from_this());
+    auto subId = m_eventSub->subscribeEvent(_job->group, _job->tailParams,
+        [self, _job](Error::Ptr _error, const std::string& _resp) {
+            auto backfill = self.lock();
+            if (backfill)
+            {
+                backfill->onTailMessage(_job, _error, _resp);
+            }
+        });
+
+    EVENT_SUB(INFO) << LOG_BADGE("EventSubBackfill") << LOG_DESC("start live tailing")
+                    << LOG_KV("id", _job->id) << LOG_KV("tailId", subId)
+                    << LOG_KV("fromBlock", _job->tailParams->fromBlock());
+
+    bool stopped = false;
+    {
+        std::lock_guard<std::mutex> lock(_job->x_state);
+        _job->tailId = subId;
+        stopped = _job->stopped;
+    }
+    if (stopped && !subId.empty())
+    {
+        m_eventSub->unsubscribeEvent(subId);
+    }
+}
+
+void EventSubBackfill::onChunkMessage(
+    Job::Ptr _job, std::size_t _chunk, Error::Ptr _error, const std::string& _resp)
+{
+    bool launchMore = false;
+    bool tailNow = false;
+    {
+        // the logs are delivered in the order they are taken out of the reorder buffer
+        std::lock_guard<std::mutex> deliverLock(_job->x_deliver);
+
+        auto resp = std::make_shared<EventSubResponse>();
+        if (!(_error && _error->errorCode() != 0) && !resp->fromJson(_resp))
+        {
+            _error = std::make_shared<Error>(-1, "invalid event sub response");
+        }
+
+        bool failed = (_error && _error->errorCode() != 0) ||
+                      (resp->status() != StatusCode::Success &&
+                          resp->status() != StatusCode::EndOfPush);
+        if (failed)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_job->x_state);
+                if (_job->stopped)
+                {
+                    return;
+                }
+                _job->chunks[_chunk].done = true;
+            }
+            stopJob(_job);
+
+            EVENT_SUB(WARNING) << LOG_BADGE("EventSubBackfill") << LOG_DESC("chunk failed")
+                               << LOG_KV("id", _job->id) << LOG_KV("chunk", _chunk)
+                               << LOG_KV("response", _resp);
+
+            if (_error && _error->errorCode() != 0)
+            {
+                _job->callback(_error, "");
+            }
+            else
+            {
+                _job->callback(nullptr, rewriteId(resp->jResp(), _job->id));
+            }
+            return;
+        }
+
+        bool endOfChunk = (resp->status() == StatusCode::EndOfPush);
+        bool isPush = !endOfChunk && resp->jResp().isMember("result");
+        bool ackNow = false;
+        bool endOfJob = false;
+        Json::Value jLogs(Json::arrayValue);
+        {
+            std::lock_guard<std::mutex> lock(_job->x_state);
+            if (_job->stopped)
+            {
+                return;
+            }
+
+            if (isPush)
+            {
+                _job->reorder->append(_chunk, resp->jResp()["result"], jLogs);
+            }
+            else if (!endOfChunk && !_job->acked)
+            {
+                _job->acked = true;
+                ackNow = true;
+            }
+
+            if (endOfChunk)
+            {
+                _job->chunks[_chunk].done = true;
+                auto head = _job->reorder->next();
+                _job->reorder->complete(_chunk, jLogs);
+                if (_job->reorder->finished())
+                {
+                    tailNow = (_job->tailParams != nullptr);
+                    endOfJob = !tailNow;
+                }
+                else
+                {
+                    // the window moves only when the chunk being delivered finished
+                    launchMore = (_job->reorder->next() != head);
+                }
+            }
+        }
+
+        if (ackNow)
+        {
+            EventSubResponse ack;
+            ack.setId(_job->id);
+            ack.setStatus(StatusCode::Success);
+            _job->callback(nullptr, ack.generateJson());
+        }
+
+        if (!jLogs.empty())
+        {
+            Json::Value jResp;
+            jResp["id"] = _job->id;
+            jResp["status"] = StatusCode::Success;
+            jResp["result"] = std::move(jLogs);
+            Json::FastWriter writer;
+            _job->callback(nullptr, writer.write(jResp));
+        }
+
+        if (endOfChunk)
+        {
+            EVENT_SUB(DEBUG) << LOG_BADGE("EventSubBackfill") << LOG_DESC("chunk finished")
+                             << LOG_KV("id", _job->id) << LOG_KV("chunk", _chunk)
+                             << LOG_KV("bufferedLogs", _job->reorder->bufferedLogs());
+        }
+
+        if (endOfJob)
+        {
+            stopJob(_job);
+
+            EVENT_SUB(INFO) << LOG_BADGE("EventSubBackfill") << LOG_DESC("end of push")
+                            << LOG_KV("id", _job->id);
+
+            EventSubResponse end;
+            end.setId(_job->id);
+            end.setStatus(StatusCode::EndOfPush);
+            _job->callback(nullptr, end.generateJson());
+        }
+    }
+
+    // NOTE: subscribe may call back synchronously on failure, outside x_deliver
+    if (launchMore)
+    {
+        launchChunks(_job);
+    }
+    if (tailNow)
+    {
+        startTail(_job);
+    }
+}
+
+void EventSubBackfill::onTailMessage(Job::Ptr _job, Error::Ptr _error, const std::string& _resp)
+{
+    std::lock_guard<std::mutex> deliverLock(_job->x_deliver);
+
+    auto resp = std::make_shared<EventSubResponse>();
+    if (!(_error && _error->errorCode() != 0) && !resp->fromJson(_resp))
+    {
+        _error = std::make_shared<Error>(-1, "invalid event sub response");
+    }
+
+    bool failed = (_error && _error->errorCode() != 0);
+    bool ended = failed || resp->status() != StatusCode::Success;
+    bool isAck = !ended && !resp->jResp().isMember("result");
+    {
+        std::lock_guard<std::mutex> lock(_job->x_state);
+        if (_job->stopped)
+        {
+            return;
+        }
+
+        if (isAck)
+        {
+            if (_job->acked)
+            {
+                return;
+            }
+            _job->acked = true;
+        }
+
+        if (ended)
+        {
+            // removed by EventSub already
+            _job->tailId.clear();
+        }
+    }
+
+    if (ended)
+    {
+        stopJob(_job);
+    }
+
+    if (failed)
+    {
+        _job->callback(_error, "");
+        return;
+    }
+
+    _job->callback(nullptr, rewriteId(resp->jResp(), _job->id));
+}
+
+void EventSubBackfill::stopJob(Job::Ptr _job)
+{
+    std::vector<std::string> subIds;
+    {
+        std::lock_guard<std::mutex> lock(_job->x_state);
+        if (_job->stopped)
+        {
+            return;
+        }
+        _job->stopped = true;
+
+        for (const auto& chunk : _job->chunks)
+        {
+            if (!chunk.done && !chunk.subId.empty())
+            {
+                subIds.push_back(chunk.subId);
+            }
+        }
+        if (!_job->tailId.empty())
+        {
+            subIds.push_back(_job->tailId);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(x_jobs);
+        m_jobs.erase(_job->id);
+    }
+
+    for (const auto& subId : subIds)
+    {
+        m_eventSub->unsubscribeEvent(subId);
+    }
+}
+
+void EventSubBackfill::unsubscribeEvent(const std::string& _id)
+{
+    Job::Ptr job;
+    {
+        std::lock_guard<std::mutex> lock(x_jobs);
+        auto it = m_jobs.find(_id);
+        if (it != m_jobs.end())
+        {
+            job = it->second;
+        }
+    }
+
+    if (!job)
+    {
+        EVENT_SUB(WARNING) << LOG_BADGE("EventSubBackfill") << LOG_DESC("event sub not found")
+                           << LOG_KV("id", _id);
+        return;
+    }
+
+    EVENT_SUB(INFO) << LOG_BADGE("EventSubBackfill") << LOG_DESC("unsubscribe event")
+                    << LOG_KV("id", _id);
+    stopJob(job);
+}
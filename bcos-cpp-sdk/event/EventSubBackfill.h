@@ -0,0 +1,173 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventSubBackfill.h
+ * @author: octopus
+ * @date 2023-03-15
+ */
+
+#pragma once
+#include <bcos-cpp-sdk/event/EventSub.h>
+#include <json/value.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace event
+{
+/**
+ * @brief the logs of the chunks arrive concurrently, the logs of the first unfinished chunk are
+ * delivered at once and the logs of the later chunks are buffered until the chunks before them
+ * finish
+ * NOTE: not thread safe
+ */
+class EventSubChunkReorder
+{
+public:
+    explicit EventSubChunkReorder(std::size_t _chunkCount)
+      : m_chunkCount(_chunkCount),
+        m_buffered(_chunkCount, Json::Value(Json::arrayValue)),
+        m_completed(_chunkCount, false)
+    {}
+
+public:
+    // the logs pushed for the chunk, the logs can be delivered in order are moved to _out
+    void append(std::size_t _chunk, Json::Value& _jLogs, Json::Value& _out);
+    // the chunk finished, the logs of the chunks can be delivered in order are moved to _out
+    void complete(std::size_t _chunk, Json::Value& _out);
+
+    // all the chunks are delivered
+    bool finished() const { return m_next >= m_chunkCount; }
+    // the chunk being delivered
+    std::size_t next() const { return m_next; }
+    std::size_t bufferedLogs() const { return m_bufferedLogs; }
+
+private:
+    std::size_t m_chunkCount;
+    std::size_t m_next = 0;
+    std::size_t m_bufferedLogs = 0;
+    std::vector<Json::Value> m_buffered;
+    std::vector<bool> m_completed;
+};
+
+/**
+ * @brief the event sub of a large historical range, the range is split into the chunks which
+ * are subscribed concurrently over the endpoints of the group, the logs are delivered in
+ * block/log order and the live tailing from the next block of the head starts after all the
+ * chunks delivered
+ */
+class EventSubBackfill : public std::enable_shared_from_this<EventSubBackfill>
+{
+public:
+    using Ptr = std::shared_ptr<EventSubBackfill>;
+    using ConstPtr = std::shared_ptr<const EventSubBackfill>;
+
+    explicit EventSubBackfill(EventSub::Ptr _eventSub) : m_eventSub(_eventSub) {}
+
+public:
+    // the same callback semantics as EventSub::subscribeEvent, the id in the responses is the id
+    // returned
+    std::string subscribeEvent(
+        const std::string& _group, EventSubParams::Ptr _params, Callback _callback);
+    void unsubscribeEvent(const std::string& _id);
+
+public:
+    int64_t chunkSize() const { return m_chunkSize; }
+    void setChunkSize(int64_t _chunkSize) { m_chunkSize = std::max<int64_t>(_chunkSize, 1); }
+
+    // the chunks subscribed from the chunk being delivered, the running and the finished ones
+    // buffered
+    std::size_t maxParallelChunks() const { return m_maxParallelChunks; }
+    void setMaxParallelChunks(std::size_t _maxParallelChunks)
+    {
+        m_maxParallelChunks = std::max<std::size_t>(_maxParallelChunks, 1);
+    }
+
+    std::size_t jobCount() const
+    {
+        std::lock_guard<std::mutex> lock(x_jobs);
+        return m_jobs.size();
+    }
+
+    // split [_fromBlock, _toBlock] into the ranges of _chunkSize blocks
+    static std::vector<std::pair<int64_t, int64_t>> splitRange(
+        int64_t _fromBlock, int64_t _toBlock, int64_t _chunkSize);
+
+private:
+    struct Chunk
+    {
+        int64_t fromBlock;
+        int64_t toBlock;
+        std::string endPoint;
+        std::string subId;
+        bool done = false;
+    };
+
+    struct Job
+    {
+        using Ptr = std::shared_ptr<Job>;
+
+        std::string id;
+        std::string group;
+        EventSubParams::Ptr params;
+        Callback callback;
+        std::vector<std::string> endPoints;
+
+        // serialize the deliveries of the job, taken before x_state
+        std::mutex x_deliver;
+
+        std::mutex x_state;
+        std::vector<Chunk> chunks;
+        std::unique_ptr<EventSubChunkReorder> reorder;
+        // the next chunk to be subscribed, at most maxParallelChunks ahead of the chunk being
+        // delivered
+        std::size_t nextChunk = 0;
+        // the live tailing sub, empty if the range ends in the history
+        EventSubParams::Ptr tailParams;
+        std::string tailId;
+        bool acked = false;
+        bool stopped = false;
+    };
+
+    void launchChunks(Job::Ptr _job);
+    void startTail(Job::Ptr _job);
+    void onChunkMessage(
+        Job::Ptr _job, std::size_t _chunk, Error::Ptr _error, const std::string& _resp);
+    void onTailMessage(Job::Ptr _job, Error::Ptr _error, const std::string& _resp);
+    // remove the job and unsubscribe its running subs
+    void stopJob(Job::Ptr _job);
+
+    static std::string rewriteId(const Json::Value& _jResp, const std::string& _id);
+
+private:
+    EventSub::Ptr m_eventSub;
+    int64_t m_chunkSize = 10000;
+    std::size_t m_maxParallelChunks = 8;
+
+    mutable std::mutex x_jobs;
+    std::unordered_map<std::string, Job::Ptr> m_jobs;
+};
+}  // namespace event
+}  // namespace cppsdk
+}  // namespace bcos
@@ -0,0 +1,313 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventSubCheckpointStore.cpp
+ * @author: octopus
+ * @date 2023-03-10
+ */
+
+#include <bcos-cpp-sdk/event/Common.h>
+#include <bcos-cpp-sdk/event/EventSubCheckpointStore.h>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::event;
+
+static void syncFile(FILE* _file)
+{
+    fflush(_file);
+#ifdef _WIN32
+    _commit(_fileno(_file));
+#else
+    fsync(fileno(_file));
+#endif
+}
+
+static void appendRecord(std::string& _buffer, const EventSubCheckpoint& _checkpoint)
+{
+    _buffer += "U " + _checkpoint.id + " " + _checkpoint.paramsHash + " " +
+               std::to_string(_checkpoint.blockNumber) + " " +
+               std::to_string(_checkpoint.transactionIndex) + " " +
+               std::to_string(_checkpoint.logIndex) + "\n";
+}
+
+EventSubCheckpointStore::EventSubCheckpointStore(
+    std::string _path, uint32_t _flushIntervalMs, uint32_t _flushBatchSize)
+  : m_path(std::move(_path)),
+    m_flushIntervalMs(_flushIntervalMs),
+    m_flushBatchSize(std::max<uint32_t>(_flushBatchSize, 1))
+{}
+
+std::string EventSubCheckpointStore::paramsHash(const EventSubParams& _params)
+{
+    // FNV-1a, stable between the processes
+    auto json = _params.toJsonString();
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto c : json)
+    {
+        hash ^= (uint8_t)c;
+        hash *= 1099511628211ULL;
+    }
+
+    std::stringstream ss;
+    ss << std::hex << hash;
+    return ss.str();
+}
+
+void EventSubCheckpointStore::start()
+{
+    if (m_running)
+    {
+        EVENT_SUB(INFO) << LOG_BADGE("EventSubCheckpointStore")
+                        << LOG_DESC("checkpoint store is running");
+        return;
+    }
+    m_running = true;
+
+    load();
+    compact();
+
+    m_file = fopen(m_path.c_str(), "ab");
+    if (m_file == nullptr)
+    {
+        m_running = false;
+        BOOST_THROW_EXCEPTION(
+            std::runtime_error("open the event sub checkpoint file failed, path: " + m_path));
+    }
+
+    if (m_flushIntervalMs > 0)
+    {
+        m_timer = std::make_shared<bcos::Timer>(m_flushIntervalMs, "eventCheckpoint");
+        m_timer->registerTimeoutHandler([this]() {
+            flush();
+            m_timer->restart();
+        });
+        m_timer->start();
+    }
+
+    EVENT_SUB(INFO) << LOG_BADGE("EventSubCheckpointStore")
+                    << LOG_DESC("start event sub checkpoint store") << LOG_KV("path", m_path)
+                    << LOG_KV("checkpoints", size())
+                    << LOG_KV("flushIntervalMs", m_flushIntervalMs)
+                    << LOG_KV("flushBatchSize", m_flushBatchSize);
+}
+
+void EventSubCheckpointStore::stop()
+{
+    if (!m_running)
+    {
+        return;
+    }
+    m_running = false;
+
+    if (m_timer)
+    {
+        m_timer->stop();
+    }
+
+    flush();
+
+    std::lock_guard<std::mutex> lock(x_file);
+    if (m_file)
+    {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+
+    EVENT_SUB(INFO) << LOG_BADGE("EventSubCheckpointStore")
+                    << LOG_DESC("stop event sub checkpoint store") << LOG_KV("path", m_path);
+}
+
+void EventSubCheckpointStore::update(const EventSubCheckpoint& _checkpoint)
+{
+    bool needFlush = false;
+    {
+        std::lock_guard<std::mutex> lock(x_checkpoints);
+        m_checkpoints[_checkpoint.id] = _checkpoint;
+        m_dirty[_checkpoint.id] = false;
+        needFlush = (m_dirty.size() >= m_flushBatchSize);
+    }
+
+    if (needFlush)
+    {
+        flush();
+    }
+}
+
+void EventSubCheckpointStore::remove(const std::string& _id)
+{
+    std::lock_guard<std::mutex> lock(x_checkpoints);
+    if (m_checkpoints.erase(_id) > 0)
+    {
+        m_dirty[_id] = true;
+    }
+}
+
+bool EventSubCheckpointStore::get(const std::string& _id, EventSubCheckpoint& _checkpoint) const
+{
+    std::lock_guard<std::mutex> lock(x_checkpoints);
+    auto it = m_checkpoints.find(_id);
+    if (it == m_checkpoints.end())
+    {
+        return false;
+    }
+    _checkpoint = it->second;
+    return true;
+}
+
+std::size_t EventSubCheckpointStore::flush()
+{
+    // the file lock is held from the drain to the write, the concurrent flushes write their
+    // records in the order they are drained, a stale record never follows a newer one
+    std::lock_guard<std::mutex> fileLock(x_file);
+    std::string buffer;
+    std::size_t count = 0;
+    {
+        std::lock_guard<std::mutex> lock(x_checkpoints);
+        if (m_dirty.empty())
+        {
+            return 0;
+        }
+
+        for (const auto& [id, removed] : m_dirty)
+        {
+            if (removed)
+            {
+                buffer += "D " + id + "\n";
+            }
+            else
+            {
+                appendRecord(buffer, m_checkpoints[id]);
+            }
+            count++;
+        }
+        m_dirty.clear();
+    }
+
+    if (m_file == nullptr)
+    {
+        EVENT_SUB(WARNING) << LOG_BADGE("EventSubCheckpointStore")
+                           << LOG_DESC("checkpoint file is not open, discard the records")
+                           << LOG_KV("count", count);
+        return 0;
+    }
+
+    fwrite(buffer.data(), 1, buffer.size(), m_file);
+    syncFile(m_file);
+
+    EVENT_SUB(TRACE) << LOG_BADGE("EventSubCheckpointStore") << LOG_DESC("flush")
+                     << LOG_KV("count", count) << LOG_KV("bytes", buffer.size());
+    return count;
+}
+
+void EventSubCheckpointStore::load()
+{
+    std::ifstream in(m_path);
+    if (!in)
+    {
+        return;
+    }
+
+    std::size_t lines = 0;
+    std::string line;
+    std::lock_guard<std::mutex> lock(x_checkpoints);
+    while (std::getline(in, line))
+    {
+        if (in.eof())
+        {
+            // the last line without the line break is torn by a crash, its last number may be
+            // truncated
+            EVENT_SUB(WARNING) << LOG_BADGE("EventSubCheckpointStore")
+                               << LOG_DESC("skip the torn last line") << LOG_KV("path", m_path)
+                               << LOG_KV("line", line);
+            break;
+        }
+        lines++;
+        std::istringstream ss(line);
+        std::string op;
+        std::string extra;
+        EventSubCheckpoint checkpoint;
+        if (!(ss >> op >> checkpoint.id))
+        {
+            continue;
+        }
+
+        if (op == "D" && !(ss >> extra))
+        {
+            m_checkpoints.erase(checkpoint.id);
+        }
+        else if (op == "U" &&
+                 (ss >> checkpoint.paramsHash >> checkpoint.blockNumber >>
+                     checkpoint.transactionIndex >> checkpoint.logIndex) &&
+                 !(ss >> extra))
+        {
+            m_checkpoints[checkpoint.id] = checkpoint;
+        }
+        else
+        {
+            EVENT_SUB(WARNING) << LOG_BADGE("EventSubCheckpointStore")
+                               << LOG_DESC("skip the invalid line") << LOG_KV("path", m_path)
+                               << LOG_KV("line", line);
+        }
+    }
+
+    EVENT_SUB(INFO) << LOG_BADGE("EventSubCheckpointStore") << LOG_DESC("load checkpoints")
+                    << LOG_KV("path", m_path) << LOG_KV("lines", lines)
+                    << LOG_KV("checkpoints", m_checkpoints.size());
+}
+
+void EventSubCheckpointStore::compact()
+{
+    std::string buffer;
+    {
+        std::lock_guard<std::mutex> lock(x_checkpoints);
+        for (const auto& [id, checkpoint] : m_checkpoints)
+        {
+            appendRecord(buffer, checkpoint);
+        }
+    }
+
+    auto tmpPath = m_path + ".tmp";
+    FILE* file = fopen(tmpPath.c_str(), "wb");
+    if (file == nullptr)
+    {
+        EVENT_SUB(WARNING) << LOG_BADGE("EventSubCheckpointStore")
+                           << LOG_DESC("open the temp file failed, skip compact")
+                           << LOG_KV("path", tmpPath);
+        return;
+    }
+    fwrite(buffer.data(), 1, buffer.size(), file);
+    syncFile(file);
+    fclose(file);
+
+    boost::system::error_code ec;
+    boost::filesystem::rename(tmpPath, m_path, ec);
+    if (ec)
+    {
+        EVENT_SUB(WARNING) << LOG_BADGE("EventSubCheckpointStore")
+                           << LOG_DESC("rename the compacted file failed")
+                           << LOG_KV("path", m_path) << LOG_KV("error", ec.message());
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventSubCheckpointStore.h
+ * @author: octopus
+ * @date 2023-03-10
+ */
+
+#pragma once
+#include <bcos-cpp-sdk/event/EventSubParams.h>
+#include <bcos-utilities/Timer.h>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace event
+{
+struct EventSubCheckpoint
+{
+    std::string id;
+    std::string paramsHash;
+    int64_t blockNumber = -1;
+    int64_t transactionIndex = -1;
+    int64_t logIndex = -1;
+};
+
+/**
+ * @brief persist the progress of the event subs to a local append-only file, one line per
+ * update:
+ *      U <id> <paramsHash> <blockNumber> <transactionIndex> <logIndex>
+ *      D <id>
+ * the updates are coalesced in memory and written on flush, flush is triggered by the timer or
+ * when the dirty subs reach the batch size, the file is compacted when the store starts
+ */
+class EventSubCheckpointStore
+{
+public:
+    using Ptr = std::shared_ptr<EventSubCheckpointStore>;
+    using ConstPtr = std::shared_ptr<const EventSubCheckpointStore>;
+
+    EventSubCheckpointStore(
+        std::string _path, uint32_t _flushIntervalMs = 1000, uint32_t _flushBatchSize = 1000);
+    ~EventSubCheckpointStore() { stop(); }
+
+    EventSubCheckpointStore(const EventSubCheckpointStore&) = delete;
+    EventSubCheckpointStore(EventSubCheckpointStore&&) = delete;
+    EventSubCheckpointStore& operator=(const EventSubCheckpointStore&) = delete;
+    EventSubCheckpointStore& operator=(EventSubCheckpointStore&&) = delete;
+
+public:
+    void start();
+    void stop();
+
+    void update(const EventSubCheckpoint& _checkpoint);
+    void remove(const std::string& _id);
+    bool get(const std::string& _id, EventSubCheckpoint& _checkpoint) const;
+
+    // write the dirty checkpoints and fsync, return the number of records written
+    std::size_t flush();
+
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(x_checkpoints);
+        return m_checkpoints.size();
+    }
+
+    const std::string& path() const { return m_path; }
+    uint32_t flushIntervalMs() const { return m_flushIntervalMs; }
+    uint32_t flushBatchSize() const { return m_flushBatchSize; }
+
+public:
+    // the stable digest of the params, a resumed sub must match it
+    static std::string paramsHash(const EventSubParams& _params);
+
+private:
+    void load();
+    void compact();
+
+private:
+    std::string m_path;
+    uint32_t m_flushIntervalMs;
+    uint32_t m_flushBatchSize;
+    bool m_running = false;
+
+    mutable std::mutex x_checkpoints;
+    std::unordered_map<std::string, EventSubCheckpoint> m_checkpoints;
+    // id => removed
+    std::unordered_map<std::string, bool> m_dirty;
+
+    std::mutex x_file;
+    FILE* m_file = nullptr;
+
+    std::shared_ptr<bcos::Timer> m_timer;
+};
+}  // namespace event
+}  // namespace cppsdk
+}  // namespace bcos
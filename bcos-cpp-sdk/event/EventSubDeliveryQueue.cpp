@@ -0,0 +1,181 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventSubDeliveryQueue.cpp
+ * @author: octopus
+ * @date 2023-03-17
+ */
+
+#include <bcos-cpp-sdk/event/Common.h>
+#include <bcos-cpp-sdk/event/EventSubDeliveryQueue.h>
+#include <boost/exception/diagnostic_information.hpp>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::event;
+
+// the pushes delivered by one drain before it yields the executor to the other event subs
+static const std::size_t DRAIN_BATCH_SIZE = 16;
+
+bool EventSubDeliveryQueue::push(
+    int64_t _blockNumber, std::size_t _logCount, std::function<void()> _deliver, bool _control)
+{
+    bool schedule = false;
+    {
+        std::unique_lock<std::mutex> lock(x_queue);
+        if (m_closed)
+        {
+            return false;
+        }
+
+        m_receivedBlock = std::max(m_receivedBlock, _blockNumber);
+        if (!_control && m_queue.size() >= m_capacity)
+        {
+            switch (m_policy)
+            {
+            case DeliveryPolicy::Block:
+                m_notFull.wait(lock, [this]() { return m_closed || m_queue.size() < m_capacity; });
+                if (m_closed)
+                {
+                    return false;
+                }
+                break;
+            case DeliveryPolicy::DropOldest:
+                while (m_queue.size() >= m_capacity && !m_queue.front().control)
+                {
+                    m_dropped += m_queue.front().logCount;
+                    m_queue.pop_front();
+                }
+                break;
+            case DeliveryPolicy::Suspend:
+                // the pushes in flight when the event sub is suspended are kept, the queue
+                // overflows them
+                break;
+            }
+        }
+
+        m_queue.push_back(Item{_blockNumber, _logCount, std::move(_deliver), _control});
+        if (!m_scheduled)
+        {
+            m_scheduled = true;
+            schedule = true;
+        }
+    }
+
+    if (schedule)
+    {
+        auto self = shared_from_this();
+        m_executor->enqueue([self]() { self->drain(); });
+    }
+    return true;
+}
+
+void EventSubDeliveryQueue::drain()
+{
+    for (std::size_t i = 0; i < DRAIN_BATCH_SIZE; ++i)
+    {
+        Item item;
+        std::function<void()> resumeHandler;
+        {
+            std::lock_guard<std::mutex> lock(x_queue);
+            if (m_closed || m_queue.empty())
+            {
+                m_scheduled = false;
+                return;
+            }
+
+            item = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_notFull.notify_one();
+
+            if (m_suspended && m_queue.size() <= m_capacity / 2)
+            {
+                m_suspended = false;
+                resumeHandler = m_resumeHandler;
+            }
+        }
+
+        try
+        {
+            item.deliver();
+        }
+        catch (const std::exception& e)
+        {
+            EVENT_SUB(WARNING) << LOG_BADGE("EventSubDeliveryQueue")
+                               << LOG_DESC("deliver event sub push failed")
+                               << LOG_KV("error", boost::diagnostic_information(e));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(x_queue);
+            m_delivered += item.logCount;
+            m_deliveredBlock = std::max(m_deliveredBlock, item.blockNumber);
+        }
+
+        if (resumeHandler)
+        {
+            resumeHandler();
+        }
+    }
+
+    // yield to the other event subs sharing the executor
+    auto self = shared_from_this();
+    m_executor->enqueue([self]() { self->drain(); });
+}
+
+void EventSubDeliveryQueue::close()
+{
+    std::lock_guard<std::mutex> lock(x_queue);
+    m_closed = true;
+    m_queue.clear();
+    m_resumeHandler = nullptr;
+    m_notFull.notify_all();
+}
+
+bool EventSubDeliveryQueue::suspend()
+{
+    std::lock_guard<std::mutex> lock(x_queue);
+    if (m_queue.size() <= m_capacity / 2)
+    {
+        return false;
+    }
+
+    if (!m_suspended)
+    {
+        m_suspended = true;
+        m_suspendCount++;
+    }
+    return true;
+}
+
+EventSubDeliveryStats EventSubDeliveryQueue::stats() const
+{
+    std::lock_guard<std::mutex> lock(x_queue);
+
+    EventSubDeliveryStats stats;
+    stats.depth = m_queue.size();
+    stats.capacity = m_capacity;
+    stats.dropped = m_dropped;
+    stats.delivered = m_delivered;
+    stats.suspendCount = m_suspendCount;
+    stats.suspended = m_suspended;
+    if (!m_queue.empty())
+    {
+        auto delivered =
+            m_deliveredBlock >= 0 ? m_deliveredBlock : m_queue.front().blockNumber - 1;
+        stats.lagBlocks = std::max<int64_t>(m_receivedBlock - delivered, 0);
+    }
+    return stats;
+}
@@ -0,0 +1,146 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventSubDeliveryQueue.h
+ * @author: octopus
+ * @date 2023-03-17
+ */
+
+#pragma once
+#include <bcos-utilities/ThreadPool.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace event
+{
+// what happens to the pushes of the event sub when its delivery queue is full
+enum class DeliveryPolicy : int
+{
+    // the receiving thread waits for the queue, the session is throttled
+    Block = 0,
+    // the oldest pushes queued are dropped
+    DropOldest = 1,
+    // the server event sub is stopped until the queue is half drained, then it is resubscribed
+    // from the last log queued
+    Suspend = 2,
+};
+
+struct EventSubDeliveryStats
+{
+    // the pushes queued
+    std::size_t depth = 0;
+    std::size_t capacity = 0;
+    // the blocks between the latest log received and the latest log delivered
+    int64_t lagBlocks = 0;
+    // the logs dropped for DropOldest
+    uint64_t dropped = 0;
+    // the logs delivered
+    uint64_t delivered = 0;
+    // the times the event sub suspended for Suspend
+    uint64_t suspendCount = 0;
+    bool suspended = false;
+};
+
+/**
+ * @brief the bounded queue between the receiving thread and the callback of one event sub, the
+ * pushes are delivered in order on the executor, at most one drain of the queue is running
+ */
+class EventSubDeliveryQueue : public std::enable_shared_from_this<EventSubDeliveryQueue>
+{
+public:
+    using Ptr = std::shared_ptr<EventSubDeliveryQueue>;
+    using ConstPtr = std::shared_ptr<const EventSubDeliveryQueue>;
+
+    EventSubDeliveryQueue(std::size_t _capacity, DeliveryPolicy _policy,
+        std::shared_ptr<bcos::ThreadPool> _executor)
+      : m_capacity(std::max<std::size_t>(_capacity, 1)), m_policy(_policy), m_executor(_executor)
+    {}
+
+public:
+    // queue the delivery of the push, the control pushes(end of push, error) are never dropped
+    // or blocked, return false if the queue is closed
+    bool push(int64_t _blockNumber, std::size_t _logCount, std::function<void()> _deliver,
+        bool _control = false);
+
+    // discard the pushes queued and wake the threads blocked
+    void close();
+    bool closed() const
+    {
+        std::lock_guard<std::mutex> lock(x_queue);
+        return m_closed;
+    }
+
+    bool full() const
+    {
+        std::lock_guard<std::mutex> lock(x_queue);
+        return m_queue.size() >= m_capacity;
+    }
+
+    // Suspend: the event sub is stopped, the handler is called when the queue is half drained,
+    // return false if the queue is half drained already
+    bool suspend();
+    void setResumeHandler(std::function<void()> _resumeHandler)
+    {
+        std::lock_guard<std::mutex> lock(x_queue);
+        m_resumeHandler = std::move(_resumeHandler);
+    }
+
+    EventSubDeliveryStats stats() const;
+
+    std::size_t capacity() const { return m_capacity; }
+    DeliveryPolicy policy() const { return m_policy; }
+
+private:
+    struct Item
+    {
+        int64_t blockNumber;
+        std::size_t logCount;
+        std::function<void()> deliver;
+        bool control;
+    };
+
+    void drain();
+
+private:
+    std::size_t m_capacity;
+    DeliveryPolicy m_policy;
+    std::shared_ptr<bcos::ThreadPool> m_executor;
+
+    mutable std::mutex x_queue;
+    std::condition_variable m_notFull;
+    std::deque<Item> m_queue;
+    bool m_scheduled = false;
+    bool m_closed = false;
+    bool m_suspended = false;
+    std::function<void()> m_resumeHandler;
+
+    int64_t m_receivedBlock = -1;
+    int64_t m_deliveredBlock = -1;
+    uint64_t m_dropped = 0;
+    uint64_t m_delivered = 0;
+    uint64_t m_suspendCount = 0;
+};
+}  // namespace event
+}  // namespace cppsdk
+}  // namespace bcos
@@ -0,0 +1,189 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventSubIndex.cpp
+ * @author: octopus
+ * @date 2023-03-13
+ */
+
+#include <bcos-cpp-sdk/event/EventSubIndex.h>
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <set>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::event;
+
+std::string EventSubIndex::normalize(const std::string& _hex)
+{
+    std::string result =
+        (_hex.compare(0, 2, "0x") == 0 || _hex.compare(0, 2, "0X") == 0) ? _hex.substr(2) : _hex;
+    boost::algorithm::to_lower(result);
+    return result;
+}
+
+// the normalized values of a position, the empty value for the position not filtered
+static std::vector<std::string> normalizeValues(const std::set<std::string>& _values)
+{
+    std::vector<std::string> result;
+    for (const auto& value : _values)
+    {
+        result.push_back(EventSubIndex::normalize(value));
+    }
+    // the same value given twice in different forms
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+bool EventSubIndex::Entry::matchTopics(const std::vector<std::string>& _topics) const
+{
+    for (std::size_t i = 0; i < CHECKED_POSITION_COUNT; ++i)
+    {
+        if (topics[i].empty())
+        {
+            continue;
+        }
+        // a log without topic i only matches the subs not filtering topic i
+        if (i + 1 >= _topics.size() ||
+            !std::binary_search(topics[i].begin(), topics[i].end(), _topics[i + 1]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void EventSubIndex::add(const std::string& _id, const EventSubParams& _params)
+{
+    remove(_id);
+
+    auto entry = std::make_shared<Entry>();
+    entry->id = _id;
+
+    const auto& topics = _params.topics();
+    for (std::size_t i = 1; i < topics.size() && i < POSITION_COUNT - 1; ++i)
+    {
+        entry->topics[i - 1] = normalizeValues(topics[i]);
+    }
+
+    auto addresses = normalizeValues(_params.addresses());
+    auto topic0s = topics.empty() ? std::vector<std::string>() : normalizeValues(topics[0]);
+    if (addresses.empty())
+    {
+        addresses.emplace_back();
+    }
+    if (topic0s.empty())
+    {
+        topic0s.emplace_back();
+    }
+    for (const auto& address : addresses)
+    {
+        for (const auto& topic0 : topic0s)
+        {
+            m_index[address][topic0].push_back(entry);
+            entry->keys.emplace_back(address, topic0);
+        }
+    }
+    m_entries[_id] = entry;
+}
+
+void EventSubIndex::erase(Entries& _entries, const std::shared_ptr<Entry>& _entry)
+{
+    _entries.erase(std::remove(_entries.begin(), _entries.end(), _entry), _entries.end());
+}
+
+bool EventSubIndex::remove(const std::string& _id)
+{
+    auto it = m_entries.find(_id);
+    if (it == m_entries.end())
+    {
+        return false;
+    }
+
+    auto entry = it->second;
+    for (const auto& [address, topic0] : entry->keys)
+    {
+        auto addressIt = m_index.find(address);
+        if (addressIt == m_index.end())
+        {
+            continue;
+        }
+        auto& topicIndex = addressIt->second;
+        auto topicIt = topicIndex.find(topic0);
+        if (topicIt == topicIndex.end())
+        {
+            continue;
+        }
+
+        erase(topicIt->second, entry);
+        if (topicIt->second.empty())
+        {
+            topicIndex.erase(topicIt);
+        }
+        if (topicIndex.empty())
+        {
+            m_index.erase(addressIt);
+        }
+    }
+
+    m_entries.erase(it);
+    return true;
+}
+
+std::size_t EventSubIndex::match(const std::string& _address,
+    const std::vector<std::string>& _topics, std::vector<std::string>& _ids) const
+{
+    static const std::string wildcard;
+    const auto& topic0 = _topics.empty() ? wildcard : _topics[0];
+
+    std::size_t candidates = 0;
+    auto probe = [&](const std::string& _addressKey) {
+        auto addressIt = m_index.find(_addressKey);
+        if (addressIt == m_index.end())
+        {
+            return;
+        }
+        auto probeTopic = [&](const std::string& _topicKey) {
+            auto topicIt = addressIt->second.find(_topicKey);
+            if (topicIt == addressIt->second.end())
+            {
+                return;
+            }
+            for (const auto& entry : topicIt->second)
+            {
+                candidates++;
+                if (entry->matchTopics(_topics))
+                {
+                    _ids.push_back(entry->id);
+                }
+            }
+        };
+        // a log without topic0 only matches the subs not filtering topic0
+        if (!topic0.empty())
+        {
+            probeTopic(topic0);
+        }
+        probeTopic(wildcard);
+    };
+
+    if (!_address.empty())
+    {
+        probe(_address);
+    }
+    probe(wildcard);
+    return candidates;
+}
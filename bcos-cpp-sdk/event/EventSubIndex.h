@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventSubIndex.h
+ * @author: octopus
+ * @date 2023-03-13
+ */
+
+#pragma once
+#include <bcos-cpp-sdk/event/EventSubParams.h>
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace event
+{
+/**
+ * @brief route the event logs to the subs by the hash index of the address and topic0, an entry is
+ * indexed under each pair of its address and topic0 values, the empty value for the position not
+ * filtered, so one lookup probes the four buckets of the log and the candidates found already match
+ * the address and topic0, only topic1..3 filtered are checked on the candidate. The cost of a log
+ * is in proportion to the candidates of its address and topic0, no filter is scanned
+ * NOTE: not thread safe
+ */
+class EventSubIndex
+{
+public:
+    using Ptr = std::shared_ptr<EventSubIndex>;
+    using ConstPtr = std::shared_ptr<const EventSubIndex>;
+
+    // the address and the four topics
+    static constexpr std::size_t POSITION_COUNT = 5;
+
+public:
+    void add(const std::string& _id, const EventSubParams& _params);
+    bool remove(const std::string& _id);
+
+    // append the ids of the subs matching the log to _ids, the address and topics of the log
+    // should be normalized, return the candidates checked
+    std::size_t match(const std::string& _address, const std::vector<std::string>& _topics,
+        std::vector<std::string>& _ids) const;
+
+    std::size_t size() const { return m_entries.size(); }
+    // the buckets of (address, topic0)
+    std::size_t keyCount() const
+    {
+        std::size_t count = 0;
+        for (const auto& [address, topics] : m_index)
+        {
+            count += topics.size();
+        }
+        return count;
+    }
+
+    // lowercase hex without the 0x prefix
+    static std::string normalize(const std::string& _hex);
+
+private:
+    // the positions checked on the candidates, topic1..3
+    static constexpr std::size_t CHECKED_POSITION_COUNT = POSITION_COUNT - 2;
+
+    struct Entry
+    {
+        std::string id;
+        // (address, topic0) indexed, the empty value for the position not filtered
+        std::vector<std::pair<std::string, std::string>> keys;
+        // the sorted values of topic1..3, empty for the position not filtered
+        std::array<std::vector<std::string>, CHECKED_POSITION_COUNT> topics;
+
+        bool matchTopics(const std::vector<std::string>& _topics) const;
+    };
+
+    using Entries = std::vector<std::shared_ptr<Entry>>;
+    static void erase(Entries& _entries, const std::shared_ptr<Entry>& _entry);
+
+private:
+    std::unordered_map<std::string, std::shared_ptr<Entry>> m_entries;
+    // address => topic0 => the subs, the empty address or topic0 for the subs not filtering it
+    std::unordered_map<std::string, std::unordered_map<std::string, Entries>> m_index;
+};
+}  // namespace event
+}  // namespace cppsdk
+}  // namespace bcos
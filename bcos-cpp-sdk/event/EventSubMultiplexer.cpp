@@ -0,0 +1,543 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventSubMultiplexer.cpp
+ * @author: octopus
+ * @date 2023-03-13
+ */
+
+#include <bcos-cpp-sdk/event/Common.h>
+#include <bcos-cpp-sdk/event/EventSubMultiplexer.h>
+#include <bcos-cpp-sdk/event/EventSubResponse.h>
+#include <bcos-cpp-sdk/event/EventSubStatus.h>
+#include <json/writer.h>
+#include <algorithm>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::event;
+
+// the blocks the delivered log positions are kept for deduplication
+static const int64_t DEDUP_BLOCK_WINDOW = 16;
+
+// the form of the addresses and topics sent to the node, the equivalent ones are merged
+static std::string canonical(const std::string& _hex)
+{
+    return "0x" + EventSubIndex::normalize(_hex);
+}
+
+static std::set<std::string> canonical(const std::set<std::string>& _hexes)
+{
+    std::set<std::string> result;
+    for (const auto& hex : _hexes)
+    {
+        result.insert(canonical(hex));
+    }
+    return result;
+}
+
+std::string EventSubMultiplexer::mergeKey(const std::string& _group, const EventSubParams& _params)
+{
+    return _group + "|" + std::to_string(_params.fromBlock()) + "|" +
+           std::to_string(_params.toBlock());
+}
+
+std::string EventSubMultiplexer::buildResponse(const std::string& _id, int32_t _status)
+{
+    EventSubResponse resp;
+    resp.setId(_id);
+    resp.setStatus(_status);
+    return resp.generateJson();
+}
+
+EventSubParams::Ptr EventSubMultiplexer::mergeParams(
+    const std::vector<EventSubParams::ConstPtr>& _params)
+{
+    auto merged = std::make_shared<EventSubParams>();
+    if (_params.empty())
+    {
+        return merged;
+    }
+
+    merged->setFromBlock(_params[0]->fromBlock());
+    merged->setToBlock(_params[0]->toBlock());
+
+    // addresses, empty for all addresses
+    bool addressWildcard = std::any_of(_params.begin(), _params.end(),
+        [](const EventSubParams::ConstPtr& _p) { return _p->addresses().empty(); });
+    if (!addressWildcard)
+    {
+        for (const auto& p : _params)
+        {
+            auto addresses = canonical(p->addresses());
+            merged->addresses().insert(addresses.begin(), addresses.end());
+        }
+    }
+
+    // topics, empty set for all topics in the position
+    std::vector<std::set<std::string>> topics(EVENT_LOG_TOPICS_MAX_INDEX);
+    std::size_t topicSize = 0;
+    for (std::size_t i = 0; i < EVENT_LOG_TOPICS_MAX_INDEX; ++i)
+    {
+        bool topicWildcard = std::any_of(
+            _params.begin(), _params.end(), [i](const EventSubParams::ConstPtr& _p) {
+                return _p->topics().size() <= i || _p->topics()[i].empty();
+            });
+        if (topicWildcard)
+        {
+            continue;
+        }
+
+        for (const auto& p : _params)
+        {
+            auto pTopics = canonical(p->topics()[i]);
+            topics[i].insert(pTopics.begin(), pTopics.end());
+        }
+        topicSize = i + 1;
+    }
+    topics.resize(topicSize);
+    merged->topics() = std::move(topics);
+
+    return merged;
+}
+
+bool EventSubMultiplexer::covers(const EventSubParams& _serverParams, const EventSubParams& _params)
+{
+    auto serverAddresses = canonical(_serverParams.addresses());
+    if (!serverAddresses.empty())
+    {
+        if (_params.addresses().empty())
+        {
+            return false;
+        }
+        for (const auto& address : _params.addresses())
+        {
+            if (serverAddresses.count(canonical(address)) == 0)
+            {
+                return false;
+            }
+        }
+    }
+
+    const auto& serverTopics = _serverParams.topics();
+    for (std::size_t i = 0; i < serverTopics.size(); ++i)
+    {
+        if (serverTopics[i].empty())
+        {
+            continue;
+        }
+
+        if (_params.topics().size() <= i || _params.topics()[i].empty())
+        {
+            return false;
+        }
+        auto topics = canonical(serverTopics[i]);
+        for (const auto& topic : _params.topics()[i])
+        {
+            if (topics.count(canonical(topic)) == 0)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+std::string EventSubMultiplexer::subscribeEvent(
+    const std::string& _group, EventSubParams::Ptr _params, Callback _callback)
+{
+    if (!_params->verifyParams())
+    {
+        auto error = std::make_shared<Error>(-1, "params verification failure");
+        _callback(error, "");
+        return "";
+    }
+
+    // the logs after the head may have been pushed to the subs merged already, a sub from an
+    // earlier block catches up by a server sub of its own instead of missing them
+    int64_t headBlock = -1;
+    bool headKnown = false;
+    if (_params->fromBlock() >= 0 && m_eventSub->service())
+    {
+        headKnown = m_eventSub->service()->getBlockNumber(_group, headBlock);
+    }
+
+    auto subscriber = std::make_shared<Subscriber>();
+    subscriber->id = "mux_" + std::to_string(++m_seq);
+    subscriber->key = mergeKey(_group, *_params);
+    subscriber->params = _params;
+    subscriber->callback = _callback;
+
+    MergedSub::Ptr merged;
+    EventSubParams::Ptr serverParams;
+    bool ackNow = false;
+    bool catchUp = false;
+    {
+        boost::unique_lock<boost::shared_mutex> lock(x_subs);
+        auto it = m_mergedSubs.find(subscriber->key);
+        if (it != m_mergedSubs.end() && _params->fromBlock() >= 0)
+        {
+            std::lock_guard<std::mutex> deliveredLock(it->second->x_delivered);
+            catchUp = !headKnown || _params->fromBlock() <= headBlock ||
+                      _params->fromBlock() <= it->second->deliveredBlock;
+        }
+        if (catchUp)
+        {
+            // never joined by the others
+            subscriber->key += "|" + subscriber->id;
+        }
+
+        auto& mergedSub = m_mergedSubs[subscriber->key];
+        if (!mergedSub)
+        {
+            mergedSub = std::make_shared<MergedSub>();
+            mergedSub->key = subscriber->key;
+            mergedSub->group = _group;
+        }
+        merged = mergedSub;
+
+        merged->subscribers[subscriber->id] = subscriber;
+        merged->index.add(subscriber->id, *_params);
+        m_subscribers[subscriber->id] = subscriber;
+
+        if (!merged->params || !covers(*merged->params, *_params))
+        {
+            std::vector<EventSubParams::ConstPtr> params;
+            params.reserve(merged->subscribers.size());
+            for (const auto& [id, s] : merged->subscribers)
+            {
+                params.push_back(s->params);
+            }
+            serverParams = mergeParams(params);
+            merged->params = serverParams;
+        }
+        else if (merged->established)
+        {
+            subscriber->acked = true;
+            ackNow = true;
+        }
+    }
+
+    EVENT_SUB(DEBUG) << LOG_BADGE("EventSubMultiplexer") << LOG_DESC("subscribe event")
+                     << LOG_KV("id", subscriber->id) << LOG_KV("key", subscriber->key)
+                     << LOG_KV("resubscribe", (serverParams != nullptr))
+                     << LOG_KV("ackNow", ackNow) << LOG_KV("catchUp", catchUp)
+                     << LOG_KV("headBlock", headBlock);
+
+    if (ackNow)
+    {
+        _callback(nullptr, buildResponse(subscriber->id, StatusCode::Success));
+    }
+
+    if (serverParams)
+    {
+        subscribeServer(merged, serverParams);
+    }
+
+    return subscriber->id;
+}
+
+void EventSubMultiplexer::subscribeServer(MergedSub::Ptr _merged, EventSubParams::Ptr _params)
+{
+    // the id of the server sub is allocated here, so the messages can be matched before
+    // subscribeEvent returns
+    auto serverId = m_eventSub->messageFactory()->newSeq();
+    {
+        boost::unique_lock<boost::shared_mutex> lock(x_subs);
+        _merged->pendingServerId = serverId;
+    }
+
+    EVENT_SUB(INFO) << LOG_BADGE("EventSubMultiplexer") << LOG_DESC("subscribe server event sub")
+                    << LOG_KV("key", _merged->key) << LOG_KV("serverId", serverId)
+                    << LOG_KV("params", _params->toJsonString());
+
+    auto key = _merged->key;
+    auto self = std::weak_ptr<EventSubMultiplexer>(shared_from_this());
+    m_eventSub->subscribeEventWithId(_merged->group, _params, serverId,
+        [self, key, serverId](Error::Ptr _error, const std::string& _resp) {
+            auto multiplexer = self.lock();
+            if (multiplexer)
+            {
+                multiplexer->onServerMessage(key, serverId, _error, _resp);
+            }
+        });
+}
+
+void EventSubMultiplexer::onServerMessage(const std::string& _key, const std::string& _serverId,
+    Error::Ptr _error, const std::string& _resp)
+{
+    auto resp = std::make_shared<EventSubResponse>();
+    if (!(_error && _error->errorCode() != 0) && !resp->fromJson(_resp))
+    {
+        _error = std::make_shared<Error>(-1, "invalid event sub response");
+    }
+
+    MergedSub::Ptr merged;
+    {
+        boost::shared_lock<boost::shared_mutex> lock(x_subs);
+        auto it = m_mergedSubs.find(_key);
+        if (it != m_mergedSubs.end())
+        {
+            merged = it->second;
+        }
+    }
+
+    bool failed = (_error && _error->errorCode() != 0);
+    bool isPush = !failed && resp->jResp().isMember("result");
+    if (!merged)
+    {
+        // all the subs left before the server sub acked
+        if (!failed && !isPush && resp->status() == StatusCode::Success)
+        {
+            m_eventSub->unsubscribeEvent(_serverId);
+        }
+        return;
+    }
+
+    if (!failed && resp->status() == StatusCode::Success)
+    {
+        if (isPush)
+        {
+            fanOut(merged, resp->jResp()["result"]);
+            return;
+        }
+
+        // the server sub acked
+        std::string staleServerId;
+        std::vector<Subscriber::Ptr> toAck;
+        {
+            boost::unique_lock<boost::shared_mutex> lock(x_subs);
+            if (_serverId != merged->pendingServerId)
+            {
+                // superseded by a wider one
+                staleServerId = _serverId;
+            }
+            else
+            {
+                if (merged->serverId != _serverId)
+                {
+                    staleServerId = merged->serverId;
+                    merged->serverId = _serverId;
+                }
+                merged->established = true;
+                for (auto& [id, subscriber] : merged->subscribers)
+                {
+                    if (!subscriber->acked)
+                    {
+                        subscriber->acked = true;
+                        toAck.push_back(subscriber);
+                    }
+                }
+            }
+        }
+
+        if (!staleServerId.empty())
+        {
+            m_eventSub->unsubscribeEvent(staleServerId);
+        }
+        for (const auto& subscriber : toAck)
+        {
+            subscriber->callback(nullptr, buildResponse(subscriber->id, StatusCode::Success));
+        }
+
+        EVENT_SUB(INFO) << LOG_BADGE("EventSubMultiplexer") << LOG_DESC("server event sub acked")
+                        << LOG_KV("key", _key) << LOG_KV("serverId", _serverId)
+                        << LOG_KV("staleServerId", staleServerId)
+                        << LOG_KV("acked", toAck.size());
+        return;
+    }
+
+    // end of push or error: the current server sub ends all the subs, the pending one fails the
+    // subs not acked
+    std::vector<Subscriber::Ptr> toNotify;
+    {
+        boost::unique_lock<boost::shared_mutex> lock(x_subs);
+        bool current = merged->established && (_serverId == merged->serverId);
+        if (!current && _serverId != merged->pendingServerId)
+        {
+            return;
+        }
+
+        for (auto it = merged->subscribers.begin(); it != merged->subscribers.end();)
+        {
+            if (!current && it->second->acked)
+            {
+                ++it;
+                continue;
+            }
+
+            toNotify.push_back(it->second);
+            merged->index.remove(it->first);
+            m_subscribers.erase(it->first);
+            it = merged->subscribers.erase(it);
+        }
+
+        if (merged->subscribers.empty())
+        {
+            m_mergedSubs.erase(_key);
+        }
+    }
+
+    EVENT_SUB(INFO) << LOG_BADGE("EventSubMultiplexer") << LOG_DESC("server event sub ended")
+                    << LOG_KV("key", _key) << LOG_KV("serverId", _serverId)
+                    << LOG_KV("status", failed ? -1 : resp->status())
+                    << LOG_KV("notify", toNotify.size());
+
+    Json::FastWriter writer;
+    for (const auto& subscriber : toNotify)
+    {
+        if (failed)
+        {
+            subscriber->callback(_error, "");
+            continue;
+        }
+
+        auto jResp = resp->jResp();
+        jResp["id"] = subscriber->id;
+        subscriber->callback(nullptr, writer.write(jResp));
+    }
+}
+
+bool EventSubMultiplexer::markDelivered(MergedSub& _merged, const Json::Value& _jLog)
+{
+    if (!_jLog.isMember("logIndex"))
+    {
+        return true;
+    }
+
+    auto blockNumber = _jLog.get("blockNumber", -1).asInt64();
+    auto position = std::make_tuple(blockNumber, _jLog.get("transactionIndex", -1).asInt64(),
+        _jLog.get("logIndex", -1).asInt64());
+
+    std::lock_guard<std::mutex> lock(_merged.x_delivered);
+    if (!_merged.delivered.insert(position).second)
+    {
+        return false;
+    }
+    _merged.deliveredBlock = std::max(_merged.deliveredBlock, blockNumber);
+
+    while (!_merged.delivered.empty() &&
+           std::get<0>(*_merged.delivered.begin()) < blockNumber - DEDUP_BLOCK_WINDOW)
+    {
+        _merged.delivered.erase(_merged.delivered.begin());
+    }
+    return true;
+}
+
+void EventSubMultiplexer::fanOut(MergedSub::Ptr _merged, Json::Value& _jLogs)
+{
+    if (!_jLogs.isArray())
+    {
+        return;
+    }
+
+    // id => logs matched
+    std::unordered_map<std::string, Json::Value> id2Logs;
+    std::vector<std::pair<Subscriber::Ptr, Json::Value*>> outputs;
+    {
+        boost::shared_lock<boost::shared_mutex> lock(x_subs);
+        std::vector<std::string> ids;
+        std::vector<std::string> topics;
+        for (const auto& jLog : _jLogs)
+        {
+            if (!markDelivered(*_merged, jLog))
+            {
+                continue;
+            }
+
+            auto address = EventSubIndex::normalize(jLog.get("address", "").asString());
+            topics.clear();
+            const auto& jTopics = jLog["topics"];
+            for (Json::ArrayIndex i = 0; jTopics.isArray() && i < jTopics.size(); ++i)
+            {
+                topics.push_back(EventSubIndex::normalize(jTopics[i].asString()));
+            }
+
+            ids.clear();
+            _merged->index.match(address, topics, ids);
+            for (const auto& id : ids)
+            {
+                auto& jMatched = id2Logs[id];
+                if (jMatched.isNull())
+                {
+                    jMatched = Json::Value(Json::arrayValue);
+                }
+                jMatched.append(jLog);
+            }
+        }
+
+        for (auto& [id, jMatched] : id2Logs)
+        {
+            auto it = _merged->subscribers.find(id);
+            if (it != _merged->subscribers.end())
+            {
+                outputs.emplace_back(it->second, &jMatched);
+            }
+        }
+    }
+
+    Json::FastWriter writer;
+    for (auto& [subscriber, jMatched] : outputs)
+    {
+        Json::Value jResp;
+        jResp["id"] = subscriber->id;
+        jResp["status"] = StatusCode::Success;
+        jResp["result"] = std::move(*jMatched);
+        subscriber->callback(nullptr, writer.write(jResp));
+    }
+}
+
+void EventSubMultiplexer::unsubscribeEvent(const std::string& _id)
+{
+    std::string serverId;
+    {
+        boost::unique_lock<boost::shared_mutex> lock(x_subs);
+        auto it = m_subscribers.find(_id);
+        if (it == m_subscribers.end())
+        {
+            EVENT_SUB(WARNING) << LOG_BADGE("EventSubMultiplexer")
+                               << LOG_DESC("event sub not found") << LOG_KV("id", _id);
+            return;
+        }
+
+        auto key = it->second->key;
+        m_subscribers.erase(it);
+
+        auto mergedIt = m_mergedSubs.find(key);
+        if (mergedIt == m_mergedSubs.end())
+        {
+            return;
+        }
+
+        auto merged = mergedIt->second;
+        merged->subscribers.erase(_id);
+        merged->index.remove(_id);
+        if (merged->subscribers.empty())
+        {
+            // the pending server sub is unsubscribed when it acks
+            serverId = merged->serverId;
+            m_mergedSubs.erase(mergedIt);
+        }
+    }
+
+    EVENT_SUB(DEBUG) << LOG_BADGE("EventSubMultiplexer") << LOG_DESC("unsubscribe event")
+                     << LOG_KV("id", _id) << LOG_KV("serverId", serverId);
+
+    if (!serverId.empty())
+    {
+        m_eventSub->unsubscribeEvent(serverId);
+    }
+}
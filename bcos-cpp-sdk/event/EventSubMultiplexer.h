@@ -0,0 +1,137 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventSubMultiplexer.h
+ * @author: octopus
+ * @date 2023-03-13
+ */
+
+#pragma once
+#include <bcos-cpp-sdk/event/EventSub.h>
+#include <bcos-cpp-sdk/event/EventSubIndex.h>
+#include <boost/thread/thread.hpp>
+#include <json/value.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace event
+{
+/**
+ * @brief merge the local event subs of the same group and block range into one server event
+ * sub whose filter covers all of them, the logs pushed are fanned out with EventSubIndex
+ * NOTE: the server sub is widened(resubscribed) when a sub out of its filter joins, it is not
+ * narrowed when the subs leave until the last one leaves. A sub only joins the server sub when
+ * nothing from its fromBlock has been pushed yet: fromBlock -1, or a fromBlock after the head of
+ * the group and the logs delivered. Otherwise it catches up by a server sub of its own, so it
+ * does not miss the earlier logs and a widening never replays them to the subs merged
+ */
+class EventSubMultiplexer : public std::enable_shared_from_this<EventSubMultiplexer>
+{
+public:
+    using Ptr = std::shared_ptr<EventSubMultiplexer>;
+    using ConstPtr = std::shared_ptr<const EventSubMultiplexer>;
+
+    explicit EventSubMultiplexer(EventSub::Ptr _eventSub) : m_eventSub(_eventSub) {}
+
+public:
+    // the same callback semantics as EventSub::subscribeEvent, the id in the responses is the id
+    // returned
+    std::string subscribeEvent(
+        const std::string& _group, EventSubParams::Ptr _params, Callback _callback);
+    void unsubscribeEvent(const std::string& _id);
+
+    // the message of the server event sub
+    void onServerMessage(const std::string& _key, const std::string& _serverId,
+        Error::Ptr _error, const std::string& _resp);
+
+public:
+    std::size_t subscriberCount() const
+    {
+        boost::shared_lock<boost::shared_mutex> lock(x_subs);
+        return m_subscribers.size();
+    }
+    std::size_t serverSubCount() const
+    {
+        boost::shared_lock<boost::shared_mutex> lock(x_subs);
+        return m_mergedSubs.size();
+    }
+
+    // the params of the server event sub merged
+    static EventSubParams::Ptr mergeParams(const std::vector<EventSubParams::ConstPtr>& _params);
+    // if the logs of _params are all pushed by the server event sub of _serverParams
+    static bool covers(const EventSubParams& _serverParams, const EventSubParams& _params);
+
+private:
+    struct Subscriber
+    {
+        using Ptr = std::shared_ptr<Subscriber>;
+        std::string id;
+        std::string key;
+        EventSubParams::ConstPtr params;
+        Callback callback;
+        // the subscribe response has been delivered
+        bool acked = false;
+    };
+
+    struct MergedSub
+    {
+        using Ptr = std::shared_ptr<MergedSub>;
+        std::string key;
+        std::string group;
+        // the server sub delivering the logs
+        std::string serverId;
+        // the latest server sub requested, it replaces serverId when acked
+        std::string pendingServerId;
+        EventSubParams::Ptr params;
+        bool established = false;
+        std::unordered_map<std::string, Subscriber::Ptr> subscribers;
+        EventSubIndex index;
+
+        // the positions of the logs delivered in the recent blocks, the logs are pushed twice
+        // when the server sub is switched
+        std::mutex x_delivered;
+        std::set<std::tuple<int64_t, int64_t, int64_t>> delivered;
+        // the highest block of the logs delivered
+        int64_t deliveredBlock = -1;
+    };
+
+    static std::string mergeKey(const std::string& _group, const EventSubParams& _params);
+    void subscribeServer(MergedSub::Ptr _merged, EventSubParams::Ptr _params);
+    void fanOut(MergedSub::Ptr _merged, Json::Value& _jLogs);
+    bool markDelivered(MergedSub& _merged, const Json::Value& _jLog);
+    static std::string buildResponse(const std::string& _id, int32_t _status);
+
+private:
+    EventSub::Ptr m_eventSub;
+    std::atomic<uint64_t> m_seq{0};
+
+    mutable boost::shared_mutex x_subs;
+    // merge key => server sub
+    std::unordered_map<std::string, MergedSub::Ptr> m_mergedSubs;
+    // id => sub
+    std::unordered_map<std::string, Subscriber::Ptr> m_subscribers;
+};
+}  // namespace event
+}  // namespace cppsdk
+}  // namespace bcos
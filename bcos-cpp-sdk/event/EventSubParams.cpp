@@ -144,14 +144,14 @@ void EventSubParams::fromJson(const Json::Value& jParams)
     EVENT_PARAMS(DEBUG) << LOG_BADGE("fromJson") << LOG_KV("EventSubParams", *this);
 }
 
-std::string EventSubParams::toJsonString()
+std::string EventSubParams::toJsonString() const
 {
     Json::FastWriter writer;
     std::string result = writer.write(toJson());
     return result;
 }
 
-Json::Value EventSubParams::toJson()
+Json::Value EventSubParams::toJson() const
 {
     Json::Value jParams;
     // fromBlock
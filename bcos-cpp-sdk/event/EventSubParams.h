@@ -60,8 +60,8 @@ public:
     bool fromJsonString(const std::string& _jsonString);
     void fromJson(const Json::Value& _json);
 
-    std::string toJsonString();
-    Json::Value toJson();
+    std::string toJsonString() const;
+    Json::Value toJson() const;
 
 public:
     bool verifyParams();
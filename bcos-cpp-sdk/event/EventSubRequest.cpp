@@ -133,9 +133,17 @@ std::string EventSubSubRequest::generateJson() const
     jResult["group"] = group();
 
     Json::Value jParams;
-    // fromBlock
-    jParams["fromBlock"] = m_state->currentBlockNumber() > 0 ? m_state->currentBlockNumber() + 1 :
-                                                               m_params->fromBlock();
+    // fromBlock, restart from the current block if it may be delivered partially
+    auto currentBlockNumber = m_state->currentBlockNumber();
+    if (currentBlockNumber > 0)
+    {
+        jParams["fromBlock"] =
+            m_state->hasLogPosition() ? currentBlockNumber : currentBlockNumber + 1;
+    }
+    else
+    {
+        jParams["fromBlock"] = m_params->fromBlock();
+    }
     // toBlock
     jParams["toBlock"] = m_params->toBlock();
     // addresses
@@ -41,7 +41,8 @@ public:
     void setStatus(int _status) { m_status = _status; }
 
     void setJResp(const Json::Value& _jResp) { m_jResp = _jResp; }
-    Json::Value jResp() const { return m_jResp; }
+    const Json::Value& jResp() const { return m_jResp; }
+    Json::Value& jResp() { return m_jResp; }
 
 public:
     std::string generateJson();
@@ -21,9 +21,14 @@
 #pragma once
 #include <bcos-boostssl/websocket/WsSession.h>
 #include <bcos-cpp-sdk/event/Common.h>
+#include <bcos-cpp-sdk/event/EventLog.h>
+#include <bcos-cpp-sdk/event/EventLogDecoder.h>
+#include <bcos-cpp-sdk/event/EventSubDeliveryQueue.h>
 #include <bcos-cpp-sdk/event/EventSubInterface.h>
 #include <bcos-cpp-sdk/event/EventSubParams.h>
 #include <atomic>
+#include <mutex>
+#include <utility>
 
 namespace bcos
 {
@@ -47,8 +52,62 @@ public:
         }
     }
 
+    // the position of the last log received in the current block, the block may be delivered
+    // partially so the resubscription starts from the current block and the logs not after the
+    // position are skipped
+    bool hasLogPosition() const { return m_hasLogPosition.load(); }
+    int64_t currentTransactionIndex() const
+    {
+        std::lock_guard<std::mutex> lock(x_logPosition);
+        return m_currentTransactionIndex;
+    }
+    int64_t currentLogIndex() const
+    {
+        std::lock_guard<std::mutex> lock(x_logPosition);
+        return m_currentLogIndex;
+    }
+
+    // return false if the log is not after the current position
+    bool advanceLogPosition(int64_t _blockNumber, int64_t _transactionIndex, int64_t _logIndex)
+    {
+        std::lock_guard<std::mutex> lock(x_logPosition);
+        auto currentBlockNumber = m_currentBlockNumber.load();
+        if (_blockNumber < currentBlockNumber)
+        {
+            return false;
+        }
+
+        if (_blockNumber == currentBlockNumber && m_hasLogPosition.load() &&
+            std::make_pair(_transactionIndex, _logIndex) <=
+                std::make_pair(m_currentTransactionIndex, m_currentLogIndex))
+        {
+            return false;
+        }
+
+        m_currentBlockNumber.store(_blockNumber);
+        m_currentTransactionIndex = _transactionIndex;
+        m_currentLogIndex = _logIndex;
+        m_hasLogPosition.store(true);
+        return true;
+    }
+
+    // restore the position from the checkpoint
+    void setLogPosition(int64_t _blockNumber, int64_t _transactionIndex, int64_t _logIndex)
+    {
+        std::lock_guard<std::mutex> lock(x_logPosition);
+        m_currentBlockNumber.store(_blockNumber);
+        m_currentTransactionIndex = _transactionIndex;
+        m_currentLogIndex = _logIndex;
+        m_hasLogPosition.store(true);
+    }
+
 private:
     std::atomic<int64_t> m_currentBlockNumber = -1;
+
+    mutable std::mutex x_logPosition;
+    std::atomic<bool> m_hasLogPosition = false;
+    int64_t m_currentTransactionIndex = -1;
+    int64_t m_currentLogIndex = -1;
 };
 
 class EventSubTask
@@ -80,6 +139,36 @@ public:
     void setCallback(Callback _callback) { m_callback = _callback; }
     Callback callback() const { return m_callback; }
 
+    // the typed event sub, the logs pushed are decoded by the decoder before delivered
+    void setDecoder(EventLogDecoder::ConstPtr _decoder) { m_decoder = _decoder; }
+    EventLogDecoder::ConstPtr decoder() const { return m_decoder; }
+
+    void setLogCallback(EventLogCallback _logCallback) { m_logCallback = _logCallback; }
+    EventLogCallback logCallback() const { return m_logCallback; }
+
+    bool typed() const { return m_decoder != nullptr; }
+
+    // the digest of the params for the checkpoint
+    void setParamsHash(const std::string& _paramsHash) { m_paramsHash = _paramsHash; }
+    std::string paramsHash() const { return m_paramsHash; }
+
+    // the endpoint the event sub is sent to, any endpoint of the group if empty or unavailable
+    void setEndPoint(const std::string& _endPoint) { m_endPoint = _endPoint; }
+    std::string endPoint() const { return m_endPoint; }
+
+    // the pushes are delivered on the receiving thread if no delivery queue
+    void setDeliveryQueue(EventSubDeliveryQueue::Ptr _deliveryQueue)
+    {
+        m_deliveryQueue = _deliveryQueue;
+    }
+    EventSubDeliveryQueue::Ptr deliveryQueue() const { return m_deliveryQueue; }
+
+    // paused for the delivery queue full, the pushes are discarded until resumed
+    bool paused() const { return m_paused.load(); }
+    // return false if paused already
+    bool pause() { return !m_paused.exchange(true); }
+    void resume() { m_paused.store(false); }
+
 private:
     std::string m_id;
     std::string m_group;
@@ -87,6 +176,12 @@ private:
     std::shared_ptr<bcos::boostssl::ws::WsSession> m_session;
     std::shared_ptr<const EventSubParams> m_params;
     std::shared_ptr<EventSubTaskState> m_state;
+    EventLogDecoder::ConstPtr m_decoder;
+    EventLogCallback m_logCallback;
+    std::string m_paramsHash;
+    std::string m_endPoint;
+    EventSubDeliveryQueue::Ptr m_deliveryQueue;
+    std::atomic<bool> m_paused{false};
 };
 
 using EventSubTaskPtrs = std::vector<EventSubTask::Ptr>;
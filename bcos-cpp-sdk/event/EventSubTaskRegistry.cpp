@@ -0,0 +1,289 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventSubTaskRegistry.cpp
+ * @author: octopus
+ * @date 2023-03-22
+ */
+
+#include <bcos-boostssl/websocket/WsSession.h>
+#include <bcos-cpp-sdk/event/EventSubTaskRegistry.h>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::event;
+
+EventSubTaskRegistry::EventSubTaskRegistry(std::size_t _shardCount)
+{
+    auto shardCount = std::max<std::size_t>(_shardCount, 1);
+    m_shards.reserve(shardCount);
+    for (std::size_t i = 0; i < shardCount; ++i)
+    {
+        m_shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+void EventSubTaskRegistry::indexEndPoint(const std::string& _endPoint, const std::string& _id)
+{
+    std::lock_guard<std::mutex> lock(x_endPoints);
+    m_endPoint2Ids[_endPoint].insert(_id);
+}
+
+void EventSubTaskRegistry::unindexEndPoint(const std::string& _endPoint, const std::string& _id)
+{
+    std::lock_guard<std::mutex> lock(x_endPoints);
+    auto it = m_endPoint2Ids.find(_endPoint);
+    if (it == m_endPoint2Ids.end())
+    {
+        return;
+    }
+
+    it->second.erase(_id);
+    if (it->second.empty())
+    {
+        m_endPoint2Ids.erase(it);
+    }
+}
+
+bool EventSubTaskRegistry::addTask(EventSubTask::Ptr _task)
+{
+    auto session = _task->session();
+    return addTask(_task, session ? session->endPoint() : std::string());
+}
+
+bool EventSubTaskRegistry::addTask(EventSubTask::Ptr _task, const std::string& _endPoint)
+{
+    const auto& id = _task->id();
+    auto& s = shard(id);
+
+    boost::unique_lock<boost::shared_mutex> lock(s.x_tasks);
+    if (s.suspendTasks.erase(id) > 0)
+    {
+        m_suspendTasksCount--;
+    }
+
+    auto it = s.workingTasks.find(id);
+    if (it != s.workingTasks.end())
+    {
+        // resubscribed while working, maybe on another session: index it by the new endpoint so
+        // that only the disconnect of the new one suspends it
+        if (it->second.endPoint != _endPoint)
+        {
+            unindexEndPoint(it->second.endPoint, id);
+            indexEndPoint(_endPoint, id);
+            it->second.endPoint = _endPoint;
+        }
+        it->second.task = _task;
+        return false;
+    }
+
+    s.workingTasks.emplace(id, WorkingEntry{_task, _endPoint});
+    indexEndPoint(_endPoint, id);
+    m_workingTasksCount++;
+    return true;
+}
+
+EventSubTask::Ptr EventSubTaskRegistry::getTask(
+    const std::string& _id, bool _includeSuspendTask) const
+{
+    auto& s = shard(_id);
+
+    boost::shared_lock<boost::shared_mutex> lock(s.x_tasks);
+    auto it = s.workingTasks.find(_id);
+    if (it != s.workingTasks.end())
+    {
+        return it->second.task;
+    }
+
+    if (_includeSuspendTask)
+    {
+        auto innerIt = s.suspendTasks.find(_id);
+        if (innerIt != s.suspendTasks.end())
+        {
+            return innerIt->second;
+        }
+    }
+
+    return nullptr;
+}
+
+EventSubTask::Ptr EventSubTaskRegistry::getTaskAndRemove(
+    const std::string& _id, bool _includeSuspendTask)
+{
+    auto& s = shard(_id);
+
+    boost::unique_lock<boost::shared_mutex> lock(s.x_tasks);
+    auto it = s.workingTasks.find(_id);
+    if (it != s.workingTasks.end())
+    {
+        auto task = it->second.task;
+        unindexEndPoint(it->second.endPoint, _id);
+        s.workingTasks.erase(it);
+        m_workingTasksCount--;
+        return task;
+    }
+
+    if (_includeSuspendTask)
+    {
+        auto innerIt = s.suspendTasks.find(_id);
+        if (innerIt != s.suspendTasks.end())
+        {
+            auto task = innerIt->second;
+            s.suspendTasks.erase(innerIt);
+            m_suspendTasksCount--;
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+bool EventSubTaskRegistry::addSuspendTaskUnsafe(Shard& _shard, EventSubTask::Ptr _task)
+{
+    auto r = _shard.suspendTasks.emplace(_task->id(), _task);
+    if (r.second)
+    {
+        m_suspendTasksCount++;
+    }
+    return r.second;
+}
+
+bool EventSubTaskRegistry::addSuspendTask(EventSubTask::Ptr _task)
+{
+    auto& s = shard(_task->id());
+
+    boost::unique_lock<boost::shared_mutex> lock(s.x_tasks);
+    return addSuspendTaskUnsafe(s, _task);
+}
+
+bool EventSubTaskRegistry::removeSuspendTask(const std::string& _id)
+{
+    auto& s = shard(_id);
+
+    boost::unique_lock<boost::shared_mutex> lock(s.x_tasks);
+    if (s.suspendTasks.erase(_id) > 0)
+    {
+        m_suspendTasksCount--;
+        return true;
+    }
+    return false;
+}
+
+bool EventSubTaskRegistry::suspendTask(const std::string& _id)
+{
+    auto& s = shard(_id);
+
+    boost::unique_lock<boost::shared_mutex> lock(s.x_tasks);
+    auto it = s.workingTasks.find(_id);
+    if (it == s.workingTasks.end())
+    {
+        return false;
+    }
+
+    auto task = it->second.task;
+    unindexEndPoint(it->second.endPoint, _id);
+    s.workingTasks.erase(it);
+    m_workingTasksCount--;
+    addSuspendTaskUnsafe(s, task);
+    return true;
+}
+
+std::vector<EventSubTask::Ptr> EventSubTaskRegistry::suspendTasks(const std::string& _endPoint)
+{
+    std::vector<std::string> ids;
+    {
+        std::lock_guard<std::mutex> lock(x_endPoints);
+        for (const auto& endPoint : {_endPoint, std::string()})
+        {
+            auto it = m_endPoint2Ids.find(endPoint);
+            if (it != m_endPoint2Ids.end())
+            {
+                ids.insert(ids.end(), it->second.begin(), it->second.end());
+            }
+        }
+    }
+
+    std::vector<EventSubTask::Ptr> tasks;
+    tasks.reserve(ids.size());
+    for (const auto& id : ids)
+    {
+        auto& s = shard(id);
+
+        boost::unique_lock<boost::shared_mutex> lock(s.x_tasks);
+        auto it = s.workingTasks.find(id);
+        // re-added on another session since indexed
+        if (it == s.workingTasks.end() ||
+            (it->second.endPoint != _endPoint && !it->second.endPoint.empty()))
+        {
+            continue;
+        }
+
+        auto task = it->second.task;
+        unindexEndPoint(it->second.endPoint, id);
+        s.workingTasks.erase(it);
+        m_workingTasksCount--;
+        addSuspendTaskUnsafe(s, task);
+        tasks.push_back(task);
+    }
+
+    return tasks;
+}
+
+std::vector<EventSubTask::Ptr> EventSubTaskRegistry::suspendTasksSnapshot(std::size_t _limit) const
+{
+    std::vector<EventSubTask::Ptr> tasks;
+    for (const auto& s : m_shards)
+    {
+        boost::shared_lock<boost::shared_mutex> lock(s->x_tasks);
+        for (const auto& taskEntry : s->suspendTasks)
+        {
+            if (tasks.size() >= _limit)
+            {
+                return tasks;
+            }
+            tasks.push_back(taskEntry.second);
+        }
+    }
+    return tasks;
+}
+
+std::vector<EventSubTask::Ptr> EventSubTaskRegistry::workingTasksSnapshot() const
+{
+    std::vector<EventSubTask::Ptr> tasks;
+    tasks.reserve(m_workingTasksCount.load());
+    for (const auto& s : m_shards)
+    {
+        boost::shared_lock<boost::shared_mutex> lock(s->x_tasks);
+        for (const auto& taskEntry : s->workingTasks)
+        {
+            tasks.push_back(taskEntry.second.task);
+        }
+    }
+    return tasks;
+}
+
+bool EventSubTaskRegistry::addWaitResp(const std::string& _id)
+{
+    auto& s = shard(_id);
+    std::lock_guard<std::mutex> lock(s.x_waitResp);
+    return s.waitResp.insert(_id).second;
+}
+
+bool EventSubTaskRegistry::removeWaitResp(const std::string& _id)
+{
+    auto& s = shard(_id);
+    std::lock_guard<std::mutex> lock(s.x_waitResp);
+    return s.waitResp.erase(_id) > 0;
+}
@@ -0,0 +1,121 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventSubTaskRegistry.h
+ * @author: octopus
+ * @date 2023-03-22
+ */
+
+#pragma once
+#include <bcos-cpp-sdk/event/EventSubTask.h>
+#include <boost/thread/thread.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace event
+{
+/**
+ * @brief the working and suspend event sub tasks sharded by id, the lookups of the pushes only
+ * take the read lock of one shard, the working tasks are also indexed by the endpoint of their
+ * session so that the tasks of a disconnected session are found without a full scan
+ */
+class EventSubTaskRegistry
+{
+public:
+    using Ptr = std::shared_ptr<EventSubTaskRegistry>;
+    using ConstPtr = std::shared_ptr<const EventSubTaskRegistry>;
+
+    explicit EventSubTaskRegistry(std::size_t _shardCount = 32);
+
+public:
+    // add the working task indexed by the endpoint of its session, the suspend task of the same
+    // id is removed, return false if the task is working already, it is reindexed by the endpoint
+    // then
+    bool addTask(EventSubTask::Ptr _task);
+    bool addTask(EventSubTask::Ptr _task, const std::string& _endPoint);
+    EventSubTask::Ptr getTask(const std::string& _id, bool _includeSuspendTask = true) const;
+    EventSubTask::Ptr getTaskAndRemove(const std::string& _id, bool _includeSuspendTask = true);
+
+    bool addSuspendTask(EventSubTask::Ptr _task);
+    bool removeSuspendTask(const std::string& _id);
+
+    // move the working task to the suspend tasks, return false if the task is not working
+    bool suspendTask(const std::string& _id);
+    // move the working tasks of the endpoint and the tasks without session to the suspend tasks
+    std::vector<EventSubTask::Ptr> suspendTasks(const std::string& _endPoint);
+
+    // the suspend tasks, at most _limit
+    std::vector<EventSubTask::Ptr> suspendTasksSnapshot(std::size_t _limit = SIZE_MAX) const;
+    std::vector<EventSubTask::Ptr> workingTasksSnapshot() const;
+
+    bool addWaitResp(const std::string& _id);
+    bool removeWaitResp(const std::string& _id);
+
+    std::size_t workingTasksCount() const { return m_workingTasksCount.load(); }
+    std::size_t suspendTasksCount() const { return m_suspendTasksCount.load(); }
+    std::size_t shardCount() const { return m_shards.size(); }
+
+private:
+    struct WorkingEntry
+    {
+        EventSubTask::Ptr task;
+        // the endpoint the task indexed by
+        std::string endPoint;
+    };
+
+    struct Shard
+    {
+        mutable boost::shared_mutex x_tasks;
+        std::unordered_map<std::string, WorkingEntry> workingTasks;
+        std::unordered_map<std::string, EventSubTask::Ptr> suspendTasks;
+
+        mutable std::mutex x_waitResp;
+        std::unordered_set<std::string> waitResp;
+    };
+
+    Shard& shard(const std::string& _id) const
+    {
+        return *m_shards[std::hash<std::string>{}(_id) % m_shards.size()];
+    }
+
+    // NOTE: called with the lock of the shard of the task
+    void indexEndPoint(const std::string& _endPoint, const std::string& _id);
+    void unindexEndPoint(const std::string& _endPoint, const std::string& _id);
+    bool addSuspendTaskUnsafe(Shard& _shard, EventSubTask::Ptr _task);
+
+private:
+    std::vector<std::unique_ptr<Shard>> m_shards;
+
+    // the lock order: the shard of the task, then x_endPoints
+    mutable std::mutex x_endPoints;
+    // endpoint => ids of the working tasks, "" for the tasks without session
+    std::unordered_map<std::string, std::unordered_set<std::string>> m_endPoint2Ids;
+
+    std::atomic<std::size_t> m_workingTasksCount{0};
+    std::atomic<std::size_t> m_suspendTasksCount{0};
+};
+}  // namespace event
+}  // namespace cppsdk
+}  // namespace bcos
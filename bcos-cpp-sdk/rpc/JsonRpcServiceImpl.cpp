@@ -21,11 +21,27 @@
 #include <bcos-cpp-sdk/rpc/JsonRpcServiceImpl.h>
 #include <bcos-utilities/BoostLog.h>
 #include <bcos-utilities/Error.h>
+#include <algorithm>
+#include <exception>
+#include <thread>
 
 using namespace bcos;
 using namespace bcos::cppsdk;
 using namespace bcos::cppsdk::jsonrpc;
 
+JsonRpcServiceImpl::~JsonRpcServiceImpl()
+{
+    auto pipeline = m_asyncPipeline;
+    if (!pipeline)
+    {
+        return;
+    }
+
+    // the transactions not signed fail, the ones signing are sent
+    pipeline->stop();
+    pipeline->signer->stop();
+}
+
 std::string JsonRpcServiceImpl::sendTransaction(const bcos::crypto::KeyPairInterface& _keyPair,
     const std::string& _groupID, const std::string& _nodeName, const std::string& _to,
     bcos::bytes&& _data, std::string _abi, int32_t _attribute, std::string _extraData,
@@ -66,3 +82,224 @@ std::string JsonRpcServiceImpl::sendTransaction(const bcos::crypto::KeyPairInter
     m_rpc->sendTransaction(_groupID, _nodeName, signedTransaction, false, std::move(_respFunc));
     return transactionHash;
 }
+
+std::future<std::string> JsonRpcServiceImpl::asyncSendTransaction(
+    bcos::crypto::KeyPairInterface::Ptr _keyPair, const std::string& _groupID,
+    const std::string& _nodeName, const std::string& _to, bcos::bytes&& _data, std::string _abi,
+    int32_t _attribute, std::string _extraData, RespFunc _respFunc)
+{
+    auto promise = std::make_shared<std::promise<std::string>>();
+    auto future = promise->get_future();
+
+    auto groupInfo = m_rpc->service()->getGroupInfo(_groupID);
+    if (!groupInfo)
+    {
+        BCOS_LOG(TRACE) << LOG_BADGE("JsonRpcServiceImpl::asyncSendTransaction")
+                        << LOG_DESC("group not exist") << LOG_KV("groupID", _groupID);
+        auto error = std::make_shared<Error>(-1, "group not exist, groupID: " + _groupID);
+        _respFunc(std::move(error), nullptr);
+        promise->set_value(std::string(""));
+        return future;
+    }
+
+    auto pipeline = asyncPipeline();
+    std::weak_ptr<AsyncPipeline> weakPipeline = pipeline;
+    AsyncPipeline::Task task;
+    task.fail = [promise, respFunc = _respFunc](bcos::Error::Ptr _error) {
+        respFunc(std::move(_error), nullptr);
+        promise->set_value(std::string(""));
+    };
+    task.run = [weakPipeline, promise, rpc = m_rpc, builder = m_transactionBuilder,
+                   keyPair = std::move(_keyPair), groupID = _groupID,
+                   chainID = groupInfo->chainID(), nodeName = _nodeName, to = _to,
+                   data = std::move(_data), abi = std::move(_abi), _attribute,
+                   extraData = std::move(_extraData), respFunc = _respFunc]() mutable {
+        auto pipeline = weakPipeline.lock();
+        if (!pipeline)
+        {
+            return;
+        }
+        int64_t blockLimit = 0;
+        std::pair<std::string, std::string> result;
+        try
+        {
+            rpc->service()->getBlockLimit(groupID, blockLimit);
+            result = builder->createSignedTransaction(
+                *keyPair, groupID, chainID, to, data, abi, blockLimit, _attribute, extraData);
+        }
+        catch (const std::exception& e)
+        {
+            BCOS_LOG(WARNING) << LOG_BADGE("JsonRpcServiceImpl::asyncSendTransaction")
+                              << LOG_DESC("sign transaction failed") << LOG_KV("groupID", groupID)
+                              << LOG_KV("error", e.what());
+            pipeline->release();
+            promise->set_exception(std::current_exception());
+            respFunc(std::make_shared<Error>(
+                         -1, "sign transaction failed, error: " + std::string(e.what())),
+                nullptr);
+            return;
+        }
+
+        if (c_fileLogLevel <= LogLevel::TRACE)
+        {
+            BCOS_LOG(TRACE) << LOG_BADGE("JsonRpcServiceImpl::asyncSendTransaction")
+                            << LOG_KV("groupID", groupID) << LOG_KV("nodeName", nodeName)
+                            << LOG_KV("to", to) << LOG_KV("blockLimit", blockLimit)
+                            << LOG_KV("transactionHash", result.first);
+        }
+
+        promise->set_value(result.first);
+        rpc->sendTransaction(groupID, nodeName, result.second, false,
+            [pipeline, respFunc = std::move(respFunc)](
+                bcos::Error::Ptr _error, std::shared_ptr<bcos::bytes> _resp) {
+                pipeline->release();
+                respFunc(std::move(_error), std::move(_resp));
+            });
+    };
+
+    auto error = pipeline->submit(std::move(task));
+    if (error)
+    {
+        BCOS_LOG(TRACE) << LOG_BADGE("JsonRpcServiceImpl::asyncSendTransaction")
+                        << LOG_DESC("transaction not queued") << LOG_KV("groupID", _groupID)
+                        << LOG_KV("error", error->errorMessage());
+        _respFunc(std::move(error), nullptr);
+        promise->set_value(std::string(""));
+    }
+    return future;
+}
+
+void JsonRpcServiceImpl::setAsyncSettings(const AsyncSettings& _settings)
+{
+    std::lock_guard<std::mutex> lock(x_asyncPipeline);
+    m_asyncSettings = _settings;
+    if (m_asyncPipeline)
+    {
+        std::lock_guard<std::mutex> inFlightLock(m_asyncPipeline->x_inFlight);
+        m_asyncPipeline->maxInFlight = std::max<std::size_t>(_settings.maxInFlight, 1);
+        m_asyncPipeline->maxQueued = _settings.maxQueued;
+        m_asyncPipeline->scheduleUnsafe();
+    }
+}
+
+JsonRpcServiceImpl::AsyncSettings JsonRpcServiceImpl::asyncSettings() const
+{
+    std::lock_guard<std::mutex> lock(x_asyncPipeline);
+    return m_asyncSettings;
+}
+
+std::size_t JsonRpcServiceImpl::inFlight() const
+{
+    std::lock_guard<std::mutex> lock(x_asyncPipeline);
+    if (!m_asyncPipeline)
+    {
+        return 0;
+    }
+    std::lock_guard<std::mutex> inFlightLock(m_asyncPipeline->x_inFlight);
+    return m_asyncPipeline->inFlight;
+}
+
+std::size_t JsonRpcServiceImpl::queued() const
+{
+    std::lock_guard<std::mutex> lock(x_asyncPipeline);
+    if (!m_asyncPipeline)
+    {
+        return 0;
+    }
+    std::lock_guard<std::mutex> inFlightLock(m_asyncPipeline->x_inFlight);
+    return m_asyncPipeline->queued.size();
+}
+
+JsonRpcServiceImpl::AsyncPipeline::Ptr JsonRpcServiceImpl::asyncPipeline()
+{
+    std::lock_guard<std::mutex> lock(x_asyncPipeline);
+    if (m_asyncPipeline)
+    {
+        return m_asyncPipeline;
+    }
+
+    auto threadCount = m_asyncSettings.signThreadCount;
+    if (threadCount == 0)
+    {
+        threadCount = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    m_asyncPipeline = std::make_shared<AsyncPipeline>();
+    m_asyncPipeline->signer = std::make_shared<bcos::ThreadPool>("t_tx_sign", threadCount);
+    m_asyncPipeline->maxInFlight = std::max<std::size_t>(m_asyncSettings.maxInFlight, 1);
+    m_asyncPipeline->maxQueued = m_asyncSettings.maxQueued;
+
+    BCOS_LOG(INFO) << LOG_BADGE("JsonRpcServiceImpl::asyncSendTransaction")
+                   << LOG_DESC("create signing pool") << LOG_KV("signThreadCount", threadCount)
+                   << LOG_KV("maxInFlight", m_asyncPipeline->maxInFlight)
+                   << LOG_KV("maxQueued", m_asyncPipeline->maxQueued);
+    return m_asyncPipeline;
+}
+
+bcos::Error::Ptr JsonRpcServiceImpl::AsyncPipeline::submit(Task _task)
+{
+    std::lock_guard<std::mutex> lock(x_inFlight);
+    if (stopped)
+    {
+        return std::make_shared<Error>(-1, "json rpc service stopped");
+    }
+    if (queued.size() >= maxQueued)
+    {
+        return std::make_shared<Error>(-1, "async send pipeline full");
+    }
+    queued.push_back(std::move(_task));
+    scheduleUnsafe();
+    return nullptr;
+}
+
+void JsonRpcServiceImpl::AsyncPipeline::release()
+{
+    std::lock_guard<std::mutex> lock(x_inFlight);
+    inFlight--;
+    scheduleUnsafe();
+}
+
+void JsonRpcServiceImpl::AsyncPipeline::stop()
+{
+    std::deque<Task> tasks;
+    {
+        std::lock_guard<std::mutex> lock(x_inFlight);
+        stopped = true;
+        tasks.swap(queued);
+    }
+
+    for (auto& task : tasks)
+    {
+        task.fail(std::make_shared<Error>(-1, "json rpc service stopped"));
+    }
+}
+
+void JsonRpcServiceImpl::AsyncPipeline::scheduleUnsafe()
+{
+    // one signing task per slot, the task run is taken from the queue when started so that the
+    // tasks are signed in order and the ones not started are failed by stop()
+    auto self = shared_from_this();
+    while (!stopped && inFlight < maxInFlight && scheduled < queued.size())
+    {
+        inFlight++;
+        scheduled++;
+        signer->enqueue([self]() { self->runNext(); });
+    }
+}
+
+void JsonRpcServiceImpl::AsyncPipeline::runNext()
+{
+    Task task;
+    {
+        std::lock_guard<std::mutex> lock(x_inFlight);
+        scheduled--;
+        if (queued.empty())
+        {
+            // failed by stop()
+            inFlight--;
+            return;
+        }
+        task = std::move(queued.front());
+        queued.pop_front();
+    }
+    task.run();
+}
@@ -25,7 +25,12 @@
 #include <bcos-cpp-sdk/ws/Service.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/Error.h>
+#include <bcos-utilities/ThreadPool.h>
+#include <cstddef>
+#include <deque>
 #include <functional>
+#include <future>
+#include <mutex>
 
 namespace bcos
 {
@@ -40,11 +45,21 @@ public:
     using Ptr = std::shared_ptr<JsonRpcServiceImpl>;
     using UniquePtr = std::unique_ptr<JsonRpcServiceImpl>;
 
+    struct AsyncSettings
+    {
+        // the threads signing the transactions, 0 for the hardware concurrency
+        std::size_t signThreadCount = 0;
+        // the transactions signing or sent without response, the others are queued
+        std::size_t maxInFlight = 10000;
+        // the transactions waiting to be signed, the others fail with the pipeline full
+        std::size_t maxQueued = 100000;
+    };
+
     JsonRpcServiceImpl(std::shared_ptr<bcos::cppsdk::jsonrpc::JsonRpcImpl> _rpc,
         utilities::TransactionBuilderInterface::Ptr _transactionBuilder)
       : m_rpc(_rpc), m_transactionBuilder(_transactionBuilder)
     {}
-    virtual ~JsonRpcServiceImpl() override {}
+    virtual ~JsonRpcServiceImpl() override;
 
 public:
     virtual std::string sendTransaction(const bcos::crypto::KeyPairInterface& _keyPair,
@@ -52,6 +67,36 @@ public:
         bcos::bytes&& _data, std::string _abi, int32_t _attribute, std::string _extraData,
         RespFunc _respFunc) override;
 
+    /**
+     * @brief sign the transaction on the signing pool and send it once signed, never blocks the
+     * caller: the transactions beyond maxInFlight are queued and signed in order, beyond maxQueued
+     * or after the service destroyed the response callback gets the error at once
+     *
+     * @param _keyPair
+     * @param _groupID
+     * @param _nodeName
+     * @param _to
+     * @param _data
+     * @param _abi
+     * @param _attribute
+     * @param _extraData
+     * @param _respFunc
+     * @return std::future<std::string> the transaction hash once signed, empty if the group not
+     * exist or the transaction not queued, the exception thrown if the signing failed
+     */
+    std::future<std::string> asyncSendTransaction(bcos::crypto::KeyPairInterface::Ptr _keyPair,
+        const std::string& _groupID, const std::string& _nodeName, const std::string& _to,
+        bcos::bytes&& _data, std::string _abi, int32_t _attribute, std::string _extraData,
+        RespFunc _respFunc);
+
+    // NOTE: the signing threads are created by the first asyncSendTransaction with the settings
+    void setAsyncSettings(const AsyncSettings& _settings);
+    AsyncSettings asyncSettings() const;
+    // the transactions signing or sent without response
+    std::size_t inFlight() const;
+    // the transactions waiting to be signed
+    std::size_t queued() const;
+
 public:
     std::shared_ptr<bcos::cppsdk::jsonrpc::JsonRpcImpl> rpc() const { return m_rpc; }
     utilities::TransactionBuilderInterface::Ptr transactionBuilder() const
@@ -59,9 +104,50 @@ public:
         return m_transactionBuilder;
     }
 
+private:
+    // shared with the signing tasks and the response callbacks
+    struct AsyncPipeline : public std::enable_shared_from_this<AsyncPipeline>
+    {
+        using Ptr = std::shared_ptr<AsyncPipeline>;
+        struct Task
+        {
+            // sign and send, release() once responded
+            std::function<void()> run;
+            // the task dropped without run
+            std::function<void(bcos::Error::Ptr)> fail;
+        };
+
+        std::shared_ptr<bcos::ThreadPool> signer;
+        mutable std::mutex x_inFlight;
+        std::deque<Task> queued;
+        // the tasks in flight include the ones scheduled on the signer and not started
+        std::size_t scheduled = 0;
+        std::size_t inFlight = 0;
+        std::size_t maxInFlight = 0;
+        std::size_t maxQueued = 0;
+        bool stopped = false;
+
+        // the error if stopped or full, the task is not run then
+        bcos::Error::Ptr submit(Task _task);
+        void release();
+        // the tasks queued fail
+        void stop();
+        // NOTE: called with x_inFlight held
+        void scheduleUnsafe();
+
+    private:
+        void runNext();
+    };
+
+    AsyncPipeline::Ptr asyncPipeline();
+
 private:
     std::shared_ptr<bcos::cppsdk::jsonrpc::JsonRpcImpl> m_rpc;
     utilities::TransactionBuilderInterface::Ptr m_transactionBuilder;
+
+    mutable std::mutex x_asyncPipeline;
+    AsyncSettings m_asyncSettings;
+    AsyncPipeline::Ptr m_asyncPipeline;
 };
 
 
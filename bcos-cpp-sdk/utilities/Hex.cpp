@@ -0,0 +1,277 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file Hex.cpp
+ * @author: octopus
+ * @date 2023-04-10
+ */
+#include <bcos-cpp-sdk/utilities/Hex.h>
+#include <array>
+#include <cstdint>
+
+// the SIMD kernels are built with the target attributes and selected by cpuid, the library is
+// not required to be built with -mavx2
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BCOS_HEX_X86 1
+#include <immintrin.h>
+#else
+#define BCOS_HEX_X86 0
+#endif
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::utilities;
+
+namespace
+{
+constexpr char c_hexChars[] = "0123456789abcdef";
+
+// the value of a hex char, -1 for the others
+constexpr std::array<int8_t, 256> c_hexValues = []() {
+    std::array<int8_t, 256> values{};
+    for (auto& value : values)
+    {
+        value = -1;
+    }
+    for (int i = 0; i < 10; ++i)
+    {
+        values['0' + i] = (int8_t)i;
+    }
+    for (int i = 0; i < 6; ++i)
+    {
+        values['a' + i] = (int8_t)(10 + i);
+        values['A' + i] = (int8_t)(10 + i);
+    }
+    return values;
+}();
+
+void encodeScalar(const bcos::byte* _data, std::size_t _size, char* _out)
+{
+    for (std::size_t i = 0; i < _size; ++i)
+    {
+        _out[2 * i] = c_hexChars[_data[i] >> 4];
+        _out[2 * i + 1] = c_hexChars[_data[i] & 0x0f];
+    }
+}
+
+bool decodeScalar(const char* _hex, std::size_t _size, bcos::byte* _out)
+{
+    for (std::size_t i = 0; i < _size / 2; ++i)
+    {
+        auto high = c_hexValues[(uint8_t)_hex[2 * i]];
+        auto low = c_hexValues[(uint8_t)_hex[2 * i + 1]];
+        if ((high | low) < 0)
+        {
+            return false;
+        }
+        _out[i] = (bcos::byte)((high << 4) | low);
+    }
+    return true;
+}
+
+#if BCOS_HEX_X86
+// 16 bytes into 32 chars a round, the nibbles are mapped to the chars by pshufb
+__attribute__((target("sse4.1"))) void encodeSSE41(
+    const bcos::byte* _data, std::size_t _size, char* _out)
+{
+    const __m128i table = _mm_setr_epi8(
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    std::size_t i = 0;
+    for (; i + 16 <= _size; i += 16)
+    {
+        __m128i input = _mm_loadu_si128((const __m128i*)(_data + i));
+        __m128i high = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(input, 4), mask));
+        __m128i low = _mm_shuffle_epi8(table, _mm_and_si128(input, mask));
+        _mm_storeu_si128((__m128i*)(_out + 2 * i), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128((__m128i*)(_out + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+    }
+    encodeScalar(_data + i, _size - i, _out + 2 * i);
+}
+
+// the values of 16 hex chars, _valid is the bit mask of the hex chars
+__attribute__((target("sse4.1"))) __m128i decodeNibblesSSE41(__m128i _chars, int& _valid)
+{
+    const __m128i minusOne = _mm_set1_epi8(-1);
+    const __m128i ten = _mm_set1_epi8(10);
+    __m128i digit = _mm_sub_epi8(_chars, _mm_set1_epi8('0'));
+    __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(digit, minusOne), _mm_cmpgt_epi8(ten, digit));
+    // 'A'-'F' to 'a'-'f', the other chars are not mapped into 'a'-'f'
+    __m128i letter =
+        _mm_sub_epi8(_mm_or_si128(_chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i isLetter = _mm_and_si128(
+        _mm_cmpgt_epi8(letter, minusOne), _mm_cmpgt_epi8(_mm_set1_epi8(6), letter));
+    _valid = _mm_movemask_epi8(_mm_or_si128(isDigit, isLetter));
+    return _mm_or_si128(
+        _mm_and_si128(isDigit, digit), _mm_and_si128(isLetter, _mm_add_epi8(letter, ten)));
+}
+
+// 32 chars into 16 bytes a round, the nibble pairs are joined by pmaddubsw
+__attribute__((target("sse4.1"))) bool decodeSSE41(
+    const char* _hex, std::size_t _size, bcos::byte* _out)
+{
+    // high * 16 + low
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    std::size_t i = 0;
+    for (; i + 32 <= _size; i += 32)
+    {
+        int validFirst = 0;
+        int validSecond = 0;
+        __m128i first =
+            decodeNibblesSSE41(_mm_loadu_si128((const __m128i*)(_hex + i)), validFirst);
+        __m128i second =
+            decodeNibblesSSE41(_mm_loadu_si128((const __m128i*)(_hex + i + 16)), validSecond);
+        if ((validFirst & validSecond) != 0xffff)
+        {
+            return false;
+        }
+        _mm_storeu_si128((__m128i*)(_out + i / 2),
+            _mm_packus_epi16(
+                _mm_maddubs_epi16(first, weights), _mm_maddubs_epi16(second, weights)));
+    }
+    return decodeScalar(_hex + i, _size - i, _out + i / 2);
+}
+
+// 32 bytes into 64 chars a round
+__attribute__((target("avx2"))) void encodeAVX2(
+    const bcos::byte* _data, std::size_t _size, char* _out)
+{
+    const __m256i table = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a',
+        'b', 'c', 'd', 'e', 'f', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c',
+        'd', 'e', 'f');
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+    std::size_t i = 0;
+    for (; i + 32 <= _size; i += 32)
+    {
+        __m256i input = _mm256_loadu_si256((const __m256i*)(_data + i));
+        __m256i high =
+            _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(input, 4), mask));
+        __m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(input, mask));
+        // unpack works in the 128 bits lanes, the lanes are put back in order
+        __m256i first = _mm256_unpacklo_epi8(high, low);
+        __m256i second = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256(
+            (__m256i*)(_out + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(
+            (__m256i*)(_out + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    encodeSSE41(_data + i, _size - i, _out + 2 * i);
+}
+
+__attribute__((target("avx2"))) __m256i decodeNibblesAVX2(__m256i _chars, int& _valid)
+{
+    const __m256i minusOne = _mm256_set1_epi8(-1);
+    const __m256i ten = _mm256_set1_epi8(10);
+    __m256i digit = _mm256_sub_epi8(_chars, _mm256_set1_epi8('0'));
+    __m256i isDigit =
+        _mm256_and_si256(_mm256_cmpgt_epi8(digit, minusOne), _mm256_cmpgt_epi8(ten, digit));
+    __m256i letter =
+        _mm256_sub_epi8(_mm256_or_si256(_chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    __m256i isLetter = _mm256_and_si256(
+        _mm256_cmpgt_epi8(letter, minusOne), _mm256_cmpgt_epi8(_mm256_set1_epi8(6), letter));
+    _valid = _mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter));
+    return _mm256_or_si256(_mm256_and_si256(isDigit, digit),
+        _mm256_and_si256(isLetter, _mm256_add_epi8(letter, ten)));
+}
+
+// 64 chars into 32 bytes a round
+__attribute__((target("avx2"))) bool decodeAVX2(
+    const char* _hex, std::size_t _size, bcos::byte* _out)
+{
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+    std::size_t i = 0;
+    for (; i + 64 <= _size; i += 64)
+    {
+        int validFirst = 0;
+        int validSecond = 0;
+        __m256i first =
+            decodeNibblesAVX2(_mm256_loadu_si256((const __m256i*)(_hex + i)), validFirst);
+        __m256i second =
+            decodeNibblesAVX2(_mm256_loadu_si256((const __m256i*)(_hex + i + 32)), validSecond);
+        if ((validFirst & validSecond) != -1)
+        {
+            return false;
+        }
+        // pack works in the 128 bits lanes, the 64 bits quarters are put back in order
+        __m256i packed = _mm256_packus_epi16(
+            _mm256_maddubs_epi16(first, weights), _mm256_maddubs_epi16(second, weights));
+        _mm256_storeu_si256((__m256i*)(_out + i / 2), _mm256_permute4x64_epi64(packed, 0xd8));
+    }
+    return decodeSSE41(_hex + i, _size - i, _out + i / 2);
+}
+#endif
+
+std::string_view stripHexPrefix(std::string_view _hex)
+{
+    if (_hex.size() >= 2 && _hex[0] == '0' && (_hex[1] == 'x' || _hex[1] == 'X'))
+    {
+        _hex.remove_prefix(2);
+    }
+    return _hex;
+}
+}  // namespace
+
+const std::vector<HexKernel>& bcos::cppsdk::utilities::supportedHexKernels()
+{
+    static const std::vector<HexKernel> kernels = []() {
+        std::vector<HexKernel> kernels{{"scalar", encodeScalar, decodeScalar}};
+#if BCOS_HEX_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse4.1"))
+        {
+            kernels.push_back({"sse4.1", encodeSSE41, decodeSSE41});
+        }
+        if (__builtin_cpu_supports("avx2"))
+        {
+            kernels.push_back({"avx2", encodeAVX2, decodeAVX2});
+        }
+#endif
+        return kernels;
+    }();
+    return kernels;
+}
+
+const HexKernel& bcos::cppsdk::utilities::hexKernel()
+{
+    static const HexKernel kernel = supportedHexKernels().back();
+    return kernel;
+}
+
+void bcos::cppsdk::utilities::hexEncode(
+    const bcos::byte* _data, std::size_t _size, char* _out) noexcept
+{
+    hexKernel().encode(_data, _size, _out);
+}
+
+std::size_t bcos::cppsdk::utilities::hexDecodedSize(std::string_view _hex) noexcept
+{
+    return (stripHexPrefix(_hex).size() + 1) / 2;
+}
+
+bool bcos::cppsdk::utilities::hexDecode(std::string_view _hex, bcos::byte* _out) noexcept
+{
+    _hex = stripHexPrefix(_hex);
+    if (_hex.size() % 2 != 0)
+    {
+        auto value = c_hexValues[(uint8_t)_hex[0]];
+        if (value < 0)
+        {
+            return false;
+        }
+        *_out++ = (bcos::byte)value;
+        _hex.remove_prefix(1);
+    }
+    return hexKernel().decode(_hex.data(), _hex.size(), _out);
+}
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief hex encode and decode with the SIMD kernels selected at runtime
+ * @file Hex.h
+ * @author: octopus
+ * @date 2023-04-10
+ */
+#pragma once
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/Exceptions.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace utilities
+{
+DERIVE_BCOS_EXCEPTION(InvalidHexString);
+
+// encode _size bytes into 2 * _size lowercase hex chars
+using HexEncodeFunc = void (*)(const bcos::byte* _data, std::size_t _size, char* _out);
+// decode an even number of hex chars into _size / 2 bytes, false if a char is not hex
+using HexDecodeFunc = bool (*)(const char* _hex, std::size_t _size, bcos::byte* _out);
+
+struct HexKernel
+{
+    const char* name;
+    HexEncodeFunc encode;
+    HexDecodeFunc decode;
+};
+
+// the kernels supported by the cpu, from the scalar one to the fastest one
+const std::vector<HexKernel>& supportedHexKernels();
+// the fastest kernel supported by the cpu
+const HexKernel& hexKernel();
+
+/**
+ * @brief encode _size bytes into _out, _out must hold 2 * _size chars
+ */
+void hexEncode(const bcos::byte* _data, std::size_t _size, char* _out) noexcept;
+
+/**
+ * @brief append the lowercase hex of _data to _out
+ *
+ * @param _data bytes, bytesConstRef, FixedBytes, or any container of byte sized elements
+ * @param _out
+ * @param _withPrefix prepend 0x
+ */
+template <typename T>
+void hexEncodeAppend(const T& _data, std::string& _out, bool _withPrefix = false)
+{
+    static_assert(sizeof(*_data.data()) == 1, "hex encode a container of byte sized elements");
+    // FixedBytes has no size()
+    std::size_t size = _data.end() - _data.begin();
+    auto offset = _out.size();
+    _out.resize(offset + (_withPrefix ? 2 : 0) + size * 2);
+    auto* out = _out.data() + offset;
+    if (_withPrefix)
+    {
+        *out++ = '0';
+        *out++ = 'x';
+    }
+    hexEncode((const bcos::byte*)_data.data(), size, out);
+}
+
+template <typename T>
+std::string hexEncode(const T& _data, bool _withPrefix = false)
+{
+    std::string out;
+    hexEncodeAppend(_data, out, _withPrefix);
+    return out;
+}
+
+// the number of the bytes of _hex with or without the 0x prefix
+std::size_t hexDecodedSize(std::string_view _hex) noexcept;
+
+/**
+ * @brief decode _hex with or without the 0x prefix into _out, _out must hold
+ * hexDecodedSize(_hex) bytes, an odd leading char is decoded as a byte
+ *
+ * @return false if _hex is not a hex string
+ */
+bool hexDecode(std::string_view _hex, bcos::byte* _out) noexcept;
+
+/**
+ * @brief append the bytes of _hex to _out, throw InvalidHexString if _hex is not a hex string
+ *
+ * @param _hex
+ * @param _out bytes, std::string, or any resizable container of byte sized elements
+ */
+template <typename T>
+void hexDecodeAppend(std::string_view _hex, T& _out)
+{
+    static_assert(sizeof(*_out.data()) == 1, "hex decode into a container of byte sized elements");
+    auto offset = _out.size();
+    _out.resize(offset + hexDecodedSize(_hex));
+    if (!hexDecode(_hex, (bcos::byte*)_out.data() + offset))
+    {
+        _out.resize(offset);
+        BOOST_THROW_EXCEPTION(InvalidHexString() << errinfo_comment(
+                                  "invalid hex string: " + std::string(_hex.substr(0, 64))));
+    }
+}
+
+inline bcos::bytes hexDecode(std::string_view _hex)
+{
+    bcos::bytes out;
+    hexDecodeAppend(_hex, out);
+    return out;
+}
+}  // namespace utilities
+}  // namespace cppsdk
+}  // namespace bcos
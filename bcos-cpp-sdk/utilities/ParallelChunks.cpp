@@ -0,0 +1,93 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file ParallelChunks.cpp
+ * @author: octopus
+ * @date 2023-04-14
+ */
+#include <bcos-cpp-sdk/utilities/ParallelChunks.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::utilities;
+
+void bcos::cppsdk::utilities::parallelChunks(std::size_t _count, std::size_t _chunkSize,
+    std::size_t _threadCount, const ChunkThreadInit& _threadInit)
+{
+    if (_count == 0)
+    {
+        return;
+    }
+    _chunkSize = std::max<std::size_t>(_chunkSize, 1);
+    if (_threadCount == 0)
+    {
+        _threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    _threadCount = std::min(_threadCount, (_count + _chunkSize - 1) / _chunkSize);
+
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex x_error;
+    auto worker = [_count, _chunkSize, &_threadInit, &next, &error, &x_error]() {
+        try
+        {
+            auto f = _threadInit();
+            std::size_t begin = 0;
+            while ((begin = next.fetch_add(_chunkSize)) < _count)
+            {
+                f(begin, std::min(begin + _chunkSize, _count));
+            }
+        }
+        catch (...)
+        {
+            // stop the other threads claiming the rest
+            next = _count;
+            std::lock_guard<std::mutex> l(x_error);
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(_threadCount - 1);
+    for (std::size_t i = 1; i < _threadCount; ++i)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+void bcos::cppsdk::utilities::parallelChunks(
+    std::size_t _count, std::size_t _chunkSize, std::size_t _threadCount, const ChunkFunc& _f)
+{
+    parallelChunks(_count, _chunkSize, _threadCount, ChunkThreadInit([&_f]() { return _f; }));
+}
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief run a function on the chunks of a range by the threads claiming them
+ * @file ParallelChunks.h
+ * @author: octopus
+ * @date 2023-04-14
+ */
+#pragma once
+#include <cstddef>
+#include <functional>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace utilities
+{
+// called with the begin and the end of a chunk
+using ChunkFunc = std::function<void(std::size_t _begin, std::size_t _end)>;
+// called once on each thread before it claims the chunks, e.g. to acquire a session kept by the
+// thread, returns the func of the chunks claimed by the thread
+using ChunkThreadInit = std::function<ChunkFunc()>;
+
+/**
+ * @brief run the chunks of [0, _count) on the threads, each thread claims _chunkSize items at a
+ * time and the caller is one of the threads. The first exception stops claiming the rest and is
+ * rethrown once all the threads joined.
+ *
+ * @param _count
+ * @param _chunkSize
+ * @param _threadCount 0 means the number of the cores, at most one thread per chunk
+ * @param _threadInit
+ */
+void parallelChunks(std::size_t _count, std::size_t _chunkSize, std::size_t _threadCount,
+    const ChunkThreadInit& _threadInit);
+
+void parallelChunks(
+    std::size_t _count, std::size_t _chunkSize, std::size_t _threadCount, const ChunkFunc& _f);
+
+}  // namespace utilities
+}  // namespace cppsdk
+}  // namespace bcos
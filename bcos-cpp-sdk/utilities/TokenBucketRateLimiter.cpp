@@ -0,0 +1,106 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2020 fisco-dev contributors.
+ */
+/**
+ * @brief : Implement of TokenBucketRateLimiter
+ * @file: TokenBucketRateLimiter.cpp
+ * @author: octopuswang
+ * @date: 2023-03-20
+ */
+#include "bcos-utilities/BoostLog.h"
+#include <bcos-cpp-sdk/utilities/TokenBucketRateLimiter.h>
+#include <thread>
+#include <utility>
+
+using namespace bcos;
+using namespace bcos::ratelimiter;
+
+void TokenBucketRateLimiter::refill(std::chrono::steady_clock::time_point _now)
+{
+    if (_now <= m_lastRefillTime)
+    {
+        return;
+    }
+
+    auto elapsedUs =
+        std::chrono::duration_cast<std::chrono::microseconds>(_now - m_lastRefillTime).count();
+    m_currentPermits = std::min<double>(m_burstSize,
+        m_currentPermits + static_cast<double>(elapsedUs) * m_permitsPerSecond / 1000000.0);
+    m_lastRefillTime = _now;
+}
+
+bool TokenBucketRateLimiter::tryAcquire(
+    int64_t _requiredPermits, std::chrono::steady_clock::time_point _now)
+{
+    if (std::cmp_greater(_requiredPermits, m_burstSize))
+    {
+        // Notice: the acquire amount exceeded the bucket, it will never succeed
+        BCOS_LOG(WARNING) << LOG_DESC("try acquire exceeded the burst size")
+                          << LOG_KV("requiredPermits", _requiredPermits)
+                          << LOG_KV("burstSize", m_burstSize);
+        return false;
+    }
+
+    Guard guard(m_mutex);
+    refill(_now);
+    if (m_currentPermits >= static_cast<double>(_requiredPermits))
+    {
+        m_currentPermits -= static_cast<double>(_requiredPermits);
+        return true;
+    }
+
+    return false;
+}
+
+uint64_t TokenBucketRateLimiter::availablePermits(std::chrono::steady_clock::time_point _now)
+{
+    Guard guard(m_mutex);
+    refill(_now);
+    return static_cast<uint64_t>(m_currentPermits);
+}
+
+bool TokenBucketRateLimiter::acquire(int64_t _requiredPermits)
+{
+    if (std::cmp_greater(_requiredPermits, m_burstSize))
+    {
+        // Notice: the acquire amount exceeded the bucket, it will never succeed
+        BCOS_LOG(WARNING) << LOG_DESC("acquire exceeded the burst size")
+                          << LOG_KV("requiredPermits", _requiredPermits)
+                          << LOG_KV("burstSize", m_burstSize);
+        return false;
+    }
+
+    while (!tryAcquire(_requiredPermits))
+    {
+        // sleep for the permits missing to be refilled
+        double missing = 0;
+        {
+            Guard guard(m_mutex);
+            missing = static_cast<double>(_requiredPermits) - m_currentPermits;
+        }
+        auto sleepUs = static_cast<int64_t>(missing * 1000000.0 / m_permitsPerSecond) + 1;
+        std::this_thread::sleep_for(std::chrono::microseconds(std::max<int64_t>(sleepUs, 1)));
+    }
+
+    return true;
+}
+
+void TokenBucketRateLimiter::rollback(int64_t _requiredPermits)
+{
+    Guard guard(m_mutex);
+    m_currentPermits =
+        std::min<double>(m_burstSize, m_currentPermits + static_cast<double>(_requiredPermits));
+}
@@ -0,0 +1,93 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2020 fisco-dev contributors.
+ */
+/**
+ * @brief : Implement of TokenBucketRateLimiter
+ * @file: TokenBucketRateLimiter.h
+ * @author: octopuswang
+ * @date: 2023-03-20
+ */
+#pragma once
+
+#include "bcos-cpp-sdk/utilities/RateLimiterInterface.h"
+#include <bcos-utilities/Common.h>
+#include <chrono>
+#include <mutex>
+
+namespace bcos
+{
+namespace ratelimiter
+{
+
+/**
+ * @brief the permits are refilled continuously at the rate and stored up to the burst size,
+ * unlike TimeWindowRateLimiter the permits are not released all at the start of a window
+ */
+class TokenBucketRateLimiter : public RateLimiterInterface
+{
+public:
+    using Ptr = std::shared_ptr<TokenBucketRateLimiter>;
+    using ConstPtr = std::shared_ptr<const TokenBucketRateLimiter>;
+    using UniquePtr = std::unique_ptr<const TokenBucketRateLimiter>;
+
+public:
+    TokenBucketRateLimiter(uint64_t _permitsPerSecond, uint64_t _burstSize)
+      : m_permitsPerSecond(std::max<uint64_t>(_permitsPerSecond, 1)),
+        m_burstSize(std::max<uint64_t>(_burstSize, 1)),
+        m_currentPermits(static_cast<double>(m_burstSize)),
+        m_lastRefillTime(std::chrono::steady_clock::now())
+    {
+        BCOS_LOG(INFO) << LOG_BADGE("[NEWOBJ][TokenBucketRateLimiter]")
+                       << LOG_KV("permitsPerSecond", _permitsPerSecond)
+                       << LOG_KV("burstSize", _burstSize);
+    }
+
+    TokenBucketRateLimiter(TokenBucketRateLimiter&&) = delete;
+    TokenBucketRateLimiter(const TokenBucketRateLimiter&) = delete;
+    TokenBucketRateLimiter& operator=(const TokenBucketRateLimiter&) = delete;
+    TokenBucketRateLimiter& operator=(TokenBucketRateLimiter&&) = delete;
+
+    ~TokenBucketRateLimiter() override = default;
+
+    uint64_t permitsPerSecond() const { return m_permitsPerSecond; }
+    uint64_t burstSize() const { return m_burstSize; }
+
+public:
+    bool acquire(int64_t _requiredPermits) override;
+    bool tryAcquire(int64_t _requiredPermits) override
+    {
+        return tryAcquire(_requiredPermits, std::chrono::steady_clock::now());
+    }
+    void rollback(int64_t _requiredPermits) override;
+
+    bool tryAcquire(int64_t _requiredPermits, std::chrono::steady_clock::time_point _now);
+    // the whole permits available at _now
+    uint64_t availablePermits(std::chrono::steady_clock::time_point _now);
+
+private:
+    void refill(std::chrono::steady_clock::time_point _now);
+
+private:
+    // lock for all data class member
+    std::mutex m_mutex;
+    uint64_t m_permitsPerSecond;
+    uint64_t m_burstSize;
+    double m_currentPermits;
+    std::chrono::steady_clock::time_point m_lastRefillTime;
+};
+
+}  // namespace ratelimiter
+}  // namespace bcos
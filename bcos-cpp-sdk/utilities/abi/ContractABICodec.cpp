@@ -19,6 +19,7 @@
  */
 
 #include <bcos-cpp-sdk/utilities/Common.h>
+#include <bcos-cpp-sdk/utilities/Hex.h>
 #include <bcos-cpp-sdk/utilities/abi/ContractABICodec.h>
 #include <bcos-cpp-sdk/utilities/abi/ContractABIMethodDefinition.h>
 #include <bcos-cpp-sdk/utilities/abi/ContractABIType.h>
@@ -69,7 +70,7 @@ void ContractABICodec::stringToJsonValue(const std::string& _params, Json::Value
 bcos::bytes ContractABICodec::encodeConstructor(
     const std::string& _abi, const std::string& _bin, const std::string& _jsonParams)
 {
-    return *fromHexString(_bin) +
+    return hexDecode(_bin) +
            encodeMethod(_abi, ContractABIMethodDefinition::CONSTRUCTOR_TYPE, _jsonParams);
 }
 
@@ -236,7 +237,7 @@ bcos::bytes decodeBytesFromString(const std::string& _str)
     {  // hex format
         try
         {
-            return std::move(*fromHexString(_str.substr(hexPrefix.size())));
+            return hexDecode(std::string_view(_str).substr(hexPrefix.size()));
         }
         catch (...)
         {
@@ -19,6 +19,7 @@
  */
 
 #pragma once
+#include <bcos-cpp-sdk/utilities/Hex.h>
 #include <bcos-cpp-sdk/utilities/abi/ContractABITypeCodec.h>
 #include <bcos-crypto/interfaces/crypto/Hash.h>
 #include <bcos-utilities/Common.h>
@@ -67,7 +68,7 @@ public:
     {
         bcos::bytes data;
         m_solCodec.serialize(_u, 256, data);
-        return toHexStringWithPrefix(data);
+        return bcos::cppsdk::utilities::hexEncode(data, true);
     }
 
     // s256 => topic
@@ -75,7 +76,7 @@ public:
     {
         bcos::bytes data;
         m_solCodec.serialize(_i, 256, data);
-        return toHexStringWithPrefix(data);
+        return bcos::cppsdk::utilities::hexEncode(data, true);
     }
 
     // string => topic
@@ -97,7 +98,7 @@ public:
     {
         bcos::bytes data;
         m_solCodec.serialize(_bsn, true, data);
-        return toHexStringWithPrefix(data);
+        return bcos::cppsdk::utilities::hexEncode(data, true);
     }
 
 private:
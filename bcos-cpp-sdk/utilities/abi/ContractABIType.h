@@ -19,6 +19,7 @@
  */
 #pragma once
 
+#include <bcos-cpp-sdk/utilities/Hex.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/DataConvertUtility.h>
 #include <bcos-utilities/FixedBytes.h>
@@ -349,7 +350,7 @@ public:
     virtual Json::Value toJson() const
     {
         Json::Value jRet(Json::stringValue);
-        jRet = "hex://" + *toHexString(m_value);
+        jRet = "hex://" + utilities::hexEncode(m_value);
         return jRet;
     }
 
@@ -441,7 +442,7 @@ public:
     virtual Json::Value toJson() const
     {
         Json::Value jRet(Json::stringValue);
-        jRet = "hex://" + *toHexString(m_value);
+        jRet = "hex://" + utilities::hexEncode(m_value);
         return jRet;
     }
 
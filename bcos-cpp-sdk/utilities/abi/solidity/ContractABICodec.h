@@ -19,6 +19,7 @@
  */
 
 #pragma once
+#include <bcos-cpp-sdk/utilities/Hex.h>
 #include <bcos-crypto/interfaces/crypto/Hash.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/DataConvertUtility.h>
@@ -439,7 +440,7 @@ public:
     template <class... T>
     bool abiOutHex(const std::string& _data, T&... _t)
     {
-        auto dataFromHex = *fromHexString(_data);
+        auto dataFromHex = bcos::cppsdk::utilities::hexDecode(_data);
         return abiOut(bytesConstRef(&dataFromHex), _t...);
     }
 
@@ -463,7 +464,7 @@ public:
     template <class... T>
     std::string abiInHex(const std::string& _sig, T const&... _t)
     {
-        return *toHexString(abiIn(_sig, _t...));
+        return bcos::cppsdk::utilities::hexEncode(abiIn(_sig, _t...));
     }
 };
 
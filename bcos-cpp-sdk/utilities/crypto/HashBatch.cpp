@@ -0,0 +1,721 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file HashBatch.cpp
+ * @author: octopus
+ * @date 2023-04-12
+ */
+#include <bcos-cpp-sdk/utilities/crypto/HashBatch.h>
+#include <bcos-cpp-sdk/utilities/receipt/TransactionReceipt.h>
+#include <bcos-cpp-sdk/utilities/tx/Transaction.h>
+#include <bcos-cpp-sdk/utilities/tx/TransactionView.h>
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/hash/SM3.h>
+#include <boost/endian/conversion.hpp>
+#include <cstring>
+#include <typeinfo>
+#include <variant>
+
+// the SIMD kernels are built with the target attributes and selected by cpuid, the library is
+// not required to be built with -mavx2 or -mavx512f
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BCOS_HASH_BATCH_X86 1
+#include <immintrin.h>
+#else
+#define BCOS_HASH_BATCH_X86 0
+#endif
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::utilities;
+
+namespace
+{
+// the keccak256 rate in bytes, 1600 - 2 * 256 bits
+constexpr std::size_t c_keccakRate = 136;
+constexpr std::size_t c_sm3BlockSize = 64;
+// the widest lanes of the kernels
+constexpr std::size_t c_maxKeccakLanes = 8;
+constexpr std::size_t c_maxSM3Lanes = 16;
+
+#if BCOS_HASH_BATCH_X86
+constexpr uint64_t c_keccakRoundConstants[24] = {0x0000000000000001ULL, 0x0000000000008082ULL,
+    0x800000000000808aULL, 0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL, 0x0000000000000088ULL,
+    0x0000000080008009ULL, 0x000000008000000aULL, 0x000000008000808bULL, 0x800000000000008bULL,
+    0x8000000000008089ULL, 0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL, 0x8000000000008080ULL,
+    0x0000000080000001ULL, 0x8000000080008008ULL};
+
+// the rotation of the word x + 5y by rho
+constexpr int c_keccakRho[25] = {
+    0, 1, 62, 28, 27, 36, 44, 6, 55, 20, 3, 10, 43, 25, 39, 41, 45, 15, 21, 8, 18, 2, 61, 56, 14};
+
+// the word x + 5y is moved to y + 5 * ((2x + 3y) % 5) by pi
+constexpr std::array<int, 25> c_keccakPi = []() {
+    std::array<int, 25> pi{};
+    for (int x = 0; x < 5; ++x)
+    {
+        for (int y = 0; y < 5; ++y)
+        {
+            pi[x + 5 * y] = y + 5 * ((2 * x + 3 * y) % 5);
+        }
+    }
+    return pi;
+}();
+
+// the round constant T_j of sm3 rotated left by j
+constexpr std::array<uint32_t, 64> c_sm3RoundConstants = []() {
+    std::array<uint32_t, 64> constants{};
+    for (int j = 0; j < 64; ++j)
+    {
+        uint32_t t = j < 16 ? 0x79cc4519U : 0x7a879d8aU;
+        int n = j % 32;
+        constants[j] = n == 0 ? t : ((t << n) | (t >> (32 - n)));
+    }
+    return constants;
+}();
+
+__attribute__((target("avx2"))) inline __m256i rotl64AVX2(__m256i _x, int _n)
+{
+    return _mm256_or_si256(_mm256_slli_epi64(_x, _n), _mm256_srli_epi64(_x, 64 - _n));
+}
+
+__attribute__((target("avx2"))) void keccakPermuteAVX2(uint64_t* _state)
+{
+    __m256i a[25];
+    __m256i b[25];
+    __m256i c[5];
+    for (int i = 0; i < 25; ++i)
+    {
+        a[i] = _mm256_load_si256((const __m256i*)(_state + i * 4));
+    }
+    for (int round = 0; round < 24; ++round)
+    {
+        // theta
+        for (int x = 0; x < 5; ++x)
+        {
+            c[x] = _mm256_xor_si256(_mm256_xor_si256(a[x], a[x + 5]),
+                _mm256_xor_si256(_mm256_xor_si256(a[x + 10], a[x + 15]), a[x + 20]));
+        }
+        for (int x = 0; x < 5; ++x)
+        {
+            auto d = _mm256_xor_si256(c[(x + 4) % 5], rotl64AVX2(c[(x + 1) % 5], 1));
+            for (int y = 0; y < 25; y += 5)
+            {
+                a[x + y] = _mm256_xor_si256(a[x + y], d);
+            }
+        }
+        // rho and pi
+        for (int i = 0; i < 25; ++i)
+        {
+            b[c_keccakPi[i]] = rotl64AVX2(a[i], c_keccakRho[i]);
+        }
+        // chi
+        for (int y = 0; y < 25; y += 5)
+        {
+            for (int x = 0; x < 5; ++x)
+            {
+                a[x + y] = _mm256_xor_si256(
+                    b[x + y], _mm256_andnot_si256(b[(x + 1) % 5 + y], b[(x + 2) % 5 + y]));
+            }
+        }
+        // iota
+        a[0] = _mm256_xor_si256(a[0], _mm256_set1_epi64x((long long)c_keccakRoundConstants[round]));
+    }
+    for (int i = 0; i < 25; ++i)
+    {
+        _mm256_store_si256((__m256i*)(_state + i * 4), a[i]);
+    }
+}
+
+// the zero masked rotations, the unmasked ones warn of the undefined source with -Wuninitialized
+// on some gcc versions, and the same instruction is emitted with the full mask
+__attribute__((target("avx512f"))) inline __m512i rotl64AVX512(__m512i _x, int _n)
+{
+    return _mm512_maskz_rolv_epi64((__mmask8)0xFF, _x, _mm512_set1_epi64(_n));
+}
+
+__attribute__((target("avx512f"))) void keccakPermuteAVX512(uint64_t* _state)
+{
+    __m512i a[25];
+    __m512i b[25];
+    __m512i c[5];
+    for (int i = 0; i < 25; ++i)
+    {
+        a[i] = _mm512_load_si512((const void*)(_state + i * 8));
+    }
+    for (int round = 0; round < 24; ++round)
+    {
+        // theta, the xor of three by the ternary logic 0x96
+        for (int x = 0; x < 5; ++x)
+        {
+            c[x] = _mm512_xor_si512(_mm512_ternarylogic_epi64(a[x], a[x + 5], a[x + 10], 0x96),
+                _mm512_xor_si512(a[x + 15], a[x + 20]));
+        }
+        for (int x = 0; x < 5; ++x)
+        {
+            auto d = _mm512_xor_si512(c[(x + 4) % 5], rotl64AVX512(c[(x + 1) % 5], 1));
+            for (int y = 0; y < 25; y += 5)
+            {
+                a[x + y] = _mm512_xor_si512(a[x + y], d);
+            }
+        }
+        // rho and pi
+        for (int i = 0; i < 25; ++i)
+        {
+            b[c_keccakPi[i]] = rotl64AVX512(a[i], c_keccakRho[i]);
+        }
+        // chi, b0 ^ (~b1 & b2) by the ternary logic 0xD2
+        for (int y = 0; y < 25; y += 5)
+        {
+            for (int x = 0; x < 5; ++x)
+            {
+                a[x + y] = _mm512_ternarylogic_epi64(
+                    b[x + y], b[(x + 1) % 5 + y], b[(x + 2) % 5 + y], 0xD2);
+            }
+        }
+        // iota
+        a[0] = _mm512_xor_si512(a[0], _mm512_set1_epi64((long long)c_keccakRoundConstants[round]));
+    }
+    for (int i = 0; i < 25; ++i)
+    {
+        _mm512_store_si512((void*)(_state + i * 8), a[i]);
+    }
+}
+
+__attribute__((target("avx2"))) inline __m256i rotl32AVX2(__m256i _x, int _n)
+{
+    return _mm256_or_si256(_mm256_slli_epi32(_x, _n), _mm256_srli_epi32(_x, 32 - _n));
+}
+
+__attribute__((target("avx2"))) void sm3CompressAVX2(uint32_t* _state, const uint32_t* _words)
+{
+    __m256i w[68];
+    for (int j = 0; j < 16; ++j)
+    {
+        w[j] = _mm256_load_si256((const __m256i*)(_words + j * 8));
+    }
+    for (int j = 16; j < 68; ++j)
+    {
+        auto x = _mm256_xor_si256(_mm256_xor_si256(w[j - 16], w[j - 9]), rotl32AVX2(w[j - 3], 15));
+        // P1(x) = x ^ (x <<< 15) ^ (x <<< 23)
+        x = _mm256_xor_si256(_mm256_xor_si256(x, rotl32AVX2(x, 15)), rotl32AVX2(x, 23));
+        w[j] = _mm256_xor_si256(_mm256_xor_si256(x, rotl32AVX2(w[j - 13], 7)), w[j - 6]);
+    }
+    __m256i v[8];
+    for (int i = 0; i < 8; ++i)
+    {
+        v[i] = _mm256_load_si256((const __m256i*)(_state + i * 8));
+    }
+    auto a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+    for (int j = 0; j < 64; ++j)
+    {
+        auto a12 = rotl32AVX2(a, 12);
+        auto ss1 = rotl32AVX2(
+            _mm256_add_epi32(_mm256_add_epi32(a12, e),
+                _mm256_set1_epi32((int)c_sm3RoundConstants[j])),
+            7);
+        auto ss2 = _mm256_xor_si256(ss1, a12);
+        __m256i ff;
+        __m256i gg;
+        if (j < 16)
+        {
+            ff = _mm256_xor_si256(_mm256_xor_si256(a, b), c);
+            gg = _mm256_xor_si256(_mm256_xor_si256(e, f), g);
+        }
+        else
+        {
+            // the majority, (a & b) | (c & (a | b))
+            ff = _mm256_or_si256(
+                _mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+            gg = _mm256_or_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        }
+        auto tt1 = _mm256_add_epi32(_mm256_add_epi32(ff, d),
+            _mm256_add_epi32(ss2, _mm256_xor_si256(w[j], w[j + 4])));
+        auto tt2 = _mm256_add_epi32(_mm256_add_epi32(gg, h), _mm256_add_epi32(ss1, w[j]));
+        d = c;
+        c = rotl32AVX2(b, 9);
+        b = a;
+        a = tt1;
+        h = g;
+        g = rotl32AVX2(f, 19);
+        f = e;
+        // P0(x) = x ^ (x <<< 9) ^ (x <<< 17)
+        e = _mm256_xor_si256(_mm256_xor_si256(tt2, rotl32AVX2(tt2, 9)), rotl32AVX2(tt2, 17));
+    }
+    __m256i out[8] = {a, b, c, d, e, f, g, h};
+    for (int i = 0; i < 8; ++i)
+    {
+        _mm256_store_si256((__m256i*)(_state + i * 8), _mm256_xor_si256(v[i], out[i]));
+    }
+}
+
+__attribute__((target("avx512f"))) inline __m512i rotl32AVX512(__m512i _x, int _n)
+{
+    return _mm512_maskz_rolv_epi32((__mmask16)0xFFFF, _x, _mm512_set1_epi32(_n));
+}
+
+__attribute__((target("avx512f"))) void sm3CompressAVX512(uint32_t* _state, const uint32_t* _words)
+{
+    __m512i w[68];
+    for (int j = 0; j < 16; ++j)
+    {
+        w[j] = _mm512_load_si512((const void*)(_words + j * 16));
+    }
+    for (int j = 16; j < 68; ++j)
+    {
+        auto x = _mm512_ternarylogic_epi32(w[j - 16], w[j - 9], rotl32AVX512(w[j - 3], 15), 0x96);
+        x = _mm512_ternarylogic_epi32(x, rotl32AVX512(x, 15), rotl32AVX512(x, 23), 0x96);
+        w[j] = _mm512_ternarylogic_epi32(x, rotl32AVX512(w[j - 13], 7), w[j - 6], 0x96);
+    }
+    __m512i v[8];
+    for (int i = 0; i < 8; ++i)
+    {
+        v[i] = _mm512_load_si512((const void*)(_state + i * 16));
+    }
+    auto a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+    for (int j = 0; j < 64; ++j)
+    {
+        auto a12 = rotl32AVX512(a, 12);
+        auto ss1 = rotl32AVX512(
+            _mm512_add_epi32(_mm512_add_epi32(a12, e),
+                _mm512_set1_epi32((int)c_sm3RoundConstants[j])),
+            7);
+        auto ss2 = _mm512_xor_si512(ss1, a12);
+        __m512i ff;
+        __m512i gg;
+        if (j < 16)
+        {
+            ff = _mm512_ternarylogic_epi32(a, b, c, 0x96);
+            gg = _mm512_ternarylogic_epi32(e, f, g, 0x96);
+        }
+        else
+        {
+            // the majority by 0xE8 and e ? f : g by 0xCA
+            ff = _mm512_ternarylogic_epi32(a, b, c, 0xE8);
+            gg = _mm512_ternarylogic_epi32(e, f, g, 0xCA);
+        }
+        auto tt1 = _mm512_add_epi32(_mm512_add_epi32(ff, d),
+            _mm512_add_epi32(ss2, _mm512_xor_si512(w[j], w[j + 4])));
+        auto tt2 = _mm512_add_epi32(_mm512_add_epi32(gg, h), _mm512_add_epi32(ss1, w[j]));
+        d = c;
+        c = rotl32AVX512(b, 9);
+        b = a;
+        a = tt1;
+        h = g;
+        g = rotl32AVX512(f, 19);
+        f = e;
+        e = _mm512_ternarylogic_epi32(tt2, rotl32AVX512(tt2, 9), rotl32AVX512(tt2, 17), 0x96);
+    }
+    __m512i out[8] = {a, b, c, d, e, f, g, h};
+    for (int i = 0; i < 8; ++i)
+    {
+        _mm512_store_si512((void*)(_state + i * 16), _mm512_xor_si512(v[i], out[i]));
+    }
+}
+#endif
+
+constexpr uint32_t c_sm3IV[8] = {0x7380166fU, 0x4914b2b9U, 0x172442d7U, 0xda8a0600U, 0xa96f30bcU,
+    0x163138aaU, 0xe38dee4dU, 0xb0fb0e4eU};
+
+/**
+ * @brief the padded stream of a message in the lane, the blocks are filled with the bytes of the
+ * pieces in order and the padding is added by the driver
+ */
+class LaneMessage
+{
+public:
+    // start the message, false if no message is left
+    bool next(const HashBatchMessages& _messages, std::size_t& _nextMessage)
+    {
+        if (_nextMessage >= _messages.size())
+        {
+            m_active = false;
+            return false;
+        }
+        m_active = true;
+        m_index = _nextMessage++;
+        m_pieces = _messages.pieces(m_index);
+        m_piece = 0;
+        m_pieceOffset = 0;
+        m_length = 0;
+        for (const auto& piece : m_pieces)
+        {
+            m_length += piece.size();
+        }
+        m_position = 0;
+        return true;
+    }
+
+    // copy the next bytes of the message into the block, return the offset of the block
+    std::size_t fill(bcos::byte* _block, std::size_t _blockSize)
+    {
+        auto blockStart = m_position;
+        std::size_t filled = 0;
+        while (filled < _blockSize && m_piece < m_pieces.size())
+        {
+            const auto& piece = m_pieces[m_piece];
+            auto size = std::min(_blockSize - filled, piece.size() - m_pieceOffset);
+            if (size > 0)
+            {
+                memcpy(_block + filled, piece.data() + m_pieceOffset, size);
+            }
+            filled += size;
+            m_pieceOffset += size;
+            if (m_pieceOffset == piece.size())
+            {
+                ++m_piece;
+                m_pieceOffset = 0;
+            }
+        }
+        m_position += _blockSize;
+        return blockStart;
+    }
+
+    bool active() const { return m_active; }
+    std::size_t index() const { return m_index; }
+    std::size_t length() const { return m_length; }
+
+private:
+    bool m_active = false;
+    std::size_t m_index = 0;
+    std::span<const bcos::bytesConstRef> m_pieces;
+    std::size_t m_piece = 0;
+    std::size_t m_pieceOffset = 0;
+    std::size_t m_length = 0;
+    // the offset of the next block in the padded stream
+    std::size_t m_position = 0;
+};
+
+// keccak pads 0x01 after the message and 0x80 at the end of the last block, at least one byte
+void keccakBatch(const HashBatchMessages& _messages, bcos::crypto::HashType* _out,
+    const HashBatchKernel& _kernel)
+{
+    auto lanes = _kernel.keccakLanes;
+    alignas(64) uint64_t state[25 * c_maxKeccakLanes];
+    bcos::byte block[c_keccakRate];
+    LaneMessage laneMessages[c_maxKeccakLanes];
+    // the lanes hashing the last block of the message
+    bool lastBlock[c_maxKeccakLanes] = {};
+    std::size_t nextMessage = 0;
+    std::size_t activeLanes = 0;
+    memset(state, 0, sizeof(state));
+    for (std::size_t lane = 0; lane < lanes; ++lane)
+    {
+        activeLanes += laneMessages[lane].next(_messages, nextMessage);
+    }
+    while (activeLanes > 0)
+    {
+        for (std::size_t lane = 0; lane < lanes; ++lane)
+        {
+            auto& laneMessage = laneMessages[lane];
+            if (!laneMessage.active())
+            {
+                continue;
+            }
+            memset(block, 0, sizeof(block));
+            auto blockStart = laneMessage.fill(block, c_keccakRate);
+            lastBlock[lane] = laneMessage.length() < blockStart + c_keccakRate;
+            if (lastBlock[lane])
+            {
+                block[laneMessage.length() - blockStart] ^= 0x01;
+                block[c_keccakRate - 1] ^= 0x80;
+            }
+            for (std::size_t i = 0; i < c_keccakRate / 8; ++i)
+            {
+                uint64_t word;
+                memcpy(&word, block + i * 8, sizeof(word));
+                state[i * lanes + lane] ^= boost::endian::little_to_native(word);
+            }
+        }
+        _kernel.keccakPermute(state);
+        for (std::size_t lane = 0; lane < lanes; ++lane)
+        {
+            auto& laneMessage = laneMessages[lane];
+            if (!laneMessage.active() || !lastBlock[lane])
+            {
+                continue;
+            }
+            auto* out = _out[laneMessage.index()].data();
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                auto word = boost::endian::native_to_little(state[i * lanes + lane]);
+                memcpy(out + i * 8, &word, sizeof(word));
+            }
+            for (std::size_t i = 0; i < 25; ++i)
+            {
+                state[i * lanes + lane] = 0;
+            }
+            activeLanes -= !laneMessage.next(_messages, nextMessage);
+        }
+    }
+}
+
+// sm3 pads 0x80 after the message and the bit length in big endian at the end of the last block
+void sm3Batch(const HashBatchMessages& _messages, bcos::crypto::HashType* _out,
+    const HashBatchKernel& _kernel)
+{
+    auto lanes = _kernel.sm3Lanes;
+    alignas(64) uint32_t state[8 * c_maxSM3Lanes];
+    alignas(64) uint32_t words[16 * c_maxSM3Lanes];
+    bcos::byte block[c_sm3BlockSize];
+    LaneMessage laneMessages[c_maxSM3Lanes];
+    bool lastBlock[c_maxSM3Lanes] = {};
+    std::size_t nextMessage = 0;
+    std::size_t activeLanes = 0;
+    auto resetState = [&state, lanes](std::size_t _lane) {
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            state[i * lanes + _lane] = c_sm3IV[i];
+        }
+    };
+    memset(words, 0, sizeof(words));
+    for (std::size_t lane = 0; lane < lanes; ++lane)
+    {
+        activeLanes += laneMessages[lane].next(_messages, nextMessage);
+        resetState(lane);
+    }
+    while (activeLanes > 0)
+    {
+        for (std::size_t lane = 0; lane < lanes; ++lane)
+        {
+            auto& laneMessage = laneMessages[lane];
+            if (!laneMessage.active())
+            {
+                continue;
+            }
+            memset(block, 0, sizeof(block));
+            auto blockStart = laneMessage.fill(block, c_sm3BlockSize);
+            auto length = laneMessage.length();
+            if (length >= blockStart && length < blockStart + c_sm3BlockSize)
+            {
+                block[length - blockStart] = 0x80;
+            }
+            // the length takes the last 8 bytes of the block after the 0x80
+            lastBlock[lane] = length + 9 <= blockStart + c_sm3BlockSize;
+            if (lastBlock[lane])
+            {
+                auto bits = boost::endian::native_to_big((uint64_t)length * 8);
+                memcpy(block + c_sm3BlockSize - 8, &bits, sizeof(bits));
+            }
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+                uint32_t word;
+                memcpy(&word, block + i * 4, sizeof(word));
+                words[i * lanes + lane] = boost::endian::big_to_native(word);
+            }
+        }
+        _kernel.sm3Compress(state, words);
+        for (std::size_t lane = 0; lane < lanes; ++lane)
+        {
+            auto& laneMessage = laneMessages[lane];
+            if (!laneMessage.active() || !lastBlock[lane])
+            {
+                continue;
+            }
+            auto* out = _out[laneMessage.index()].data();
+            for (std::size_t i = 0; i < 8; ++i)
+            {
+                auto word = boost::endian::native_to_big(state[i * lanes + lane]);
+                memcpy(out + i * 4, &word, sizeof(word));
+            }
+            resetState(lane);
+            activeLanes -= !laneMessage.next(_messages, nextMessage);
+        }
+    }
+}
+
+void hashOneByOne(const bcos::crypto::Hash::Ptr& _hashImpl, const HashBatchMessages& _messages,
+    bcos::crypto::HashType* _out)
+{
+    for (std::size_t i = 0; i < _messages.size(); ++i)
+    {
+        auto anyHasher = _hashImpl->hasher();
+        std::visit(
+            [&_messages, &_out, i](auto& hasher) {
+                for (const auto& piece : _messages.pieces(i))
+                {
+                    hasher.update(piece);
+                }
+                hasher.final(_out[i]);
+            },
+            anyHasher);
+    }
+}
+
+template <class Container>
+bcos::bytesConstRef toBytes(const Container& _container)
+{
+    return bcos::bytesConstRef((const bcos::byte*)_container.data(), _container.size());
+}
+}  // namespace
+
+const std::vector<HashBatchKernel>& bcos::cppsdk::utilities::supportedHashBatchKernels()
+{
+    static const std::vector<HashBatchKernel> kernels = []() {
+        std::vector<HashBatchKernel> kernels{{"scalar", 1, nullptr, 1, nullptr}};
+#if BCOS_HASH_BATCH_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            kernels.push_back({"avx2", 4, keccakPermuteAVX2, 8, sm3CompressAVX2});
+        }
+        if (__builtin_cpu_supports("avx512f"))
+        {
+            kernels.push_back({"avx512", 8, keccakPermuteAVX512, 16, sm3CompressAVX512});
+        }
+#endif
+        return kernels;
+    }();
+    return kernels;
+}
+
+const HashBatchKernel& bcos::cppsdk::utilities::hashBatchKernel()
+{
+    static const HashBatchKernel kernel = supportedHashBatchKernels().back();
+    return kernel;
+}
+
+void HashBatchMessages::reserve(std::size_t _messages, std::size_t _pieces)
+{
+    m_offsets.reserve(_messages + 1);
+    m_pieces.reserve(_pieces);
+}
+
+void HashBatchMessages::clear()
+{
+    m_pieces.clear();
+    m_offsets.resize(1);
+    m_integers.clear();
+}
+
+void HashBatchMessages::add(bcos::bytesConstRef _piece)
+{
+    m_pieces.push_back(_piece);
+}
+
+void HashBatchMessages::addBigEndian(int32_t _value)
+{
+    auto& integer = m_integers.emplace_back();
+    auto value = boost::endian::native_to_big(_value);
+    memcpy(integer.data(), &value, sizeof(value));
+    add(bcos::bytesConstRef(integer.data(), sizeof(value)));
+}
+
+void HashBatchMessages::addBigEndian(int64_t _value)
+{
+    auto& integer = m_integers.emplace_back();
+    auto value = boost::endian::native_to_big(_value);
+    memcpy(integer.data(), &value, sizeof(value));
+    add(bcos::bytesConstRef(integer.data(), sizeof(value)));
+}
+
+void bcos::cppsdk::utilities::addHashMessage(
+    HashBatchMessages& _messages, const bcostars::TransactionData& _data)
+{
+    _messages.addBigEndian((int32_t)_data.version);
+    _messages.add(_data.chainID);
+    _messages.add(_data.groupID);
+    _messages.addBigEndian((int64_t)_data.blockLimit);
+    _messages.add(_data.nonce);
+    _messages.add(_data.to);
+    _messages.add(toBytes(_data.input));
+    _messages.add(_data.abi);
+    _messages.endMessage();
+}
+
+void bcos::cppsdk::utilities::addHashMessage(
+    HashBatchMessages& _messages, const TransactionDataView& _data)
+{
+    _messages.addBigEndian(_data.version);
+    _messages.add(_data.chainID);
+    _messages.add(_data.groupID);
+    _messages.addBigEndian(_data.blockLimit);
+    _messages.add(_data.nonce);
+    _messages.add(_data.to);
+    _messages.add(_data.input);
+    _messages.add(_data.abi);
+    _messages.endMessage();
+}
+
+void bcos::cppsdk::utilities::addHashMessage(
+    HashBatchMessages& _messages, const bcostars::TransactionReceiptData& _data)
+{
+    _messages.addBigEndian((int32_t)_data.version);
+    _messages.add(_data.gasUsed);
+    _messages.add(_data.contractAddress);
+    _messages.addBigEndian((int32_t)_data.status);
+    _messages.add(toBytes(_data.output));
+    for (const auto& log : _data.logEntries)
+    {
+        _messages.add(log.address);
+        for (const auto& item : log.topic)
+        {
+            _messages.add(toBytes(item));
+        }
+        _messages.add(toBytes(log.data));
+    }
+    _messages.addBigEndian((int64_t)_data.blockNumber);
+    _messages.endMessage();
+}
+
+void bcos::cppsdk::utilities::hashBatch(const bcos::crypto::Hash::Ptr& _hashImpl,
+    const HashBatchMessages& _messages, bcos::crypto::HashType* _out,
+    const HashBatchKernel& _kernel)
+{
+    // the subclasses of the hashes may differ from the standard ones
+    if (_kernel.keccakLanes > 1 && typeid(*_hashImpl) == typeid(bcos::crypto::Keccak256))
+    {
+        keccakBatch(_messages, _out, _kernel);
+        return;
+    }
+    if (_kernel.sm3Lanes > 1 && typeid(*_hashImpl) == typeid(bcos::crypto::SM3))
+    {
+        sm3Batch(_messages, _out, _kernel);
+        return;
+    }
+    hashOneByOne(_hashImpl, _messages, _out);
+}
+
+std::vector<bcos::crypto::HashType> bcos::cppsdk::utilities::hashBatch(
+    const bcos::crypto::Hash::Ptr& _hashImpl,
+    std::span<const bcostars::TransactionData* const> _transactionData)
+{
+    HashBatchMessages messages;
+    messages.reserve(_transactionData.size(), _transactionData.size() * 8);
+    for (const auto* data : _transactionData)
+    {
+        addHashMessage(messages, *data);
+    }
+    std::vector<bcos::crypto::HashType> hashes(_transactionData.size());
+    hashBatch(_hashImpl, messages, hashes.data());
+    return hashes;
+}
+
+std::vector<bcos::crypto::HashType> bcos::cppsdk::utilities::hashBatch(
+    const bcos::crypto::Hash::Ptr& _hashImpl,
+    std::span<const bcostars::TransactionReceiptData* const> _receiptData)
+{
+    HashBatchMessages messages;
+    messages.reserve(_receiptData.size(), _receiptData.size() * 7);
+    for (const auto* data : _receiptData)
+    {
+        addHashMessage(messages, *data);
+    }
+    std::vector<bcos::crypto::HashType> hashes(_receiptData.size());
+    hashBatch(_hashImpl, messages, hashes.data());
+    return hashes;
+}
@@ -0,0 +1,141 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief hash the independent messages of a batch together with the multi lane SIMD kernels
+ * @file HashBatch.h
+ * @author: octopus
+ * @date 2023-04-12
+ */
+#pragma once
+#include <bcos-crypto/interfaces/crypto/Hash.h>
+#include <bcos-utilities/Common.h>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace bcostars
+{
+struct TransactionData;
+struct TransactionReceiptData;
+}  // namespace bcostars
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace utilities
+{
+class TransactionDataView;
+
+// permute the interleaved keccak-f[1600] states, the word i of the lane l at _state[i * lanes + l]
+using KeccakPermuteFunc = void (*)(uint64_t* _state);
+// compress a block into each of the interleaved sm3 states, the word i of the lane l at
+// _state[i * lanes + l] and the block word i of the lane l at _words[i * lanes + l]
+using SM3CompressFunc = void (*)(uint32_t* _state, const uint32_t* _words);
+
+struct HashBatchKernel
+{
+    const char* name;
+    // the messages hashed at a time, 1 means one by one with the hasher of the Hash
+    std::size_t keccakLanes;
+    KeccakPermuteFunc keccakPermute;
+    std::size_t sm3Lanes;
+    SM3CompressFunc sm3Compress;
+};
+
+// the kernels supported by the cpu, from the scalar one to the widest one
+const std::vector<HashBatchKernel>& supportedHashBatchKernels();
+// the widest kernel supported by the cpu
+const HashBatchKernel& hashBatchKernel();
+
+/**
+ * @brief the messages of a batch, each one hashed as the concatenation of its pieces, the same as
+ * the hasher updated with the pieces in order. The pieces are not copied except the integers, and
+ * must be alive until hashed.
+ */
+class HashBatchMessages
+{
+public:
+    void reserve(std::size_t _messages, std::size_t _pieces);
+    void clear();
+
+    void add(bcos::bytesConstRef _piece);
+    void add(std::string_view _piece)
+    {
+        add(bcos::bytesConstRef((const bcos::byte*)_piece.data(), _piece.size()));
+    }
+    // the big endian bytes of the integer
+    void addBigEndian(int32_t _value);
+    void addBigEndian(int64_t _value);
+    // the pieces added next belong to the next message
+    void endMessage() { m_offsets.push_back(m_pieces.size()); }
+
+    std::size_t size() const { return m_offsets.size() - 1; }
+    std::span<const bcos::bytesConstRef> pieces(std::size_t _index) const
+    {
+        return {m_pieces.data() + m_offsets[_index], m_offsets[_index + 1] - m_offsets[_index]};
+    }
+
+private:
+    std::vector<bcos::bytesConstRef> m_pieces;
+    // the pieces of the message i are [m_offsets[i], m_offsets[i + 1])
+    std::vector<std::size_t> m_offsets{0};
+    // the pieces of the integers point to the elements, not moved by push_back
+    std::deque<std::array<bcos::byte, 8>> m_integers;
+};
+
+// the pieces hashed by bcostars::TransactionData::hash
+void addHashMessage(HashBatchMessages& _messages, const bcostars::TransactionData& _data);
+void addHashMessage(HashBatchMessages& _messages, const TransactionDataView& _data);
+// the pieces hashed by bcostars::TransactionReceiptData::hash
+void addHashMessage(HashBatchMessages& _messages, const bcostars::TransactionReceiptData& _data);
+
+/**
+ * @brief hash the messages, Keccak256 and SM3 by the lanes of the kernel, the other hashes and
+ * the scalar kernel one by one with the hasher of _hashImpl
+ *
+ * @param _hashImpl
+ * @param _messages
+ * @param _out the hashes of the messages in order, must hold _messages.size() hashes
+ * @param _kernel
+ */
+void hashBatch(const bcos::crypto::Hash::Ptr& _hashImpl, const HashBatchMessages& _messages,
+    bcos::crypto::HashType* _out, const HashBatchKernel& _kernel = hashBatchKernel());
+
+/**
+ * @brief the same hashes as bcostars::TransactionData::hash of the items in order
+ *
+ * @param _hashImpl
+ * @param _transactionData
+ * @return std::vector<bcos::crypto::HashType>
+ */
+std::vector<bcos::crypto::HashType> hashBatch(const bcos::crypto::Hash::Ptr& _hashImpl,
+    std::span<const bcostars::TransactionData* const> _transactionData);
+
+/**
+ * @brief the same hashes as bcostars::TransactionReceiptData::hash of the items in order
+ *
+ * @param _hashImpl
+ * @param _receiptData
+ * @return std::vector<bcos::crypto::HashType>
+ */
+std::vector<bcos::crypto::HashType> hashBatch(const bcos::crypto::Hash::Ptr& _hashImpl,
+    std::span<const bcostars::TransactionReceiptData* const> _receiptData);
+}  // namespace utilities
+}  // namespace cppsdk
+}  // namespace bcos
@@ -0,0 +1,175 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file HsmSessionPool.cpp
+ * @author: octopus
+ * @date 2023-04-13
+ */
+#include <bcos-cpp-sdk/utilities/Common.h>
+#include <bcos-cpp-sdk/utilities/ParallelChunks.h>
+#include <bcos-cpp-sdk/utilities/crypto/HsmSessionPool.h>
+#include <bcos-crypto/signature/hsmSM2/HsmSM2Crypto.h>
+#include <bcos-utilities/BoostLog.h>
+#include <algorithm>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::utilities;
+
+namespace
+{
+// the hashes claimed by a signing thread at a time
+constexpr std::size_t c_signBatchSize = 16;
+}  // namespace
+
+HsmSessionPool::Session::~Session()
+{
+    if (m_pool && m_signatureImpl)
+    {
+        m_pool->release(m_hsmLibPath, std::move(m_signatureImpl));
+    }
+}
+
+HsmSessionPool::HsmSessionPool(std::size_t _sessionCount, SessionFactory _sessionFactory)
+  : m_sessionFactory(std::move(_sessionFactory)),
+    m_sessionCount(std::max<std::size_t>(_sessionCount, 1))
+{
+    if (!m_sessionFactory)
+    {
+        m_sessionFactory = [](const std::string& _hsmLibPath) {
+            return std::make_shared<bcos::crypto::HsmSM2Crypto>(_hsmLibPath);
+        };
+    }
+}
+
+HsmSessionPool::Session HsmSessionPool::acquire(const std::string& _hsmLibPath)
+{
+    std::unique_lock<std::mutex> lock(x_devices);
+    auto& device = m_devices[_hsmLibPath];
+    m_released.wait(lock, [this, &device]() {
+        return !device.idleSessions.empty() || device.openedSessions < m_sessionCount;
+    });
+    if (!device.idleSessions.empty())
+    {
+        auto session = std::move(device.idleSessions.back());
+        device.idleSessions.pop_back();
+        return Session(this, _hsmLibPath, std::move(session));
+    }
+
+    // open the session out of the lock, the slot is taken in advance
+    ++device.openedSessions;
+    lock.unlock();
+    try
+    {
+        auto session = m_sessionFactory(_hsmLibPath);
+        UTILITIES_KEYPAIR_LOG(INFO) << LOG_BADGE("HsmSessionPool") << LOG_DESC("open session")
+                                    << LOG_KV("hsmLibPath", _hsmLibPath);
+        return Session(this, _hsmLibPath, std::move(session));
+    }
+    catch (...)
+    {
+        lock.lock();
+        --device.openedSessions;
+        lock.unlock();
+        m_released.notify_one();
+        throw;
+    }
+}
+
+void HsmSessionPool::release(
+    const std::string& _hsmLibPath, bcos::crypto::SignatureCrypto::Ptr _session)
+{
+    {
+        std::lock_guard<std::mutex> lock(x_devices);
+        auto& device = m_devices[_hsmLibPath];
+        if (device.openedSessions > m_sessionCount)
+        {
+            // closed out of the lock
+            --device.openedSessions;
+        }
+        else
+        {
+            device.idleSessions.push_back(std::move(_session));
+        }
+    }
+    // the waiters of the different libraries share the condition
+    m_released.notify_all();
+}
+
+void HsmSessionPool::setSessionCount(std::size_t _sessionCount)
+{
+    std::vector<bcos::crypto::SignatureCrypto::Ptr> closed;
+    {
+        std::lock_guard<std::mutex> lock(x_devices);
+        m_sessionCount = std::max<std::size_t>(_sessionCount, 1);
+        // the idle sessions over the count are closed now, the ones in use when returned
+        for (auto& [path, device] : m_devices)
+        {
+            while (device.openedSessions > m_sessionCount && !device.idleSessions.empty())
+            {
+                closed.push_back(std::move(device.idleSessions.back()));
+                device.idleSessions.pop_back();
+                --device.openedSessions;
+            }
+        }
+    }
+    m_released.notify_all();
+}
+
+std::size_t HsmSessionPool::sessionCount() const
+{
+    std::lock_guard<std::mutex> lock(x_devices);
+    return m_sessionCount;
+}
+
+std::size_t HsmSessionPool::openedSessions(const std::string& _hsmLibPath) const
+{
+    std::lock_guard<std::mutex> lock(x_devices);
+    auto it = m_devices.find(_hsmLibPath);
+    return it == m_devices.end() ? 0 : it->second.openedSessions;
+}
+
+std::shared_ptr<bcos::bytes> HsmSessionPool::sign(const bcos::crypto::KeyPairInterface& _keyPair,
+    const bcos::crypto::HashType& _hash, const std::string& _hsmLibPath, bool _signatureWithPub)
+{
+    auto session = acquire(_hsmLibPath);
+    return session->sign(_keyPair, _hash, _signatureWithPub);
+}
+
+std::vector<std::shared_ptr<bcos::bytes>> HsmSessionPool::signBatch(
+    const bcos::crypto::KeyPairInterface& _keyPair,
+    const std::vector<bcos::crypto::HashType>& _hashes, const std::string& _hsmLibPath,
+    bool _signatureWithPub)
+{
+    std::vector<std::shared_ptr<bcos::bytes>> results(_hashes.size());
+    if (_hashes.empty())
+    {
+        return results;
+    }
+    // one signing thread per session, the caller is one of them
+    parallelChunks(_hashes.size(), c_signBatchSize, std::max<std::size_t>(sessionCount(), 1),
+        [this, &_keyPair, &_hashes, &_hsmLibPath, _signatureWithPub, &results]() -> ChunkFunc {
+            // the session is kept by the thread till all the hashes are claimed
+            auto session = std::make_shared<Session>(acquire(_hsmLibPath));
+            return [session, &_keyPair, &_hashes, _signatureWithPub, &results](
+                       std::size_t _begin, std::size_t _end) {
+                for (auto i = _begin; i < _end; ++i)
+                {
+                    results[i] = (*session)->sign(_keyPair, _hashes[i], _signatureWithPub);
+                }
+            };
+        });
+    return results;
+}
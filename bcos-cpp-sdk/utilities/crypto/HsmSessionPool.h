@@ -0,0 +1,162 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the pool of the hsm sessions of each hsm library
+ * @file HsmSessionPool.h
+ * @author: octopus
+ * @date 2023-04-13
+ */
+#pragma once
+#include <bcos-crypto/interfaces/crypto/KeyPairInterface.h>
+#include <bcos-crypto/interfaces/crypto/Signature.h>
+#include <bcos-utilities/Common.h>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace utilities
+{
+/**
+ * @brief keep the hsm sessions of each library path for reuse, at most sessionCount sessions of a
+ * library are opened and each one is used by one thread at a time. Loading the library and
+ * opening the device session is done once per session instead of once per call.
+ */
+class HsmSessionPool
+{
+public:
+    using Ptr = std::shared_ptr<HsmSessionPool>;
+    using ConstPtr = std::shared_ptr<const HsmSessionPool>;
+    // open a session of the library, HsmSM2Crypto by default
+    using SessionFactory =
+        std::function<bcos::crypto::SignatureCrypto::Ptr(const std::string& _hsmLibPath)>;
+
+    static constexpr std::size_t c_defaultSessionCount = 4;
+
+    // the pool shared by Signature and TransactionBuilder
+    static HsmSessionPool& instance()
+    {
+        static HsmSessionPool ins;
+        return ins;
+    }
+
+    HsmSessionPool(std::size_t _sessionCount = c_defaultSessionCount,
+        SessionFactory _sessionFactory = nullptr);
+
+    HsmSessionPool(const HsmSessionPool&) = delete;
+    HsmSessionPool(HsmSessionPool&&) = delete;
+    HsmSessionPool& operator=(const HsmSessionPool&) = delete;
+    HsmSessionPool& operator=(HsmSessionPool&&) = delete;
+
+public:
+    /**
+     * @brief the session borrowed from the pool, returned on destruction
+     */
+    class Session
+    {
+    public:
+        Session(HsmSessionPool* _pool, std::string _hsmLibPath,
+            bcos::crypto::SignatureCrypto::Ptr _signatureImpl)
+          : m_pool(_pool),
+            m_hsmLibPath(std::move(_hsmLibPath)),
+            m_signatureImpl(std::move(_signatureImpl))
+        {}
+        ~Session();
+
+        Session(const Session&) = delete;
+        Session& operator=(const Session&) = delete;
+        Session(Session&& _session) noexcept
+          : m_pool(_session.m_pool),
+            m_hsmLibPath(std::move(_session.m_hsmLibPath)),
+            m_signatureImpl(std::move(_session.m_signatureImpl))
+        {
+            _session.m_pool = nullptr;
+        }
+        Session& operator=(Session&&) = delete;
+
+        bcos::crypto::SignatureCrypto& signatureImpl() const { return *m_signatureImpl; }
+        bcos::crypto::SignatureCrypto* operator->() const { return m_signatureImpl.get(); }
+
+    private:
+        HsmSessionPool* m_pool;
+        std::string m_hsmLibPath;
+        bcos::crypto::SignatureCrypto::Ptr m_signatureImpl;
+    };
+
+    /**
+     * @brief borrow a session of the library, wait if all the sessions are in use
+     *
+     * @param _hsmLibPath
+     * @return Session
+     */
+    Session acquire(const std::string& _hsmLibPath);
+
+    /**
+     * @brief the sessions of a library opened at most, the sessions over the count are closed
+     * when returned
+     *
+     * @param _sessionCount
+     */
+    void setSessionCount(std::size_t _sessionCount);
+    std::size_t sessionCount() const;
+    // the sessions of the library opened, in use or idle
+    std::size_t openedSessions(const std::string& _hsmLibPath) const;
+
+    std::shared_ptr<bcos::bytes> sign(const bcos::crypto::KeyPairInterface& _keyPair,
+        const bcos::crypto::HashType& _hash, const std::string& _hsmLibPath,
+        bool _signatureWithPub = false);
+
+    /**
+     * @brief sign the hashes by the sessions of the library in parallel, each signing thread keeps
+     * its session for the hashes it claims so the device works on sessionCount requests at a time
+     *
+     * @param _keyPair
+     * @param _hashes
+     * @param _hsmLibPath
+     * @param _signatureWithPub
+     * @return std::vector<std::shared_ptr<bcos::bytes>> the signatures in the order of _hashes
+     */
+    std::vector<std::shared_ptr<bcos::bytes>> signBatch(
+        const bcos::crypto::KeyPairInterface& _keyPair,
+        const std::vector<bcos::crypto::HashType>& _hashes, const std::string& _hsmLibPath,
+        bool _signatureWithPub = false);
+
+private:
+    struct Device
+    {
+        std::vector<bcos::crypto::SignatureCrypto::Ptr> idleSessions;
+        // the sessions opened or being opened
+        std::size_t openedSessions = 0;
+    };
+
+    void release(const std::string& _hsmLibPath, bcos::crypto::SignatureCrypto::Ptr _session);
+
+    SessionFactory m_sessionFactory;
+    std::size_t m_sessionCount;
+    std::map<std::string, Device> m_devices;
+    mutable std::mutex x_devices;
+    std::condition_variable m_released;
+};
+}  // namespace utilities
+}  // namespace cppsdk
+}  // namespace bcos
@@ -18,27 +18,84 @@
  * @date 2022-12-14
  */
 #include <bcos-cpp-sdk/utilities/Common.h>
+#include <bcos-cpp-sdk/utilities/ParallelChunks.h>
+#include <bcos-cpp-sdk/utilities/crypto/HsmSessionPool.h>
 #include <bcos-cpp-sdk/utilities/crypto/Signature.h>
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
 #include <bcos-crypto/interfaces/crypto/KeyInterface.h>
-#include <bcos-crypto/signature/hsmSM2/HsmSM2Crypto.h>
 #include <bcos-crypto/signature/key/KeyPair.h>
+#include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
+#include <bcos-crypto/signature/sm2/SM2Crypto.h>
 #include <bcos-utilities/BoostLog.h>
 #include <boost/throw_exception.hpp>
+#include <algorithm>
 #include <exception>
+#include <functional>
 #include <memory>
+#include <vector>
 
 using namespace bcos;
 using namespace bcos::cppsdk;
 using namespace bcos::cppsdk::utilities;
 
+namespace
+{
+// the signatures claimed by a verifying thread at a time
+constexpr std::size_t c_verifyBatchSize = 32;
+
+// the software implementations are stateless and shared by the threads, the hsm ones are not
+bcos::crypto::SignatureCrypto::Ptr softwareSignatureImpl(CryptoType _cryptoType)
+{
+    switch (_cryptoType)
+    {
+    case CryptoType::Secp256K1:
+        return std::make_shared<bcos::crypto::Secp256k1Crypto>();
+    case CryptoType::SM2:
+        return std::make_shared<bcos::crypto::SM2Crypto>();
+    case CryptoType::HsmSM2:
+        return nullptr;
+    default:
+        BOOST_THROW_EXCEPTION(std::runtime_error("sign don't unsupport algorithm "));
+    }
+}
+
+// run _f with the signature implementation of the chunk, a pooled session for the hsm
+void withSignatureImpl(const bcos::crypto::SignatureCrypto::Ptr& _softwareImpl,
+    const std::string& _hsmLibPath,
+    const std::function<void(bcos::crypto::SignatureCrypto&)>& _f)
+{
+    if (_softwareImpl)
+    {
+        _f(*_softwareImpl);
+        return;
+    }
+    auto session = HsmSessionPool::instance().acquire(_hsmLibPath);
+    _f(session.signatureImpl());
+}
+}  // namespace
+
 std::shared_ptr<bcos::bytes> Signature::sign(const bcos::crypto::KeyPairInterface& _keyPair,
     const bcos::crypto::HashType& _hash, const std::string _hsmLibPath)
 {
     auto crypto_type = _keyPair.keyPairType();
     if (crypto_type == CryptoType::HsmSM2)
     {
-        auto signatureImpl = std::make_shared<bcos::crypto::HsmSM2Crypto>(_hsmLibPath);
-        return signatureImpl->sign(_keyPair, _hash);
+        return HsmSessionPool::instance().sign(_keyPair, _hash, _hsmLibPath);
+    }
+    else
+    {
+        BOOST_THROW_EXCEPTION(std::runtime_error("sign don't unsupport algorithm "));
+    }
+}
+
+std::vector<std::shared_ptr<bcos::bytes>> Signature::signBatch(
+    const bcos::crypto::KeyPairInterface& _keyPair,
+    const std::vector<bcos::crypto::HashType>& _hashes, const std::string _hsmLibPath)
+{
+    auto crypto_type = _keyPair.keyPairType();
+    if (crypto_type == CryptoType::HsmSM2)
+    {
+        return HsmSessionPool::instance().signBatch(_keyPair, _hashes, _hsmLibPath);
     }
     else
     {
@@ -52,8 +109,8 @@ bool Signature::verify(CryptoType _cryptoType, std::shared_ptr<bcos::bytes const
 {
     if (_cryptoType == CryptoType::HsmSM2)
     {
-        auto signatureImpl = std::make_shared<bcos::crypto::HsmSM2Crypto>(_hsmLibPath);
-        return signatureImpl->verify(_pubKeyBytes, _hash, _signatureData);
+        auto session = HsmSessionPool::instance().acquire(_hsmLibPath);
+        return session->verify(_pubKeyBytes, _hash, _signatureData);
     }
     else
     {
@@ -67,8 +124,8 @@ bcos::crypto::PublicPtr Signature::recover(CryptoType _cryptoType,
 {
     if (_cryptoType == CryptoType::HsmSM2)
     {
-        auto signatureImpl = std::make_shared<bcos::crypto::HsmSM2Crypto>(_hsmLibPath);
-        return signatureImpl->recover(_hash, _signatureData);
+        auto session = HsmSessionPool::instance().acquire(_hsmLibPath);
+        return session->recover(_hash, _signatureData);
     }
     else
     {
@@ -81,11 +138,71 @@ std::pair<bool, bcos::bytes> Signature::recoverAddress(CryptoType _cryptoType,
 {
     if (_cryptoType == CryptoType::HsmSM2)
     {
-        auto signatureImpl = std::make_shared<bcos::crypto::HsmSM2Crypto>(_hsmLibPath);
-        return signatureImpl->recoverAddress(_hashImpl, _in);
+        auto session = HsmSessionPool::instance().acquire(_hsmLibPath);
+        return session->recoverAddress(_hashImpl, _in);
     }
     else
     {
         BOOST_THROW_EXCEPTION(std::runtime_error("sign don't unsupport algorithm "));
     }
 }
+
+std::vector<bool> Signature::verifyBatch(CryptoType _cryptoType,
+    std::span<const SignatureItem> _items, std::size_t _threadCount, const std::string _hsmLibPath)
+{
+    auto softwareImpl = softwareSignatureImpl(_cryptoType);
+    // the bits of std::vector<bool> are not written by the threads
+    std::vector<char> verified(_items.size(), 0);
+    parallelChunks(
+        _items.size(), c_verifyBatchSize, _threadCount, [&](std::size_t _begin, std::size_t _end) {
+            withSignatureImpl(
+                softwareImpl, _hsmLibPath, [&](bcos::crypto::SignatureCrypto& _signatureImpl) {
+                    for (auto i = _begin; i < _end; ++i)
+                    {
+                        const auto& item = _items[i];
+                        try
+                        {
+                            verified[i] =
+                                item.publicKey &&
+                                _signatureImpl.verify(item.publicKey, item.hash, item.signature);
+                        }
+                        catch (const std::exception&)
+                        {
+                            // the malformed signature or public key
+                            verified[i] = false;
+                        }
+                    }
+                });
+        });
+    return std::vector<bool>(verified.begin(), verified.end());
+}
+
+std::vector<std::pair<bool, bcos::bytes>> Signature::recoverAddressBatch(CryptoType _cryptoType,
+    bcos::crypto::Hash::Ptr _hashImpl, std::span<const SignatureItem> _items,
+    std::size_t _threadCount, const std::string _hsmLibPath)
+{
+    auto softwareImpl = softwareSignatureImpl(_cryptoType);
+    bcos::crypto::CryptoSuite cryptoSuite(_hashImpl, softwareImpl, nullptr);
+    std::vector<std::pair<bool, bcos::bytes>> results(_items.size());
+    parallelChunks(
+        _items.size(), c_verifyBatchSize, _threadCount, [&](std::size_t _begin, std::size_t _end) {
+            withSignatureImpl(
+                softwareImpl, _hsmLibPath, [&](bcos::crypto::SignatureCrypto& _signatureImpl) {
+                    for (auto i = _begin; i < _end; ++i)
+                    {
+                        try
+                        {
+                            auto publicKey =
+                                _signatureImpl.recover(_items[i].hash, _items[i].signature);
+                            results[i] = {true, cryptoSuite.calculateAddress(publicKey).asBytes()};
+                        }
+                        catch (const std::exception&)
+                        {
+                            // the malformed signature or no key recovered
+                            results[i] = {false, bcos::bytes()};
+                        }
+                    }
+                });
+        });
+    return results;
+}
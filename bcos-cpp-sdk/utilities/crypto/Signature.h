@@ -24,12 +24,23 @@
 #include <bcos-crypto/signature/key/KeyPair.h>
 #include <bcos-utilities/Common.h>
 #include <memory>
+#include <span>
+#include <vector>
 namespace bcos
 {
 namespace cppsdk
 {
 namespace utilities
 {
+// a signature of the batch APIs, the views must be alive until the call returns
+struct SignatureItem
+{
+    bcos::crypto::HashType hash;
+    bcos::bytesConstRef signature;
+    // the public key of the signer, verifyBatch only
+    std::shared_ptr<bcos::bytes const> publicKey;
+};
+
 class Signature
 {
 public:
@@ -40,6 +51,19 @@ public:
     std::shared_ptr<bcos::bytes> sign(const bcos::crypto::KeyPairInterface& _keyPair,
         const bcos::crypto::HashType& _hash,
         const std::string _hsmLibPath = "/usr/local/lib/libgmt0018.so");
+    /**
+     * @brief sign the hashes by the pooled hsm sessions of the library in parallel, see
+     * HsmSessionPool::setSessionCount for the number of the sessions
+     *
+     * @param _keyPair
+     * @param _hashes
+     * @param _hsmLibPath
+     * @return std::vector<std::shared_ptr<bcos::bytes>> the signatures in the order of _hashes
+     */
+    std::vector<std::shared_ptr<bcos::bytes>> signBatch(
+        const bcos::crypto::KeyPairInterface& _keyPair,
+        const std::vector<bcos::crypto::HashType>& _hashes,
+        const std::string _hsmLibPath = "/usr/local/lib/libgmt0018.so");
     bool verify(CryptoType _cryptoType, std::shared_ptr<bcos::bytes const> _pubKeyBytes,
         const bcos::crypto::HashType& _hash, bytesConstRef _signatureData,
         const std::string _hsmLibPath = "/usr/local/lib/libgmt0018.so");
@@ -49,6 +73,39 @@ public:
     std::pair<bool, bcos::bytes> recoverAddress(CryptoType _cryptoType,
         bcos::crypto::Hash::Ptr _hashImpl, bytesConstRef _in,
         const std::string _hsmLibPath = "/usr/local/lib/libgmt0018.so");
+
+    /**
+     * @brief verify the signatures of the items by their public keys in parallel, a malformed
+     * signature fails its own item only
+     *
+     * @param _cryptoType Secp256K1, SM2 or HsmSM2 by the pooled hsm sessions
+     * @param _items
+     * @param _threadCount the number of the verifying threads including the caller, 0 means the
+     * number of the cores
+     * @param _hsmLibPath
+     * @return std::vector<bool> the result of each item in the order of _items
+     */
+    std::vector<bool> verifyBatch(CryptoType _cryptoType, std::span<const SignatureItem> _items,
+        std::size_t _threadCount = 0,
+        const std::string _hsmLibPath = "/usr/local/lib/libgmt0018.so");
+
+    /**
+     * @brief recover the addresses of the signers of the items in parallel, the public keys of
+     * the items are not used
+     *
+     * @param _cryptoType Secp256K1, SM2 or HsmSM2 by the pooled hsm sessions
+     * @param _hashImpl the hash of the addresses
+     * @param _items
+     * @param _threadCount the number of the recovering threads including the caller, 0 means the
+     * number of the cores
+     * @param _hsmLibPath
+     * @return std::vector<std::pair<bool, bcos::bytes>> whether recovered and the address of each
+     * item in the order of _items
+     */
+    std::vector<std::pair<bool, bcos::bytes>> recoverAddressBatch(CryptoType _cryptoType,
+        bcos::crypto::Hash::Ptr _hashImpl, std::span<const SignatureItem> _items,
+        std::size_t _threadCount = 0,
+        const std::string _hsmLibPath = "/usr/local/lib/libgmt0018.so");
 };
 }  // namespace utilities
 }  // namespace cppsdk
@@ -19,6 +19,7 @@
  */
 
 #include "ReceiptBuilder.h"
+#include "ReceiptView.h"
 bcostars::ReceiptDataUniquePtr bcos::cppsdk::utilities::ReceiptBuilder::createReceiptData(
     const std::string& _gasUsed, const std::string& _contractAddress, const bcos::bytes& _output,
     int64_t _blockNumber)
@@ -72,10 +73,7 @@ bcos::bytesConstPtr bcos::cppsdk::utilities::ReceiptBuilder::encodeReceipt(
 std::string bcos::cppsdk::utilities::ReceiptBuilder::decodeReceiptDataToJsonObj(
     const bcos::bytes& _receiptBytes)
 {
-    tars::TarsInputStream<tars::BufferReader> inputStream;
-    inputStream.setBuffer((const char*)_receiptBytes.data(), _receiptBytes.size());
-    auto receiptData = std::make_unique<bcostars::TransactionReceiptData>();
-    receiptData->readFrom(inputStream);
-    auto receiptDataJson = receiptData->writeToJsonString();
-    return receiptDataJson;
+    // written from the views of the encoded bytes, the fields are not copied
+    ReceiptDataView receiptData(bcos::ref(_receiptBytes));
+    return receiptData.writeToJsonString();
 }
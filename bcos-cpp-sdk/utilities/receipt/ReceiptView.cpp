@@ -0,0 +1,304 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file ReceiptView.cpp
+ * @author: octopus
+ * @date 2023-04-11
+ */
+#include <bcos-cpp-sdk/utilities/Hex.h>
+#include <bcos-cpp-sdk/utilities/receipt/ReceiptView.h>
+#include <boost/endian/conversion.hpp>
+#include <algorithm>
+#include <variant>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::utilities;
+
+namespace
+{
+bcos::bytesConstRef toBytes(std::string_view _view)
+{
+    return bcos::bytesConstRef((const bcos::byte*)_view.data(), _view.size());
+}
+}  // namespace
+
+void LogEntryView::decode(tars::TarsViewReader& _reader)
+{
+    *this = LogEntryView();
+    tars::TarsViewReader::Head head;
+    while (_reader.nextField(head))
+    {
+        switch (head.tag)
+        {
+        case 1:
+            address = _reader.readString(head);
+            break;
+        case 2:
+        {
+            auto size = _reader.readListSize(head);
+            topic.reserve(size);
+            tars::TarsViewReader::Head elementHead;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                _reader.readElementHead(elementHead);
+                topic.push_back(toBytes(_reader.readBytes(elementHead)));
+            }
+            break;
+        }
+        case 3:
+            data = toBytes(_reader.readBytes(head));
+            break;
+        default:
+            _reader.skipField(head.type);
+            break;
+        }
+    }
+}
+
+void LogEntryView::toLogEntry(bcostars::LogEntry& _logEntry) const
+{
+    _logEntry.address = address;
+    _logEntry.topic.resize(topic.size());
+    for (std::size_t i = 0; i < topic.size(); ++i)
+    {
+        _logEntry.topic[i].assign(topic[i].begin(), topic[i].end());
+    }
+    _logEntry.data.assign(data.begin(), data.end());
+}
+
+void LogEntryView::writeToJsonStream(tars::JsonStreamWriter& _writer) const
+{
+    auto& buffer = _writer.buffer();
+    _writer.raw('{');
+    for (const auto& key : bcostars::LogEntry::jsonKeyOrder())
+    {
+        _writer.raw(key.prefix);
+        switch (key.field)
+        {
+        case 0:
+            _writer.writeString(address);
+            break;
+        case 1:
+            // the empty strings before the topics as LogEntry::writeToJson does
+            _writer.raw('[');
+            for (std::size_t i = 0; i < topic.size(); ++i)
+            {
+                _writer.raw(i > 0 ? ",\"\"" : "\"\"");
+            }
+            for (const auto& item : topic)
+            {
+                _writer.raw(",\"");
+                hexEncodeAppend(item, buffer);
+                _writer.raw('"');
+            }
+            _writer.raw(']');
+            break;
+        default:
+            _writer.raw('"');
+            hexEncodeAppend(data, buffer, true);
+            _writer.raw('"');
+            break;
+        }
+    }
+    _writer.raw('}');
+}
+
+void ReceiptDataView::decode(bcos::bytesConstRef _data)
+{
+    tars::TarsViewReader reader((const char*)_data.data(), _data.size());
+    decode(reader);
+}
+
+void ReceiptDataView::decode(tars::TarsViewReader& _reader)
+{
+    *this = ReceiptDataView();
+    bool versionFound = false;
+    tars::TarsViewReader::Head head;
+    while (_reader.nextField(head))
+    {
+        switch (head.tag)
+        {
+        case 1:
+            version = (int32_t)_reader.readInt(head);
+            versionFound = true;
+            break;
+        case 2:
+            gasUsed = _reader.readString(head);
+            break;
+        case 3:
+            contractAddress = _reader.readString(head);
+            break;
+        case 4:
+            status = (int32_t)_reader.readInt(head);
+            break;
+        case 5:
+            output = toBytes(_reader.readBytes(head));
+            break;
+        case 6:
+        {
+            // the size is bounded by the bytes left
+            logEntries.resize(_reader.readListSize(head));
+            tars::TarsViewReader::Head elementHead;
+            for (auto& logEntry : logEntries)
+            {
+                _reader.readElementHead(elementHead);
+                _reader.beginStruct(elementHead);
+                logEntry.decode(_reader);
+            }
+            break;
+        }
+        case 7:
+            blockNumber = _reader.readInt(head);
+            break;
+        default:
+            _reader.skipField(head.type);
+            break;
+        }
+    }
+    tars::TarsViewReader::checkRequired(versionFound, 1, "bcostars.TransactionReceiptData");
+}
+
+bcos::crypto::HashType ReceiptDataView::hash(const bcos::crypto::Hash::Ptr& _hashImpl) const
+{
+    auto anyHasher = _hashImpl->hasher();
+    bcos::crypto::HashType hashResult;
+    std::visit(
+        [this, &hashResult](auto& hasher) {
+            int32_t networkVersion = boost::endian::native_to_big(version);
+            hasher.update(networkVersion);
+            hasher.update(toBytes(gasUsed));
+            hasher.update(toBytes(contractAddress));
+            int32_t receiptStatus = boost::endian::native_to_big(status);
+            hasher.update(
+                bcos::bytesConstRef((const bcos::byte*)(&receiptStatus), sizeof(receiptStatus)));
+            hasher.update(output);
+            for (const auto& log : logEntries)
+            {
+                hasher.update(toBytes(log.address));
+                for (const auto& item : log.topic)
+                {
+                    hasher.update(item);
+                }
+                hasher.update(log.data);
+            }
+            int64_t receiptBlockNumber = boost::endian::native_to_big(blockNumber);
+            hasher.update(bcos::bytesConstRef(
+                (const bcos::byte*)(&receiptBlockNumber), sizeof(receiptBlockNumber)));
+            hasher.final(hashResult);
+        },
+        anyHasher);
+    return hashResult;
+}
+
+void ReceiptDataView::toReceiptData(bcostars::TransactionReceiptData& _receiptData) const
+{
+    _receiptData.version = version;
+    _receiptData.gasUsed = gasUsed;
+    _receiptData.contractAddress = contractAddress;
+    _receiptData.status = status;
+    _receiptData.output.assign(output.begin(), output.end());
+    _receiptData.logEntries.resize(logEntries.size());
+    for (std::size_t i = 0; i < logEntries.size(); ++i)
+    {
+        logEntries[i].toLogEntry(_receiptData.logEntries[i]);
+    }
+    _receiptData.blockNumber = blockNumber;
+}
+
+void ReceiptDataView::writeToJsonStream(tars::JsonStreamWriter& _writer) const
+{
+    _writer.raw('{');
+    for (const auto& key : bcostars::TransactionReceiptData::jsonKeyOrder())
+    {
+        _writer.raw(key.prefix);
+        switch (key.field)
+        {
+        case 0:
+            _writer.writeInt(version);
+            break;
+        case 1:
+            _writer.writeString(gasUsed);
+            break;
+        case 2:
+            _writer.writeString(contractAddress);
+            break;
+        case 3:
+            _writer.writeInt(status);
+            break;
+        case 4:
+            _writer.raw('"');
+            hexEncodeAppend(output, _writer.buffer(), true);
+            _writer.raw('"');
+            break;
+        case 5:
+            _writer.raw('[');
+            for (std::size_t i = 0; i < logEntries.size(); ++i)
+            {
+                if (i > 0)
+                {
+                    _writer.raw(',');
+                }
+                logEntries[i].writeToJsonStream(_writer);
+            }
+            _writer.raw(']');
+            break;
+        default:
+            _writer.writeInt(blockNumber);
+            break;
+        }
+    }
+    _writer.raw('}');
+}
+
+std::string ReceiptDataView::writeToJsonString() const
+{
+    std::string json;
+    tars::JsonStreamWriter writer(json);
+    writeToJsonStream(writer);
+    return json;
+}
+
+void ReceiptView::decode(bcos::bytesConstRef _data)
+{
+    *this = ReceiptView();
+    tars::TarsViewReader reader((const char*)_data.data(), _data.size());
+    tars::TarsViewReader::Head head;
+    while (reader.nextField(head))
+    {
+        switch (head.tag)
+        {
+        case 1:
+            reader.beginStruct(head);
+            data.decode(reader);
+            break;
+        case 2:
+            dataHash = toBytes(reader.readBytes(head));
+            break;
+        case 3:
+            message = reader.readString(head);
+            break;
+        default:
+            reader.skipField(head.type);
+            break;
+        }
+    }
+}
+
+bool ReceiptView::verifyHash(const bcos::crypto::Hash::Ptr& _hashImpl) const
+{
+    auto hash = data.hash(_hashImpl);
+    return std::equal(dataHash.begin(), dataHash.end(), hash.begin(), hash.end());
+}
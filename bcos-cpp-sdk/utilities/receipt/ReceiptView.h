@@ -0,0 +1,126 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the tars encoded receipt decoded as the views of the encoded bytes
+ * @file ReceiptView.h
+ * @author: octopus
+ * @date 2023-04-11
+ */
+#pragma once
+#include <bcos-cpp-sdk/utilities/receipt/TransactionReceipt.h>
+#include <bcos-cpp-sdk/utilities/tx/tars/tup/TarsJsonStream.h>
+#include <bcos-cpp-sdk/utilities/tx/tars/tup/TarsView.h>
+#include <bcos-crypto/interfaces/crypto/Hash.h>
+#include <bcos-utilities/Common.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace utilities
+{
+/**
+ * @brief the fields of the encoded bcostars::LogEntry as the views of the encoded bytes
+ */
+class LogEntryView
+{
+public:
+    void decode(tars::TarsViewReader& _reader);
+
+    void toLogEntry(bcostars::LogEntry& _logEntry) const;
+
+    // the same json as bcostars::LogEntry::writeToJsonStream
+    void writeToJsonStream(tars::JsonStreamWriter& _writer) const;
+
+public:
+    std::string_view address;
+    std::vector<bcos::bytesConstRef> topic;
+    bcos::bytesConstRef data;
+};
+
+/**
+ * @brief the fields of the encoded bcostars::TransactionReceiptData, the strings and the bytes
+ * are the views of the encoded bytes and valid as long as them
+ */
+class ReceiptDataView
+{
+public:
+    ReceiptDataView() = default;
+    // throw tars::TarsDecodeException if _data is not an encoded TransactionReceiptData
+    explicit ReceiptDataView(bcos::bytesConstRef _data) { decode(_data); }
+
+    void decode(bcos::bytesConstRef _data);
+    // decode the fields of the struct from the reader, till the end of the buffer or the struct
+    void decode(tars::TarsViewReader& _reader);
+
+    /**
+     * @brief the hash of the data, the same as bcostars::TransactionReceiptData::hash
+     *
+     * @param _hashImpl
+     * @return bcos::crypto::HashType
+     */
+    bcos::crypto::HashType hash(const bcos::crypto::Hash::Ptr& _hashImpl) const;
+
+    // copy the fields into the struct
+    void toReceiptData(bcostars::TransactionReceiptData& _receiptData) const;
+
+    // the same json as bcostars::TransactionReceiptData::writeToJsonString
+    void writeToJsonStream(tars::JsonStreamWriter& _writer) const;
+    std::string writeToJsonString() const;
+
+public:
+    int32_t version = 0;
+    std::string_view gasUsed;
+    std::string_view contractAddress;
+    int32_t status = 0;
+    bcos::bytesConstRef output;
+    std::vector<LogEntryView> logEntries;
+    int64_t blockNumber = 0;
+};
+
+/**
+ * @brief the fields of the encoded bcostars::TransactionReceipt as the views of the encoded bytes
+ */
+class ReceiptView
+{
+public:
+    ReceiptView() = default;
+    // throw tars::TarsDecodeException if _data is not an encoded TransactionReceipt
+    explicit ReceiptView(bcos::bytesConstRef _data) { decode(_data); }
+
+    void decode(bcos::bytesConstRef _data);
+
+    // the receipt hash carried by the receipt
+    bcos::bytesConstRef hash() const { return dataHash; }
+
+    /**
+     * @brief check the hash carried by the receipt against the hash of its data
+     *
+     * @param _hashImpl
+     * @return bool
+     */
+    bool verifyHash(const bcos::crypto::Hash::Ptr& _hashImpl) const;
+
+public:
+    ReceiptDataView data;
+    bcos::bytesConstRef dataHash;
+    std::string_view message;
+};
+}  // namespace utilities
+}  // namespace cppsdk
+}  // namespace bcos
@@ -6,6 +6,8 @@
 #pragma once
 #include "bcos-cpp-sdk/utilities/tx/tars/tup/Tars.h"
 #include "bcos-cpp-sdk/utilities/tx/tars/tup/TarsJson.h"
+#include "bcos-cpp-sdk/utilities/tx/tars/tup/TarsJsonStream.h"
+#include <bcos-cpp-sdk/utilities/Hex.h>
 #include <bcos-crypto/interfaces/crypto/Hash.h>
 #include <bcos-utilities/DataConvertUtility.h>
 #include <boost/asio/detail/socket_ops.hpp>
@@ -59,11 +61,12 @@ public:
         topics.resize(topic.size());
         for (const auto& item : topic)
         {
-            std::string hex = bcos::toHex(item);
+            std::string hex = bcos::cppsdk::utilities::hexEncode(item);
             topics.push_back(std::move(hex));
         }
         p->value["topics"] = tars::JsonOutput::writeJson(topics);
-        p->value["data"] = tars::JsonOutput::writeJson(bcos::toHexStringWithPrefix(data));
+        p->value["data"] =
+            tars::JsonOutput::writeJson(bcos::cppsdk::utilities::hexEncode(data, true));
         return p;
     }
     void readFromJson(const tars::JsonValuePtr& p, bool isRequire = true)
@@ -89,15 +92,97 @@ public:
             {
                 std::string topicHex{};
                 tars::JsonInput::readJson(topicHex, *it, true);
-                auto topicBytes = bcos::fromHexString(topicHex);
-                std::copy(topicBytes->begin(), topicBytes->end(), std::back_inserter(topic[i]));
+                bcos::cppsdk::utilities::hexDecodeAppend(topicHex, topic[i]);
             }
         }
 
         std::string dataHex{};
         tars::JsonInput::readJson(dataHex, pObj->value["data"], true);
-        auto dataBytes = bcos::fromHexString(dataHex);
-        std::copy(dataBytes->begin(), dataBytes->end(), std::back_inserter(data));
+        bcos::cppsdk::utilities::hexDecodeAppend(dataHex, data);
+    }
+    // the order the fields are written in by writeToJson
+    static const tars::JsonKeyOrder& jsonKeyOrder()
+    {
+        static const tars::JsonKeyOrder keyOrder{"address", "topics", "data"};
+        return keyOrder;
+    }
+    void writeToJsonStream(tars::JsonStreamWriter& _writer) const
+    {
+        auto& buffer = _writer.buffer();
+        _writer.raw('{');
+        for (const auto& key : jsonKeyOrder())
+        {
+            _writer.raw(key.prefix);
+            switch (key.field)
+            {
+            case 0:
+                _writer.writeString(address);
+                break;
+            case 1:
+                // the empty strings before the topics as writeToJson does
+                _writer.raw('[');
+                for (std::size_t i = 0; i < topic.size(); ++i)
+                {
+                    _writer.raw(i > 0 ? ",\"\"" : "\"\"");
+                }
+                for (const auto& item : topic)
+                {
+                    _writer.raw(",\"");
+                    bcos::cppsdk::utilities::hexEncodeAppend(item, buffer);
+                    _writer.raw('"');
+                }
+                _writer.raw(']');
+                break;
+            default:
+                _writer.raw('"');
+                bcos::cppsdk::utilities::hexEncodeAppend(data, buffer, true);
+                _writer.raw('"');
+                break;
+            }
+        }
+        _writer.raw('}');
+    }
+    void readFromJsonStream(tars::JsonStreamReader& _reader)
+    {
+        resetDefault();
+        auto type = _reader.peekType();
+        if (type != tars::eJsonTypeObj)
+        {
+            char s[128];
+            snprintf(s, sizeof(s), "read 'struct' type mismatch, get type: %d.", type);
+            throw tars::TC_Json_Exception(s);
+        }
+        uint32_t found = 0;
+        _reader.readObject([this, &_reader, &found](std::string_view _key) {
+            if (_key == "address")
+            {
+                _reader.read(address, true);
+                found |= 1 << 0;
+            }
+            else if (_key == "topics" && _reader.peekType() == tars::eJsonTypeArray)
+            {
+                topic.clear();
+                _reader.readArray([this, &_reader]() {
+                    std::string_view topicHex;
+                    _reader.readStringView(topicHex, true);
+                    topic.emplace_back();
+                    bcos::cppsdk::utilities::hexDecodeAppend(topicHex, topic.back());
+                });
+            }
+            else if (_key == "data")
+            {
+                std::string_view dataHex;
+                _reader.readStringView(dataHex, true);
+                found |= 1 << 2;
+                data.clear();
+                bcos::cppsdk::utilities::hexDecodeAppend(dataHex, data);
+            }
+            else
+            {
+                _reader.skipValue();
+            }
+        });
+        tars::JsonStreamReader::checkRequired(found, 0x05, "bcostars.LogEntry");
     }
     std::ostream& display(std::ostream& _os, int _level = 0) const
     {
@@ -194,14 +279,65 @@ public:
         p->value["gasUsed"] = tars::JsonOutput::writeJson(gasUsed);
         p->value["contractAddress"] = tars::JsonOutput::writeJson(contractAddress);
         p->value["status"] = tars::JsonOutput::writeJson(status);
-        p->value["output"] = tars::JsonOutput::writeJson(bcos::toHexStringWithPrefix(output));
+        p->value["output"] =
+            tars::JsonOutput::writeJson(bcos::cppsdk::utilities::hexEncode(output, true));
         p->value["logEntries"] = tars::JsonOutput::writeJson(logEntries);
         p->value["blockNumber"] = tars::JsonOutput::writeJson(blockNumber);
         return p;
     }
+    // the order the fields are written in by writeToJson
+    static const tars::JsonKeyOrder& jsonKeyOrder()
+    {
+        static const tars::JsonKeyOrder keyOrder{"version", "gasUsed", "contractAddress",
+            "status", "output", "logEntries", "blockNumber"};
+        return keyOrder;
+    }
+    void writeToJsonStream(tars::JsonStreamWriter& _writer) const
+    {
+        _writer.raw('{');
+        for (const auto& key : jsonKeyOrder())
+        {
+            _writer.raw(key.prefix);
+            switch (key.field)
+            {
+            case 0:
+                _writer.writeInt(version);
+                break;
+            case 1:
+                _writer.writeString(gasUsed);
+                break;
+            case 2:
+                _writer.writeString(contractAddress);
+                break;
+            case 3:
+                _writer.writeInt(status);
+                break;
+            case 4:
+                _writer.raw('"');
+                bcos::cppsdk::utilities::hexEncodeAppend(output, _writer.buffer(), true);
+                _writer.raw('"');
+                break;
+            case 5:
+                _writer.writeStructs(logEntries);
+                break;
+            default:
+                _writer.writeInt(blockNumber);
+                break;
+            }
+        }
+        _writer.raw('}');
+    }
     [[nodiscard]] std::string writeToJsonString() const
     {
-        return tars::TC_Json::writeValue(writeToJson());
+        std::string json;
+        writeToJsonString(json);
+        return json;
+    }
+    // append the json to _json
+    void writeToJsonString(std::string& _json) const
+    {
+        tars::JsonStreamWriter writer(_json);
+        writeToJsonStream(writer);
     }
 
     void readFromJson(const tars::JsonValuePtr& p, bool isRequire = true)
@@ -222,13 +358,72 @@ public:
 
         std::string outputHex{};
         tars::JsonInput::readJson(outputHex, pObj->value["output"], true);
-        auto outputBytes = bcos::fromHexString(outputHex);
-        std::copy(outputBytes->begin(), outputBytes->end(), std::back_inserter(output));
+        bcos::cppsdk::utilities::hexDecodeAppend(outputHex, output);
 
         tars::JsonInput::readJson(logEntries, pObj->value["logEntries"], false);
         tars::JsonInput::readJson(blockNumber, pObj->value["blockNumber"], true);
     }
-    void readFromJsonString(const std::string& str) { readFromJson(tars::TC_Json::getValue(str)); }
+    void readFromJsonStream(tars::JsonStreamReader& _reader)
+    {
+        resetDefault();
+        auto type = _reader.peekType();
+        if (type != tars::eJsonTypeObj)
+        {
+            char s[128];
+            snprintf(s, sizeof(s), "read 'struct' type mismatch, get type: %d.", type);
+            throw tars::TC_Json_Exception(s);
+        }
+        uint32_t found = 0;
+        _reader.readObject([this, &_reader, &found](std::string_view _key) {
+            if (_key == "version")
+            {
+                _reader.read(version, true);
+                found |= 1 << 0;
+            }
+            else if (_key == "gasUsed")
+            {
+                _reader.read(gasUsed, true);
+                found |= 1 << 1;
+            }
+            else if (_key == "contractAddress")
+            {
+                _reader.read(contractAddress, true);
+                found |= 1 << 2;
+            }
+            else if (_key == "status")
+            {
+                _reader.read(status, true);
+                found |= 1 << 3;
+            }
+            else if (_key == "output")
+            {
+                std::string_view outputHex;
+                _reader.readStringView(outputHex, true);
+                found |= 1 << 4;
+                output.clear();
+                bcos::cppsdk::utilities::hexDecodeAppend(outputHex, output);
+            }
+            else if (_key == "logEntries")
+            {
+                _reader.readStructs(logEntries, false);
+            }
+            else if (_key == "blockNumber")
+            {
+                _reader.read(blockNumber, true);
+                found |= 1 << 6;
+            }
+            else
+            {
+                _reader.skipValue();
+            }
+        });
+        tars::JsonStreamReader::checkRequired(found, 0x5f, "bcostars.TransactionReceiptData");
+    }
+    void readFromJsonString(const std::string& str)
+    {
+        tars::JsonStreamReader reader(str.data(), str.size());
+        readFromJsonStream(reader);
+    }
     std::ostream& display(std::ostream& _os, int _level = 0) const
     {
         tars::TarsDisplayer _ds(_os, _level);
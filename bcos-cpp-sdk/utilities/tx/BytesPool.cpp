@@ -0,0 +1,82 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file BytesPool.cpp
+ * @author: octopus
+ * @date 2023-04-08
+ */
+#include <bcos-cpp-sdk/utilities/tx/BytesPool.h>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::utilities;
+
+bcos::bytes BytesPool::acquire()
+{
+    {
+        std::lock_guard<std::mutex> lock(x_buffers);
+        if (!m_buffers.empty())
+        {
+            auto buffer = std::move(m_buffers.back());
+            m_buffers.pop_back();
+            m_bytes -= buffer.capacity();
+            m_reused++;
+            return buffer;
+        }
+    }
+    m_missed++;
+    return bcos::bytes();
+}
+
+void BytesPool::release(bcos::bytes&& _bytes)
+{
+    if (_bytes.capacity() == 0 || _bytes.capacity() > m_maxCapacity)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(x_buffers);
+    if (m_buffers.size() < m_maxCount && m_bytes + _bytes.capacity() <= m_maxBytes)
+    {
+        m_bytes += _bytes.capacity();
+        m_buffers.emplace_back(std::move(_bytes));
+    }
+}
+
+std::shared_ptr<bcos::bytes> BytesPool::share(bcos::bytes&& _bytes)
+{
+    std::weak_ptr<BytesPool> weakPool = weak_from_this();
+    return std::shared_ptr<bcos::bytes>(
+        new bcos::bytes(std::move(_bytes)), [weakPool](bcos::bytes* _buffer) {
+            auto pool = weakPool.lock();
+            if (pool)
+            {
+                pool->release(std::move(*_buffer));
+            }
+            delete _buffer;
+        });
+}
+
+std::size_t BytesPool::size() const
+{
+    std::lock_guard<std::mutex> lock(x_buffers);
+    return m_buffers.size();
+}
+
+std::size_t BytesPool::retainedBytes() const
+{
+    std::lock_guard<std::mutex> lock(x_buffers);
+    return m_bytes;
+}
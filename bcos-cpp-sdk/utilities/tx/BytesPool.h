@@ -0,0 +1,156 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file BytesPool.h
+ * @author: octopus
+ * @date 2023-04-08
+ */
+#pragma once
+#include <bcos-cpp-sdk/utilities/tx/tars/tup/Tars.h>
+#include <bcos-utilities/Common.h>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace utilities
+{
+/**
+ * @brief the free list of the encode buffers, the buffers shared by share() are recycled when the
+ * last owner releases them
+ */
+class BytesPool : public std::enable_shared_from_this<BytesPool>
+{
+public:
+    using Ptr = std::shared_ptr<BytesPool>;
+    using ConstPtr = std::shared_ptr<const BytesPool>;
+
+    /**
+     * @param _maxCount the max number of the free buffers
+     * @param _maxCapacity the buffers larger than it are freed instead of recycled
+     * @param _maxBytes the max capacity of all the free buffers
+     */
+    BytesPool(std::size_t _maxCount = 256, std::size_t _maxCapacity = 1024 * 1024,
+        std::size_t _maxBytes = 16 * 1024 * 1024)
+      : m_maxCount(_maxCount), m_maxCapacity(_maxCapacity), m_maxBytes(_maxBytes)
+    {}
+
+public:
+    // a free buffer or an empty one when the pool is empty
+    bcos::bytes acquire();
+    void release(bcos::bytes&& _bytes);
+    // the shared buffer released to the pool with its last owner
+    std::shared_ptr<bcos::bytes> share(bcos::bytes&& _bytes);
+
+    std::size_t size() const;
+    // the capacity of the free buffers
+    std::size_t retainedBytes() const;
+    // the number of the acquires served by the free list
+    uint64_t reused() const { return m_reused; }
+    // the number of the acquires the pool is empty
+    uint64_t missed() const { return m_missed; }
+
+private:
+    std::size_t m_maxCount;
+    std::size_t m_maxCapacity;
+    std::size_t m_maxBytes;
+
+    mutable std::mutex x_buffers;
+    std::vector<bcos::bytes> m_buffers;
+    std::size_t m_bytes = 0;
+
+    std::atomic<uint64_t> m_reused{0};
+    std::atomic<uint64_t> m_missed{0};
+};
+
+/**
+ * @brief the tars writer encoding into a bcos::bytes, reserve() the encoded size before writing to
+ * grow the buffer at most once, detach() the encoded bytes without copy
+ */
+class BytesBufferWriter
+{
+protected:
+    bcos::bytes _buffer;
+    char* _buf;
+    size_t _len;
+    size_t _buf_len;
+    std::function<char*(BytesBufferWriter&, size_t)> _reserve;
+
+private:
+    BytesBufferWriter(const BytesBufferWriter&);
+    BytesBufferWriter& operator=(const BytesBufferWriter& buf);
+
+public:
+    BytesBufferWriter() : _buf(NULL), _len(0), _buf_len(0)
+    {
+        _reserve = [](BytesBufferWriter& os, size_t len) {
+            os._buffer.resize(len);
+            return (char*)os._buffer.data();
+        };
+    }
+
+    ~BytesBufferWriter() {}
+
+    void reset() { _len = 0; }
+
+    void writeBuf(const char* buf, size_t len)
+    {
+        TarsReserveBuf(*this, _len + len);
+        memcpy(_buf + _len, buf, len);
+        _len += len;
+    }
+
+    const char* getBuffer() const { return _buf; }
+    size_t getLength() const { return _len; }
+
+    // encode into _bytes, the content is dropped
+    void attach(bcos::bytes&& _bytes)
+    {
+        _buffer = std::move(_bytes);
+        _buf = _buffer.empty() ? NULL : (char*)_buffer.data();
+        _buf_len = _buffer.size();
+        _len = 0;
+    }
+
+    // make sure _size bytes can be written without growing
+    void reserve(size_t _size)
+    {
+        if (_buf_len < _len + _size)
+        {
+            _buf = _reserve(*this, _len + _size);
+            _buf_len = _len + _size;
+        }
+    }
+
+    // the encoded bytes, the writer is empty after it
+    bcos::bytes detach()
+    {
+        _buffer.resize(_len);
+        _buf = NULL;
+        _buf_len = 0;
+        _len = 0;
+        return std::move(_buffer);
+    }
+};
+}  // namespace utilities
+}  // namespace cppsdk
+}  // namespace bcos
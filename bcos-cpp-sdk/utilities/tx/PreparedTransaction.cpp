@@ -0,0 +1,183 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file PreparedTransaction.cpp
+ * @author: octopus
+ * @date 2023-04-07
+ */
+#include <bcos-cpp-sdk/utilities/Hex.h>
+#include <bcos-cpp-sdk/utilities/tx/PreparedTransaction.h>
+#include <bcos-cpp-sdk/utilities/tx/TransactionBuilder.h>
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/hash/SM3.h>
+#include <bcos-utilities/DataConvertUtility.h>
+#include <boost/endian/conversion.hpp>
+#include <utility>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::utilities;
+
+namespace
+{
+void writeEncoded(tars::TarsOutputStream<tars::BufferWriter>& _output, const std::string& _encoded)
+{
+    if (!_encoded.empty())
+    {
+        _output.writeBuf(_encoded.data(), _encoded.size());
+    }
+}
+
+std::string toEncoded(const tars::TarsOutputStream<tars::BufferWriter>& _output)
+{
+    return std::string(_output.getBuffer(), _output.getLength());
+}
+}  // namespace
+
+PreparedTransaction::PreparedTransaction(TransactionBuilderInterface::Ptr _builder,
+    CryptoType _cryptoType, std::string _groupID, std::string _chainID, std::string _to,
+    std::string _abi, int32_t _attribute, std::string _extraData)
+  : m_builder(std::move(_builder)),
+    m_groupID(std::move(_groupID)),
+    m_chainID(std::move(_chainID)),
+    m_to(std::move(_to)),
+    m_abi(std::move(_abi)),
+    m_attribute(_attribute),
+    m_extraData(std::move(_extraData))
+{
+    if (_cryptoType == bcos::crypto::KeyPairType::SM2 ||
+        _cryptoType == bcos::crypto::KeyPairType::HsmSM2)
+    {
+        m_hashImpl = std::make_shared<bcos::crypto::SM3>();
+    }
+    else
+    {
+        m_hashImpl = std::make_shared<bcos::crypto::Keccak256>();
+    }
+
+    // the same order as bcostars::TransactionData::hash, the version is always 0
+    int32_t networkVersion = boost::endian::native_to_big((int32_t)0);
+    m_hashPrefix.insert(m_hashPrefix.end(), (const bcos::byte*)&networkVersion,
+        (const bcos::byte*)&networkVersion + sizeof(networkVersion));
+    m_hashPrefix.insert(m_hashPrefix.end(), m_chainID.begin(), m_chainID.end());
+    m_hashPrefix.insert(m_hashPrefix.end(), m_groupID.begin(), m_groupID.end());
+
+    // the same fields as bcostars::Transaction::writeTo and bcostars::TransactionData::writeTo
+    tars::TarsOutputStream<tars::BufferWriter> output;
+    TarsWriteToHead(output, TarsHeadeStructBegin, 1);
+    output.write((tars::Int32)0, 1);
+    output.write(m_chainID, 2);
+    output.write(m_groupID, 3);
+    m_encodedHead = toEncoded(output);
+
+    output.reset();
+    if (!m_to.empty())
+    {
+        output.write(m_to, 6);
+    }
+    m_encodedTo = toEncoded(output);
+
+    output.reset();
+    if (!m_abi.empty())
+    {
+        output.write(m_abi, 8);
+    }
+    TarsWriteToHead(output, TarsHeadeStructEnd, 0);
+    m_encodedDataTail = toEncoded(output);
+
+    output.reset();
+    if (m_attribute != 0)
+    {
+        output.write(m_attribute, 5);
+    }
+    if (!m_extraData.empty())
+    {
+        output.write(m_extraData, 8);
+    }
+    m_encodedTail = toEncoded(output);
+}
+
+bcostars::TransactionDataUniquePtr PreparedTransaction::createTransactionData(
+    bcos::bytesConstRef _input, int64_t _blockLimit, const std::string& _nonce) const
+{
+    auto transactionData = std::make_unique<bcostars::TransactionData>();
+    transactionData->version = 0;
+    transactionData->chainID = m_chainID;
+    transactionData->groupID = m_groupID;
+    transactionData->to = m_to;
+    transactionData->blockLimit = _blockLimit;
+    transactionData->nonce = _nonce;
+    transactionData->abi = m_abi;
+    transactionData->input.assign(_input.begin(), _input.end());
+    return transactionData;
+}
+
+crypto::HashType PreparedTransaction::hash(
+    bcos::bytesConstRef _input, int64_t _blockLimit, const std::string& _nonce) const
+{
+    auto anyHasher = m_hashImpl->hasher();
+    bcos::crypto::HashType hashResult;
+    std::visit(
+        [this, &_input, _blockLimit, &_nonce, &hashResult](auto& hasher) {
+            // version, chainID and groupID
+            hasher.update(bcos::bytesConstRef(m_hashPrefix.data(), m_hashPrefix.size()));
+            int64_t networkBlockLimit = boost::endian::native_to_big(_blockLimit);
+            hasher.update(bcos::bytesConstRef(
+                (const bcos::byte*)(&networkBlockLimit), sizeof(networkBlockLimit)));
+            hasher.update(bcos::bytesConstRef((const bcos::byte*)_nonce.data(), _nonce.size()));
+            hasher.update(bcos::bytesConstRef((const bcos::byte*)m_to.data(), m_to.size()));
+            hasher.update(_input);
+            hasher.update(bcos::bytesConstRef((const bcos::byte*)m_abi.data(), m_abi.size()));
+
+            hasher.final(hashResult);
+        },
+        anyHasher);
+    return hashResult;
+}
+
+void PreparedTransaction::encode(tars::TarsOutputStream<tars::BufferWriter>& _output,
+    bcos::bytesConstRef _input, int64_t _blockLimit, const std::string& _nonce,
+    const crypto::HashType& _hash, bcos::bytesConstRef _signData) const
+{
+    writeEncoded(_output, m_encodedHead);
+    _output.write((tars::Int64)_blockLimit, 4);
+    _output.write(_nonce, 5);
+    writeEncoded(_output, m_encodedTo);
+    _output.write((const char*)_input.data(), (tars::UInt32)_input.size(), 7);
+    writeEncoded(_output, m_encodedDataTail);
+    _output.write((const char*)_hash.data(), (tars::UInt32)(_hash.end() - _hash.begin()), 2);
+    if (!_signData.empty())
+    {
+        _output.write((const char*)_signData.data(), (tars::UInt32)_signData.size(), 3);
+    }
+    writeEncoded(_output, m_encodedTail);
+}
+
+std::pair<std::string, std::string> PreparedTransaction::createSignedTransaction(
+    const bcos::crypto::KeyPairInterface& _keyPair, bcos::bytesConstRef _input,
+    int64_t _blockLimit) const
+{
+    static thread_local tars::TarsOutputStream<tars::BufferWriter> output;
+
+    auto nonce = TransactionBuilder::generateRandomStr();
+    auto transactionDataHash = hash(_input, _blockLimit, nonce);
+    auto signData = m_builder->signTransactionDataHash(_keyPair, transactionDataHash);
+
+    output.reset();
+    encode(output, _input, _blockLimit, nonce, transactionDataHash, bcos::ref(*signData));
+    return std::make_pair(hexEncode(transactionDataHash, true),
+        hexEncode(
+            bcos::bytesConstRef((const bcos::byte*)output.getBuffer(), output.getLength()), true));
+}
@@ -0,0 +1,136 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file PreparedTransaction.h
+ * @author: octopus
+ * @date 2023-04-07
+ */
+#pragma once
+#include <bcos-cpp-sdk/utilities/tx/Transaction.h>
+#include <bcos-cpp-sdk/utilities/tx/TransactionBuilderInterface.h>
+#include <bcos-crypto/interfaces/crypto/Hash.h>
+#include <bcos-utilities/Common.h>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace utilities
+{
+/**
+ * @brief the template of the transactions with the same group, chain, to, abi, attribute and
+ * extraData, the constant fields are encoded and the constant prefix of the hash is laid out once,
+ * each transaction only encodes and hashes blockLimit, nonce and input
+ */
+class PreparedTransaction
+{
+public:
+    using Ptr = std::shared_ptr<PreparedTransaction>;
+    using ConstPtr = std::shared_ptr<const PreparedTransaction>;
+
+    /**
+     * @param _builder sign the transaction data hash
+     * @param _cryptoType the type of the key pairs signing the transactions
+     */
+    PreparedTransaction(TransactionBuilderInterface::Ptr _builder, CryptoType _cryptoType,
+        std::string _groupID, std::string _chainID, std::string _to, std::string _abi,
+        int32_t _attribute = 0, std::string _extraData = "");
+
+public:
+    /**
+     * @brief Create a Transaction Data object of the template
+     *
+     * @param _input
+     * @param _blockLimit
+     * @param _nonce
+     * @return bcostars::TransactionDataUniquePtr
+     */
+    bcostars::TransactionDataUniquePtr createTransactionData(
+        bcos::bytesConstRef _input, int64_t _blockLimit, const std::string& _nonce) const;
+
+    /**
+     * @brief the transaction data hash, the same as bcostars::TransactionData::hash
+     *
+     * @param _input
+     * @param _blockLimit
+     * @param _nonce
+     * @return crypto::HashType
+     */
+    crypto::HashType hash(
+        bcos::bytesConstRef _input, int64_t _blockLimit, const std::string& _nonce) const;
+
+    /**
+     * @brief append the encoded signed transaction to _output, the same bytes as
+     * TransactionBuilder::createSignedTransaction
+     *
+     * @param _output
+     * @param _input
+     * @param _blockLimit
+     * @param _nonce
+     * @param _hash
+     * @param _signData
+     */
+    void encode(tars::TarsOutputStream<tars::BufferWriter>& _output, bcos::bytesConstRef _input,
+        int64_t _blockLimit, const std::string& _nonce, const crypto::HashType& _hash,
+        bcos::bytesConstRef _signData) const;
+
+    /**
+     * @brief Create a Signed Transaction object with a new nonce
+     *
+     * @param _keyPair
+     * @param _input
+     * @param _blockLimit
+     * @return std::pair<std::string, std::string> the hash and the encoded transaction
+     */
+    std::pair<std::string, std::string> createSignedTransaction(
+        const bcos::crypto::KeyPairInterface& _keyPair, bcos::bytesConstRef _input,
+        int64_t _blockLimit) const;
+
+public:
+    const std::string& groupID() const { return m_groupID; }
+    const std::string& chainID() const { return m_chainID; }
+    const std::string& to() const { return m_to; }
+    const std::string& abi() const { return m_abi; }
+    int32_t attribute() const { return m_attribute; }
+    const std::string& extraData() const { return m_extraData; }
+
+private:
+    TransactionBuilderInterface::Ptr m_builder;
+    bcos::crypto::Hash::Ptr m_hashImpl;
+
+    std::string m_groupID;
+    std::string m_chainID;
+    std::string m_to;
+    std::string m_abi;
+    int32_t m_attribute;
+    std::string m_extraData;
+
+    // version, chainID and groupID hashed before blockLimit
+    bcos::bytes m_hashPrefix;
+    // the transaction begin, data begin, version, chainID and groupID
+    std::string m_encodedHead;
+    // to
+    std::string m_encodedTo;
+    // abi and data end
+    std::string m_encodedDataTail;
+    // attribute and extraData
+    std::string m_encodedTail;
+};
+}  // namespace utilities
+}  // namespace cppsdk
+}  // namespace bcos
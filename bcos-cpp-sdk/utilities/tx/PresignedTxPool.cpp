@@ -0,0 +1,324 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file PresignedTxPool.cpp
+ * @author: octopus
+ * @date 2023-04-10
+ */
+#include <bcos-cpp-sdk/utilities/Common.h>
+#include <bcos-cpp-sdk/utilities/tx/PresignedTxPool.h>
+#include <bcos-utilities/BoostLog.h>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::utilities;
+
+// the transactions signed by one task of the background pool
+static const std::size_t c_signBatchSize = 16;
+
+PresignedTxPool::PresignedTxPool(Settings _settings, BlockLimitFunc _blockLimit)
+  : m_settings(_settings), m_blockLimit(std::move(_blockLimit))
+{}
+
+PresignedTxPool::PresignedTxPool(Settings _settings, TransactionBuilderService::Ptr _builderService)
+  : m_settings(_settings), m_builderService(std::move(_builderService))
+{
+    auto service = m_builderService->service();
+    auto group = m_builderService->groupInfo()->groupID();
+    m_blockLimit = [service, group](int64_t& _blockLimit) {
+        return service->getBlockLimit(group, _blockLimit);
+    };
+}
+
+void PresignedTxPool::start()
+{
+    if (m_running.exchange(true))
+    {
+        return;
+    }
+
+    m_signer = std::make_shared<bcos::ThreadPool>(
+        "t_presign", std::max<std::size_t>(m_settings.threadCount, 1));
+
+    // NOTE: the notifier can not be unregistered, registered once for the pool restarted
+    if (m_builderService && !m_notifierRegistered)
+    {
+        m_notifierRegistered = true;
+        auto service = m_builderService->service();
+        auto group = m_builderService->groupInfo()->groupID();
+        int64_t blockNumber = 0;
+        if (service->getBlockNumber(group, blockNumber))
+        {
+            m_blockNumber = blockNumber;
+        }
+
+        std::weak_ptr<PresignedTxPool> weakPool = shared_from_this();
+        service->registerBlockNumberNotifier(
+            group, [weakPool](const std::string&, int64_t _blockNumber) {
+                auto pool = weakPool.lock();
+                if (pool)
+                {
+                    pool->onBlockNumber(_blockNumber);
+                }
+            });
+    }
+
+    std::lock_guard<std::mutex> lock(x_entries);
+    for (const auto& entry : m_entries)
+    {
+        refill(entry);
+    }
+
+    UTILITIES_TX_LOG(INFO) << LOG_BADGE("PresignedTxPool") << LOG_DESC("start")
+                           << LOG_KV("depth", m_settings.depth)
+                           << LOG_KV("refreshBlocks", m_settings.refreshBlocks)
+                           << LOG_KV("threadCount", m_settings.threadCount)
+                           << LOG_KV("entries", m_entries.size());
+}
+
+void PresignedTxPool::stop()
+{
+    if (!m_running.exchange(false))
+    {
+        return;
+    }
+
+    // the tasks not run are dropped
+    m_signer->stop();
+
+    std::lock_guard<std::mutex> lock(x_entries);
+    for (const auto& entry : m_entries)
+    {
+        entry->signing = 0;
+    }
+
+    UTILITIES_TX_LOG(INFO) << LOG_BADGE("PresignedTxPool") << LOG_DESC("stop")
+                           << LOG_KV("signedCount", m_signedCount.load())
+                           << LOG_KV("refreshed", m_refreshed.load())
+                           << LOG_KV("hits", m_hits.load()) << LOG_KV("misses", m_misses.load());
+}
+
+std::size_t PresignedTxPool::addEntry(bcos::crypto::KeyPairInterface::Ptr _keyPair,
+    PreparedTransaction::ConstPtr _prepared, bcos::bytes _input)
+{
+    if (m_builderService)
+    {
+        m_builderService->checkKeyPair(*_keyPair);
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->keyPair = std::move(_keyPair);
+    entry->prepared = std::move(_prepared);
+    entry->input = std::move(_input);
+
+    std::lock_guard<std::mutex> lock(x_entries);
+    m_entries.push_back(entry);
+    refill(entry);
+    return m_entries.size() - 1;
+}
+
+PresignedTxPool::SignedTransaction PresignedTxPool::pop(std::size_t _id)
+{
+    SignedTransaction transaction;
+    if (tryPop(_id, transaction))
+    {
+        return transaction;
+    }
+
+    Entry::Ptr entry;
+    {
+        std::lock_guard<std::mutex> lock(x_entries);
+        entry = this->entry(_id);
+    }
+    m_misses++;
+    return sign(*entry).transaction;
+}
+
+bool PresignedTxPool::tryPop(std::size_t _id, SignedTransaction& _transaction)
+{
+    std::lock_guard<std::mutex> lock(x_entries);
+    auto entry = this->entry(_id);
+    auto& ready = entry->ready;
+    // expired before the block notified refreshed them
+    auto blockNumber = m_blockNumber.load();
+    while (!ready.empty() && ready.front().blockLimit <= blockNumber)
+    {
+        ready.pop_front();
+        m_refreshed++;
+    }
+
+    if (ready.empty())
+    {
+        refill(entry);
+        return false;
+    }
+
+    _transaction = std::move(ready.front().transaction);
+    ready.pop_front();
+    m_hits++;
+    refill(entry);
+    return true;
+}
+
+void PresignedTxPool::onBlockNumber(int64_t _blockNumber)
+{
+    auto blockNumber = m_blockNumber.load();
+    while (blockNumber < _blockNumber &&
+           !m_blockNumber.compare_exchange_weak(blockNumber, _blockNumber))
+    {
+    }
+    if (blockNumber >= _blockNumber)
+    {
+        return;
+    }
+
+    uint64_t refreshed = 0;
+    {
+        std::lock_guard<std::mutex> lock(x_entries);
+        for (const auto& entry : m_entries)
+        {
+            auto& ready = entry->ready;
+            auto it = std::remove_if(ready.begin(), ready.end(), [&](const SignedEntry& _signed) {
+                return _signed.blockLimit - _blockNumber <= m_settings.refreshBlocks;
+            });
+            refreshed += ready.end() - it;
+            ready.erase(it, ready.end());
+            refill(entry);
+        }
+    }
+    m_refreshed += refreshed;
+    m_lastRefreshed = refreshed;
+
+    if (refreshed > 0)
+    {
+        UTILITIES_TX_LOG(DEBUG) << LOG_BADGE("PresignedTxPool") << LOG_DESC("refresh")
+                                << LOG_KV("blockNumber", _blockNumber)
+                                << LOG_KV("refreshed", refreshed);
+    }
+}
+
+std::size_t PresignedTxPool::entries() const
+{
+    std::lock_guard<std::mutex> lock(x_entries);
+    return m_entries.size();
+}
+
+std::size_t PresignedTxPool::depth(std::size_t _id) const
+{
+    std::lock_guard<std::mutex> lock(x_entries);
+    return entry(_id)->ready.size();
+}
+
+PresignedTxPool::Metrics PresignedTxPool::metrics() const
+{
+    Metrics metrics;
+    {
+        std::lock_guard<std::mutex> lock(x_entries);
+        for (const auto& entry : m_entries)
+        {
+            metrics.depth += entry->ready.size();
+            metrics.signing += entry->signing;
+        }
+    }
+    metrics.signedCount = m_signedCount.load();
+    metrics.refreshed = m_refreshed.load();
+    metrics.lastRefreshed = m_lastRefreshed.load();
+    metrics.hits = m_hits.load();
+    metrics.misses = m_misses.load();
+    metrics.blockNumber = m_blockNumber.load();
+    return metrics;
+}
+
+bool PresignedTxPool::waitForDepth(
+    std::size_t _id, std::size_t _depth, std::chrono::milliseconds _timeout) const
+{
+    std::unique_lock<std::mutex> lock(x_entries);
+    auto entry = this->entry(_id);
+    return m_signed.wait_for(
+        lock, _timeout, [&entry, _depth]() { return entry->ready.size() >= _depth; });
+}
+
+PresignedTxPool::Entry::Ptr PresignedTxPool::entry(std::size_t _id) const
+{
+    if (_id >= m_entries.size())
+    {
+        BOOST_THROW_EXCEPTION(
+            std::invalid_argument("presigned entry not exist, id: " + std::to_string(_id)));
+    }
+    return m_entries[_id];
+}
+
+PresignedTxPool::SignedEntry PresignedTxPool::sign(const Entry& _entry)
+{
+    int64_t blockLimit = 0;
+    if (!m_blockLimit(blockLimit))
+    {
+        BOOST_THROW_EXCEPTION(std::runtime_error("get block limit failed"));
+    }
+    return SignedEntry{blockLimit, _entry.prepared->createSignedTransaction(
+                                       *_entry.keyPair, bcos::ref(_entry.input), blockLimit)};
+}
+
+void PresignedTxPool::refill(const Entry::Ptr& _entry)
+{
+    if (!m_running)
+    {
+        return;
+    }
+
+    auto pending = _entry->ready.size() + _entry->signing;
+    if (pending >= m_settings.depth)
+    {
+        return;
+    }
+
+    auto count = m_settings.depth - pending;
+    while (count > 0)
+    {
+        auto batch = std::min(count, c_signBatchSize);
+        _entry->signing += batch;
+        count -= batch;
+        m_signer->enqueue([this, _entry, batch]() { signBatch(_entry, batch); });
+    }
+}
+
+void PresignedTxPool::signBatch(const Entry::Ptr& _entry, std::size_t _count)
+{
+    std::size_t signedCount = 0;
+    try
+    {
+        for (; signedCount < _count && m_running; ++signedCount)
+        {
+            auto signedEntry = sign(*_entry);
+            std::lock_guard<std::mutex> lock(x_entries);
+            _entry->ready.push_back(std::move(signedEntry));
+            _entry->signing--;
+            m_signedCount++;
+            m_signed.notify_all();
+        }
+    }
+    catch (const std::exception& e)
+    {
+        UTILITIES_TX_LOG(WARNING) << LOG_BADGE("PresignedTxPool") << LOG_DESC("sign failed")
+                                  << LOG_KV("error", e.what());
+    }
+
+    // refilled on the next pop or block notified
+    std::lock_guard<std::mutex> lock(x_entries);
+    _entry->signing -= std::min(_entry->signing, _count - signedCount);
+}
@@ -0,0 +1,200 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file PresignedTxPool.h
+ * @author: octopus
+ * @date 2023-04-10
+ */
+#pragma once
+#include <bcos-cpp-sdk/utilities/tx/PreparedTransaction.h>
+#include <bcos-cpp-sdk/utilities/tx/TransactionBuilderService.h>
+#include <bcos-crypto/interfaces/crypto/KeyPairInterface.h>
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/ThreadPool.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace utilities
+{
+/**
+ * @brief keep the signed transactions of the (key pair, template) entries ready for submission.
+ * Each entry is refilled to the depth on the background pool after the transactions popped, and
+ * the transactions whose block limit is within refreshBlocks of the block number notified are
+ * dropped and re-signed with the new block limit.
+ */
+class PresignedTxPool : public std::enable_shared_from_this<PresignedTxPool>
+{
+public:
+    using Ptr = std::shared_ptr<PresignedTxPool>;
+    using ConstPtr = std::shared_ptr<const PresignedTxPool>;
+    // the block limit of the transactions signed now, false if unknown
+    using BlockLimitFunc = std::function<bool(int64_t& _blockLimit)>;
+    // the hash and the encoded transaction
+    using SignedTransaction = std::pair<std::string, std::string>;
+
+    struct Settings
+    {
+        // the signed transactions kept ready for each entry
+        std::size_t depth = 64;
+        // NOTE: should be less than the block limit range of the service
+        int64_t refreshBlocks = 100;
+        std::size_t threadCount = 2;
+    };
+
+    struct Metrics
+    {
+        // the signed transactions ready
+        std::size_t depth = 0;
+        // the transactions being signed on the background pool
+        std::size_t signing = 0;
+        uint64_t signedCount = 0;
+        // the transactions dropped close to expiry and re-signed
+        uint64_t refreshed = 0;
+        // the transactions refreshed on the last block notified
+        uint64_t lastRefreshed = 0;
+        // popped ready or signed on the calling thread
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        int64_t blockNumber = 0;
+    };
+
+    PresignedTxPool(Settings _settings, BlockLimitFunc _blockLimit);
+    /**
+     * @brief the pool of the group of the service, refreshed by the block notifications of the
+     * group after start
+     */
+    PresignedTxPool(Settings _settings, TransactionBuilderService::Ptr _builderService);
+    ~PresignedTxPool() { stop(); }
+
+    PresignedTxPool(const PresignedTxPool&) = delete;
+    PresignedTxPool(PresignedTxPool&&) = delete;
+    PresignedTxPool& operator=(const PresignedTxPool&) = delete;
+    PresignedTxPool& operator=(PresignedTxPool&&) = delete;
+
+public:
+    void start();
+    void stop();
+
+    /**
+     * @brief keep the transactions of the template with the input signed by the key pair ready
+     *
+     * @param _keyPair
+     * @param _prepared
+     * @param _input
+     * @return std::size_t the id of the entry
+     */
+    std::size_t addEntry(bcos::crypto::KeyPairInterface::Ptr _keyPair,
+        PreparedTransaction::ConstPtr _prepared, bcos::bytes _input);
+
+    /**
+     * @brief pop a signed transaction of the entry, signed on the calling thread if none ready
+     *
+     * @param _id
+     * @return SignedTransaction
+     */
+    SignedTransaction pop(std::size_t _id);
+
+    /**
+     * @brief pop a signed transaction of the entry if any ready
+     *
+     * @param _id
+     * @param _transaction
+     * @return bool
+     */
+    bool tryPop(std::size_t _id, SignedTransaction& _transaction);
+
+    // drop and re-sign the transactions close to expiry at the block number
+    void onBlockNumber(int64_t _blockNumber);
+
+    const Settings& settings() const { return m_settings; }
+    std::size_t entries() const;
+    // the signed transactions ready of the entry
+    std::size_t depth(std::size_t _id) const;
+    Metrics metrics() const;
+
+    /**
+     * @brief wait till the entry has at least _depth signed transactions ready, e.g. to warm up
+     * before the submission
+     *
+     * @param _id
+     * @param _depth
+     * @param _timeout
+     * @return bool false on timeout
+     */
+    bool waitForDepth(
+        std::size_t _id, std::size_t _depth, std::chrono::milliseconds _timeout) const;
+
+private:
+    struct SignedEntry
+    {
+        int64_t blockLimit;
+        SignedTransaction transaction;
+    };
+
+    struct Entry
+    {
+        using Ptr = std::shared_ptr<Entry>;
+
+        bcos::crypto::KeyPairInterface::Ptr keyPair;
+        PreparedTransaction::ConstPtr prepared;
+        bcos::bytes input;
+
+        std::deque<SignedEntry> ready;
+        std::size_t signing = 0;
+    };
+
+    Entry::Ptr entry(std::size_t _id) const;
+    SignedEntry sign(const Entry& _entry);
+    // NOTE: called with x_entries held
+    void refill(const Entry::Ptr& _entry);
+    void signBatch(const Entry::Ptr& _entry, std::size_t _count);
+
+private:
+    Settings m_settings;
+    BlockLimitFunc m_blockLimit;
+    TransactionBuilderService::Ptr m_builderService;
+
+    std::shared_ptr<bcos::ThreadPool> m_signer;
+    std::atomic<bool> m_running{false};
+    bool m_notifierRegistered = false;
+
+    mutable std::mutex x_entries;
+    std::vector<Entry::Ptr> m_entries;
+    // notified with x_entries when a transaction signed on the background pool is ready
+    mutable std::condition_variable m_signed;
+
+    std::atomic<int64_t> m_blockNumber{0};
+    std::atomic<uint64_t> m_signedCount{0};
+    std::atomic<uint64_t> m_refreshed{0};
+    std::atomic<uint64_t> m_lastRefreshed{0};
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+};
+}  // namespace utilities
+}  // namespace cppsdk
+}  // namespace bcos
@@ -6,8 +6,10 @@
 #ifndef __TRANSACTION_H_
 #define __TRANSACTION_H_
 
+#include <bcos-cpp-sdk/utilities/Hex.h>
 #include <bcos-cpp-sdk/utilities/tx/tars/tup/Tars.h>
 #include <bcos-cpp-sdk/utilities/tx/tars/tup/TarsJson.h>
+#include <bcos-cpp-sdk/utilities/tx/tars/tup/TarsJsonStream.h>
 #include <bcos-crypto/interfaces/crypto/Hash.h>
 #include <bcos-utilities/DataConvertUtility.h>
 #include <boost/asio/detail/socket_ops.hpp>
@@ -77,11 +79,68 @@ public:
         p->value["blockLimit"] = tars::JsonOutput::writeJson(blockLimit);
         p->value["nonce"] = tars::JsonOutput::writeJson(nonce);
         p->value["to"] = tars::JsonOutput::writeJson(to);
-        p->value["input"] = tars::JsonOutput::writeJson(bcos::toHexStringWithPrefix(input));
+        p->value["input"] =
+            tars::JsonOutput::writeJson(bcos::cppsdk::utilities::hexEncode(input, true));
         p->value["abi"] = tars::JsonOutput::writeJson(abi);
         return p;
     }
-    std::string writeToJsonString() const { return tars::TC_Json::writeValue(writeToJson()); }
+    // the order the fields are written in by writeToJson
+    static const tars::JsonKeyOrder& jsonKeyOrder()
+    {
+        static const tars::JsonKeyOrder keyOrder{
+            "version", "chainID", "groupID", "blockLimit", "nonce", "to", "input", "abi"};
+        return keyOrder;
+    }
+    void writeToJsonStream(tars::JsonStreamWriter& _writer) const
+    {
+        _writer.raw('{');
+        for (const auto& key : jsonKeyOrder())
+        {
+            _writer.raw(key.prefix);
+            switch (key.field)
+            {
+            case 0:
+                _writer.writeInt(version);
+                break;
+            case 1:
+                _writer.writeString(chainID);
+                break;
+            case 2:
+                _writer.writeString(groupID);
+                break;
+            case 3:
+                _writer.writeInt(blockLimit);
+                break;
+            case 4:
+                _writer.writeString(nonce);
+                break;
+            case 5:
+                _writer.writeString(to);
+                break;
+            case 6:
+                _writer.raw('"');
+                bcos::cppsdk::utilities::hexEncodeAppend(input, _writer.buffer(), true);
+                _writer.raw('"');
+                break;
+            default:
+                _writer.writeString(abi);
+                break;
+            }
+        }
+        _writer.raw('}');
+    }
+    std::string writeToJsonString() const
+    {
+        std::string json;
+        writeToJsonString(json);
+        return json;
+    }
+    // append the json to _json
+    void writeToJsonString(std::string& _json) const
+    {
+        tars::JsonStreamWriter writer(_json);
+        writeToJsonStream(writer);
+    }
     void readFromJson(const tars::JsonValuePtr& p, bool isRequire = true)
     {
         resetDefault();
@@ -101,11 +160,74 @@ public:
         tars::JsonInput::readJson(to, pObj->value["to"], false);
         std::string inputHex{};
         tars::JsonInput::readJson(inputHex, pObj->value["input"], true);
-        auto inputBytes = bcos::fromHexString(inputHex);
-        std::copy(inputBytes->begin(), inputBytes->end(), std::back_inserter(input));
+        bcos::cppsdk::utilities::hexDecodeAppend(inputHex, input);
         tars::JsonInput::readJson(abi, pObj->value["abi"], false);
     }
-    void readFromJsonString(const std::string& str) { readFromJson(tars::TC_Json::getValue(str)); }
+    void readFromJsonStream(tars::JsonStreamReader& _reader)
+    {
+        resetDefault();
+        auto type = _reader.peekType();
+        if (type != tars::eJsonTypeObj)
+        {
+            char s[128];
+            snprintf(s, sizeof(s), "read 'struct' type mismatch, get type: %d.", type);
+            throw tars::TC_Json_Exception(s);
+        }
+        uint32_t found = 0;
+        _reader.readObject([this, &_reader, &found](std::string_view _key) {
+            if (_key == "version")
+            {
+                _reader.read(version, true);
+                found |= 1 << 0;
+            }
+            else if (_key == "chainID")
+            {
+                _reader.read(chainID, true);
+                found |= 1 << 1;
+            }
+            else if (_key == "groupID")
+            {
+                _reader.read(groupID, true);
+                found |= 1 << 2;
+            }
+            else if (_key == "blockLimit")
+            {
+                _reader.read(blockLimit, true);
+                found |= 1 << 3;
+            }
+            else if (_key == "nonce")
+            {
+                _reader.read(nonce, true);
+                found |= 1 << 4;
+            }
+            else if (_key == "to")
+            {
+                _reader.read(to, false);
+            }
+            else if (_key == "input")
+            {
+                std::string_view inputHex;
+                _reader.readStringView(inputHex, true);
+                found |= 1 << 6;
+                input.clear();
+                bcos::cppsdk::utilities::hexDecodeAppend(inputHex, input);
+            }
+            else if (_key == "abi")
+            {
+                _reader.read(abi, false);
+            }
+            else
+            {
+                _reader.skipValue();
+            }
+        });
+        tars::JsonStreamReader::checkRequired(found, 0x5f, "bcostars.TransactionData");
+    }
+    void readFromJsonString(const std::string& str)
+    {
+        tars::JsonStreamReader reader(str.data(), str.size());
+        readFromJsonStream(reader);
+    }
     std::ostream& display(std::ostream& _os, int _level = 0) const
     {
         tars::TarsDisplayer _ds(_os, _level);
@@ -267,7 +389,58 @@ public:
         p->value["extraData"] = tars::JsonOutput::writeJson(extraData);
         return p;
     }
-    std::string writeToJsonString() const { return tars::TC_Json::writeValue(writeToJson()); }
+    // the order the fields are written in by writeToJson
+    static const tars::JsonKeyOrder& jsonKeyOrder()
+    {
+        static const tars::JsonKeyOrder keyOrder{"data", "dataHash", "signature", "importTime",
+            "attribute", "sender", "extraData"};
+        return keyOrder;
+    }
+    void writeToJsonStream(tars::JsonStreamWriter& _writer) const
+    {
+        _writer.raw('{');
+        for (const auto& key : jsonKeyOrder())
+        {
+            _writer.raw(key.prefix);
+            switch (key.field)
+            {
+            case 0:
+                _writer.writeStruct(data);
+                break;
+            case 1:
+                _writer.writeBytes(dataHash);
+                break;
+            case 2:
+                _writer.writeBytes(signature);
+                break;
+            case 3:
+                _writer.writeInt(importTime);
+                break;
+            case 4:
+                _writer.writeInt(attribute);
+                break;
+            case 5:
+                _writer.writeBytes(sender);
+                break;
+            default:
+                _writer.writeString(extraData);
+                break;
+            }
+        }
+        _writer.raw('}');
+    }
+    std::string writeToJsonString() const
+    {
+        std::string json;
+        writeToJsonString(json);
+        return json;
+    }
+    // append the json to _json
+    void writeToJsonString(std::string& _json) const
+    {
+        tars::JsonStreamWriter writer(_json);
+        writeToJsonStream(writer);
+    }
     void readFromJson(const tars::JsonValuePtr& p, bool isRequire = true)
     {
         resetDefault();
@@ -287,7 +460,56 @@ public:
         tars::JsonInput::readJson(sender, pObj->value["sender"], false);
         tars::JsonInput::readJson(extraData, pObj->value["extraData"], false);
     }
-    void readFromJsonString(const std::string& str) { readFromJson(tars::TC_Json::getValue(str)); }
+    void readFromJsonStream(tars::JsonStreamReader& _reader)
+    {
+        resetDefault();
+        auto type = _reader.peekType();
+        if (type != tars::eJsonTypeObj)
+        {
+            char s[128];
+            snprintf(s, sizeof(s), "read 'struct' type mismatch, get type: %d.", type);
+            throw tars::TC_Json_Exception(s);
+        }
+        _reader.readObject([this, &_reader](std::string_view _key) {
+            if (_key == "data")
+            {
+                _reader.readStruct(data, false);
+            }
+            else if (_key == "dataHash")
+            {
+                _reader.read(dataHash, false);
+            }
+            else if (_key == "signature")
+            {
+                _reader.read(signature, false);
+            }
+            else if (_key == "importTime")
+            {
+                _reader.read(importTime, false);
+            }
+            else if (_key == "attribute")
+            {
+                _reader.read(attribute, false);
+            }
+            else if (_key == "sender")
+            {
+                _reader.read(sender, false);
+            }
+            else if (_key == "extraData")
+            {
+                _reader.read(extraData, false);
+            }
+            else
+            {
+                _reader.skipValue();
+            }
+        });
+    }
+    void readFromJsonString(const std::string& str)
+    {
+        tars::JsonStreamReader reader(str.data(), str.size());
+        readFromJsonStream(reader);
+    }
     std::ostream& display(std::ostream& _os, int _level = 0) const
     {
         tars::TarsDisplayer _ds(_os, _level);
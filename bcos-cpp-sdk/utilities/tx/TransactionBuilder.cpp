@@ -18,24 +18,85 @@
  * @date 2022-01-13
  */
 #include <bcos-cpp-sdk/utilities/Common.h>
+#include <bcos-cpp-sdk/utilities/Hex.h>
+#include <bcos-cpp-sdk/utilities/ParallelChunks.h>
+#include <bcos-cpp-sdk/utilities/crypto/HashBatch.h>
+#include <bcos-cpp-sdk/utilities/crypto/HsmSessionPool.h>
 #include <bcos-cpp-sdk/utilities/tx/Transaction.h>
 #include <bcos-cpp-sdk/utilities/tx/TransactionBuilder.h>
+#include <bcos-cpp-sdk/utilities/tx/TransactionView.h>
 #include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
 #include <bcos-crypto/signature/hsmSM2/HsmSM2Crypto.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/DataConvertUtility.h>
 #include <bcos-utilities/FixedBytes.h>
 #include <time.h>
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <memory>
+#include <random>
 #include <string>
-#include <thread>
 #include <utility>
 
 using namespace bcos;
 using namespace bcos::cppsdk;
 using namespace bcos::cppsdk::utilities;
 
+namespace
+{
+// the crypto suites, the transaction and the encode buffer of a signing thread, reused by all the
+// transactions signed on the thread to avoid the allocations and the sharing between the threads
+struct SignContext
+{
+    bcos::crypto::CryptoSuite ecdsaCryptoSuite{std::make_shared<bcos::crypto::Keccak256>(),
+        std::make_shared<bcos::crypto::Secp256k1Crypto>(), nullptr};
+    bcos::crypto::CryptoSuite smCryptoSuite{std::make_shared<bcos::crypto::SM3>(),
+        std::make_shared<bcos::crypto::SM2Crypto>(), nullptr};
+    bcostars::Transaction transaction;
+    tars::TarsOutputStream<tars::BufferWriter> output;
+};
+
+SignContext& signContext()
+{
+    static thread_local SignContext context;
+    return context;
+}
+
+// the number of the transactions claimed by a signing thread at a time
+constexpr std::size_t c_signBatchSize = 16;
+
+// the max bytes of a tars field besides its content: a 2 bytes head, a 2 bytes element head for the
+// byte lists and a 9 bytes length or integer
+constexpr std::size_t c_tarsFieldOverhead = 16;
+
+// the upper bound of the encoded size, the encode buffer grows at most once
+std::size_t encodedSizeBound(const bcostars::TransactionData& _transactionData)
+{
+    return c_tarsFieldOverhead * 10 + _transactionData.chainID.size() +
+           _transactionData.groupID.size() + _transactionData.nonce.size() +
+           _transactionData.to.size() + _transactionData.input.size() +
+           _transactionData.abi.size();
+}
+
+std::size_t encodedSizeBound(const bcostars::Transaction& _transaction)
+{
+    return encodedSizeBound(_transaction.data) + c_tarsFieldOverhead * 8 +
+           _transaction.dataHash.size() + _transaction.signature.size() +
+           _transaction.sender.size() + _transaction.extraData.size();
+}
+
+template <typename T>
+bytesConstPtr encodeWithPool(const T& _object, BytesPool& _pool)
+{
+    tars::TarsOutputStream<BytesBufferWriter> output;
+    output.attach(_pool.acquire());
+    output.reserve(encodedSizeBound(_object));
+    _object.writeTo(output);
+    return _pool.share(output.detach());
+}
+}  // namespace
+
 /**
  * @brief
  *
@@ -82,22 +143,14 @@ bcostars::TransactionDataUniquePtr TransactionBuilder::createTransactionDataWith
 bytesConstPtr TransactionBuilder::encodeTransactionData(
     const bcostars::TransactionData& _transactionData)
 {
-    tars::TarsOutputStream<tars::BufferWriter> output;
-    _transactionData.writeTo(output);
-
-    auto buffer = std::make_shared<bcos::bytes>();
-    buffer->assign(output.getBuffer(), output.getBuffer() + output.getLength());
-    return buffer;
+    return encodeWithPool(_transactionData, *m_bytesPool);
 }
 
 std::string TransactionBuilder::decodeTransactionDataToJsonObj(const bcos::bytes& _txBytes)
 {
-    tars::TarsInputStream<tars::BufferReader> inputStream;
-    inputStream.setBuffer((const char*)_txBytes.data(), _txBytes.size());
-    auto txData = std::make_unique<bcostars::TransactionData>();
-    txData->readFrom(inputStream);
-    auto txDataJson = txData->writeToJsonString();
-    return txDataJson;
+    // written from the views of the encoded bytes, the fields are not copied
+    TransactionDataView txData(bcos::ref(_txBytes));
+    return txData.writeToJsonString();
 }
 
 /**
@@ -140,19 +193,9 @@ bcos::bytesConstPtr TransactionBuilder::signTransactionDataHash(
     }
     else if (_keyPair.keyPairType() == bcos::crypto::KeyPairType::HsmSM2)
     {
-        if (!m_hsmCryptoSuite)
-        {
-            std::lock_guard<std::mutex> l(x_hsmCryptoSuite);
-            if (!m_hsmCryptoSuite)
-            {
-                m_hsmCryptoSuite = std::make_unique<bcos::crypto::CryptoSuite>(
-                    std::make_shared<bcos::crypto::SM3>(),
-                    std::make_shared<bcos::crypto::HsmSM2Crypto>(
-                        dynamic_cast<const bcos::crypto::HsmSM2KeyPair&>(_keyPair).hsmLibPath()),
-                    nullptr);
-            }
-        }
-        cryptoSuite = &*m_hsmCryptoSuite;
+        // the sessions of the hsm library are pooled and signing in parallel
+        return HsmSessionPool::instance().sign(_keyPair, _transactionDataHash,
+            dynamic_cast<const bcos::crypto::HsmSM2KeyPair&>(_keyPair).hsmLibPath(), true);
     }
     else
     {
@@ -197,22 +240,13 @@ bcostars::TransactionUniquePtr TransactionBuilder::createTransaction(
  */
 bytesConstPtr TransactionBuilder::encodeTransaction(const bcostars::Transaction& _transaction)
 {
-    tars::TarsOutputStream<tars::BufferWriter> output;
-    _transaction.writeTo(output);
-
-    auto buffer = std::make_shared<bcos::bytes>();
-    buffer->assign(output.getBuffer(), output.getBuffer() + output.getLength());
-    return buffer;
+    return encodeWithPool(_transaction, *m_bytesPool);
 }
 
 std::string TransactionBuilder::decodeTransactionToJsonObj(const bcos::bytes& _txBytes)
 {
-    tars::TarsInputStream<tars::BufferReader> inputStream;
-    inputStream.setBuffer((const char*)_txBytes.data(), _txBytes.size());
-    auto tx = std::make_unique<bcostars::Transaction>();
-    tx->readFrom(inputStream);
-    auto txDataJson = tx->writeToJsonString();
-    return txDataJson;
+    TransactionView tx(bcos::ref(_txBytes));
+    return tx.writeToJsonString();
 }
 
 /**
@@ -262,30 +296,158 @@ std::pair<std::string, std::string> TransactionBuilder::createSignedTransaction(
     auto encodedTx = encodeTransaction(*transaction);
 
     return std::make_pair<std::string, std::string>(
-        toHexStringWithPrefix(transactionDataHash), toHexStringWithPrefix(*encodedTx));
+        hexEncode(transactionDataHash, true), hexEncode(*encodedTx, true));
 }
 
-std::string TransactionBuilder::generateRandomStr()
+/**
+ * @brief
+ *
+ * @param _specs
+ * @param _threadCount
+ * @return std::vector<std::pair<std::string, std::string>>
+ */
+std::vector<std::pair<std::string, std::string>> TransactionBuilder::createSignedTransactions(
+    const std::vector<TransactionSpec>& _specs, std::size_t _threadCount)
 {
-    static thread_local std::mt19937 generator(std::random_device{}());
-    /*
-    static thread_local auto timeTicks = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::system_clock::now().time_since_epoch())
-                                             .count();
-    static thread_local std::mt19937 generator(timeTicks);
-    */
+    std::vector<std::pair<std::string, std::string>> results(_specs.size());
+    if (_specs.empty())
+    {
+        return results;
+    }
 
-    std::uniform_int_distribution<int> dis(0, 255);
-    std::array<bcos::byte, 16> randomFixedBytes;
-    for (auto& element : randomFixedBytes)
+    // the caller is one of the signing threads
+    parallelChunks(_specs.size(), c_signBatchSize, _threadCount,
+        [this, &_specs, &results](std::size_t _begin, std::size_t _end) {
+            for (auto i = _begin; i < _end; ++i)
+            {
+                results[i] = signTransactionSpec(_specs[i]);
+            }
+        });
+    return results;
+}
+
+std::vector<std::size_t> TransactionBuilder::verifyTransactionHashes(
+    CryptoType _cryptoType, const std::vector<bcos::bytesConstRef>& _encodedTransactions)
+{
+    auto hashImpl = (_cryptoType == bcos::crypto::KeyPairType::SM2 ||
+                        _cryptoType == bcos::crypto::KeyPairType::HsmSM2) ?
+                        m_smCryptoSuite->hashImpl() :
+                        m_ecdsaCryptoSuite->hashImpl();
+
+    // decode all first and hash the decoded ones together by the SIMD lanes
+    std::vector<TransactionView> transactions(_encodedTransactions.size());
+    std::vector<std::size_t> decoded;
+    decoded.reserve(_encodedTransactions.size());
+    HashBatchMessages messages;
+    messages.reserve(_encodedTransactions.size(), _encodedTransactions.size() * 8);
+    for (std::size_t i = 0; i < _encodedTransactions.size(); ++i)
     {
-        element = dis(generator);
+        try
+        {
+            transactions[i].decode(_encodedTransactions[i]);
+            addHashMessage(messages, transactions[i].data);
+            decoded.push_back(i);
+        }
+        catch (const tars::TarsDecodeException& e)
+        {
+            UTILITIES_TX_LOG(DEBUG) << LOG_BADGE("verifyTransactionHashes")
+                                    << LOG_DESC("decode failed") << LOG_KV("index", i)
+                                    << LOG_KV("error", e.what());
+        }
     }
+    std::vector<bcos::crypto::HashType> hashes(decoded.size());
+    hashBatch(hashImpl, messages, hashes.data());
 
-    uint64_t* firstNum = (uint64_t*)randomFixedBytes.data();
-    uint64_t* lastNum = (uint64_t*)(randomFixedBytes.data() + sizeof(uint64_t));
+    std::vector<bool> verified(_encodedTransactions.size(), false);
+    for (std::size_t k = 0; k < decoded.size(); ++k)
+    {
+        const auto& dataHash = transactions[decoded[k]].dataHash;
+        verified[decoded[k]] =
+            std::equal(dataHash.begin(), dataHash.end(), hashes[k].begin(), hashes[k].end());
+    }
+    std::vector<std::size_t> failed;
+    for (std::size_t i = 0; i < verified.size(); ++i)
+    {
+        if (!verified[i])
+        {
+            failed.push_back(i);
+        }
+    }
+    return failed;
+}
+
+std::pair<std::string, std::string> TransactionBuilder::signTransactionSpec(
+    const TransactionSpec& _spec)
+{
+    auto& context = signContext();
+    auto keyPairType = _spec.keyPair->keyPairType();
+
+    auto& transaction = context.transaction;
+    transaction.resetDefault();
+    auto& transactionData = transaction.data;
+    transactionData.version = 0;
+    transactionData.chainID = _spec.chainID;
+    transactionData.groupID = _spec.groupID;
+    transactionData.to = _spec.to;
+    transactionData.blockLimit = _spec.blockLimit;
+    transactionData.nonce = generateRandomStr();
+    transactionData.abi = _spec.abi;
+    transactionData.input.assign(_spec.input.begin(), _spec.input.end());
+
+    auto* cryptoSuite = (keyPairType == bcos::crypto::KeyPairType::SM2 ||
+                            keyPairType == bcos::crypto::KeyPairType::HsmSM2) ?
+                            &context.smCryptoSuite :
+                            &context.ecdsaCryptoSuite;
+    auto transactionDataHash = transactionData.hash(cryptoSuite->hashImpl());
+
+    bcos::bytesConstPtr signData;
+    if (keyPairType == bcos::crypto::KeyPairType::HsmSM2)
+    {
+        // the pooled hsm sessions
+        signData = signTransactionDataHash(*_spec.keyPair, transactionDataHash);
+    }
+    else
+    {
+        signData = cryptoSuite->signatureImpl()->sign(*_spec.keyPair, transactionDataHash, true);
+    }
+
+    transaction.dataHash.assign(transactionDataHash.begin(), transactionDataHash.end());
+    transaction.signature.assign(signData->begin(), signData->end());
+    transaction.attribute = _spec.attribute;
+    transaction.extraData = _spec.extraData;
+
+    context.output.reset();
+    transaction.writeTo(context.output);
+    return std::make_pair(hexEncode(transactionDataHash, true),
+        hexEncode(bcos::bytesConstRef(
+                      (const bcos::byte*)context.output.getBuffer(), context.output.getLength()),
+            true));
+}
+
+std::string TransactionBuilder::generateRandomStr()
+{
+    // the prefix is drawn once per thread, the threads and the processes get different prefixes
+    // with overwhelming probability, the fixed width counter keeps prefix + counter unambiguous
+    static thread_local const std::string prefix = []() {
+        std::random_device randomDevice;
+        uint64_t seed = ((uint64_t)randomDevice() << 32) | randomDevice();
+        return std::to_string(seed);
+    }();
+    static thread_local uint64_t counter = 0;
+
+    std::array<char, 20> digits;
+    digits.fill('0');
+    auto value = counter++;
+    for (auto it = digits.rbegin(); value != 0 && it != digits.rend(); ++it)
+    {
+        *it = (char)('0' + value % 10);
+        value /= 10;
+    }
 
-    return std::to_string(*firstNum) + std::to_string(*lastNum);
+    std::string nonce;
+    nonce.reserve(prefix.size() + digits.size());
+    nonce.append(prefix).append(digits.data(), digits.size());
+    return nonce;
 }
 
 u256 TransactionBuilder::genRandomUint256()
@@ -18,6 +18,7 @@
  * @date 2022-01-13
  */
 #pragma once
+#include <bcos-cpp-sdk/utilities/tx/BytesPool.h>
 #include <bcos-cpp-sdk/utilities/tx/Transaction.h>
 #include <bcos-cpp-sdk/utilities/tx/TransactionBuilderInterface.h>
 #include <bcos-crypto/hash/Keccak256.h>
@@ -28,6 +29,7 @@
 #include <bcos-utilities/Common.h>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace bcos
 {
@@ -35,6 +37,23 @@ namespace cppsdk
 {
 namespace utilities
 {
+/**
+ * @brief the parameters of a transaction signed by TransactionBuilder::createSignedTransactions,
+ * the key pair is not owned and must be alive until the call returns
+ */
+struct TransactionSpec
+{
+    const bcos::crypto::KeyPairInterface* keyPair = nullptr;
+    std::string groupID;
+    std::string chainID;
+    std::string to;
+    bcos::bytes input;
+    std::string abi;
+    int64_t blockLimit = 0;
+    int32_t attribute = 0;
+    std::string extraData;
+};
+
 class TransactionBuilder : public TransactionBuilderInterface
 {
 public:
@@ -173,16 +192,51 @@ public:
         const std::string& _abi, int64_t _blockLimit, int32_t _attribute,
         const std::string& _extraData = "") override;
 
+    /**
+     * @brief Create signed transactions in parallel, each signing thread has its own crypto
+     * suites and encode buffer
+     *
+     * @param _specs
+     * @param _threadCount the number of the signing threads including the caller, 0 means the
+     * number of the cores
+     * @return std::vector<std::pair<std::string, std::string>> the hash and the encoded
+     * transaction in the order of _specs, the same as createSignedTransaction
+     */
+    std::vector<std::pair<std::string, std::string>> createSignedTransactions(
+        const std::vector<TransactionSpec>& _specs, std::size_t _threadCount = 0);
+
+    /**
+     * @brief check the hash carried by each encoded transaction against the hash of its data, the
+     * transactions are decoded as the views of the encoded bytes without copying the fields and
+     * hashed together by hashBatch
+     *
+     * @param _cryptoType
+     * @param _encodedTransactions
+     * @return std::vector<std::size_t> the indexes of the transactions failed to decode or whose
+     * hash mismatched, in order
+     */
+    std::vector<std::size_t> verifyTransactionHashes(
+        CryptoType _cryptoType, const std::vector<bcos::bytesConstRef>& _encodedTransactions);
 
     [[deprecated("Use generateRandomStr")]] u256 genRandomUint256();
 
-    std::string generateRandomStr();
+    /**
+     * @brief generate the nonce, a random prefix per thread followed by a 20 digits counter, unique
+     * in the thread without any lock
+     *
+     * @return std::string
+     */
+    static std::string generateRandomStr();
 
 public:
     auto ecdsaCryptoSuite() -> auto& { return m_ecdsaCryptoSuite; }
     auto smCryptoSuite() -> auto& { return m_smCryptoSuite; }
+    // the buffers of the encoded transactions and transaction data
+    auto bytesPool() -> auto& { return m_bytesPool; }
 
 private:
+    std::pair<std::string, std::string> signTransactionSpec(const TransactionSpec& _spec);
+
     bcos::crypto::CryptoSuite::UniquePtr m_ecdsaCryptoSuite =
         std::make_unique<bcos::crypto::CryptoSuite>(std::make_shared<bcos::crypto::Keccak256>(),
             std::make_shared<bcos::crypto::Secp256k1Crypto>(), nullptr);
@@ -191,9 +245,7 @@ private:
         std::make_unique<bcos::crypto::CryptoSuite>(std::make_shared<bcos::crypto::SM3>(),
             std::make_shared<bcos::crypto::SM2Crypto>(), nullptr);
 
-    bcos::crypto::CryptoSuite::UniquePtr m_hsmCryptoSuite = nullptr;
-
-    std::mutex x_hsmCryptoSuite;
+    BytesPool::Ptr m_bytesPool = std::make_shared<BytesPool>();
 };
 }  // namespace utilities
 }  // namespace cppsdk
@@ -48,12 +48,12 @@ TransactionBuilderService::TransactionBuilderService(service::Service::Ptr _serv
     m_groupInfo = groupInfo;
     if (_transactionBuilderInterface)
     {
-        // default builder
-        m_transactionBuilderInterface = std::make_shared<TransactionBuilder>();
+        m_transactionBuilderInterface = _transactionBuilderInterface;
     }
     else
     {
-        m_transactionBuilderInterface = _transactionBuilderInterface;
+        // default builder
+        m_transactionBuilderInterface = std::make_shared<TransactionBuilder>();
     }
 }
 
@@ -68,12 +68,7 @@ TransactionBuilderService::TransactionBuilderService(service::Service::Ptr _serv
 bcostars::TransactionDataUniquePtr TransactionBuilderService::createTransactionData(
     const std::string& _to, const bcos::bytes& _data, const std::string& _abi)
 {
-    int64_t blockLimit = 0;
-    if (!m_service->getBlockLimit(m_groupInfo->groupID(), blockLimit))
-    {
-        BOOST_THROW_EXCEPTION(
-            std::runtime_error("get block limit failed, groupID: " + m_groupInfo->groupID()));
-    }
+    auto blockLimit = this->blockLimit();
 
     return m_transactionBuilderInterface->createTransactionData(
         m_groupInfo->groupID(), m_groupInfo->chainID(), _to, _data, _abi, blockLimit);
@@ -95,13 +90,33 @@ std::pair<std::string, std::string> TransactionBuilderService::createSignedTrans
     const bcos::bytes& _data, const std::string& _abi, int32_t _attribute,
     const std::string& _extraData)
 {
-    int64_t blockLimit = 0;
-    if (!m_service->getBlockLimit(m_groupInfo->groupID(), blockLimit))
-    {
-        BOOST_THROW_EXCEPTION(
-            std::runtime_error("get block limit failed, groupID: " + m_groupInfo->groupID()));
-    }
+    auto blockLimit = this->blockLimit();
+
+    checkKeyPair(_keyPair);
+
+    return m_transactionBuilderInterface->createSignedTransaction(_keyPair, m_groupInfo->groupID(),
+        m_groupInfo->chainID(), _to, _data, _abi, blockLimit, _attribute, _extraData);
+}
+
+/**
+ * @brief Create a transaction template of the group
+ *
+ * @param _to
+ * @param _abi
+ * @param _attribute
+ * @param _extraData
+ * @return PreparedTransaction::Ptr
+ */
+PreparedTransaction::Ptr TransactionBuilderService::prepareTransaction(const std::string& _to,
+    const std::string& _abi, int32_t _attribute, const std::string& _extraData)
+{
+    auto cryptoType = m_groupInfo->smCryptoType() ? CryptoType::SM2 : CryptoType::Secp256K1;
+    return std::make_shared<PreparedTransaction>(m_transactionBuilderInterface, cryptoType,
+        m_groupInfo->groupID(), m_groupInfo->chainID(), _to, _abi, _attribute, _extraData);
+}
 
+void TransactionBuilderService::checkKeyPair(const bcos::crypto::KeyPairInterface& _keyPair) const
+{
     auto keyPairStrFunc = [](auto type) {
         if (type == bcos::crypto::KeyPairType::SM2 || type == bcos::crypto::KeyPairType::HsmSM2)
         {
@@ -130,7 +145,15 @@ std::pair<std::string, std::string> TransactionBuilderService::createSignedTrans
             "group id: " + m_groupInfo->groupID() + " ,group crypto type: none sm" +
             " ,but the keypair type: " + keyPairStrFunc(keyPairType)));
     }
+}
 
-    return m_transactionBuilderInterface->createSignedTransaction(_keyPair, m_groupInfo->groupID(),
-        m_groupInfo->chainID(), _to, _data, _abi, blockLimit, _attribute, _extraData);
+int64_t TransactionBuilderService::blockLimit() const
+{
+    int64_t blockLimit = 0;
+    if (!m_service->getBlockLimit(m_groupInfo->groupID(), blockLimit))
+    {
+        BOOST_THROW_EXCEPTION(
+            std::runtime_error("get block limit failed, groupID: " + m_groupInfo->groupID()));
+    }
+    return blockLimit;
 }
@@ -19,6 +19,7 @@
  */
 #pragma once
 #include <bcos-cpp-sdk/Sdk.h>
+#include <bcos-cpp-sdk/utilities/tx/PreparedTransaction.h>
 #include <bcos-cpp-sdk/utilities/tx/TransactionBuilder.h>
 #include <bcos-cpp-sdk/ws/Service.h>
 #include <bcos-utilities/Common.h>
@@ -70,6 +71,40 @@ public:
         const bcos::bytes& _data, const std::string& _abi, int32_t _attribute,
         const std::string& _extraData = "");
 
+    /**
+     * @brief Create a transaction template of the group
+     *
+     * @param _to
+     * @param _abi
+     * @param _attribute
+     * @param _extraData
+     * @return PreparedTransaction::Ptr
+     */
+    PreparedTransaction::Ptr prepareTransaction(const std::string& _to,
+        const std::string& _abi = "", int32_t _attribute = 0, const std::string& _extraData = "");
+
+    /**
+     * @brief throw if the key pair type does not match the crypto type of the group
+     *
+     * @param _keyPair
+     */
+    void checkKeyPair(const bcos::crypto::KeyPairInterface& _keyPair) const;
+
+    /**
+     * @brief the block limit of the group
+     *
+     * @return int64_t
+     */
+    int64_t blockLimit() const;
+
+public:
+    service::Service::Ptr service() const { return m_service; }
+    bcos::group::GroupInfo::Ptr groupInfo() const { return m_groupInfo; }
+    TransactionBuilderInterface::Ptr transactionBuilder() const
+    {
+        return m_transactionBuilderInterface;
+    }
+
 private:
     service::Service::Ptr m_service;
     bcos::group::GroupInfo::Ptr m_groupInfo;
@@ -0,0 +1,273 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file TransactionView.cpp
+ * @author: octopus
+ * @date 2023-04-11
+ */
+#include <bcos-cpp-sdk/utilities/Hex.h>
+#include <bcos-cpp-sdk/utilities/tx/TransactionView.h>
+#include <boost/endian/conversion.hpp>
+#include <algorithm>
+#include <variant>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::utilities;
+
+namespace
+{
+bcos::bytesConstRef toBytes(std::string_view _view)
+{
+    return bcos::bytesConstRef((const bcos::byte*)_view.data(), _view.size());
+}
+
+void writeHex(tars::JsonStreamWriter& _writer, bcos::bytesConstRef _bytes)
+{
+    _writer.raw('"');
+    hexEncodeAppend(_bytes, _writer.buffer(), true);
+    _writer.raw('"');
+}
+}  // namespace
+
+void TransactionDataView::decode(bcos::bytesConstRef _data)
+{
+    tars::TarsViewReader reader((const char*)_data.data(), _data.size());
+    decode(reader);
+}
+
+void TransactionDataView::decode(tars::TarsViewReader& _reader)
+{
+    *this = TransactionDataView();
+    // the tags of the required fields found
+    uint32_t found = 0;
+    tars::TarsViewReader::Head head;
+    while (_reader.nextField(head))
+    {
+        switch (head.tag)
+        {
+        case 1:
+            version = (int32_t)_reader.readInt(head);
+            break;
+        case 2:
+            chainID = _reader.readString(head);
+            break;
+        case 3:
+            groupID = _reader.readString(head);
+            break;
+        case 4:
+            blockLimit = _reader.readInt(head);
+            break;
+        case 5:
+            nonce = _reader.readString(head);
+            break;
+        case 6:
+            to = _reader.readString(head);
+            break;
+        case 7:
+            input = toBytes(_reader.readBytes(head));
+            break;
+        case 8:
+            abi = _reader.readString(head);
+            break;
+        default:
+            _reader.skipField(head.type);
+            continue;
+        }
+        found |= 1 << head.tag;
+    }
+    for (uint8_t tag : {1, 2, 3, 4, 5, 7})
+    {
+        tars::TarsViewReader::checkRequired(
+            found & (1 << tag), tag, "bcostars.TransactionData");
+    }
+}
+
+bcos::crypto::HashType TransactionDataView::hash(const bcos::crypto::Hash::Ptr& _hashImpl) const
+{
+    auto anyHasher = _hashImpl->hasher();
+    bcos::crypto::HashType hashResult;
+    std::visit(
+        [this, &hashResult](auto& hasher) {
+            int32_t networkVersion = boost::endian::native_to_big(version);
+            hasher.update(networkVersion);
+            hasher.update(toBytes(chainID));
+            hasher.update(toBytes(groupID));
+            int64_t networkBlockLimit = boost::endian::native_to_big(blockLimit);
+            hasher.update(bcos::bytesConstRef(
+                (const bcos::byte*)(&networkBlockLimit), sizeof(networkBlockLimit)));
+            hasher.update(toBytes(nonce));
+            hasher.update(toBytes(to));
+            hasher.update(input);
+            hasher.update(toBytes(abi));
+            hasher.final(hashResult);
+        },
+        anyHasher);
+    return hashResult;
+}
+
+void TransactionDataView::toTransactionData(bcostars::TransactionData& _transactionData) const
+{
+    _transactionData.version = version;
+    _transactionData.chainID = chainID;
+    _transactionData.groupID = groupID;
+    _transactionData.blockLimit = blockLimit;
+    _transactionData.nonce = nonce;
+    _transactionData.to = to;
+    _transactionData.input.assign(input.begin(), input.end());
+    _transactionData.abi = abi;
+}
+
+void TransactionDataView::writeToJsonStream(tars::JsonStreamWriter& _writer) const
+{
+    _writer.raw('{');
+    for (const auto& key : bcostars::TransactionData::jsonKeyOrder())
+    {
+        _writer.raw(key.prefix);
+        switch (key.field)
+        {
+        case 0:
+            _writer.writeInt(version);
+            break;
+        case 1:
+            _writer.writeString(chainID);
+            break;
+        case 2:
+            _writer.writeString(groupID);
+            break;
+        case 3:
+            _writer.writeInt(blockLimit);
+            break;
+        case 4:
+            _writer.writeString(nonce);
+            break;
+        case 5:
+            _writer.writeString(to);
+            break;
+        case 6:
+            writeHex(_writer, input);
+            break;
+        default:
+            _writer.writeString(abi);
+            break;
+        }
+    }
+    _writer.raw('}');
+}
+
+std::string TransactionDataView::writeToJsonString() const
+{
+    std::string json;
+    tars::JsonStreamWriter writer(json);
+    writeToJsonStream(writer);
+    return json;
+}
+
+void TransactionView::decode(bcos::bytesConstRef _data)
+{
+    *this = TransactionView();
+    tars::TarsViewReader reader((const char*)_data.data(), _data.size());
+    tars::TarsViewReader::Head head;
+    while (reader.nextField(head))
+    {
+        switch (head.tag)
+        {
+        case 1:
+            reader.beginStruct(head);
+            data.decode(reader);
+            break;
+        case 2:
+            dataHash = toBytes(reader.readBytes(head));
+            break;
+        case 3:
+            signature = toBytes(reader.readBytes(head));
+            break;
+        case 4:
+            importTime = reader.readInt(head);
+            break;
+        case 5:
+            attribute = (int32_t)reader.readInt(head);
+            break;
+        case 7:
+            sender = toBytes(reader.readBytes(head));
+            break;
+        case 8:
+            extraData = reader.readString(head);
+            break;
+        default:
+            reader.skipField(head.type);
+            break;
+        }
+    }
+}
+
+bool TransactionView::verifyHash(const bcos::crypto::Hash::Ptr& _hashImpl) const
+{
+    auto hash = data.hash(_hashImpl);
+    return std::equal(dataHash.begin(), dataHash.end(), hash.begin(), hash.end());
+}
+
+void TransactionView::toTransaction(bcostars::Transaction& _transaction) const
+{
+    data.toTransactionData(_transaction.data);
+    _transaction.dataHash.assign(dataHash.begin(), dataHash.end());
+    _transaction.signature.assign(signature.begin(), signature.end());
+    _transaction.importTime = importTime;
+    _transaction.attribute = attribute;
+    _transaction.sender.assign(sender.begin(), sender.end());
+    _transaction.extraData = extraData;
+}
+
+void TransactionView::writeToJsonStream(tars::JsonStreamWriter& _writer) const
+{
+    _writer.raw('{');
+    for (const auto& key : bcostars::Transaction::jsonKeyOrder())
+    {
+        _writer.raw(key.prefix);
+        switch (key.field)
+        {
+        case 0:
+            data.writeToJsonStream(_writer);
+            break;
+        case 1:
+            _writer.writeBytes((const tars::Char*)dataHash.data(), dataHash.size());
+            break;
+        case 2:
+            _writer.writeBytes((const tars::Char*)signature.data(), signature.size());
+            break;
+        case 3:
+            _writer.writeInt(importTime);
+            break;
+        case 4:
+            _writer.writeInt(attribute);
+            break;
+        case 5:
+            _writer.writeBytes((const tars::Char*)sender.data(), sender.size());
+            break;
+        default:
+            _writer.writeString(extraData);
+            break;
+        }
+    }
+    _writer.raw('}');
+}
+
+std::string TransactionView::writeToJsonString() const
+{
+    std::string json;
+    tars::JsonStreamWriter writer(json);
+    writeToJsonStream(writer);
+    return json;
+}
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the tars encoded transaction decoded as the views of the encoded bytes
+ * @file TransactionView.h
+ * @author: octopus
+ * @date 2023-04-11
+ */
+#pragma once
+#include <bcos-cpp-sdk/utilities/tx/Transaction.h>
+#include <bcos-cpp-sdk/utilities/tx/tars/tup/TarsJsonStream.h>
+#include <bcos-cpp-sdk/utilities/tx/tars/tup/TarsView.h>
+#include <bcos-crypto/interfaces/crypto/Hash.h>
+#include <bcos-utilities/Common.h>
+#include <string>
+#include <string_view>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace utilities
+{
+/**
+ * @brief the fields of the encoded bcostars::TransactionData, the strings and the bytes are the
+ * views of the encoded bytes and valid as long as them. Nothing is copied, reading the fields
+ * before input does not touch input.
+ */
+class TransactionDataView
+{
+public:
+    TransactionDataView() = default;
+    // throw tars::TarsDecodeException if _data is not an encoded TransactionData
+    explicit TransactionDataView(bcos::bytesConstRef _data) { decode(_data); }
+
+    void decode(bcos::bytesConstRef _data);
+    // decode the fields of the struct from the reader, till the end of the buffer or the struct
+    void decode(tars::TarsViewReader& _reader);
+
+    /**
+     * @brief the hash of the data, the same as bcostars::TransactionData::hash
+     *
+     * @param _hashImpl
+     * @return bcos::crypto::HashType
+     */
+    bcos::crypto::HashType hash(const bcos::crypto::Hash::Ptr& _hashImpl) const;
+
+    // copy the fields into the struct
+    void toTransactionData(bcostars::TransactionData& _transactionData) const;
+
+    // the same json as bcostars::TransactionData::writeToJsonString
+    void writeToJsonStream(tars::JsonStreamWriter& _writer) const;
+    std::string writeToJsonString() const;
+
+public:
+    int32_t version = 0;
+    std::string_view chainID;
+    std::string_view groupID;
+    int64_t blockLimit = 0;
+    std::string_view nonce;
+    std::string_view to;
+    bcos::bytesConstRef input;
+    std::string_view abi;
+};
+
+/**
+ * @brief the fields of the encoded bcostars::Transaction as the views of the encoded bytes
+ */
+class TransactionView
+{
+public:
+    TransactionView() = default;
+    // throw tars::TarsDecodeException if _data is not an encoded Transaction
+    explicit TransactionView(bcos::bytesConstRef _data) { decode(_data); }
+
+    void decode(bcos::bytesConstRef _data);
+
+    // the transaction hash carried by the transaction
+    bcos::bytesConstRef hash() const { return dataHash; }
+
+    /**
+     * @brief check the hash carried by the transaction against the hash of its data
+     *
+     * @param _hashImpl
+     * @return bool
+     */
+    bool verifyHash(const bcos::crypto::Hash::Ptr& _hashImpl) const;
+
+    // copy the fields into the struct
+    void toTransaction(bcostars::Transaction& _transaction) const;
+
+    // the same json as bcostars::Transaction::writeToJsonString
+    void writeToJsonStream(tars::JsonStreamWriter& _writer) const;
+    std::string writeToJsonString() const;
+
+public:
+    TransactionDataView data;
+    bcos::bytesConstRef dataHash;
+    bcos::bytesConstRef signature;
+    int64_t importTime = 0;
+    int32_t attribute = 0;
+    bcos::bytesConstRef sender;
+    std::string_view extraData;
+};
+}  // namespace utilities
+}  // namespace cppsdk
+}  // namespace bcos
@@ -0,0 +1,718 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the json codec of the tars structs without the TC_Json dom
+ * @file TarsJsonStream.h
+ * @author: octopus
+ * @date 2023-04-11
+ */
+
+#ifndef __TARS_JSON_STREAM_H__
+#define __TARS_JSON_STREAM_H__
+
+#include <bcos-cpp-sdk/utilities/tx/tars/tup/TarsType.h>
+#include <bcos-cpp-sdk/utilities/tx/tars/util/tc_json.h>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace tars
+{
+/**
+ * @brief the order TC_Json writes the fields of a struct in. The fields of JsonValueObj are kept
+ * in an unordered_map filled in the field order, the same keys inserted in the same order into the
+ * same map type iterate in the same order.
+ */
+class JsonKeyOrder
+{
+public:
+    struct Key
+    {
+        // the index of the field in the names
+        std::size_t field;
+        // the separator, the quoted name and the colon
+        std::string prefix;
+    };
+
+    JsonKeyOrder(std::initializer_list<const char*> _names)
+    {
+        std::vector<std::string> names(_names.begin(), _names.end());
+        std::unordered_map<std::string, JsonValuePtr> object;
+        for (const auto& name : names)
+        {
+            object[name];
+        }
+        for (const auto& it : object)
+        {
+            auto field = std::find(names.begin(), names.end(), it.first) - names.begin();
+            m_keys.push_back(
+                Key{(std::size_t)field, (m_keys.empty() ? "\"" : ",\"") + it.first + "\":"});
+        }
+    }
+
+    std::vector<Key>::const_iterator begin() const { return m_keys.begin(); }
+    std::vector<Key>::const_iterator end() const { return m_keys.end(); }
+
+private:
+    std::vector<Key> m_keys;
+};
+
+/**
+ * @brief append the json to a string, the same bytes as TC_Json::writeValue without space
+ */
+class JsonStreamWriter
+{
+public:
+    explicit JsonStreamWriter(std::string& _buffer) : m_buffer(_buffer) {}
+
+    std::string& buffer() { return m_buffer; }
+    void raw(char _c) { m_buffer.push_back(_c); }
+    void raw(std::string_view _s) { m_buffer.append(_s); }
+
+    void writeInt(int64_t _n)
+    {
+        char buf[24];
+        auto result = std::to_chars(buf, buf + sizeof(buf), _n);
+        m_buffer.append(buf, result.ptr);
+    }
+
+    void writeString(std::string_view _s)
+    {
+        m_buffer.push_back('"');
+        std::size_t begin = 0;
+        for (std::size_t i = 0; i < _s.size(); ++i)
+        {
+            auto c = (unsigned char)_s[i];
+            if (c >= 0x20 && c != '"' && c != '\\' && c != '/')
+            {
+                continue;
+            }
+            m_buffer.append(_s.data() + begin, i - begin);
+            begin = i + 1;
+            switch (c)
+            {
+            case '"':
+                m_buffer.append("\\\"");
+                break;
+            case '\\':
+                m_buffer.append("\\\\");
+                break;
+            case '/':
+                m_buffer.append("\\/");
+                break;
+            case '\b':
+                m_buffer.append("\\b");
+                break;
+            case '\f':
+                m_buffer.append("\\f");
+                break;
+            case '\n':
+                m_buffer.append("\\n");
+                break;
+            case '\r':
+                m_buffer.append("\\r");
+                break;
+            case '\t':
+                m_buffer.append("\\t");
+                break;
+            default:
+            {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", c);
+                m_buffer.append(buf, 6);
+                break;
+            }
+            }
+        }
+        m_buffer.append(_s.data() + begin, _s.size() - begin);
+        m_buffer.push_back('"');
+    }
+
+    // the bytes are written as an array of the signed numbers as JsonOutput does
+    void writeBytes(const Char* _data, std::size_t _size)
+    {
+        m_buffer.push_back('[');
+        for (std::size_t i = 0; i < _size; ++i)
+        {
+            if (i > 0)
+            {
+                m_buffer.push_back(',');
+            }
+            writeInt((int64_t)_data[i]);
+        }
+        m_buffer.push_back(']');
+    }
+    void writeBytes(const std::vector<Char>& _v) { writeBytes(_v.data(), _v.size()); }
+
+    template <typename T>
+    void writeStruct(const T& _v)
+    {
+        _v.writeToJsonStream(*this);
+    }
+
+    template <typename T>
+    void writeStructs(const std::vector<T>& _v)
+    {
+        m_buffer.push_back('[');
+        for (std::size_t i = 0; i < _v.size(); ++i)
+        {
+            if (i > 0)
+            {
+                m_buffer.push_back(',');
+            }
+            _v[i].writeToJsonStream(*this);
+        }
+        m_buffer.push_back(']');
+    }
+
+private:
+    std::string& m_buffer;
+};
+
+/**
+ * @brief read the json in one pass without the dom, accepts the same json as TC_Json::getValue.
+ * The readers of the values skip the value of another type, or throw TC_Json_Exception if the
+ * value is required.
+ */
+class JsonStreamReader
+{
+public:
+    JsonStreamReader(const char* _buf, std::size_t _len) : m_buf(_buf), m_len(_len) {}
+    explicit JsonStreamReader(std::string_view _json) : JsonStreamReader(_json.data(), _json.size())
+    {}
+
+    // the type of the next value, the whitespace before it skipped
+    eJsonType peekType()
+    {
+        char c = nextNonSpace();
+        back();
+        switch (c)
+        {
+        case '{':
+            return eJsonTypeObj;
+        case '[':
+            return eJsonTypeArray;
+        case '"':
+            return eJsonTypeString;
+        case 'T':
+        case 't':
+        case 'F':
+        case 'f':
+            return eJsonTypeBoolean;
+        case 'n':
+        case 'N':
+            return eJsonTypeNull;
+        default:
+            if ((c >= '0' && c <= '9') || c == '-')
+            {
+                return eJsonTypeNum;
+            }
+            error("buffer overflow when peekBuf, over %u.", m_cur);
+        }
+        return eJsonTypeNull;
+    }
+
+    /**
+     * @brief read the members of the next object, _onKey(std::string_view) reads or skips the
+     * value of the key
+     */
+    template <typename F>
+    void readObject(F&& _onKey)
+    {
+        nextNonSpace();
+        bool first = true;
+        while (true)
+        {
+            char c = nextNonSpace();
+            if (c == '}' && first)
+            {
+                return;
+            }
+            first = false;
+            if (c != '"')
+            {
+                error("get obj error(key is not string)[pos:%u]", m_cur);
+            }
+            std::string_view key;
+            readRawString(key, m_key);
+            if (nextNonSpace() != ':')
+            {
+                error("get obj error(: not find)[pos:%u]", m_cur);
+            }
+            _onKey(key);
+
+            c = nextNonSpace();
+            if (c == ',')
+            {
+                continue;
+            }
+            if (c == '}')
+            {
+                return;
+            }
+            error("get obj error(, not find)[pos:%u]", m_cur);
+        }
+    }
+
+    // read the elements of the next array, _onElement() reads or skips the element
+    template <typename F>
+    void readArray(F&& _onElement)
+    {
+        nextNonSpace();
+        if (nextNonSpace() == ']')
+        {
+            return;
+        }
+        back();
+        while (true)
+        {
+            _onElement();
+
+            char c = nextNonSpace();
+            if (c == ',')
+            {
+                continue;
+            }
+            if (c == ']')
+            {
+                return;
+            }
+            error("get vector error(, not find )[pos:%u]", m_cur);
+        }
+    }
+
+    void skipValue()
+    {
+        switch (peekType())
+        {
+        case eJsonTypeObj:
+            readObject([this](std::string_view) { skipValue(); });
+            break;
+        case eJsonTypeArray:
+            readArray([this]() { skipValue(); });
+            break;
+        case eJsonTypeString:
+        {
+            std::string_view s;
+            nextNonSpace();
+            readRawString(s, m_value);
+            break;
+        }
+        case eJsonTypeNum:
+        {
+            int64_t n;
+            readNum(n);
+            break;
+        }
+        case eJsonTypeBoolean:
+            readBoolean();
+            break;
+        default:
+            readNull();
+            break;
+        }
+    }
+
+    // the view is valid until the next string read
+    bool readStringView(std::string_view& _s, bool _required)
+    {
+        if (!expect(eJsonTypeString, "string", _required))
+        {
+            return false;
+        }
+        nextNonSpace();
+        readRawString(_s, m_value);
+        return true;
+    }
+
+    bool read(std::string& _s, bool _required)
+    {
+        std::string_view s;
+        if (!readStringView(s, _required))
+        {
+            return false;
+        }
+        _s.assign(s.data(), s.size());
+        return true;
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, bool>::type
+    read(T& _n, bool _required)
+    {
+        if (!expect(eJsonTypeNum, "num", _required))
+        {
+            return false;
+        }
+        int64_t n = 0;
+        readNum(n);
+        _n = (T)n;
+        return true;
+    }
+
+    bool read(std::vector<Char>& _v, bool _required)
+    {
+        if (!expect(eJsonTypeArray, "vector", _required))
+        {
+            return false;
+        }
+        _v.clear();
+        readArray([this, &_v]() {
+            Char c = 0;
+            read(c, true);
+            _v.push_back(c);
+        });
+        return true;
+    }
+
+    template <typename T>
+    bool readStruct(T& _v, bool _required)
+    {
+        if (!expect(eJsonTypeObj, "struct", _required))
+        {
+            return false;
+        }
+        _v.readFromJsonStream(*this);
+        return true;
+    }
+
+    template <typename T>
+    bool readStructs(std::vector<T>& _v, bool _required)
+    {
+        if (!expect(eJsonTypeArray, "vector", _required))
+        {
+            return false;
+        }
+        _v.clear();
+        readArray([this, &_v]() {
+            _v.emplace_back();
+            readStruct(_v.back(), true);
+        });
+        return true;
+    }
+
+    // throw if the struct has not the required fields
+    static void checkRequired(uint32_t _found, uint32_t _required, const char* _className)
+    {
+        if ((_found & _required) != _required)
+        {
+            std::string s = "read '";
+            s.append(_className).append("' required field not exist");
+            throw TC_Json_Exception(s);
+        }
+    }
+
+    [[noreturn]] static void error(const char* _format, std::size_t _pos)
+    {
+        char s[64];
+        snprintf(s, sizeof(s), _format, (uint32_t)_pos);
+        throw TC_Json_Exception(s);
+    }
+
+private:
+    bool expect(eJsonType _type, const char* _name, bool _required)
+    {
+        auto type = peekType();
+        if (type == _type)
+        {
+            return true;
+        }
+        if (_required)
+        {
+            char s[128];
+            snprintf(s, sizeof(s), "read '%s' type mismatch, get type: %d.", _name, type);
+            throw TC_Json_Exception(s);
+        }
+        skipValue();
+        return false;
+    }
+
+    char read()
+    {
+        if (m_cur >= m_len)
+        {
+            error("buffer overflow when peekBuf, over %u.", m_len);
+        }
+        return m_buf[m_cur++];
+    }
+
+    void back() { m_cur--; }
+
+    char nextNonSpace()
+    {
+        char c = read();
+        while (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+        {
+            c = read();
+        }
+        return c;
+    }
+
+    // the opening quote read, the same unescaping as TC_Json::getString
+    void readRawString(std::string_view& _s, std::string& _scratch)
+    {
+        auto begin = m_cur;
+        while (true)
+        {
+            char c = read();
+            if (c == '"')
+            {
+                _s = std::string_view(m_buf + begin, m_cur - begin - 1);
+                return;
+            }
+            if (c == '\\')
+            {
+                break;
+            }
+        }
+
+        back();
+        _scratch.assign(m_buf + begin, m_cur - begin);
+        while (true)
+        {
+            char c = read();
+            if (c == '"')
+            {
+                break;
+            }
+            if (c != '\\')
+            {
+                _scratch.push_back(c);
+                continue;
+            }
+            c = read();
+            switch (c)
+            {
+            case '\\':
+            case '"':
+            case '/':
+                _scratch.push_back(c);
+                break;
+            case 'b':
+                _scratch.push_back('\b');
+                break;
+            case 'f':
+                _scratch.push_back('\f');
+                break;
+            case 'n':
+                _scratch.push_back('\n');
+                break;
+            case 'r':
+                _scratch.push_back('\r');
+                break;
+            case 't':
+                _scratch.push_back('\t');
+                break;
+            case 'u':
+                appendUtf8(readHex(), _scratch);
+                break;
+            default:
+                // dropped as TC_Json does
+                break;
+            }
+        }
+        _s = std::string_view(_scratch.data(), _scratch.size());
+    }
+
+    uint32_t readHex()
+    {
+        uint32_t code = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            char c = read();
+            if (c >= 'a' && c <= 'f')
+            {
+                code = code * 16 + c - 'a' + 10;
+            }
+            else if (c >= 'A' && c <= 'F')
+            {
+                code = code * 16 + c - 'A' + 10;
+            }
+            else if (c >= '0' && c <= '9')
+            {
+                code = code * 16 + c - '0';
+            }
+            else
+            {
+                error("get string error3(\\u)[pos:%u]", m_cur);
+            }
+        }
+        return code;
+    }
+
+    static void appendUtf8(uint32_t _code, std::string& _s)
+    {
+        if (_code < 0x00080)
+        {
+            _s.push_back((char)(_code & 0xFF));
+        }
+        else if (_code < 0x00800)
+        {
+            _s.push_back((char)(0xC0 + ((_code >> 6) & 0x1F)));
+            _s.push_back((char)(0x80 + (_code & 0x3F)));
+        }
+        else
+        {
+            _s.push_back((char)(0xE0 + ((_code >> 12) & 0x0F)));
+            _s.push_back((char)(0x80 + ((_code >> 6) & 0x3F)));
+            _s.push_back((char)(0x80 + (_code & 0x3F)));
+        }
+    }
+
+    // the same arithmetic as TC_Json::getNum, the integer value of the floats truncated
+    void readNum(int64_t& _n)
+    {
+        char head = nextNonSpace();
+        bool ok = true;
+        bool isFloat = false;
+        bool exponential = false;
+        bool negative = false;
+        bool exponentialNegative = false;
+        int64_t integer = 0;
+        double fraction = 0;
+        double fractionRate = 0;
+        int64_t exponent = 0;
+        if (head == '-')
+        {
+            ok = false;
+            negative = true;
+        }
+        else
+        {
+            integer = head - '0';
+        }
+
+        while (m_cur < m_len)
+        {
+            char c = read();
+            if (c >= '0' && c <= '9')
+            {
+                ok = true;
+                if (exponential)
+                {
+                    exponent = exponent * 10 + c - '0';
+                }
+                else if (isFloat)
+                {
+                    fraction = fraction + fractionRate * (c - '0');
+                    fractionRate = fractionRate * 0.1;
+                }
+                else
+                {
+                    integer = integer * 10 + c - '0';
+                }
+            }
+            else if (c == '.' && !isFloat && !exponential && ok)
+            {
+                ok = false;
+                isFloat = true;
+                fractionRate = 0.1;
+            }
+            else if ((c == 'e' || c == 'E') && !exponential && ok)
+            {
+                ok = false;
+                exponential = true;
+                exponent = 0;
+                if (m_cur >= m_len)
+                {
+                    break;
+                }
+                c = read();
+                if (c == '-')
+                {
+                    exponentialNegative = true;
+                }
+                else if (c >= '0' && c <= '9')
+                {
+                    ok = true;
+                    exponential = (bool)(c - '0');
+                }
+                else if (c != '+')
+                {
+                    back();
+                    break;
+                }
+            }
+            else
+            {
+                back();
+                break;
+            }
+        }
+        if (!ok)
+        {
+            error("get num error[pos:%u]", m_cur);
+        }
+        if (exponentialNegative)
+        {
+            exponent = 0 - exponent;
+        }
+
+        if (isFloat)
+        {
+            double result = (integer + fraction) * pow(10, exponent);
+            _n = (int64_t)(negative ? 0 - result : result);
+        }
+        else
+        {
+            _n = negative ? 0 - integer : integer;
+        }
+    }
+
+    bool readBoolean()
+    {
+        char c = nextNonSpace();
+        const char* rest = (c == 't' || c == 'T') ? "rue" : "alse";
+        for (const char* p = rest; *p; ++p)
+        {
+            if ((read() | 0x20) != *p)
+            {
+                error("get bool error[pos:%u]", m_cur);
+            }
+        }
+        return c == 't' || c == 'T';
+    }
+
+    void readNull()
+    {
+        nextNonSpace();
+        for (const char* p = "ull"; *p; ++p)
+        {
+            if ((read() | 0x20) != *p)
+            {
+                error("get NULL error[pos:%u]", m_cur);
+            }
+        }
+    }
+
+private:
+    const char* m_buf;
+    std::size_t m_len;
+    std::size_t m_cur = 0;
+    // the unescaped keys and strings
+    std::string m_key;
+    std::string m_value;
+};
+}  // namespace tars
+
+#endif
@@ -0,0 +1,333 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief walk the tars encoded fields over the buffer without copying them
+ * @file TarsView.h
+ * @author: octopus
+ * @date 2023-04-11
+ */
+
+#ifndef __TARS_VIEW_H__
+#define __TARS_VIEW_H__
+
+#include <bcos-cpp-sdk/utilities/tx/tars/tup/Tars.h>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+
+namespace tars
+{
+/**
+ * @brief read the fields of the tars encoded structs as the views of the buffer. Every read is
+ * bounds checked against the buffer and throws TarsDecodeException on the malformed input, the
+ * views are valid as long as the buffer.
+ *
+ * The fields of a struct are visited in the encoded order:
+ *
+ *     TarsViewReader::Head head;
+ *     while (reader.nextField(head))
+ *     {
+ *         switch (head.tag) { case 1: n = reader.readInt(head); break; ...
+ *         default: reader.skipField(head.type); }
+ *     }
+ *
+ * nextField returns false at the end of the buffer for the top struct, and after consuming the
+ * StructEnd for the struct of a field begun by beginStruct.
+ */
+class TarsViewReader
+{
+public:
+    struct Head
+    {
+        uint8_t type = 0;
+        uint8_t tag = 0;
+    };
+
+    TarsViewReader(const char* _buf, std::size_t _len) : m_buf(_buf), m_len(_len) {}
+
+    std::size_t position() const { return m_cur; }
+    bool hasEnd() const { return m_cur >= m_len; }
+
+    bool nextField(Head& _head)
+    {
+        if (hasEnd())
+        {
+            if (m_structDepth > 0)
+            {
+                throw TarsDecodeException("struct end not found");
+            }
+            return false;
+        }
+        readHead(_head);
+        if (_head.type != TarsHeadeStructEnd)
+        {
+            return true;
+        }
+        if (m_structDepth > 0)
+        {
+            --m_structDepth;
+        }
+        return false;
+    }
+
+    // the integral field of any width, the same as TarsInputStream::read(Int64&)
+    Int64 readInt(const Head& _head)
+    {
+        switch (_head.type)
+        {
+        case TarsHeadeZeroTag:
+            return 0;
+        case TarsHeadeChar:
+            return (Char)readBigEndian(1);
+        case TarsHeadeShort:
+            return (Short)readBigEndian(2);
+        case TarsHeadeInt32:
+            return (Int32)readBigEndian(4);
+        case TarsHeadeInt64:
+            return (Int64)readBigEndian(8);
+        default:
+            mismatch("int", _head);
+        }
+        return 0;
+    }
+
+    std::string_view readString(const Head& _head)
+    {
+        uint64_t len = 0;
+        switch (_head.type)
+        {
+        case TarsHeadeString1:
+            len = readBigEndian(1);
+            break;
+        case TarsHeadeString4:
+            len = readBigEndian(4);
+            if (len > TARS_MAX_STRING_LENGTH)
+            {
+                invalid("string size", _head, len);
+            }
+            break;
+        default:
+            mismatch("string", _head);
+        }
+        return readView(len);
+    }
+
+    // the vector<Char> field, encoded as the SimpleList of Char by the tars writer
+    std::string_view readBytes(const Head& _head)
+    {
+        if (_head.type != TarsHeadeSimpleList)
+        {
+            mismatch("bytes", _head);
+        }
+        Head elementHead;
+        readHead(elementHead);
+        if (elementHead.type != TarsHeadeChar)
+        {
+            mismatch("bytes element", elementHead);
+        }
+        return readView(readSize(_head));
+    }
+
+    // the number of the elements of the list field, the elements follow with tag 0
+    std::size_t readListSize(const Head& _head)
+    {
+        if (_head.type != TarsHeadeList)
+        {
+            mismatch("list", _head);
+        }
+        // every element takes one byte at least
+        return readSize(_head);
+    }
+
+    // the head of an element of the list
+    void readElementHead(Head& _head) { readHead(_head); }
+
+    // the fields of the struct follow till its StructEnd
+    void beginStruct(const Head& _head)
+    {
+        if (_head.type != TarsHeadeStructBegin)
+        {
+            mismatch("struct", _head);
+        }
+        ++m_structDepth;
+    }
+
+    void skipField(uint8_t _type, std::size_t _depth = 0)
+    {
+        // nested containers of the malformed input exhaust the stack
+        if (_depth > c_maxDepth)
+        {
+            throw TarsDecodeInvalidValue("skipField too deep");
+        }
+        switch (_type)
+        {
+        case TarsHeadeChar:
+            skip(1);
+            break;
+        case TarsHeadeShort:
+            skip(2);
+            break;
+        case TarsHeadeInt32:
+        case TarsHeadeFloat:
+            skip(4);
+            break;
+        case TarsHeadeInt64:
+        case TarsHeadeDouble:
+            skip(8);
+            break;
+        case TarsHeadeString1:
+            skip(readBigEndian(1));
+            break;
+        case TarsHeadeString4:
+            skip(readBigEndian(4));
+            break;
+        case TarsHeadeMap:
+        case TarsHeadeList:
+        {
+            Head head{_type, 0};
+            auto size = readSize(head) * (_type == TarsHeadeMap ? 2 : 1);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                readHead(head);
+                skipField(head.type, _depth + 1);
+            }
+            break;
+        }
+        case TarsHeadeSimpleList:
+            readBytes(Head{_type, 0});
+            break;
+        case TarsHeadeStructBegin:
+        {
+            Head head;
+            do
+            {
+                readHead(head);
+                skipField(head.type, _depth + 1);
+            } while (head.type != TarsHeadeStructEnd);
+            break;
+        }
+        case TarsHeadeStructEnd:
+        case TarsHeadeZeroTag:
+            break;
+        default:
+        {
+            char s[64];
+            snprintf(s, sizeof(s), "skipField with invalid type, type value:%d.", _type);
+            throw TarsDecodeMismatch(s);
+        }
+        }
+    }
+
+    // throw if the required field of the tag is not found
+    static void checkRequired(bool _found, uint8_t _tag, const char* _className)
+    {
+        if (!_found)
+        {
+            char s[128];
+            snprintf(
+                s, sizeof(s), "require field not exist, tag: %d, class: %s", _tag, _className);
+            throw TarsDecodeRequireNotExist(s);
+        }
+    }
+
+private:
+    static constexpr std::size_t c_maxDepth = 64;
+
+    void readHead(Head& _head)
+    {
+        auto typeTag = (uint8_t)readBigEndian(1);
+        _head.type = typeTag & 0x0F;
+        _head.tag = typeTag >> 4;
+        if (_head.tag == 15)
+        {
+            _head.tag = (uint8_t)readBigEndian(1);
+        }
+    }
+
+    // the size of the list, the integral with tag 0 not more than the bytes left
+    std::size_t readSize(const Head& _head)
+    {
+        Head sizeHead;
+        readHead(sizeHead);
+        auto size = readInt(sizeHead);
+        if (size < 0 || (uint64_t)size > m_len - m_cur)
+        {
+            invalid("size", _head, size);
+        }
+        return (std::size_t)size;
+    }
+
+    uint64_t readBigEndian(std::size_t _size)
+    {
+        checkLeft(_size);
+        uint64_t n = 0;
+        for (std::size_t i = 0; i < _size; ++i)
+        {
+            n = (n << 8) | (uint8_t)m_buf[m_cur + i];
+        }
+        m_cur += _size;
+        return n;
+    }
+
+    std::string_view readView(uint64_t _size)
+    {
+        checkLeft(_size);
+        std::string_view view(m_buf + m_cur, _size);
+        m_cur += _size;
+        return view;
+    }
+
+    void skip(uint64_t _size)
+    {
+        checkLeft(_size);
+        m_cur += _size;
+    }
+
+    void checkLeft(uint64_t _size) const
+    {
+        if (tars_unlikely(_size > m_len - m_cur))
+        {
+            char s[96];
+            snprintf(s, sizeof(s), "buffer overflow when read %lu bytes at %lu, over %lu.",
+                (unsigned long)_size, (unsigned long)m_cur, (unsigned long)m_len);
+            throw TarsDecodeException(s);
+        }
+    }
+
+    [[noreturn]] static void mismatch(const char* _name, const Head& _head)
+    {
+        char s[64];
+        snprintf(s, sizeof(s), "read '%s' type mismatch, tag: %d, get type: %d.", _name,
+            _head.tag, _head.type);
+        throw TarsDecodeMismatch(s);
+    }
+
+    [[noreturn]] static void invalid(const char* _name, const Head& _head, int64_t _value)
+    {
+        char s[96];
+        snprintf(s, sizeof(s), "invalid %s, tag: %d, type: %d, value: %lld", _name, _head.tag,
+            _head.type, (long long)_value);
+        throw TarsDecodeInvalidValue(s);
+    }
+
+    const char* m_buf;
+    std::size_t m_len;
+    std::size_t m_cur = 0;
+    // the structs begun and not ended
+    std::size_t m_structDepth = 0;
+};
+}  // namespace tars
+
+#endif
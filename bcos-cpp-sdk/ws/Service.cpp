@@ -17,6 +17,7 @@
  * @author: octopus
  * @date 2021-10-22
  */
+#include <bcos-boostssl/websocket/WsConnector.h>
 #include <bcos-boostssl/websocket/WsError.h>
 #include <bcos-cpp-sdk/ws/Common.h>
 #include <bcos-cpp-sdk/ws/HandshakeResponse.h>
@@ -42,9 +43,17 @@ using namespace bcos;
 static const int32_t BLOCK_LIMIT_RANGE = 500;
 
 Service::Service(bcos::group::GroupInfoCodec::Ptr _groupInfoCodec,
-    bcos::group::GroupInfoFactory::Ptr _groupInfoFactory, std::string _moduleName)
-  : WsService(_moduleName), m_groupInfoCodec(_groupInfoCodec), m_groupInfoFactory(_groupInfoFactory)
+    bcos::group::GroupInfoFactory::Ptr _groupInfoFactory, std::string _moduleName,
+    SharedContext::Ptr _sharedContext)
+  : WsService(_moduleName),
+    m_groupInfoCodec(_groupInfoCodec),
+    m_groupInfoFactory(_groupInfoFactory),
+    m_sharedContext(_sharedContext)
 {
+    if (m_sharedContext)
+    {
+        m_sharedContext->attach();
+    }
     m_localProtocol = g_BCOSConfig.protocolInfo(bcos::protocol::ProtocolModuleID::RpcService);
     RPC_WS_LOG(INFO) << LOG_DESC("init the local protocol")
                      << LOG_KV("minVersion", m_localProtocol->minVersion())
@@ -54,14 +63,64 @@ Service::Service(bcos::group::GroupInfoCodec::Ptr _groupInfoCodec,
 
 void Service::start()
 {
+    if (m_sharedContext)
+    {
+        m_sharedContext->start();
+    }
+
     bcos::boostssl::ws::WsService::start();
 
     waitForConnectionEstablish();
 }
 
+void Service::useSharedContext()
+{
+    if (!m_sharedContext)
+    {
+        return;
+    }
+
+    auto ioServicePool = m_sharedContext->ioServicePool();
+    setIOServicePool(ioServicePool);
+    setThreadPool(m_sharedContext->threadPool());
+    setTimerFactory(m_sharedContext->timerFactory());
+
+    // the sessions run on the io context the connector resolves on, rebuild the connector on the
+    // shared one with the stream builder and the ssl context of the initializer
+    auto initConnector = connector();
+    auto resolver =
+        std::make_shared<boost::asio::ip::tcp::resolver>(*ioServicePool->getIOService());
+    auto sharedConnector = std::make_shared<WsConnector>(resolver);
+    sharedConnector->setBuilder(initConnector->builder());
+    sharedConnector->setCtx(initConnector->ctx());
+    setConnector(sharedConnector);
+}
+
 void Service::stop()
 {
+    if (!m_sharedContext)
+    {
+        bcos::boostssl::ws::WsService::stop();
+        return;
+    }
+
+    // close the sessions of this instance first, they run on the shared io context
+    for (const auto& session : sessions())
+    {
+        session->drop(bcos::boostssl::ws::WsError::UserDisconnect);
+    }
+
+    // the base class stops the executors it holds, release the shared ones before so that only
+    // the timers of this instance are stopped and the other instances keep running
+    auto sharedContext = m_sharedContext;
+    m_sharedContext.reset();
+    setIOServicePool(nullptr);
+    setThreadPool(nullptr);
     bcos::boostssl::ws::WsService::stop();
+    sharedContext->detach();
+
+    RPC_WS_LOG(INFO) << LOG_BADGE("stop") << LOG_DESC("detach from the shared context")
+                     << LOG_KV("attachedCount", sharedContext->attachedCount());
 }
 
 void Service::waitForConnectionEstablish()
@@ -21,6 +21,7 @@
 #pragma once
 #include <bcos-boostssl/websocket/WsService.h>
 #include <bcos-cpp-sdk/ws/BlockNumberInfo.h>
+#include <bcos-cpp-sdk/ws/SharedContext.h>
 #include <bcos-framework/interfaces/multigroup/GroupInfoCodec.h>
 #include <bcos-framework/interfaces/multigroup/GroupInfoFactory.h>
 #include <bcos-framework/interfaces/protocol/GlobalConfig.h>
@@ -47,7 +48,8 @@ public:
     using Ptr = std::shared_ptr<Service>;
     using ConstPtr = std::shared_ptr<const Service>;
     Service(bcos::group::GroupInfoCodec::Ptr _groupInfoCodec,
-        bcos::group::GroupInfoFactory::Ptr _groupInfoFactory, std::string _moduleName);
+        bcos::group::GroupInfoFactory::Ptr _groupInfoFactory, std::string _moduleName,
+        SharedContext::Ptr _sharedContext = nullptr);
 
     // ---------------------overide begin------------------------------------
 
@@ -118,6 +120,13 @@ public:
 
     uint32_t handshakeSucCount() const { return m_handshakeSucCount.load(); }
 
+    // the io context and thread pool shared with other Service instances, nullptr if the
+    // instance owns its executors
+    SharedContext::Ptr sharedContext() const { return m_sharedContext; }
+    // take the shared executors in place of the ones built by WsInitializer, called after
+    // initWsService
+    void useSharedContext();
+
     void increaseHandshakeSucCount() { m_handshakeSucCount++; }
 
     void registerWsHandshakeSucHandler(WsHandshakeSucHandler _handler)
@@ -139,6 +148,8 @@ private:
     //
     std::vector<WsHandshakeSucHandler> m_wsHandshakeSucHandlers;
 
+    SharedContext::Ptr m_sharedContext;
+
 private:
     mutable boost::shared_mutex x_endPointLock;
     // group => node => endpoints
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file SharedContext.cpp
+ * @author: octopus
+ * @date 2023-03-06
+ */
+#include <bcos-cpp-sdk/ws/Common.h>
+#include <bcos-cpp-sdk/ws/SharedContext.h>
+#include <bcos-utilities/BoostLog.h>
+#include <algorithm>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::service;
+
+SharedContext::SharedContext(std::size_t _ioThreadCount, std::size_t _threadPoolSize)
+  : m_ioThreadCount(std::max<std::size_t>(_ioThreadCount, 1)),
+    m_threadPoolSize(std::max<std::size_t>(_threadPoolSize, 1))
+{
+    m_ioServicePool = std::make_shared<bcos::IOServicePool>(m_ioThreadCount);
+    m_threadPool = std::make_shared<bcos::ThreadPool>("t_sdk_shared", m_threadPoolSize);
+    m_timerFactory = std::make_shared<bcos::timer::TimerFactory>();
+
+    RPC_WS_LOG(INFO) << LOG_BADGE("SharedContext") << LOG_DESC("create shared context")
+                     << LOG_KV("ioThreadCount", m_ioThreadCount)
+                     << LOG_KV("threadPoolSize", m_threadPoolSize);
+}
+
+void SharedContext::start()
+{
+    std::lock_guard<std::mutex> lock(x_running);
+    if (m_running)
+    {
+        return;
+    }
+    m_running = true;
+    m_ioServicePool->start();
+
+    RPC_WS_LOG(INFO) << LOG_BADGE("SharedContext") << LOG_DESC("start shared context")
+                     << LOG_KV("ioThreadCount", m_ioThreadCount)
+                     << LOG_KV("threadPoolSize", m_threadPoolSize);
+}
+
+void SharedContext::stop()
+{
+    std::lock_guard<std::mutex> lock(x_running);
+    if (!m_running)
+    {
+        return;
+    }
+    m_running = false;
+    m_ioServicePool->stop();
+    m_threadPool->stop();
+
+    RPC_WS_LOG(INFO) << LOG_BADGE("SharedContext") << LOG_DESC("stop shared context")
+                     << LOG_KV("attachedCount", m_attachedCount.load());
+}
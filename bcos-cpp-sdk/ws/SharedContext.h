@@ -0,0 +1,87 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file SharedContext.h
+ * @author: octopus
+ * @date 2023-03-06
+ */
+
+#pragma once
+#include <bcos-utilities/IOServicePool.h>
+#include <bcos-utilities/ThreadPool.h>
+#include <bcos-utilities/Timer.h>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace service
+{
+/**
+ * @brief the io context, message handling thread pool and timer factory shared by all the
+ * Service(and Sdk) instances built from the same SdkFactory, the thread counts are configured
+ * here once for the whole process instead of per connection config
+ */
+class SharedContext
+{
+public:
+    using Ptr = std::shared_ptr<SharedContext>;
+    using ConstPtr = std::shared_ptr<const SharedContext>;
+
+    SharedContext(std::size_t _ioThreadCount, std::size_t _threadPoolSize);
+    ~SharedContext() { stop(); }
+
+    SharedContext(const SharedContext&) = delete;
+    SharedContext(SharedContext&&) = delete;
+    SharedContext& operator=(const SharedContext&) = delete;
+    SharedContext& operator=(SharedContext&&) = delete;
+
+public:
+    void start();
+    void stop();
+
+    // the instances attached to the context, for report only
+    void attach() { m_attachedCount++; }
+    void detach() { m_attachedCount--; }
+    uint32_t attachedCount() const { return m_attachedCount.load(); }
+
+public:
+    std::size_t ioThreadCount() const { return m_ioThreadCount; }
+    std::size_t threadPoolSize() const { return m_threadPoolSize; }
+
+    std::shared_ptr<bcos::IOServicePool> ioServicePool() const { return m_ioServicePool; }
+    std::shared_ptr<bcos::ThreadPool> threadPool() const { return m_threadPool; }
+    std::shared_ptr<bcos::timer::TimerFactory> timerFactory() const { return m_timerFactory; }
+
+private:
+    std::size_t m_ioThreadCount;
+    std::size_t m_threadPoolSize;
+
+    std::mutex x_running;
+    bool m_running = false;
+    std::atomic<uint32_t> m_attachedCount{0};
+
+    std::shared_ptr<bcos::IOServicePool> m_ioServicePool;
+    std::shared_ptr<bcos::ThreadPool> m_threadPool;
+    std::shared_ptr<bcos::timer::TimerFactory> m_timerFactory;
+};
+
+}  // namespace service
+}  // namespace cppsdk
+}  // namespace bcos
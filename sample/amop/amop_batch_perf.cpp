@@ -0,0 +1,162 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file amop_batch_perf.cpp
+ * @author: octopus
+ * @date 2023-03-29
+ */
+
+#include <bcos-boostssl/websocket/WsMessage.h>
+#include <bcos-cpp-sdk/amop/AMOPBatch.h>
+#include <bcos-cpp-sdk/amop/AMOPRequest.h>
+#include <bcos-cpp-sdk/amop/Common.h>
+#include <bcos-utilities/Common.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::boostssl::ws;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::amop;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+void usage()
+{
+    std::cerr << "Desc: the client side cost of publishing small amop messages one frame each "
+                 "against batched, the frames are encoded and responded in process\n";
+    std::cerr << "Usage: amop_batch_perf <messageSize> <messageCount> <maxMessages>\n"
+              << "Example:\n"
+              << "    ./amop_batch_perf 128 1000000 256\n";
+    std::exit(0);
+}
+
+// encode the frame as the websocket layer, respond it with the payload as the subscriber
+std::shared_ptr<WsMessage> sendFrame(std::shared_ptr<WsMessageFactory> _messageFactory,
+    std::shared_ptr<bcos::protocol::AMOPRequestFactory> _requestFactory, const std::string& _topic,
+    uint32_t _version, bytesConstRef _data, uint64_t& _frameBytes)
+{
+    auto request = _requestFactory->buildRequest();
+    request->setTopic(_topic);
+    request->setVersion(_version);
+    request->setData(_data);
+    auto buffer = std::make_shared<bytes>();
+    request->encode(*buffer);
+
+    auto msg = std::dynamic_pointer_cast<WsMessage>(_messageFactory->buildMessage());
+    msg->setSeq(_messageFactory->newSeq());
+    msg->setPacketType(bcos::cppsdk::amop::MessageType::AMOP_REQUEST);
+    msg->setPayload(buffer);
+    auto frame = std::make_shared<bytes>();
+    msg->encode(*frame);
+    _frameBytes += frame->size();
+
+    auto resp = std::dynamic_pointer_cast<WsMessage>(_messageFactory->buildMessage());
+    resp->setSeq(msg->seq());
+    resp->setPacketType(bcos::cppsdk::amop::MessageType::AMOP_RESPONSE);
+    resp->setPayload(std::make_shared<bytes>(_data.begin(), _data.end()));
+    return resp;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        usage();
+    }
+
+    std::size_t messageSize = std::stoul(argv[1]);
+    std::size_t messageCount = std::stoul(argv[2]);
+    uint32_t maxMessages = std::max<uint32_t>(std::stoul(argv[3]), 1);
+
+    std::cout << LOG_DESC(" [AMOPBatchPerf] params ===>>>> ")
+              << LOG_KV("messageSize", messageSize) << LOG_KV("messageCount", messageCount)
+              << LOG_KV("maxMessages", maxMessages) << std::endl;
+
+    auto messageFactory = std::make_shared<WsMessageFactory>();
+    auto requestFactory = std::make_shared<bcos::protocol::AMOPRequestFactory>();
+    std::string topic = "topic";
+    bytes data(messageSize, 'a');
+    std::atomic<uint64_t> responded{0};
+    PubCallback callback = [&responded](Error::Ptr _error, std::shared_ptr<WsMessage>,
+                               std::shared_ptr<WsSession>) {
+        if (!_error)
+        {
+            responded++;
+        }
+    };
+
+    // one frame each
+    uint64_t frames = 0;
+    uint64_t frameBytes = 0;
+    auto startT = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < messageCount; ++i)
+    {
+        auto resp = sendFrame(messageFactory, requestFactory, topic, 0, ref(data), frameBytes);
+        frames++;
+        callback(nullptr, resp, nullptr);
+    }
+    auto singleMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - startT)
+                        .count();
+
+    std::cout << LOG_DESC(" [AMOPBatchPerf] single ===>>>> ") << LOG_KV("frames", frames)
+              << LOG_KV("frameBytes", frameBytes) << LOG_KV("responded", responded.load())
+              << LOG_KV("elapsed(ms)", singleMs)
+              << LOG_KV("msgs/s", singleMs > 0 ? messageCount * 1000 / singleMs : 0)
+              << std::endl;
+
+    // batched, the subscriber responds each message with its payload
+    responded = 0;
+    frames = 0;
+    frameBytes = 0;
+    AMOPPublishBatcher::Settings settings;
+    settings.maxMessages = maxMessages;
+    settings.maxBytes = std::max<uint32_t>(settings.maxBytes, maxMessages * (messageSize + 4));
+    settings.maxMessageSize = std::max<uint32_t>(settings.maxMessageSize, messageSize);
+    auto batcher = std::make_shared<AMOPPublishBatcher>(
+        settings,
+        [&](const std::string& _topic, std::shared_ptr<bytes> _envelope, uint32_t,
+            PubCallback _callback) {
+            auto resp = sendFrame(messageFactory, requestFactory, _topic, AMOP_BATCH_VERSION,
+                ref(*_envelope), frameBytes);
+            frames++;
+            _callback(nullptr, resp, nullptr);
+        },
+        messageFactory);
+
+    startT = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < messageCount; ++i)
+    {
+        batcher->publish(topic, ref(data), 10000, callback);
+    }
+    batcher->flush(true);
+    auto batchMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - startT)
+                       .count();
+
+    std::cout << LOG_DESC(" [AMOPBatchPerf] batched ===>>>> ") << LOG_KV("frames", frames)
+              << LOG_KV("frameBytes", frameBytes) << LOG_KV("responded", responded.load())
+              << LOG_KV("elapsed(ms)", batchMs)
+              << LOG_KV("msgs/s", batchMs > 0 ? messageCount * 1000 / batchMs : 0)
+              << LOG_KV("speedup", batchMs > 0 ? (double)singleMs / batchMs : 0) << std::endl;
+
+    return 0;
+}
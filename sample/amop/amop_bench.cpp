@@ -0,0 +1,357 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file amop_bench.cpp
+ * @author: octopus
+ * @date 2023-04-04
+ */
+
+#include "fake/AMOPNodeFake.h"
+#include <bcos-cpp-sdk/amop/AMOP.h>
+#include <bcos-utilities/Common.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::boostssl::ws;
+using namespace bcos::cppsdk::amop;
+using namespace bcos::cppsdk::test;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+void usage()
+{
+    std::cerr << "Desc: the amop throughput and latency between the sdk instances connected to an "
+                 "in process fake node, no chain required\n";
+    std::cerr << "Usage: amop_bench <publish|broadcast|subscribe|all> <messageSize> "
+                 "<messageCount> [rate] [subscribers] [window]\n"
+              << "    rate: messages per second, 0 for unlimited, default 0\n"
+              << "    subscribers: the subscriber instances, default 1\n"
+              << "    window: the max publishes waiting for the response, default 1000\n"
+              << "Example:\n"
+              << "    ./amop_bench all 256 100000 0 2 1000\n"
+              << "The exit code is not 0 if any message lost or failed\n";
+    std::exit(0);
+}
+
+using Clock = std::chrono::steady_clock;
+
+int64_t nowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now().time_since_epoch())
+        .count();
+}
+
+// the latencies in us
+class LatencyRecorder
+{
+public:
+    void record(int64_t _latencyUs)
+    {
+        std::lock_guard<std::mutex> lock(x_latencies);
+        m_latencies.push_back(_latencyUs);
+    }
+
+    void report(const std::string& _name, std::size_t _count, uint64_t _bytes, int64_t _elapsedUs)
+    {
+        std::lock_guard<std::mutex> lock(x_latencies);
+        std::sort(m_latencies.begin(), m_latencies.end());
+        auto percentile = [this](double _p) -> int64_t {
+            if (m_latencies.empty())
+            {
+                return 0;
+            }
+            auto index = (std::size_t)(_p * (m_latencies.size() - 1));
+            return m_latencies[index];
+        };
+        auto seconds = std::max<double>((double)_elapsedUs / 1000000, 1e-6);
+        std::cout << std::fixed << std::setprecision(2) << " [" << _name << "] count: " << _count
+                  << ", elapsed: " << seconds << " s"
+                  << ", throughput: " << _count / seconds << " msgs/s, "
+                  << (double)_bytes / seconds / 1024 / 1024 << " MB/s" << std::endl;
+        std::cout << " [" << _name << "] latency(us) p50: " << percentile(0.5)
+                  << ", p90: " << percentile(0.9) << ", p99: " << percentile(0.99)
+                  << ", p999: " << percentile(0.999)
+                  << ", max: " << (m_latencies.empty() ? 0 : m_latencies.back()) << std::endl;
+    }
+
+private:
+    std::mutex x_latencies;
+    std::vector<int64_t> m_latencies;
+};
+
+// send at the rate, 0 for unlimited
+class Pacer
+{
+public:
+    explicit Pacer(uint64_t _rate) : m_rate(_rate), m_start(Clock::now()) {}
+    void wait(std::size_t _index)
+    {
+        if (m_rate == 0)
+        {
+            return;
+        }
+        std::this_thread::sleep_until(
+            m_start + std::chrono::nanoseconds((int64_t)(_index * 1000000000 / m_rate)));
+    }
+
+private:
+    uint64_t m_rate;
+    Clock::time_point m_start;
+};
+
+// the payload with the send time in the first 8 bytes
+std::shared_ptr<bytes> buildPayload(std::size_t _size)
+{
+    return std::make_shared<bytes>(std::max<std::size_t>(_size, sizeof(int64_t)), 'a');
+}
+
+void stamp(bytes& _payload)
+{
+    auto now = nowUs();
+    std::memcpy(_payload.data(), &now, sizeof(now));
+}
+
+int64_t stampOf(bytesConstRef _data)
+{
+    int64_t stamp = 0;
+    if (_data.size() >= sizeof(stamp))
+    {
+        std::memcpy(&stamp, _data.data(), sizeof(stamp));
+    }
+    return stamp;
+}
+
+bool waitFor(std::function<bool()> _done, int64_t _timeoutMs)
+{
+    auto deadline = Clock::now() + std::chrono::milliseconds(_timeoutMs);
+    while (!_done())
+    {
+        if (Clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// publish to the subscribers round robin, the latency from the publish to the response
+bool benchPublish(std::size_t _size, std::size_t _count, uint64_t _rate,
+    std::size_t _subscriberCount, std::size_t _window)
+{
+    auto node = std::make_shared<AMOPNodeFake>();
+    auto publisher = node->connect("publisher");
+    std::string topic = "bench_publish";
+    std::atomic<uint64_t> received{0};
+    std::vector<AMOP::Ptr> subscribers;
+    for (std::size_t i = 0; i < _subscriberCount; ++i)
+    {
+        auto subscriber = node->connect("subscriber" + std::to_string(i));
+        std::weak_ptr<AMOP> weakSubscriber = subscriber;
+        subscriber->subscribe(topic,
+            [weakSubscriber, &received](Error::Ptr, const std::string& _endPoint,
+                const std::string& _seq, bytesConstRef, std::shared_ptr<WsSession>) {
+                received++;
+                auto subscriber = weakSubscriber.lock();
+                if (subscriber)
+                {
+                    subscriber->sendResponse(_endPoint, _seq, bytesConstRef());
+                }
+            });
+        subscribers.push_back(subscriber);
+    }
+    waitFor([&]() { return node->topics("subscriber0").count(topic) > 0; }, 5000);
+
+    LatencyRecorder latencies;
+    std::atomic<uint64_t> responded{0};
+    std::atomic<uint64_t> failed{0};
+    std::mutex x_window;
+    std::condition_variable windowCV;
+    std::size_t inFlight = 0;
+
+    auto payload = buildPayload(_size);
+    Pacer pacer(_rate);
+    auto start = nowUs();
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+        pacer.wait(i);
+        {
+            std::unique_lock<std::mutex> lock(x_window);
+            windowCV.wait(lock, [&]() { return inFlight < _window; });
+            inFlight++;
+        }
+
+        auto sendTime = nowUs();
+        publisher->publish(topic, ref(*payload), 30000,
+            [&, sendTime](Error::Ptr _error, std::shared_ptr<WsMessage>,
+                std::shared_ptr<WsSession>) {
+                if (_error && _error->errorCode() != 0)
+                {
+                    failed++;
+                }
+                else
+                {
+                    latencies.record(nowUs() - sendTime);
+                }
+                responded++;
+                std::lock_guard<std::mutex> lock(x_window);
+                inFlight--;
+                windowCV.notify_one();
+            });
+    }
+    auto done = waitFor([&]() { return responded.load() >= _count; }, 60000);
+    auto elapsed = nowUs() - start;
+
+    latencies.report("publish", responded.load(), responded.load() * payload->size(), elapsed);
+    std::cout << " [publish] received: " << received.load() << ", failed: " << failed.load()
+              << std::endl;
+    node->stop();
+    return done && failed.load() == 0 && received.load() == _count;
+}
+
+// broadcast to all the subscribers, the latency from the broadcast to the receipt of each
+bool benchBroadcast(std::size_t _size, std::size_t _count, uint64_t _rate,
+    std::size_t _subscriberCount)
+{
+    auto node = std::make_shared<AMOPNodeFake>();
+    auto broadcaster = node->connect("broadcaster");
+    std::string topic = "bench_broadcast";
+    LatencyRecorder latencies;
+    std::atomic<uint64_t> received{0};
+    std::vector<AMOP::Ptr> subscribers;
+    for (std::size_t i = 0; i < _subscriberCount; ++i)
+    {
+        auto subscriber = node->connect("subscriber" + std::to_string(i));
+        subscriber->subscribe(topic,
+            [&latencies, &received](Error::Ptr, const std::string&, const std::string&,
+                bytesConstRef _data, std::shared_ptr<WsSession>) {
+                latencies.record(nowUs() - stampOf(_data));
+                received++;
+            });
+        subscribers.push_back(subscriber);
+    }
+    waitFor(
+        [&]() {
+            return node->topics("subscriber" + std::to_string(_subscriberCount - 1)).count(topic) >
+                   0;
+        },
+        5000);
+
+    auto payload = buildPayload(_size);
+    Pacer pacer(_rate);
+    auto start = nowUs();
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+        pacer.wait(i);
+        stamp(*payload);
+        broadcaster->broadcast(topic, ref(*payload));
+    }
+    auto expected = _count * _subscriberCount;
+    auto done = waitFor([&]() { return received.load() >= expected; }, 60000);
+    auto elapsed = nowUs() - start;
+
+    latencies.report("broadcast", received.load(), received.load() * payload->size(), elapsed);
+    node->stop();
+    return done && received.load() == expected;
+}
+
+// subscribe and unsubscribe the topics one by one, the time until the node converged
+bool benchSubscribe(std::size_t _count, bool _incremental)
+{
+    auto node = std::make_shared<AMOPNodeFake>();
+    auto subscriber = node->connect("subscriber");
+    AMOPTopicSync::Settings settings;
+    settings.incremental = _incremental;
+    subscriber->setTopicSync(settings);
+
+    auto start = nowUs();
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+        subscriber->subscribe(std::set<std::string>{"topic" + std::to_string(i)});
+    }
+    for (std::size_t i = 0; i < _count; i += 2)
+    {
+        subscriber->unsubscribe(std::set<std::string>{"topic" + std::to_string(i)});
+    }
+    std::set<std::string> topics;
+    subscriber->querySubTopics(topics);
+    auto done = waitFor([&]() { return node->topics("subscriber") == topics; }, 60000);
+    auto elapsed = nowUs() - start;
+
+    auto topicSync = subscriber->topicSync();
+    std::string name = _incremental ? "subscribe incremental" : "subscribe full";
+    auto seconds = std::max<double>((double)elapsed / 1000000, 1e-6);
+    std::cout << std::fixed << std::setprecision(2) << " [" << name
+              << "] operations: " << _count + (_count + 1) / 2 << ", elapsed: " << seconds
+              << " s, throughput: " << (_count + (_count + 1) / 2) / seconds << " ops/s"
+              << ", sent: " << topicSync->sentBytes() << " bytes"
+              << ", full syncs: " << topicSync->fullSyncs()
+              << ", deltas: " << topicSync->deltas() << std::endl;
+    node->stop();
+    return done;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        usage();
+    }
+
+    std::string scenario = argv[1];
+    std::size_t size = std::atoi(argv[2]);
+    std::size_t count = std::atoi(argv[3]);
+    uint64_t rate = argc > 4 ? std::atoi(argv[4]) : 0;
+    std::size_t subscriberCount = argc > 5 ? std::max(std::atoi(argv[5]), 1) : 1;
+    std::size_t window = argc > 6 ? std::max(std::atoi(argv[6]), 1) : 1000;
+
+    std::cout << " scenario: " << scenario << ", messageSize: " << size
+              << ", messageCount: " << count << ", rate: " << rate
+              << ", subscribers: " << subscriberCount << ", window: " << window << std::endl;
+
+    bool ok = true;
+    if (scenario == "publish" || scenario == "all")
+    {
+        ok = benchPublish(size, count, rate, subscriberCount, window) && ok;
+    }
+    if (scenario == "broadcast" || scenario == "all")
+    {
+        ok = benchBroadcast(size, count, rate, subscriberCount) && ok;
+    }
+    if (scenario == "subscribe" || scenario == "all")
+    {
+        // the topics synced quadratically without the delta, keep it small
+        auto topicCount = std::min<std::size_t>(count, 2000);
+        ok = benchSubscribe(topicCount, false) && ok;
+        ok = benchSubscribe(topicCount, true) && ok;
+    }
+
+    std::cout << (ok ? " PASS" : " FAIL") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
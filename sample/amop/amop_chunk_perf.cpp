@@ -0,0 +1,164 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file amop_chunk_perf.cpp
+ * @author: octopus
+ * @date 2023-03-27
+ */
+
+#include <bcos-cpp-sdk/amop/AMOPChunk.h>
+#include <bcos-cpp-sdk/amop/AMOPTopicStats.h>
+#include <bcos-utilities/Common.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::amop;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+void usage()
+{
+    std::cerr << "Desc: reassemble the chunked amop messages in process, the fragments arrive "
+                 "out of order within a window, whole or stream mode\n";
+    std::cerr << "Usage: amop_chunk_perf <messageSize> <chunkSize> <messageCount> <whole|stream> "
+                 "[window]\n"
+              << "Example:\n"
+              << "    ./amop_chunk_perf 16777216 262144 64 whole 4\n"
+              << "    ./amop_chunk_perf 16777216 262144 64 stream 4\n";
+    std::exit(0);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        usage();
+    }
+
+    std::size_t messageSize = std::max<std::size_t>(std::stoul(argv[1]), 1);
+    uint32_t chunkSize = std::max<uint32_t>(std::stoul(argv[2]), 1);
+    std::size_t messageCount = std::stoul(argv[3]);
+    bool stream = (std::string(argv[4]) == "stream");
+    std::size_t window = argc > 5 ? std::max<std::size_t>(std::stoul(argv[5]), 1) : 4;
+
+    std::cout << LOG_DESC(" [AMOPChunkPerf] params ===>>>> ")
+              << LOG_KV("messageSize", messageSize) << LOG_KV("chunkSize", chunkSize)
+              << LOG_KV("messageCount", messageCount) << LOG_KV("stream", stream)
+              << LOG_KV("window", window) << std::endl;
+
+    bytes data(messageSize);
+    for (std::size_t i = 0; i < messageSize; ++i)
+    {
+        data[i] = (byte)i;
+    }
+
+    AMOPChunkReassembler::Settings settings;
+    settings.maxMessageSize = std::max<uint64_t>(settings.maxMessageSize, messageSize);
+    settings.maxBufferedBytes = std::max<uint64_t>(settings.maxBufferedBytes, 2 * messageSize);
+    AMOPChunkReassembler reassembler(settings);
+    AMOPTopicStats stats;
+
+    uint64_t deliveredBytes = 0;
+    uint64_t peakBufferedBytes = 0;
+    std::mt19937 rng(1);
+    uint32_t count = (messageSize + chunkSize - 1) / chunkSize;
+
+    auto startT = std::chrono::high_resolution_clock::now();
+    for (std::size_t m = 0; m < messageCount; ++m)
+    {
+        std::string topic = "topic" + std::to_string(m % 4);
+        // the fragments are sent with at most window in flight, shuffled within the window
+        std::vector<uint32_t> order(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            order[i] = i;
+        }
+        for (std::size_t begin = 0; begin < count; begin += window)
+        {
+            auto end = std::min<std::size_t>(begin + window, count);
+            std::shuffle(order.begin() + begin, order.begin() + end, rng);
+        }
+
+        for (auto index : order)
+        {
+            AMOPChunkHeader header;
+            header.transferId = m + 1;
+            header.index = index;
+            header.count = count;
+            header.totalSize = messageSize;
+            header.offset = (uint64_t)index * chunkSize;
+
+            bytes encoded;
+            auto fragmentSize = std::min<uint64_t>(chunkSize, messageSize - header.offset);
+            encoded.reserve(AMOPChunkHeader::SIZE + fragmentSize);
+            header.encode(encoded);
+            encoded.insert(encoded.end(), data.begin() + header.offset,
+                data.begin() + header.offset + fragmentSize);
+            stats.onSent(topic, fragmentSize, 1, index + 1 == count);
+
+            AMOPChunkHeader decoded;
+            bytesConstRef fragment;
+            decoded.decode(ref(encoded), fragment);
+            stats.onRecv(topic, fragment.size(), 1, false);
+
+            std::string reason;
+            auto result = reassembler.append(decoded, fragment, stream,
+                [&deliveredBytes](const AMOPChunkFragment& _fragment) {
+                    deliveredBytes += _fragment.data->size();
+                },
+                reason);
+            if (result == AMOPChunkReassembler::Result::Completed)
+            {
+                stats.onRecv(topic, 0, 0, true);
+            }
+            else if (result == AMOPChunkReassembler::Result::Rejected)
+            {
+                stats.onDropped(topic);
+            }
+            peakBufferedBytes = std::max(peakBufferedBytes, reassembler.bufferedBytes());
+        }
+    }
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - startT)
+                         .count();
+
+    double mbps = elapsedMs > 0 ? (double)deliveredBytes / 1024 / 1024 * 1000 / elapsedMs : 0;
+    std::cout << LOG_DESC(" [AMOPChunkPerf] ===>>>> ")
+              << LOG_KV("mode", stream ? "stream" : "whole")
+              << LOG_KV("deliveredBytes", deliveredBytes)
+              << LOG_KV("peakBufferedBytes", peakBufferedBytes)
+              << LOG_KV("elapsed(ms)", elapsedMs) << LOG_KV("MB/s", mbps) << std::endl;
+
+    for (const auto& [topic, throughput] : stats.throughput())
+    {
+        std::cout << LOG_DESC(" [AMOPChunkPerf] topic ===>>>> ") << LOG_KV("topic", topic)
+                  << LOG_KV("recvMessages", throughput.recvMessages)
+                  << LOG_KV("recvFragments", throughput.recvFragments)
+                  << LOG_KV("recvBytes", throughput.recvBytes)
+                  << LOG_KV("dropped", throughput.droppedMessages)
+                  << LOG_KV("recvBytes/s", (uint64_t)throughput.recvBytesPerSecond())
+                  << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file amop_executor_perf.cpp
+ * @author: octopus
+ * @date 2023-03-31
+ */
+
+#include <bcos-cpp-sdk/amop/AMOPExecutor.h>
+#include <bcos-utilities/Common.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::amop;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+void usage()
+{
+    std::cerr << "Desc: the throughput of a cpu heavy subscriber callback over the topics, "
+                 "executed on the receiving thread against the amop executor\n";
+    std::cerr << "Usage: amop_executor_perf <topicCount> <messageCount> <threadCount> "
+                 "<workPerMessage>\n"
+              << "Example:\n"
+              << "    ./amop_executor_perf 16 200000 8 2000\n";
+    std::exit(0);
+}
+
+// the cpu heavy handler
+uint64_t work(uint64_t _seed, uint64_t _rounds)
+{
+    uint64_t x = _seed;
+    for (uint64_t i = 0; i < _rounds; ++i)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+    return x;
+}
+
+struct TopicState
+{
+    // the last seq executed, only touched by the lane of the topic
+    int64_t lastSeq = -1;
+    uint64_t violations = 0;
+    uint64_t sink = 0;
+};
+
+void onMessage(TopicState& _state, int64_t _seq, uint64_t _rounds)
+{
+    if (_seq <= _state.lastSeq)
+    {
+        _state.violations++;
+    }
+    _state.lastSeq = _seq;
+    _state.sink += work((uint64_t)_seq + 1, _rounds);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        usage();
+    }
+
+    std::size_t topicCount = std::max(std::atoi(argv[1]), 1);
+    std::size_t messageCount = std::atoi(argv[2]);
+    std::size_t threadCount = std::max(std::atoi(argv[3]), 1);
+    uint64_t rounds = std::atoi(argv[4]);
+
+    std::vector<std::string> topics;
+    for (std::size_t i = 0; i < topicCount; ++i)
+    {
+        topics.push_back("topic" + std::to_string(i));
+    }
+
+    // inline
+    std::vector<TopicState> inlineStates(topicCount);
+    auto startT = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < messageCount; ++i)
+    {
+        auto t = i % topicCount;
+        onMessage(inlineStates[t], (int64_t)(i / topicCount), rounds);
+    }
+    auto inlineMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - startT)
+                        .count();
+
+    // executor
+    std::vector<TopicState> states(topicCount);
+    AMOPExecutor::Settings settings;
+    settings.threadCount = threadCount;
+    settings.queueCapacity = 10000;
+    auto executor = std::make_shared<AMOPExecutor>(settings);
+    startT = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < messageCount; ++i)
+    {
+        auto t = i % topicCount;
+        auto seq = (int64_t)(i / topicCount);
+        executor->execute(topics[t], bytesConstRef(),
+            [&states, t, seq, rounds]() { onMessage(states[t], seq, rounds); });
+    }
+    while (executor->executed() < messageCount)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    auto executorMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - startT)
+                          .count();
+
+    uint64_t violations = 0;
+    for (std::size_t t = 0; t < topicCount; ++t)
+    {
+        violations += states[t].violations;
+    }
+
+    auto rate = [messageCount](int64_t _ms) {
+        return messageCount * 1000 / std::max<int64_t>(_ms, 1);
+    };
+    std::cout << " topicCount: " << topicCount << " messageCount: " << messageCount
+              << " threadCount: " << threadCount << " workPerMessage: " << rounds << std::endl;
+    std::cout << " inline: " << inlineMs << " ms, " << rate(inlineMs) << " msgs/s" << std::endl;
+    std::cout << " executor: " << executorMs << " ms, " << rate(executorMs) << " msgs/s"
+              << ", blocked: " << executor->blocked() << ", ordering violations: " << violations
+              << std::endl;
+    std::cout << " speedup: " << (double)std::max<int64_t>(inlineMs, 1) /
+                                     std::max<int64_t>(executorMs, 1)
+              << std::endl;
+
+    executor->stop();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,203 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file amop_topic_match_perf.cpp
+ * @author: octopus
+ * @date 2023-03-24
+ */
+
+#include <bcos-cpp-sdk/amop/AMOP.h>
+#include <bcos-cpp-sdk/amop/TopicTrie.h>
+#include <bcos-utilities/Common.h>
+#include <boost/thread/thread.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::amop;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+void usage()
+{
+    std::cerr << "Desc: the callback lookups of the received amop messages with N topics "
+                 "registered, the topic trie against the locked exact map\n";
+    std::cerr << "Usage: amop_topic_match_perf <topicCount> <threads> <seconds>\n"
+              << "Example:\n"
+              << "    ./amop_topic_match_perf 100000 8 5\n";
+    std::exit(0);
+}
+
+// the lookup before the trie: one map of the exact topics behind one lock
+class LockedTopicMap
+{
+public:
+    void add(const std::string& _topic, SubCallback _callback)
+    {
+        boost::unique_lock<boost::shared_mutex> lock(x_topic2Callback);
+        m_topic2Callback[_topic] = _callback;
+    }
+
+    SubCallback get(const std::string& _topic)
+    {
+        boost::shared_lock<boost::shared_mutex> lock(x_topic2Callback);
+        auto it = m_topic2Callback.find(_topic);
+        return it == m_topic2Callback.end() ? nullptr : it->second;
+    }
+
+private:
+    boost::shared_mutex x_topic2Callback;
+    std::unordered_map<std::string, SubCallback> m_topic2Callback;
+};
+
+template <typename Lookup>
+void runLookup(const std::string& _name, const std::vector<std::string>& _topics,
+    std::size_t _threads, int64_t _seconds, Lookup _lookup)
+{
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> lookups{0};
+    std::atomic<uint64_t> matched{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < _threads; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            std::mt19937_64 rng(t);
+            uint64_t count = 0;
+            uint64_t hit = 0;
+            while (running)
+            {
+                hit += _lookup(_topics[rng() % _topics.size()]) ? 1 : 0;
+                count++;
+            }
+            lookups += count;
+            matched += hit;
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(_seconds));
+    running = false;
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::cout << LOG_DESC(" [AMOPTopicMatchPerf] ===>>>> ") << LOG_KV("lookup", _name)
+              << LOG_KV("lookups/s", lookups.load() / _seconds)
+              << LOG_KV("matched", matched.load()) << LOG_KV("lookups", lookups.load())
+              << std::endl;
+}
+
+int64_t elapsedMs(std::chrono::high_resolution_clock::time_point _start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - _start)
+        .count();
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        usage();
+    }
+
+    std::size_t topicCount = std::max<std::size_t>(std::stoul(argv[1]), 1);
+    std::size_t threads = std::max<std::size_t>(std::stoul(argv[2]), 1);
+    int64_t seconds = std::max<int64_t>(std::stol(argv[3]), 1);
+
+    std::cout << LOG_DESC(" [AMOPTopicMatchPerf] params ===>>>> ")
+              << LOG_KV("topicCount", topicCount) << LOG_KV("threads", threads)
+              << LOG_KV("seconds", seconds) << std::endl;
+
+    SubCallback callback = [](bcos::Error::Ptr, const std::string&, const std::string&,
+                               bcos::bytesConstRef,
+                               std::shared_ptr<bcos::boostssl::ws::WsSession>) {};
+
+    // org{0..99}/dev{i}/event, the received topics of the devices
+    std::unordered_map<std::string, SubCallback> topic2Callback;
+    std::vector<std::string> topics;
+    for (std::size_t i = 0; i < topicCount; ++i)
+    {
+        auto topic = "org" + std::to_string(i % 100) + "/dev" + std::to_string(i) + "/event";
+        topic2Callback[topic] = callback;
+        topics.push_back(topic);
+    }
+
+    // the filters of the alarms and the status of the orgs
+    std::unordered_map<std::string, SubCallback> filter2Callback;
+    std::vector<std::string> wildcardTopics;
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        filter2Callback["org" + std::to_string(i) + "/+/alarm"] = callback;
+        filter2Callback["org" + std::to_string(i) + "/status/#"] = callback;
+    }
+    for (std::size_t i = 0; i < topicCount; ++i)
+    {
+        wildcardTopics.push_back(i % 2 == 0 ?
+                                     "org" + std::to_string(i % 100) + "/dev" + std::to_string(i) +
+                                         "/alarm" :
+                                     "org" + std::to_string(i % 100) + "/status/dev" +
+                                         std::to_string(i) + "/online");
+    }
+
+    // registration
+    auto startT = std::chrono::high_resolution_clock::now();
+    auto builtTrie = TopicTrie::build(topic2Callback);
+    std::cout << LOG_DESC(" [AMOPTopicMatchPerf] build ===>>>> ")
+              << LOG_KV("topics", builtTrie->size()) << LOG_KV("elapsed(ms)", elapsedMs(startT))
+              << std::endl;
+
+    startT = std::chrono::high_resolution_clock::now();
+    TopicTrie::ConstPtr insertedTrie = std::make_shared<TopicTrie>();
+    for (const auto& topic : topics)
+    {
+        insertedTrie = insertedTrie->insert(topic, callback);
+    }
+    std::cout << LOG_DESC(" [AMOPTopicMatchPerf] insert one by one ===>>>> ")
+              << LOG_KV("topics", insertedTrie->size()) << LOG_KV("elapsed(ms)", elapsedMs(startT))
+              << std::endl;
+
+    LockedTopicMap lockedMap;
+    for (const auto& [topic, topicCallback] : topic2Callback)
+    {
+        lockedMap.add(topic, topicCallback);
+    }
+
+    AMOP amop;
+    amop.addTopicCallbacks(topic2Callback);
+    amop.addTopicCallbacks(filter2Callback);
+
+    // exact topics
+    runLookup("lockedMap", topics, threads, seconds,
+        [&lockedMap](const std::string& _topic) { return lockedMap.get(_topic) != nullptr; });
+    runLookup("trie", topics, threads, seconds,
+        [&amop](const std::string& _topic) { return amop.topicTrie()->match(_topic) != nullptr; });
+
+    // the topics matched by the filters only
+    runLookup("trieWildcard", wildcardTopics, threads, seconds,
+        [&amop](const std::string& _topic) { return amop.topicTrie()->match(_topic) != nullptr; });
+
+    return 0;
+}
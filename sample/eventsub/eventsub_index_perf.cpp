@@ -0,0 +1,187 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file eventsub_index_perf.cpp
+ * @author: octopus
+ * @date 2023-03-13
+ */
+
+#include <bcos-cpp-sdk/event/EventSubIndex.h>
+#include <bcos-cpp-sdk/event/EventSubParams.h>
+#include <bcos-utilities/Common.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::event;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+void usage()
+{
+    std::cerr << "Desc: route synthetic event logs to the local subs with EventSubIndex, and "
+                 "with the linear scan of all the subs as the baseline\n";
+    std::cerr << "Usage: eventsub_index_perf <subCount> <logCount> <addressCount> <topicCount>\n"
+              << "Example:\n"
+              << "    ./eventsub_index_perf 10000 1000000 1000 100\n"
+              << "    # the subs of one address on different topics\n"
+              << "    ./eventsub_index_perf 10000 1000000 1 10000\n";
+    std::exit(0);
+}
+
+static std::string hexOf(uint64_t _value, std::size_t _width)
+{
+    static const char* digits = "0123456789abcdef";
+    std::string result(_width, '0');
+    for (std::size_t i = 0; i < _width && _value > 0; ++i, _value >>= 4)
+    {
+        result[_width - 1 - i] = digits[_value & 0xf];
+    }
+    return result;
+}
+
+// the linear scan a sub is checked with
+static bool linearMatch(const EventSubParams& _params, const std::string& _address,
+    const std::vector<std::string>& _topics)
+{
+    if (!_params.addresses().empty() && _params.addresses().count(_address) == 0)
+    {
+        return false;
+    }
+
+    const auto& topics = _params.topics();
+    for (std::size_t i = 0; i < topics.size(); ++i)
+    {
+        if (topics[i].empty())
+        {
+            continue;
+        }
+        if (i >= _topics.size() || topics[i].count(_topics[i]) == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        usage();
+    }
+
+    std::size_t subCount = std::stoul(argv[1]);
+    std::size_t logCount = std::stoul(argv[2]);
+    std::size_t addressCount = std::stoul(argv[3]);
+    std::size_t topicCount = std::stoul(argv[4]);
+
+    std::cout << LOG_DESC(" [EventSubIndexPerf] params ===>>>> ") << LOG_KV("subCount", subCount)
+              << LOG_KV("logCount", logCount) << LOG_KV("addressCount", addressCount)
+              << LOG_KV("topicCount", topicCount) << std::endl;
+
+    std::mt19937_64 rng(20230313);
+    auto randomAddress = [&rng, addressCount]() { return hexOf(rng() % addressCount, 40); };
+    auto randomTopic = [&rng, topicCount]() { return hexOf(rng() % topicCount, 64); };
+
+    // 5% subs of all addresses, 5% subs of all topics, 1% subs of all logs
+    EventSubIndex index;
+    std::vector<EventSubParams> subs(subCount);
+    for (std::size_t i = 0; i < subCount; ++i)
+    {
+        auto percent = rng() % 100;
+        if (percent >= 6)
+        {
+            subs[i].addAddress(randomAddress());
+        }
+        if (percent >= 11 || (percent >= 1 && percent < 6))
+        {
+            subs[i].addTopic(0, randomTopic());
+        }
+        index.add("sub" + std::to_string(i), subs[i]);
+    }
+
+    std::vector<std::pair<std::string, std::vector<std::string>>> logs(logCount);
+    for (auto& log : logs)
+    {
+        log.first = randomAddress();
+        log.second = {randomTopic(), randomTopic()};
+    }
+
+    std::cout << LOG_DESC(" [EventSubIndexPerf] index built") << LOG_KV("keys", index.keyCount())
+              << std::endl;
+
+    // index
+    std::size_t indexMatches = 0;
+    std::size_t indexCandidates = 0;
+    std::vector<std::string> ids;
+    auto startT = std::chrono::high_resolution_clock::now();
+    for (const auto& log : logs)
+    {
+        ids.clear();
+        indexCandidates += index.match(log.first, log.second, ids);
+        indexMatches += ids.size();
+    }
+    auto indexNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - startT)
+                       .count();
+
+    // linear scan on the first logs only, it costs subCount checks per log
+    std::size_t linearLogCount = std::min<std::size_t>(logCount, 10000);
+    std::size_t linearMatches = 0;
+    std::size_t indexMatchesOfLinear = 0;
+    startT = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < linearLogCount; ++i)
+    {
+        for (const auto& sub : subs)
+        {
+            if (linearMatch(sub, logs[i].first, logs[i].second))
+            {
+                linearMatches++;
+            }
+        }
+    }
+    auto linearNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - startT)
+                        .count();
+
+    for (std::size_t i = 0; i < linearLogCount; ++i)
+    {
+        ids.clear();
+        index.match(logs[i].first, logs[i].second, ids);
+        indexMatchesOfLinear += ids.size();
+    }
+
+    std::cout << LOG_DESC(" [EventSubIndexPerf] index ===>>>> ")
+              << LOG_KV("ns/log", (logCount ? indexNs / (int64_t)logCount : 0))
+              << LOG_KV("avgMatches", (logCount ? (double)indexMatches / logCount : 0))
+              << LOG_KV("avgCandidates", (logCount ? (double)indexCandidates / logCount : 0))
+              << std::endl;
+    std::cout << LOG_DESC(" [EventSubIndexPerf] linear ===>>>> ")
+              << LOG_KV("logs", linearLogCount)
+              << LOG_KV("ns/log", (linearLogCount ? linearNs / (int64_t)linearLogCount : 0))
+              << LOG_KV("avgMatches",
+                     (linearLogCount ? (double)linearMatches / linearLogCount : 0))
+              << LOG_KV("consistent", (linearMatches == indexMatchesOfLinear)) << std::endl;
+
+    return 0;
+}
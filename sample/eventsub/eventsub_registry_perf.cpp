@@ -0,0 +1,204 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file eventsub_registry_perf.cpp
+ * @author: octopus
+ * @date 2023-03-22
+ */
+
+#include <bcos-cpp-sdk/event/EventSubTaskRegistry.h>
+#include <bcos-utilities/Common.h>
+#include <boost/thread/thread.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::event;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+void usage()
+{
+    std::cerr << "Desc: the push path lookups of the event sub tasks while the sessions "
+                 "disconnect and reconnect, the sharded registry against one locked map\n";
+    std::cerr << "Usage: eventsub_registry_perf <taskCount> <endPointCount> <lookupThreads> "
+                 "<seconds>\n"
+              << "Example:\n"
+              << "    ./eventsub_registry_perf 50000 8 8 5\n";
+    std::exit(0);
+}
+
+// the registry before sharding: one map of all the tasks behind one lock, the disconnection
+// scans all the tasks
+class LockedMapRegistry
+{
+public:
+    void addTask(EventSubTask::Ptr _task, const std::string& _endPoint)
+    {
+        boost::unique_lock<boost::shared_mutex> lock(x_tasks);
+        m_suspendTasks.erase(_task->id());
+        m_workingTasks[_task->id()] = std::make_pair(_task, _endPoint);
+    }
+
+    EventSubTask::Ptr getTask(const std::string& _id)
+    {
+        boost::shared_lock<boost::shared_mutex> lock(x_tasks);
+        auto it = m_workingTasks.find(_id);
+        if (it != m_workingTasks.end())
+        {
+            return it->second.first;
+        }
+        auto innerIt = m_suspendTasks.find(_id);
+        return innerIt != m_suspendTasks.end() ? innerIt->second : nullptr;
+    }
+
+    std::vector<EventSubTask::Ptr> suspendTasks(const std::string& _endPoint)
+    {
+        std::vector<EventSubTask::Ptr> tasks;
+        boost::unique_lock<boost::shared_mutex> lock(x_tasks);
+        for (auto it = m_workingTasks.begin(); it != m_workingTasks.end();)
+        {
+            if (it->second.second != _endPoint)
+            {
+                ++it;
+                continue;
+            }
+            tasks.push_back(it->second.first);
+            m_suspendTasks[it->first] = it->second.first;
+            it = m_workingTasks.erase(it);
+        }
+        return tasks;
+    }
+
+private:
+    boost::shared_mutex x_tasks;
+    std::unordered_map<std::string, std::pair<EventSubTask::Ptr, std::string>> m_workingTasks;
+    std::unordered_map<std::string, EventSubTask::Ptr> m_suspendTasks;
+};
+
+template <typename Registry>
+void runPerf(const std::string& _name, Registry& _registry, std::size_t _taskCount,
+    std::size_t _endPointCount, std::size_t _lookupThreads, int64_t _seconds)
+{
+    std::vector<std::string> ids;
+    std::vector<std::string> endPoints;
+    for (std::size_t i = 0; i < _endPointCount; ++i)
+    {
+        endPoints.push_back("127.0.0.1:" + std::to_string(20200 + i));
+    }
+    for (std::size_t i = 0; i < _taskCount; ++i)
+    {
+        auto task = std::make_shared<EventSubTask>();
+        task->setId(std::to_string(i) + "_" + std::to_string(i * 7919));
+        ids.push_back(task->id());
+        _registry.addTask(task, endPoints[i % _endPointCount]);
+    }
+
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> lookups{0};
+    std::atomic<uint64_t> disconnects{0};
+    std::atomic<uint64_t> maxDisconnectUs{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < _lookupThreads; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            std::mt19937_64 rng(t);
+            uint64_t count = 0;
+            while (running)
+            {
+                auto task = _registry.getTask(ids[rng() % ids.size()]);
+                (void)task;
+                count++;
+            }
+            lookups += count;
+        });
+    }
+
+    // one session disconnects and reconnects at a time
+    threads.emplace_back([&]() {
+        std::size_t round = 0;
+        while (running)
+        {
+            const auto& endPoint = endPoints[round++ % endPoints.size()];
+            auto startT = std::chrono::high_resolution_clock::now();
+            auto tasks = _registry.suspendTasks(endPoint);
+            uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::high_resolution_clock::now() - startT)
+                              .count();
+            if (us > maxDisconnectUs)
+            {
+                maxDisconnectUs = us;
+            }
+            for (const auto& task : tasks)
+            {
+                _registry.addTask(task, endPoint);
+            }
+            disconnects++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::seconds(_seconds));
+    running = false;
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::cout << LOG_DESC(" [EventSubRegistryPerf] ===>>>> ") << LOG_KV("registry", _name)
+              << LOG_KV("lookups/s", lookups.load() / _seconds)
+              << LOG_KV("disconnects", disconnects.load())
+              << LOG_KV("maxDisconnectUs", maxDisconnectUs.load()) << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        usage();
+    }
+
+    std::size_t taskCount = std::stoul(argv[1]);
+    std::size_t endPointCount = std::max<std::size_t>(std::stoul(argv[2]), 1);
+    std::size_t lookupThreads = std::max<std::size_t>(std::stoul(argv[3]), 1);
+    int64_t seconds = std::max<int64_t>(std::stol(argv[4]), 1);
+
+    std::cout << LOG_DESC(" [EventSubRegistryPerf] params ===>>>> ")
+              << LOG_KV("taskCount", taskCount) << LOG_KV("endPointCount", endPointCount)
+              << LOG_KV("lookupThreads", lookupThreads) << LOG_KV("seconds", seconds)
+              << std::endl;
+
+    {
+        LockedMapRegistry registry;
+        runPerf("lockedMap", registry, taskCount, endPointCount, lookupThreads, seconds);
+    }
+
+    {
+        EventSubTaskRegistry registry;
+        runPerf("sharded", registry, taskCount, endPointCount, lookupThreads, seconds);
+    }
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file multi_sdk_perf.cpp
+ * @author: octopus
+ * @date 2023-03-06
+ */
+
+#include <bcos-cpp-sdk/SdkFactory.h>
+#include <bcos-cpp-sdk/config/Config.h>
+#include <bcos-utilities/Common.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+void usage()
+{
+    std::cerr << "Desc: getBlockNumber qps of N sdk instances in one process, with the io context "
+                 "and thread pool shared or owned per instance\n";
+    std::cerr << "Usage: multi_sdk_perf <config> <group> <sdkCount> <shared|private> <count>\n"
+              << "Example:\n"
+              << "    ./multi_sdk_perf ./config_sample.ini group0 16 shared 100000\n"
+              << "    ./multi_sdk_perf ./config_sample.ini group0 16 private 100000\n";
+    std::exit(0);
+}
+
+// the number of threads of the current process
+uint32_t threadCount()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.rfind("Threads:", 0) == 0)
+        {
+            return std::stoul(line.substr(8));
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 6)
+    {
+        usage();
+    }
+
+    std::string configFile = argv[1];
+    std::string group = argv[2];
+    uint32_t sdkCount = std::stoul(argv[3]);
+    bool shared = (std::string(argv[4]) == "shared");
+    uint32_t count = std::stoul(argv[5]);
+    if (sdkCount < 1)
+    {
+        std::cerr << "sdkCount should be at least 1" << std::endl;
+        usage();
+    }
+
+    std::cout << LOG_DESC(" [MultiSdkPerf] params ===>>>> ") << LOG_KV("\n\t # config", configFile)
+              << LOG_KV("\n\t # group", group) << LOG_KV("\n\t # sdkCount", sdkCount)
+              << LOG_KV("\n\t # shared", shared) << LOG_KV("\n\t # count", count) << std::endl;
+
+    auto config = std::make_shared<bcos::cppsdk::config::Config>();
+    auto wsConfig = config->loadConfig(configFile);
+
+    auto factory = std::make_shared<SdkFactory>();
+    if (shared)
+    {
+        factory->buildSharedContext(
+            std::thread::hardware_concurrency(), wsConfig->threadPoolSize());
+    }
+
+    uint32_t threadsBefore = threadCount();
+    std::vector<bcos::cppsdk::Sdk::UniquePtr> sdks;
+    for (uint32_t i = 0; i < sdkCount; ++i)
+    {
+        auto sdk = factory->buildSdk(wsConfig, config->sendRpcRequestToHighestBlockNode());
+        sdk->start();
+        sdks.push_back(std::move(sdk));
+    }
+    uint32_t threadsAfter = threadCount();
+
+    std::cout << LOG_DESC(" [MultiSdkPerf] start sdks ... ")
+              << LOG_KV("threadsBefore", threadsBefore) << LOG_KV("threadsAfter", threadsAfter)
+              << LOG_KV("threadsPerSdk", (double)(threadsAfter - threadsBefore) / sdkCount)
+              << std::endl;
+
+    // limit the requests in flight
+    uint32_t maxPending = 1000 * sdkCount;
+    std::atomic<uint32_t> pending{0};
+    std::atomic<uint32_t> succeed{0};
+    std::atomic<uint32_t> failed{0};
+
+    auto startPoint = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        while (pending.load() >= maxPending)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+
+        pending++;
+        sdks[i % sdkCount]->jsonRpc()->getBlockNumber(group, "",
+            [&pending, &succeed, &failed](bcos::Error::Ptr _error, std::shared_ptr<bytes>) {
+                if (_error && _error->errorCode() != 0)
+                {
+                    failed++;
+                }
+                else
+                {
+                    succeed++;
+                }
+                pending--;
+            });
+    }
+
+    while (pending.load() > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto endPoint = std::chrono::high_resolution_clock::now();
+    auto elapsedMS =
+        (long long)std::chrono::duration_cast<std::chrono::milliseconds>(endPoint - startPoint)
+            .count();
+
+    std::cout << " [MultiSdkPerf] " << LOG_KV("mode", (shared ? "shared" : "private"))
+              << LOG_KV("sdkCount", sdkCount) << LOG_KV("threads", threadCount())
+              << LOG_KV("succeed", succeed.load()) << LOG_KV("failed", failed.load())
+              << LOG_KV("elapsed(ms)", elapsedMS)
+              << LOG_KV("qps", elapsedMS > 0 ? (1000 * (long long)count / elapsedMS) : 0)
+              << std::endl;
+
+    for (auto& sdk : sdks)
+    {
+        sdk->stop();
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file hash_batch_perf.cpp
+ * @author: octopus
+ * @date 2023-04-12
+ */
+
+#include <bcos-cpp-sdk/utilities/crypto/HashBatch.h>
+#include <bcos-cpp-sdk/utilities/tx/Transaction.h>
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/hash/SM3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk::utilities;
+
+void usage()
+{
+    printf("Desc: hash the transaction data one by one and by the batch kernels\n");
+    printf("Usage: hash_batch_perf [batchSize] [rounds]\n");
+    printf("Example:\n");
+    printf("    ./hash_batch_perf\n");
+    printf("    ./hash_batch_perf 1000 100\n");
+    exit(0);
+}
+
+// run _f for _rounds, return the transactions hashed per second
+double measure(std::size_t _batchSize, std::size_t _rounds, const std::function<void()>& _f)
+{
+    auto startPoint = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < _rounds; ++i)
+    {
+        _f();
+    }
+    auto endPoint = std::chrono::high_resolution_clock::now();
+    auto elapsedUS =
+        std::chrono::duration_cast<std::chrono::microseconds>(endPoint - startPoint).count();
+    return (double)_batchSize * _rounds * 1000000 / std::max<int64_t>(elapsedUS, 1);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help"))
+    {
+        usage();
+    }
+
+    std::size_t batchSize = 1000;
+    std::size_t rounds = 100;
+    if (argc > 1)
+    {
+        batchSize = std::stoul(argv[1]);
+    }
+    if (argc > 2)
+    {
+        rounds = std::stoul(argv[2]);
+    }
+
+    printf("[Hash Batch Perf Test] ===>>>> batchSize: %zu, rounds: %zu, selected kernel: %s\n",
+        batchSize, rounds, hashBatchKernel().name);
+    printf("  %-10s %8s %-16s %14s\n", "hash", "input", "impl", "tx/s");
+
+    std::vector<std::pair<std::string, bcos::crypto::Hash::Ptr>> hashImpls{
+        {"keccak256", std::make_shared<bcos::crypto::Keccak256>()},
+        {"sm3", std::make_shared<bcos::crypto::SM3>()}};
+
+    // a transfer, a call, a small deploy, a large deploy
+    for (std::size_t inputSize : {68, 260, 4 * 1024, 32 * 1024})
+    {
+        std::vector<bcostars::TransactionData> transactionData(batchSize);
+        std::vector<const bcostars::TransactionData*> items;
+        for (std::size_t i = 0; i < batchSize; ++i)
+        {
+            auto& data = transactionData[i];
+            data.version = 0;
+            data.chainID = "chain0";
+            data.groupID = "group0";
+            data.blockLimit = 501;
+            data.nonce = std::to_string(i * 7919 + 1);
+            data.to = "0x1f9840a85d5af5bf1d1762f925bdaddc4201f984";
+            data.input.resize(inputSize);
+            for (std::size_t j = 0; j < inputSize; ++j)
+            {
+                data.input[j] = (tars::Char)(i + j * 131);
+            }
+            items.push_back(&data);
+        }
+
+        for (const auto& [name, hashImpl] : hashImpls)
+        {
+            // the hasher of each transaction as TransactionBuilder does
+            std::vector<bcos::crypto::HashType> expected(batchSize);
+            auto txs = measure(batchSize, rounds, [&]() {
+                for (std::size_t i = 0; i < batchSize; ++i)
+                {
+                    expected[i] = transactionData[i].hash(hashImpl);
+                }
+            });
+            printf("  %-10s %8zu %-16s %14.0f\n", name.c_str(), inputSize, "one by one", txs);
+
+            HashBatchMessages messages;
+            for (const auto* data : items)
+            {
+                addHashMessage(messages, *data);
+            }
+            std::vector<bcos::crypto::HashType> hashes(batchSize);
+            for (const auto& kernel : supportedHashBatchKernels())
+            {
+                txs = measure(batchSize, rounds,
+                    [&]() { hashBatch(hashImpl, messages, hashes.data(), kernel); });
+                if (hashes != expected)
+                {
+                    printf("  %s: unexpected result\n", kernel.name);
+                    return -1;
+                }
+                printf("  %-10s %8zu %-16s %14.0f\n", name.c_str(), inputSize, kernel.name, txs);
+            }
+
+            // the api, the messages are collected each time
+            txs = measure(batchSize, rounds, [&]() {
+                hashBatch(hashImpl, std::span<const bcostars::TransactionData* const>(items));
+            });
+            printf("  %-10s %8zu %-16s %14.0f\n", name.c_str(), inputSize, "hashBatch", txs);
+        }
+    }
+
+    return 0;
+}
@@ -123,9 +123,12 @@ std::string getBinary(bool _sm)
 void usage()
 {
     std::cerr << "Desc: c++ deploy HelloWorld perf contract\n";
-    std::cerr << "Usage: hello_perf <config> <groupID> <clientCount> <QPS>\n"
+    std::cerr << "Usage: hello_perf <config> <groupID> <clientCount> <QPS> [async]\n"
+              << "    async: one client thread sends with asyncSendTransaction, clientCount is\n"
+              << "           the signing thread count\n"
               << "Example:\n"
               << "    ./hello_perf ./config_sample.ini group0 16 1024\n"
+              << "    ./hello_perf ./config_sample.ini group0 16 1024 async\n"
                  "\n";
     std::exit(0);
 }
@@ -141,6 +144,7 @@ int main(int argc, char** argv)
     std::string group = argv[2];
     uint32_t client = std::atoi(argv[3]);
     uint32_t qps = std::atoi(argv[4]);
+    bool async = (argc > 5 && std::string(argv[5]) == "async");
 
     std::cout << LOG_DESC(" [HelloPerf] params ===>>>> ") << LOG_KV("\n\t # config", config)
               << LOG_KV("\n\t # groupID", group)  << LOG_KV("\n\t # clientCount", client)<< LOG_KV("\n\t # qps", qps) << std::endl;
@@ -171,7 +175,7 @@ int main(int argc, char** argv)
     auto transactionBuilder = std::make_shared<bcos::cppsdk::utilities::TransactionBuilder>();
 
     auto keyPairBuilder = std::make_shared<KeyPairBuilder>();
-    auto keyPair = keyPairBuilder->genKeyPair(
+    bcos::crypto::KeyPairInterface::Ptr keyPair = keyPairBuilder->genKeyPair(
         groupInfo->smCryptoType() ? CryptoType::SM2 : CryptoType::Secp256K1);
 
     bcos::crypto::CryptoSuite* cryptoSuite = groupInfo->smCryptoType() ?
@@ -264,6 +268,32 @@ int main(int argc, char** argv)
         }
     };
 
+    if (async)
+    {
+        // signed on the signing pool of the rpc service, the caller only sends
+        jsonrpc::JsonRpcServiceImpl::AsyncSettings settings;
+        settings.signThreadCount = client;
+        rpcService->setAsyncSettings(settings);
+        while (true)
+        {
+            ratelimit->acquire(1);
+            sendRateReporter->update(1, true);
+            auto getBytes = fromHexString(getData);
+            rpcService->asyncSendTransaction(keyPair, group, "", contractAddress,
+                std::move(*getBytes), "", 0, "extraData",
+                [&recvRateReporter](bcos::Error::Ptr _error, std::shared_ptr<bcos::bytes>) {
+                    recvRateReporter->update(1, true);
+                    if (_error && _error->errorCode() != 0)
+                    {
+                        std::cout << LOG_DESC(" [HelloPerf] send transaction response error")
+                                  << LOG_KV("errorCode", _error->errorCode())
+                                  << LOG_KV("errorMessage", _error->errorMessage())
+                                  << std::endl;
+                    }
+                });
+        }
+    }
+
     std::vector<std::shared_ptr<std::thread>> threads;
     for(uint32_t i =0;i<client;i++) {
         threads.push_back(std::make_shared<std::thread>(task));
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file hex_perf.cpp
+ * @author: octopus
+ * @date 2023-04-10
+ */
+
+#include <bcos-cpp-sdk/utilities/Hex.h>
+#include <bcos-utilities/DataConvertUtility.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk::utilities;
+
+void usage()
+{
+    printf("Desc: hex encode and decode perf test, the kernels and bcos-utilities\n");
+    printf("Usage: hex_perf [totalMB]\n");
+    printf("Example:\n");
+    printf("    ./hex_perf\n");
+    printf("    ./hex_perf 1024\n");
+    exit(0);
+}
+
+// run _f on _size bytes until _totalBytes are processed, return MB/s
+double measure(std::size_t _size, std::size_t _totalBytes, const std::function<void()>& _f)
+{
+    auto rounds = std::max<std::size_t>(_totalBytes / std::max<std::size_t>(_size, 1), 1);
+    auto startPoint = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < rounds; ++i)
+    {
+        _f();
+    }
+    auto endPoint = std::chrono::high_resolution_clock::now();
+    auto elapsedUS =
+        std::chrono::duration_cast<std::chrono::microseconds>(endPoint - startPoint).count();
+    return (double)rounds * _size / std::max<int64_t>(elapsedUS, 1);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help"))
+    {
+        usage();
+    }
+
+    std::size_t totalBytes = 256 * 1024 * 1024;
+    if (argc > 1)
+    {
+        totalBytes = std::stoul(argv[1]) * 1024 * 1024;
+    }
+
+    printf("[Hex Perf Test] ===>>>> total(MB): %zu, selected kernel: %s\n",
+        totalBytes / 1024 / 1024, hexKernel().name);
+    printf("  %8s %-16s %14s %14s\n", "bytes", "impl", "encode(MB/s)", "decode(MB/s)");
+
+    // an address, a hash, a call, a small deploy, a large deploy
+    for (std::size_t size : {20, 32, 260, 4 * 1024, 64 * 1024, 512 * 1024})
+    {
+        bcos::bytes data(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            data[i] = (bcos::byte)(i * 131 + 7);
+        }
+        auto hex = bcos::toHexStringWithPrefix(data);
+        std::string encoded(size * 2, ' ');
+        bcos::bytes decoded(size);
+
+        // the implementation before the kernels, a new string or a new bytes each time
+        auto encodeMBs = measure(size, totalBytes, [&data, &encoded]() {
+            encoded = bcos::toHexStringWithPrefix(data);
+        });
+        auto decodeMBs = measure(size, totalBytes, [&hex, &decoded]() {
+            decoded = *bcos::fromHexString(hex);
+        });
+        printf("  %8zu %-16s %14.1f %14.1f\n", size, "bcos-utilities", encodeMBs, decodeMBs);
+
+        for (const auto& kernel : supportedHexKernels())
+        {
+            // into the preallocated buffers, the kernels only
+            encoded.assign(size * 2, ' ');
+            encodeMBs = measure(size, totalBytes, [&kernel, &data, &encoded]() {
+                kernel.encode(data.data(), data.size(), encoded.data());
+            });
+            decodeMBs = measure(size, totalBytes, [&kernel, &hex, &decoded]() {
+                kernel.decode(hex.data() + 2, hex.size() - 2, decoded.data());
+            });
+            if (decoded != data || encoded != hex.substr(2))
+            {
+                printf("  %s: unexpected result\n", kernel.name);
+                return -1;
+            }
+            printf("  %8zu %-16s %14.1f %14.1f\n", size, kernel.name, encodeMBs, decodeMBs);
+        }
+
+        // the api, a new string or a new bytes each time
+        encodeMBs = measure(
+            size, totalBytes, [&data, &encoded]() { encoded = hexEncode(data, true); });
+        decodeMBs =
+            measure(size, totalBytes, [&hex, &decoded]() { decoded = hexDecode(hex); });
+        printf("  %8zu %-16s %14.1f %14.1f\n", size, "hexEncode/Decode", encodeMBs, decodeMBs);
+    }
+
+    return 0;
+}
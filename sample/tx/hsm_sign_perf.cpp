@@ -0,0 +1,135 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file hsm_sign_perf.cpp
+ * @author: octopus
+ * @date 2023-04-13
+ */
+
+#include <bcos-cpp-sdk/utilities/crypto/HsmSessionPool.h>
+#include <bcos-cpp-sdk/utilities/crypto/KeyPairBuilder.h>
+#include <bcos-crypto/hash/SM3.h>
+#include <bcos-crypto/signature/hsmSM2/HsmSM2Crypto.h>
+#include <bcos-crypto/signature/sm2/SM2Crypto.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk::utilities;
+
+void usage()
+{
+    printf("Desc: hsm sign perf test, a session per call, the pooled sessions and the batch\n");
+    printf("Usage: hsm_sign_perf count [maxSessions] [hsmLibPath keyIndex password]\n");
+    printf("    the software sm2 stands in for the hsm without hsmLibPath, opening a session\n");
+    printf("    of it sleeps 2ms as loading the library does\n");
+    printf("Example:\n");
+    printf("    ./hsm_sign_perf 10000\n");
+    printf("    ./hsm_sign_perf 10000 8 /usr/local/lib/libgmt0018.so 1 123456\n");
+    exit(0);
+}
+
+// run _f, return the signatures per second
+double measure(std::size_t _count, const std::function<void()>& _f)
+{
+    auto startPoint = std::chrono::high_resolution_clock::now();
+    _f();
+    auto endPoint = std::chrono::high_resolution_clock::now();
+    auto elapsedUS =
+        std::chrono::duration_cast<std::chrono::microseconds>(endPoint - startPoint).count();
+    return (double)_count * 1000000 / std::max<int64_t>(elapsedUS, 1);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help")
+    {
+        usage();
+    }
+
+    std::size_t count = std::stoul(argv[1]);
+    std::size_t maxSessions = argc > 2 ? std::stoul(argv[2]) : 8;
+    std::string hsmLibPath = argc > 3 ? argv[3] : "soft";
+
+    HsmSessionPool::SessionFactory sessionFactory;
+    bcos::crypto::KeyPairInterface::UniquePtr keyPair;
+    if (argc > 5)
+    {
+        sessionFactory = [](const std::string& _hsmLibPath) {
+            return std::make_shared<bcos::crypto::HsmSM2Crypto>(_hsmLibPath);
+        };
+        keyPair = KeyPairBuilder().useHsmKeyPair(std::stoul(argv[4]), argv[5], hsmLibPath);
+    }
+    else
+    {
+        sessionFactory = [](const std::string&) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            return std::make_shared<bcos::crypto::SM2Crypto>();
+        };
+        keyPair = KeyPairBuilder().genKeyPair(CryptoType::SM2);
+    }
+
+    bcos::crypto::SM3 hashImpl;
+    std::vector<bcos::crypto::HashType> hashes(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto data = std::to_string(i);
+        hashes[i] = hashImpl.hash(bcos::bytesConstRef((const bcos::byte*)data.data(), data.size()));
+    }
+
+    printf("[HSM Sign Perf Test] ===>>>> count: %zu, hsmLibPath: %s\n", count, hsmLibPath.c_str());
+    printf("  %-24s %10s %14s\n", "impl", "sessions", "signatures/s");
+
+    // the session opened for each signature as before the pool
+    auto perCallCount = std::min<std::size_t>(count, 1000);
+    auto tps = measure(perCallCount, [&]() {
+        for (std::size_t i = 0; i < perCallCount; ++i)
+        {
+            sessionFactory(hsmLibPath)->sign(*keyPair, hashes[i], true);
+        }
+    });
+    printf("  %-24s %10d %14.0f\n", "session per call", 1, tps);
+
+    for (std::size_t sessions = 1; sessions <= maxSessions; sessions *= 2)
+    {
+        HsmSessionPool pool(sessions, sessionFactory);
+        tps = measure(count, [&]() {
+            for (const auto& hash : hashes)
+            {
+                pool.sign(*keyPair, hash, hsmLibPath, true);
+            }
+        });
+        printf("  %-24s %10zu %14.0f\n", "pooled sign", sessions, tps);
+
+        std::vector<std::shared_ptr<bcos::bytes>> signatures;
+        tps = measure(count, [&]() { signatures = pool.signBatch(*keyPair, hashes, hsmLibPath); });
+        if (signatures.size() != count)
+        {
+            printf("  unexpected signatures: %zu\n", signatures.size());
+            return -1;
+        }
+        printf("  %-24s %10zu %14.0f\n", "signBatch", sessions, tps);
+    }
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file sig_verify_batch_perf.cpp
+ * @author: octopus
+ * @date 2023-04-14
+ */
+
+#include <bcos-cpp-sdk/utilities/crypto/KeyPairBuilder.h>
+#include <bcos-cpp-sdk/utilities/crypto/Signature.h>
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/hash/SM3.h>
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
+#include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
+#include <bcos-crypto/signature/sm2/SM2Crypto.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk::utilities;
+
+void usage()
+{
+    printf("Desc: signature verify and address recover perf test, one by one and the batch\n");
+    printf("Usage: sig_verify_batch_perf count [maxThreads]\n");
+    printf("Example:\n");
+    printf("    ./sig_verify_batch_perf 10000\n");
+    printf("    ./sig_verify_batch_perf 10000 16\n");
+    exit(0);
+}
+
+// run _f, return the signatures per second
+double measure(std::size_t _count, const std::function<void()>& _f)
+{
+    auto startPoint = std::chrono::high_resolution_clock::now();
+    _f();
+    auto endPoint = std::chrono::high_resolution_clock::now();
+    auto elapsedUS =
+        std::chrono::duration_cast<std::chrono::microseconds>(endPoint - startPoint).count();
+    return (double)_count * 1000000 / std::max<int64_t>(elapsedUS, 1);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help")
+    {
+        usage();
+    }
+
+    std::size_t count = std::stoul(argv[1]);
+    std::size_t maxThreads =
+        argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    for (auto cryptoType : {CryptoType::Secp256K1, CryptoType::SM2})
+    {
+        bcos::crypto::Hash::Ptr hashImpl;
+        bcos::crypto::SignatureCrypto::Ptr signatureImpl;
+        if (cryptoType == CryptoType::SM2)
+        {
+            hashImpl = std::make_shared<bcos::crypto::SM3>();
+            signatureImpl = std::make_shared<bcos::crypto::SM2Crypto>();
+        }
+        else
+        {
+            hashImpl = std::make_shared<bcos::crypto::Keccak256>();
+            signatureImpl = std::make_shared<bcos::crypto::Secp256k1Crypto>();
+        }
+
+        auto keyPair = KeyPairBuilder().genKeyPair(cryptoType);
+        auto publicKey = std::make_shared<bcos::bytes const>(keyPair->publicKey()->data());
+        std::vector<bcos::bytes> signatures(count);
+        std::vector<SignatureItem> items(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto data = std::to_string(i);
+            items[i].hash =
+                hashImpl->hash(bcos::bytesConstRef((const bcos::byte*)data.data(), data.size()));
+            signatures[i] = *signatureImpl->sign(*keyPair, items[i].hash, true);
+            items[i].signature = bcos::ref(signatures[i]);
+            items[i].publicKey = publicKey;
+        }
+
+        printf("[Signature Verify Batch Perf Test] ===>>>> type: %s, count: %zu\n",
+            cryptoType == CryptoType::SM2 ? "sm2" : "secp256k1", count);
+        printf("  %-24s %10s %14s\n", "impl", "threads", "signatures/s");
+
+        std::size_t verified = 0;
+        auto tps = measure(count, [&]() {
+            for (const auto& item : items)
+            {
+                verified += signatureImpl->verify(item.publicKey, item.hash, item.signature);
+            }
+        });
+        if (verified != count)
+        {
+            printf("  unexpected verified: %zu\n", verified);
+            return -1;
+        }
+        printf("  %-24s %10d %14.0f\n", "verify one by one", 1, tps);
+
+        bcos::crypto::CryptoSuite cryptoSuite(hashImpl, signatureImpl, nullptr);
+        tps = measure(count, [&]() {
+            for (const auto& item : items)
+            {
+                auto recovered = signatureImpl->recover(item.hash, item.signature);
+                cryptoSuite.calculateAddress(recovered);
+            }
+        });
+        printf("  %-24s %10d %14.0f\n", "recover one by one", 1, tps);
+
+        Signature signature;
+        for (std::size_t threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            std::vector<bool> results;
+            tps = measure(
+                count, [&]() { results = signature.verifyBatch(cryptoType, items, threads); });
+            if (std::count(results.begin(), results.end(), true) != (int64_t)count)
+            {
+                printf("  unexpected verifyBatch results\n");
+                return -1;
+            }
+            printf("  %-24s %10zu %14.0f\n", "verifyBatch", threads, tps);
+
+            std::vector<std::pair<bool, bcos::bytes>> addresses;
+            tps = measure(count, [&]() {
+                addresses = signature.recoverAddressBatch(cryptoType, hashImpl, items, threads);
+            });
+            printf("  %-24s %10zu %14.0f\n", "recoverAddressBatch", threads, tps);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file tx_encode_perf.cpp
+ * @author: octopus
+ * @date 2023-04-08
+ */
+
+#include <bcos-cpp-sdk/utilities/tx/TransactionBuilder.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+
+// count the heap allocations of the encoding
+static std::atomic<uint64_t> g_allocations{0};
+static std::atomic<uint64_t> g_allocatedBytes{0};
+
+void* operator new(std::size_t _size)
+{
+    g_allocations++;
+    g_allocatedBytes += _size;
+    if (auto p = std::malloc(_size == 0 ? 1 : _size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* _p) noexcept
+{
+    std::free(_p);
+}
+
+void operator delete(void* _p, std::size_t) noexcept
+{
+    std::free(_p);
+}
+
+using namespace bcos;
+using namespace bcos::cppsdk::utilities;
+
+void usage()
+{
+    printf("Desc: encode signed transactions with the copied and the pooled buffers perf test\n");
+    printf("Usage: tx_encode_perf txCount [inputSize]\n");
+    printf("Example:\n");
+    printf("    ./tx_encode_perf 100000\n");
+    printf("    ./tx_encode_perf 100000 4096\n");
+    exit(0);
+}
+
+// the encoding before the buffer pool, a growing BufferWriter copied into a new bcos::bytes
+bytesConstPtr encodeWithCopy(const bcostars::Transaction& _transaction)
+{
+    tars::TarsOutputStream<tars::BufferWriter> output;
+    _transaction.writeTo(output);
+
+    auto buffer = std::make_shared<bcos::bytes>();
+    buffer->assign(output.getBuffer(), output.getBuffer() + output.getLength());
+    return buffer;
+}
+
+template <typename F>
+void report(const std::string& _name, uint32_t _txCount, F _encode)
+{
+    uint64_t totalBytes = 0;
+    auto allocations = g_allocations.load();
+    auto allocatedBytes = g_allocatedBytes.load();
+    auto startPoint = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < _txCount; ++i)
+    {
+        // the encoded transaction released at once as the send path does
+        totalBytes += _encode()->size();
+    }
+    auto endPoint = std::chrono::high_resolution_clock::now();
+    auto elapsedUS =
+        std::chrono::duration_cast<std::chrono::microseconds>(endPoint - startPoint).count();
+    elapsedUS = std::max<int64_t>(elapsedUS, 1);
+
+    printf(
+        "  %-8s elapsed(ms): %8.2f, txs/s: %10.0f, MB/s: %8.2f, allocs/tx: %6.2f, "
+        "allocated bytes/tx: %10.1f\n",
+        _name.c_str(), (double)elapsedUS / 1000, (double)_txCount * 1000000 / elapsedUS,
+        (double)totalBytes / elapsedUS, (double)(g_allocations - allocations) / _txCount,
+        (double)(g_allocatedBytes - allocatedBytes) / _txCount);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        usage();
+    }
+
+    uint32_t txCount = std::stoul(argv[1]);
+    uint32_t inputSize = 256;
+    if (argc > 2)
+    {
+        inputSize = std::stoul(argv[2]);
+    }
+
+    printf("[Encode Tx Perf Test] ===>>>> txCount: %u, inputSize: %u\n", txCount, inputSize);
+
+    auto transactionBuilder = std::make_shared<TransactionBuilder>();
+    auto transactionData = transactionBuilder->createTransactionData("group0", "chain0",
+        "0x6849f21d1e455e9f0712b1e99fa4fcd23758e8f1", bcos::bytes(inputSize, 0x5a), "", 111111);
+    auto transaction = transactionBuilder->createTransaction(
+        *transactionData, bcos::bytes(65, 0x1b), bcos::crypto::HashType(), 0);
+
+    // warm up the pool
+    transactionBuilder->encodeTransaction(*transaction);
+
+    report("copy", txCount, [&transaction]() { return encodeWithCopy(*transaction); });
+    report("pooled", txCount, [&transactionBuilder, &transaction]() {
+        return transactionBuilder->encodeTransaction(*transaction);
+    });
+
+    auto& pool = transactionBuilder->bytesPool();
+    printf("  pool reused: %lu, missed: %lu\n", (unsigned long)pool->reused(),
+        (unsigned long)pool->missed());
+
+    return 0;
+}
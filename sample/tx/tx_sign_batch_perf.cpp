@@ -0,0 +1,119 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file tx_sign_batch_perf.cpp
+ * @author: octopus
+ * @date 2023-04-06
+ */
+
+#include <bcos-cpp-sdk/utilities/crypto/KeyPairBuilder.h>
+#include <bcos-cpp-sdk/utilities/tx/TransactionBuilder.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk::utilities;
+
+void usage()
+{
+    printf("Desc: create signed transactions in parallel, the scaling from 1 to N threads\n");
+    printf("Usage: tx_sign_batch_perf txCount [maxThreads] [inputSize]\n");
+    printf("Example:\n");
+    printf("    ./tx_sign_batch_perf 30000\n");
+    printf("    ./tx_sign_batch_perf 30000 8 1024\n");
+    exit(0);
+}
+
+void scaling(CryptoType _cryptoType, const std::string& _name, uint32_t _txCount,
+    uint32_t _maxThreads, uint32_t _inputSize)
+{
+    auto keyPairBuilder = std::make_shared<KeyPairBuilder>();
+    auto keyPair = keyPairBuilder->genKeyPair(_cryptoType);
+    auto transactionBuilder = std::make_shared<TransactionBuilder>();
+
+    std::vector<TransactionSpec> specs(_txCount);
+    for (auto& spec : specs)
+    {
+        spec.keyPair = keyPair.get();
+        spec.groupID = "group0";
+        spec.chainID = "chain0";
+        spec.to = "0x6849f21d1e455e9f0712b1e99fa4fcd23758e8f1";
+        spec.input = bcos::bytes(_inputSize, 0x5a);
+        spec.blockLimit = 111111;
+    }
+
+    printf(" [%s] txCount: %u, inputSize: %u\n", _name.c_str(), _txCount, _inputSize);
+    printf("  %8s %14s %12s %10s %12s\n", "threads", "elapsed(ms)", "txs/s", "speedup",
+        "efficiency");
+
+    double baseTps = 0;
+    for (uint32_t threads = 1; threads <= _maxThreads; ++threads)
+    {
+        auto startPoint = std::chrono::high_resolution_clock::now();
+        auto results = transactionBuilder->createSignedTransactions(specs, threads);
+        auto endPoint = std::chrono::high_resolution_clock::now();
+        auto elapsedUS = std::chrono::duration_cast<std::chrono::microseconds>(
+            endPoint - startPoint)
+                             .count();
+        if (results.size() != specs.size())
+        {
+            printf(" [%s] unexpected results: %zu\n", _name.c_str(), results.size());
+            exit(-1);
+        }
+
+        auto tps = (double)_txCount * 1000000 / std::max<int64_t>(elapsedUS, 1);
+        if (threads == 1)
+        {
+            baseTps = tps;
+        }
+        printf("  %8u %14.2f %12.0f %10.2f %11.1f%%\n", threads, (double)elapsedUS / 1000, tps,
+            tps / baseTps, tps / baseTps / threads * 100);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        usage();
+    }
+
+    uint32_t txCount = std::stoul(argv[1]);
+    uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (argc > 2)
+    {
+        maxThreads = std::stoul(argv[2]);
+    }
+    uint32_t inputSize = 256;
+    if (argc > 3)
+    {
+        inputSize = std::stoul(argv[3]);
+    }
+
+    printf("[Create Signed Txs Scaling Test] ===>>>> txCount: %u, maxThreads: %u\n", txCount,
+        maxThreads);
+
+    scaling(CryptoType::Secp256K1, "secp256k1", txCount, maxThreads, inputSize);
+    scaling(CryptoType::SM2, "sm2", txCount, maxThreads, inputSize);
+
+    return 0;
+}
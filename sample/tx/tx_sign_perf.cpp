@@ -19,6 +19,7 @@
  */
 
 #include <bcos-cpp-sdk/utilities/crypto/KeyPairBuilder.h>
+#include <bcos-cpp-sdk/utilities/tx/PreparedTransaction.h>
 #include <bcos-cpp-sdk/utilities/tx/TransactionBuilder.h>
 #include <bcos-cpp-sdk/utilities/tx/TransactionBuilderService.h>
 
@@ -125,10 +126,11 @@ const char* getBinary(int _sm)
 void usage()
 {
     printf("Desc: create signed transaction[HelloWorld set] perf test\n");
-    printf("Usage: tx_sign_perf isSM txCount\n");
+    printf("Usage: tx_sign_perf isSM txCount [prepared]\n");
     printf("Example:\n");
     printf("    ./tx_sign_perf true 30000\n");
     printf("    ./tx_sign_perf false 30000\n");
+    printf("    ./tx_sign_perf false 30000 prepared\n");
     exit(0);
 }
 
@@ -141,8 +143,10 @@ int main(int argc, char** argv)
 
     bool smCrypto = (std::string(argv[1]) == "true");
     uint32_t txCount = std::stoul(argv[2]);
+    bool prepared = (argc > 3 && std::string(argv[3]) == "prepared");
 
-    printf("[Create Signed Tx Perf Test] ===>>>> smCrypto: %d, txCount: %u\n", smCrypto, txCount);
+    printf("[Create Signed Tx Perf Test] ===>>>> smCrypto: %d, txCount: %u, prepared: %d\n",
+        smCrypto, txCount, prepared);
 
     auto keyPairBuilder = std::make_shared<bcos::cppsdk::utilities::KeyPairBuilder>();
     auto keyPair =
@@ -156,6 +160,9 @@ int main(int argc, char** argv)
     const char* group_id = "group0";
     const char* chain_id = "chain0";
 
+    auto preparedTransaction = std::make_shared<bcos::cppsdk::utilities::PreparedTransaction>(
+        transactionBuilder, keyPair->keyPairType(), group_id, chain_id, "", "");
+
     std::string txHash = "";
     uint32_t i = 0;
     uint32_t _10Per = txCount / 10;
@@ -168,8 +175,10 @@ int main(int argc, char** argv)
             std::cerr << " ..process : " << ((double)i / txCount) * 100 << "%" << std::endl;
         }
 
-        auto txPair = transactionBuilder->createSignedTransaction(
-            *keyPair, group_id, chain_id, "", code, "", block_limit, 0);
+        auto txPair = prepared ? preparedTransaction->createSignedTransaction(
+                                     *keyPair, bcos::ref(code), block_limit) :
+                                 transactionBuilder->createSignedTransaction(
+                                     *keyPair, group_id, chain_id, "", code, "", block_limit, 0);
         txHash = txPair.first;
     }
 
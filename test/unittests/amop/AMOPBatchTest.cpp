@@ -0,0 +1,171 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the amop batch
+ * @file AMOPBatchTest.cpp
+ * @author: octopus
+ * @date 2023-03-29
+ */
+#include <bcos-boostssl/websocket/WsMessage.h>
+#include <bcos-cpp-sdk/amop/AMOPBatch.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::boostssl::ws;
+using namespace bcos::cppsdk::amop;
+using namespace bcos::test;
+
+BOOST_FIXTURE_TEST_SUITE(AMOPBatchTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_AMOPBatchEnvelope)
+{
+    std::vector<bytes> messages = {bytes{1, 2, 3}, bytes{}, bytes(300, 7)};
+    bytes envelope;
+    AMOPBatchEnvelope::encode(messages, envelope);
+    BOOST_CHECK_EQUAL(envelope.size(), 4 + 3 * 4 + 3 + 300);
+
+    std::vector<bytesConstRef> decoded;
+    BOOST_CHECK(AMOPBatchEnvelope::decode(ref(envelope), decoded));
+    BOOST_CHECK_EQUAL(decoded.size(), messages.size());
+    for (std::size_t i = 0; i < messages.size(); ++i)
+    {
+        BOOST_CHECK(decoded[i].toBytes() == messages[i]);
+    }
+
+    // truncated
+    BOOST_CHECK(!AMOPBatchEnvelope::decode(bytesConstRef(envelope.data(), 10), decoded));
+    // trailing bytes
+    envelope.push_back(0);
+    BOOST_CHECK(!AMOPBatchEnvelope::decode(ref(envelope), decoded));
+    // the count too large
+    bytes invalid = {0xff, 0xff, 0xff, 0xff, 0, 0, 0, 0};
+    BOOST_CHECK(!AMOPBatchEnvelope::decode(ref(invalid), decoded));
+
+    std::string seq;
+    uint32_t index = 0;
+    auto messageSeq = AMOPBatchEnvelope::messageSeq("abcdef", 12);
+    BOOST_CHECK(AMOPBatchEnvelope::parseMessageSeq(messageSeq, seq, index));
+    BOOST_CHECK_EQUAL(seq, "abcdef");
+    BOOST_CHECK_EQUAL(index, 12);
+    BOOST_CHECK(!AMOPBatchEnvelope::parseMessageSeq("abcdef", seq, index));
+    BOOST_CHECK(!AMOPBatchEnvelope::parseMessageSeq("abcdef#", seq, index));
+    BOOST_CHECK(!AMOPBatchEnvelope::parseMessageSeq("abcdef#x", seq, index));
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPPublishBatcher)
+{
+    auto messageFactory = std::make_shared<WsMessageFactory>();
+
+    std::vector<std::pair<std::string, std::shared_ptr<bytes>>> sent;
+    std::vector<PubCallback> batchCallbacks;
+    AMOPPublishBatcher::Settings settings;
+    settings.maxMessages = 4;
+    settings.maxMessageSize = 16;
+    auto batcher = std::make_shared<AMOPPublishBatcher>(
+        settings,
+        [&sent, &batchCallbacks](const std::string& _topic, std::shared_ptr<bytes> _envelope,
+            uint32_t, PubCallback _callback) {
+            sent.emplace_back(_topic, _envelope);
+            batchCallbacks.push_back(_callback);
+        },
+        messageFactory);
+
+    std::vector<std::string> responses(5);
+    for (int i = 0; i < 5; ++i)
+    {
+        bytes data(1, (byte)i);
+        BOOST_CHECK(batcher->publish("topic0", ref(data), 1000,
+            [&responses, i](Error::Ptr _error, std::shared_ptr<WsMessage> _msg,
+                std::shared_ptr<WsSession>) {
+                if (_error)
+                {
+                    responses[i] = "error";
+                    return;
+                }
+                responses[i] = std::string(_msg->payload()->begin(), _msg->payload()->end());
+            }));
+    }
+    // too large to batch
+    bytes large(17, 0);
+    BOOST_CHECK(!batcher->publish("topic0", ref(large), 1000, nullptr));
+
+    // the full batch is sent at once
+    BOOST_CHECK_EQUAL(sent.size(), 1);
+    std::vector<bytesConstRef> messages;
+    BOOST_CHECK(AMOPBatchEnvelope::decode(ref(*sent[0].second), messages));
+    BOOST_CHECK_EQUAL(messages.size(), 4);
+    BOOST_CHECK_EQUAL(messages[3][0], 3);
+
+    // the rest is sent by the flush
+    batcher->flush(true);
+    BOOST_CHECK_EQUAL(sent.size(), 2);
+    BOOST_CHECK_EQUAL(batcher->sentBatches(), 2);
+    BOOST_CHECK_EQUAL(batcher->sentMessages(), 5);
+
+    // the response of the batch is split to the messages
+    std::vector<bytes> resps = {bytes{'a'}, bytes{'b'}, bytes{'c'}, bytes{'d'}};
+    bytes envelope;
+    AMOPBatchEnvelope::encode(resps, envelope);
+    auto resp = std::dynamic_pointer_cast<WsMessage>(messageFactory->buildMessage());
+    resp->setPayload(std::make_shared<bytes>(envelope));
+    batchCallbacks[0](nullptr, resp, nullptr);
+    BOOST_CHECK_EQUAL(responses[0], "a");
+    BOOST_CHECK_EQUAL(responses[3], "d");
+
+    // the invalid response fails all
+    batchCallbacks[1](nullptr, resp, nullptr);
+    BOOST_CHECK_EQUAL(responses[4], "error");
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPBatchResponder)
+{
+    AMOPBatchResponder responder;
+    responder.addBatch("127.0.0.1:20200", "seq0", 3);
+    BOOST_CHECK_EQUAL(responder.pendingBatches(), 1);
+
+    std::string endPoint;
+    std::string seq;
+    bytes envelope;
+    auto send = [&](const std::string& _endPoint, const std::string& _seq,
+                    bytesConstRef _envelope) {
+        endPoint = _endPoint;
+        seq = _seq;
+        envelope = _envelope.toBytes();
+    };
+
+    bytes data = {'x'};
+    BOOST_CHECK(responder.respond(AMOPBatchEnvelope::messageSeq("seq0", 2), ref(data), send));
+    BOOST_CHECK(!responder.respond(AMOPBatchEnvelope::messageSeq("seq0", 2), ref(data), send));
+    BOOST_CHECK(!responder.respond(AMOPBatchEnvelope::messageSeq("seq0", 3), ref(data), send));
+    BOOST_CHECK(!responder.respond(AMOPBatchEnvelope::messageSeq("seq1", 0), ref(data), send));
+    BOOST_CHECK(responder.respond(AMOPBatchEnvelope::messageSeq("seq0", 0), ref(data), send));
+    BOOST_CHECK(seq.empty());
+
+    BOOST_CHECK(responder.respond(AMOPBatchEnvelope::messageSeq("seq0", 1), bytesConstRef(), send));
+    BOOST_CHECK_EQUAL(seq, "seq0");
+    BOOST_CHECK_EQUAL(endPoint, "127.0.0.1:20200");
+    BOOST_CHECK_EQUAL(responder.pendingBatches(), 0);
+
+    std::vector<bytesConstRef> responses;
+    BOOST_CHECK(AMOPBatchEnvelope::decode(ref(envelope), responses));
+    BOOST_CHECK_EQUAL(responses.size(), 3);
+    BOOST_CHECK_EQUAL(responses[0].size(), 1);
+    BOOST_CHECK_EQUAL(responses[1].size(), 0);
+    BOOST_CHECK_EQUAL(responses[2].size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,330 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the amop chunked message
+ * @file AMOPChunkTest.cpp
+ * @author: octopus
+ * @date 2023-03-27
+ */
+#include <bcos-cpp-sdk/amop/AMOPChunk.h>
+#include <bcos-cpp-sdk/amop/AMOPTopicStats.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::cppsdk::amop;
+using namespace bcos::test;
+
+BOOST_FIXTURE_TEST_SUITE(AMOPChunkTest, TestPromptFixture)
+
+// split the data into the encoded fragments
+static std::vector<bytes> buildFragments(const bytes& _data, uint64_t _transferId, uint32_t _size)
+{
+    std::vector<bytes> fragments;
+    uint32_t count = (_data.size() + _size - 1) / _size;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        AMOPChunkHeader header;
+        header.transferId = _transferId;
+        header.index = i;
+        header.count = count;
+        header.totalSize = _data.size();
+        header.offset = (uint64_t)i * _size;
+
+        bytes fragment;
+        header.encode(fragment);
+        auto end = std::min<uint64_t>(header.offset + _size, _data.size());
+        fragment.insert(fragment.end(), _data.begin() + header.offset, _data.begin() + end);
+        fragments.push_back(fragment);
+    }
+    return fragments;
+}
+
+static bytes buildData(std::size_t _size)
+{
+    bytes data(_size);
+    for (std::size_t i = 0; i < _size; ++i)
+    {
+        data[i] = (byte)(i * 31 + 7);
+    }
+    return data;
+}
+
+static AMOPChunkReassembler::Result append(
+    AMOPChunkReassembler& _reassembler, const bytes& _encoded, bool _stream,
+    AMOPChunkReassembler::DeliverFunc _deliver)
+{
+    AMOPChunkHeader header;
+    bytesConstRef fragment;
+    BOOST_CHECK(header.decode(ref(_encoded), fragment));
+    std::string reason;
+    return _reassembler.append(header, fragment, _stream, _deliver, reason);
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPChunkHeader)
+{
+    AMOPChunkHeader header;
+    header.transferId = 0x0102030405060708;
+    header.index = 3;
+    header.count = 10;
+    header.totalSize = 1000;
+    header.offset = 300;
+
+    bytes buffer;
+    header.encode(buffer);
+    BOOST_CHECK_EQUAL(buffer.size(), AMOPChunkHeader::SIZE);
+    BOOST_CHECK_EQUAL(buffer[0], 0x01);
+    buffer.push_back(0xff);
+
+    AMOPChunkHeader decoded;
+    bytesConstRef fragment;
+    BOOST_CHECK(decoded.decode(ref(buffer), fragment));
+    BOOST_CHECK_EQUAL(decoded.transferId, header.transferId);
+    BOOST_CHECK_EQUAL(decoded.index, header.index);
+    BOOST_CHECK_EQUAL(decoded.count, header.count);
+    BOOST_CHECK_EQUAL(decoded.totalSize, header.totalSize);
+    BOOST_CHECK_EQUAL(decoded.offset, header.offset);
+    BOOST_CHECK_EQUAL(fragment.size(), 1);
+
+    // the fragment out of the message
+    header.offset = 1000;
+    buffer.clear();
+    header.encode(buffer);
+    buffer.push_back(0xff);
+    BOOST_CHECK(!decoded.decode(ref(buffer), fragment));
+    BOOST_CHECK(!decoded.decode(bytesConstRef(buffer.data(), 10), fragment));
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPChunkReassembler_whole)
+{
+    AMOPChunkReassembler reassembler;
+    auto data = buildData(10000);
+    auto fragments = buildFragments(data, 1, 1024);
+    BOOST_CHECK_EQUAL(fragments.size(), 10);
+
+    bytes received;
+    int delivered = 0;
+    auto deliver = [&received, &delivered](const AMOPChunkFragment& _fragment) {
+        BOOST_CHECK(_fragment.last);
+        received = *_fragment.data;
+        delivered++;
+    };
+
+    // out of order with duplicates
+    for (int i = 9; i > 0; --i)
+    {
+        BOOST_CHECK(append(reassembler, fragments[i], false, deliver) ==
+                    AMOPChunkReassembler::Result::Incomplete);
+    }
+    BOOST_CHECK(append(reassembler, fragments[5], false, deliver) ==
+                AMOPChunkReassembler::Result::Incomplete);
+    BOOST_CHECK_EQUAL(reassembler.transferCount(), 1);
+    // the message and the received flags of the 10 fragments
+    BOOST_CHECK_EQUAL(reassembler.bufferedBytes(), data.size() + 2);
+    BOOST_CHECK_EQUAL(delivered, 0);
+
+    BOOST_CHECK(append(reassembler, fragments[0], false, deliver) ==
+                AMOPChunkReassembler::Result::Completed);
+    BOOST_CHECK_EQUAL(delivered, 1);
+    BOOST_CHECK(received == data);
+    BOOST_CHECK_EQUAL(reassembler.transferCount(), 0);
+    BOOST_CHECK_EQUAL(reassembler.bufferedBytes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPChunkReassembler_stream)
+{
+    AMOPChunkReassembler reassembler;
+    auto data = buildData(10000);
+    auto fragments = buildFragments(data, 2, 1024);
+
+    bytes received;
+    bool last = false;
+    auto deliver = [&received, &last](const AMOPChunkFragment& _fragment) {
+        BOOST_CHECK_EQUAL(_fragment.offset, received.size());
+        received.insert(received.end(), _fragment.data->begin(), _fragment.data->end());
+        last = _fragment.last;
+    };
+
+    BOOST_CHECK(append(reassembler, fragments[0], true, deliver) ==
+                AMOPChunkReassembler::Result::Incomplete);
+    BOOST_CHECK_EQUAL(received.size(), 1024);
+
+    // only the out of order ones are buffered
+    BOOST_CHECK(append(reassembler, fragments[2], true, deliver) ==
+                AMOPChunkReassembler::Result::Incomplete);
+    BOOST_CHECK(append(reassembler, fragments[3], true, deliver) ==
+                AMOPChunkReassembler::Result::Incomplete);
+    BOOST_CHECK_EQUAL(received.size(), 1024);
+    BOOST_CHECK_EQUAL(reassembler.bufferedBytes(), 2048);
+
+    BOOST_CHECK(append(reassembler, fragments[1], true, deliver) ==
+                AMOPChunkReassembler::Result::Incomplete);
+    BOOST_CHECK_EQUAL(received.size(), 4096);
+    BOOST_CHECK_EQUAL(reassembler.bufferedBytes(), 0);
+
+    for (std::size_t i = 4; i < fragments.size(); ++i)
+    {
+        auto result = append(reassembler, fragments[i], true, deliver);
+        BOOST_CHECK(result == (i + 1 == fragments.size() ?
+                                      AMOPChunkReassembler::Result::Completed :
+                                      AMOPChunkReassembler::Result::Incomplete));
+    }
+    BOOST_CHECK(last);
+    BOOST_CHECK(received == data);
+    BOOST_CHECK_EQUAL(reassembler.transferCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPChunkReassembler_bounded)
+{
+    AMOPChunkReassembler::Settings settings;
+    settings.maxMessageSize = 8192;
+    settings.maxBufferedBytes = 12000;
+    settings.maxTransfers = 2;
+    AMOPChunkReassembler reassembler(settings);
+
+    auto deliver = [](const AMOPChunkFragment&) {};
+
+    // too large to reassemble as a whole, the rest of the fragments are rejected too
+    auto large = buildFragments(buildData(10000), 1, 1024);
+    BOOST_CHECK(append(reassembler, large[0], false, deliver) ==
+                AMOPChunkReassembler::Result::Rejected);
+    BOOST_CHECK(append(reassembler, large[1], false, deliver) ==
+                AMOPChunkReassembler::Result::Rejected);
+    BOOST_CHECK_EQUAL(reassembler.droppedTransfers(), 1);
+
+    // the buffered bytes of the transfers are bounded
+    auto first = buildFragments(buildData(8000), 2, 1024);
+    auto second = buildFragments(buildData(8000), 3, 1024);
+    BOOST_CHECK(append(reassembler, first[0], false, deliver) ==
+                AMOPChunkReassembler::Result::Incomplete);
+    BOOST_CHECK(append(reassembler, second[0], false, deliver) ==
+                AMOPChunkReassembler::Result::Rejected);
+    BOOST_CHECK_EQUAL(reassembler.bufferedBytes(), 8001);
+
+    // the stream is bounded by the max message size too
+    auto largeStream = buildFragments(buildData(10000), 6, 1024);
+    BOOST_CHECK(append(reassembler, largeStream[0], true, deliver) ==
+                AMOPChunkReassembler::Result::Rejected);
+
+    // the stream buffers the out of order fragments only
+    auto stream = buildFragments(buildData(8192), 4, 1024);
+    BOOST_CHECK(append(reassembler, stream[0], true, deliver) ==
+                AMOPChunkReassembler::Result::Incomplete);
+    BOOST_CHECK(append(reassembler, stream[1], true, deliver) ==
+                AMOPChunkReassembler::Result::Incomplete);
+    BOOST_CHECK(append(reassembler, stream[3], true, deliver) ==
+                AMOPChunkReassembler::Result::Incomplete);
+    BOOST_CHECK_EQUAL(reassembler.bufferedBytes(), 8001 + 1024);
+
+    // too many transfers
+    auto third = buildFragments(buildData(1000), 5, 1024);
+    BOOST_CHECK(append(reassembler, third[0], false, deliver) ==
+                AMOPChunkReassembler::Result::Rejected);
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPChunkReassembler_invalidHeader)
+{
+    AMOPChunkReassembler reassembler;
+    auto deliver = [](const AMOPChunkFragment&) {};
+    auto data = buildData(10000);
+    std::string reason;
+
+    auto check = [&](const AMOPChunkHeader& _header, uint64_t _offset, uint64_t _size) {
+        auto result = reassembler.append(
+            _header, bytesConstRef(data.data() + _offset, _size), false, deliver, reason);
+        return result == AMOPChunkReassembler::Result::Rejected;
+    };
+
+    AMOPChunkHeader header;
+    header.transferId = 1;
+    header.totalSize = data.size();
+
+    // the count unrelated to the size of the message
+    header.index = 0;
+    header.count = 0xffffffff;
+    header.offset = 0;
+    BOOST_CHECK(check(header, 0, 1024));
+    BOOST_CHECK_EQUAL(reason, "invalid chunk header");
+    header.count = 20;
+    BOOST_CHECK(check(header, 0, 1024));
+
+    // the offset not at the chunk boundary
+    header.count = 10;
+    header.index = 1;
+    header.offset = 1000;
+    BOOST_CHECK(check(header, 1000, 1024));
+
+    // the last fragment not ending the message, or larger than the chunk
+    header.index = 9;
+    header.offset = 9216;
+    BOOST_CHECK(check(header, 9216, 100));
+    header.count = 2;
+    header.index = 1;
+    header.offset = 1;
+    BOOST_CHECK(check(header, 1, 9999));
+
+    // the more fragments than the bytes
+    header.totalSize = 1;
+    header.count = 2;
+    header.index = 0;
+    header.offset = 0;
+    BOOST_CHECK(check(header, 0, 1));
+
+    BOOST_CHECK_EQUAL(reassembler.transferCount(), 0);
+    BOOST_CHECK_EQUAL(reassembler.bufferedBytes(), 0);
+
+    // the valid fragments, the last one first
+    header.totalSize = data.size();
+    header.count = 10;
+    header.index = 9;
+    header.offset = 9216;
+    BOOST_CHECK(!check(header, 9216, 784));
+    header.index = 0;
+    header.offset = 0;
+    BOOST_CHECK(!check(header, 0, 1024));
+    BOOST_CHECK_EQUAL(reassembler.transferCount(), 1);
+
+    // the empty message
+    header.transferId = 2;
+    header.totalSize = 0;
+    header.count = 1;
+    BOOST_CHECK(!check(header, 0, 0));
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPTopicStats)
+{
+    AMOPTopicStats stats;
+    stats.onSent("topic0", 1000, 1, true);
+    stats.onSent("topic0", 500, 2, false);
+    stats.onRecv("topic1", 300, 1, true);
+    stats.onDropped("topic1");
+
+    auto topic0 = stats.throughput("topic0");
+    BOOST_CHECK_EQUAL(topic0.sentBytes, 1500);
+    BOOST_CHECK_EQUAL(topic0.sentFragments, 3);
+    BOOST_CHECK_EQUAL(topic0.sentMessages, 1);
+    BOOST_CHECK_EQUAL(topic0.recvBytes, 0);
+
+    auto all = stats.throughput();
+    BOOST_CHECK_EQUAL(all.size(), 2);
+    BOOST_CHECK_EQUAL(all["topic1"].recvBytes, 300);
+    BOOST_CHECK_EQUAL(all["topic1"].droppedMessages, 1);
+
+    stats.reset();
+    BOOST_CHECK(stats.throughput().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,190 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the amop executor
+ * @file AMOPExecutorTest.cpp
+ * @author: octopus
+ * @date 2023-03-31
+ */
+#include <bcos-cpp-sdk/amop/AMOPExecutor.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::cppsdk::amop;
+using namespace bcos::test;
+
+namespace
+{
+void waitExecuted(AMOPExecutor& _executor, uint64_t _executed)
+{
+    for (int i = 0; i < 1000 && _executor.executed() < _executed; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(AMOPExecutorTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_AMOPExecutorTopicOrder)
+{
+    AMOPExecutor::Settings settings;
+    settings.threadCount = 4;
+    AMOPExecutor executor(settings);
+
+    const std::size_t topicCount = 8;
+    const std::size_t messageCount = 1000;
+    std::vector<std::vector<std::size_t>> received(topicCount);
+    for (std::size_t i = 0; i < messageCount; ++i)
+    {
+        for (std::size_t t = 0; t < topicCount; ++t)
+        {
+            // the messages of a topic are executed on one thread, no lock needed
+            BOOST_CHECK(executor.execute("topic" + std::to_string(t), bytesConstRef(),
+                [&received, t, i]() { received[t].push_back(i); }));
+        }
+    }
+    waitExecuted(executor, topicCount * messageCount);
+    BOOST_CHECK_EQUAL(executor.executed(), topicCount * messageCount);
+    BOOST_CHECK_EQUAL(executor.queued(), 0);
+
+    for (std::size_t t = 0; t < topicCount; ++t)
+    {
+        BOOST_CHECK_EQUAL(received[t].size(), messageCount);
+        for (std::size_t i = 0; i < received[t].size(); ++i)
+        {
+            BOOST_CHECK_EQUAL(received[t][i], i);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPExecutorKeyOrder)
+{
+    AMOPExecutor::Settings settings;
+    settings.threadCount = 4;
+    // ordered by the first byte of the data instead of the topic
+    settings.keyExtractor = [](const std::string&, bytesConstRef _data) {
+        return _data.empty() ? std::string() : std::string(1, (char)_data[0]);
+    };
+    AMOPExecutor executor(settings);
+
+    const std::size_t keyCount = 4;
+    const std::size_t messageCount = 500;
+    std::vector<std::vector<std::size_t>> received(keyCount);
+    std::vector<bytes> datas;
+    for (std::size_t k = 0; k < keyCount; ++k)
+    {
+        datas.push_back(bytes{(byte)k});
+    }
+    for (std::size_t i = 0; i < messageCount; ++i)
+    {
+        for (std::size_t k = 0; k < keyCount; ++k)
+        {
+            // the same key from different topics
+            executor.execute("topic" + std::to_string(i % 3), ref(datas[k]),
+                [&received, k, i]() { received[k].push_back(i); });
+        }
+    }
+    waitExecuted(executor, keyCount * messageCount);
+
+    for (std::size_t k = 0; k < keyCount; ++k)
+    {
+        BOOST_CHECK_EQUAL(received[k].size(), messageCount);
+        for (std::size_t i = 0; i < received[k].size(); ++i)
+        {
+            BOOST_CHECK_EQUAL(received[k][i], i);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPExecutorDrop)
+{
+    AMOPExecutor::Settings settings;
+    settings.threadCount = 1;
+    settings.queueCapacity = 2;
+    settings.backpressure = AMOPExecutor::Backpressure::Drop;
+    AMOPExecutor executor(settings);
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    BOOST_CHECK(executor.execute("a", bytesConstRef(), [released]() { released.wait(); }));
+    BOOST_CHECK(executor.execute("a", bytesConstRef(), []() {}));
+    // the lane is full
+    BOOST_CHECK(!executor.execute("a", bytesConstRef(), []() {}));
+    BOOST_CHECK(!executor.execute("b", bytesConstRef(), []() {}));
+    BOOST_CHECK_EQUAL(executor.dropped(), 2);
+    BOOST_CHECK_EQUAL(executor.queued(), 2);
+
+    release.set_value();
+    waitExecuted(executor, 2);
+    BOOST_CHECK_EQUAL(executor.executed(), 2);
+    BOOST_CHECK(executor.execute("a", bytesConstRef(), []() {}));
+    waitExecuted(executor, 3);
+    BOOST_CHECK_EQUAL(executor.executed(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPExecutorBlock)
+{
+    AMOPExecutor::Settings settings;
+    settings.threadCount = 1;
+    settings.queueCapacity = 1;
+    settings.backpressure = AMOPExecutor::Backpressure::Block;
+    AMOPExecutor executor(settings);
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    BOOST_CHECK(executor.execute("a", bytesConstRef(), [released]() { released.wait(); }));
+
+    // blocked until the first one executed
+    auto blocked = std::async(std::launch::async,
+        [&executor]() { return executor.execute("a", bytesConstRef(), []() {}); });
+    BOOST_CHECK(blocked.wait_for(std::chrono::milliseconds(100)) == std::future_status::timeout);
+
+    release.set_value();
+    BOOST_CHECK(blocked.get());
+    waitExecuted(executor, 2);
+    BOOST_CHECK_EQUAL(executor.executed(), 2);
+    BOOST_CHECK_EQUAL(executor.blocked(), 1);
+    BOOST_CHECK_EQUAL(executor.dropped(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPExecutorException)
+{
+    AMOPExecutor executor;
+    std::atomic<int> count{0};
+    executor.execute("a", bytesConstRef(), []() { throw std::runtime_error("callback error"); });
+    executor.execute("a", bytesConstRef(), [&count]() { count++; });
+    waitExecuted(executor, 2);
+    BOOST_CHECK_EQUAL(count.load(), 1);
+
+    // not a std::exception, the lane is released and keeps running
+    executor.execute("a", bytesConstRef(), []() { throw 1; });
+    executor.execute("a", bytesConstRef(), [&count]() { count++; });
+    waitExecuted(executor, 4);
+    BOOST_CHECK_EQUAL(count.load(), 2);
+    BOOST_CHECK_EQUAL(executor.queued(), 0);
+
+    executor.stop();
+    BOOST_CHECK(!executor.execute("a", bytesConstRef(), [&count]() { count++; }));
+    BOOST_CHECK_EQUAL(executor.dropped(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
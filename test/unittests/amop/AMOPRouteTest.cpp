@@ -0,0 +1,162 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the amop routed by the fake node
+ * @file AMOPRouteTest.cpp
+ * @author: octopus
+ * @date 2023-04-04
+ */
+#include "../fake/AMOPNodeFake.h"
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <future>
+
+using namespace bcos;
+using namespace bcos::boostssl::ws;
+using namespace bcos::cppsdk::amop;
+using namespace bcos::cppsdk::test;
+using namespace bcos::test;
+
+namespace
+{
+template <typename T>
+bool ready(std::future<T>& _future)
+{
+    return _future.wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(AMOPRouteTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_AMOPRoutePublish)
+{
+    auto node = std::make_shared<AMOPNodeFake>();
+    auto publisher = node->connect("publisher");
+    auto subscriber = node->connect("subscriber");
+    std::weak_ptr<AMOP> weakSubscriber = subscriber;
+    subscriber->subscribe("topic", [weakSubscriber](Error::Ptr, const std::string& _endPoint,
+                                       const std::string& _seq, bytesConstRef _data,
+                                       std::shared_ptr<WsSession>) {
+        // echo
+        auto subscriber = weakSubscriber.lock();
+        if (subscriber)
+        {
+            subscriber->sendResponse(_endPoint, _seq, _data);
+        }
+    });
+    BOOST_CHECK(node->topics("subscriber").count("topic"));
+
+    const int count = 100;
+    std::atomic<int> responded{0};
+    std::atomic<int> matched{0};
+    std::promise<void> allResponded;
+    auto allRespondedFuture = allResponded.get_future();
+    for (int i = 0; i < count; ++i)
+    {
+        auto data = std::make_shared<std::string>("message" + std::to_string(i));
+        publisher->publish("topic", bytesConstRef((byte*)data->data(), data->size()), 10000,
+            [&responded, &matched, &allResponded, data](Error::Ptr _error,
+                std::shared_ptr<WsMessage> _msg, std::shared_ptr<WsSession>) {
+                if (!_error && std::string(_msg->payload()->begin(), _msg->payload()->end()) ==
+                                   *data)
+                {
+                    matched++;
+                }
+                if (++responded == count)
+                {
+                    allResponded.set_value();
+                }
+            });
+    }
+    BOOST_CHECK(ready(allRespondedFuture));
+    BOOST_CHECK_EQUAL(matched.load(), count);
+    BOOST_CHECK_EQUAL(node->pending(), 0);
+
+    // no subscriber
+    std::promise<bool> failed;
+    auto failedFuture = failed.get_future();
+    std::string data = "nobody";
+    publisher->publish("unknown", bytesConstRef((byte*)data.data(), data.size()), 10000,
+        [&failed](Error::Ptr _error, std::shared_ptr<WsMessage>, std::shared_ptr<WsSession>) {
+            failed.set_value(_error && _error->errorCode() == AMOPNodeFake::NO_SUBSCRIBER);
+        });
+    BOOST_CHECK(ready(failedFuture) && failedFuture.get());
+    node->stop();
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPRouteBroadcast)
+{
+    auto node = std::make_shared<AMOPNodeFake>();
+    auto broadcaster = node->connect("broadcaster");
+    std::vector<AMOP::Ptr> subscribers;
+    std::atomic<int> received{0};
+    std::promise<void> allReceived;
+    auto allReceivedFuture = allReceived.get_future();
+    for (int i = 0; i < 3; ++i)
+    {
+        auto subscriber = node->connect("subscriber" + std::to_string(i));
+        subscriber->subscribe("topic",
+            [&received, &allReceived](Error::Ptr, const std::string&, const std::string&,
+                bytesConstRef, std::shared_ptr<WsSession>) {
+                if (++received == 30)
+                {
+                    allReceived.set_value();
+                }
+            });
+        subscribers.push_back(subscriber);
+    }
+
+    std::string data = "broadcast";
+    for (int i = 0; i < 10; ++i)
+    {
+        broadcaster->broadcast("topic", bytesConstRef((byte*)data.data(), data.size()));
+    }
+    BOOST_CHECK(ready(allReceivedFuture));
+    BOOST_CHECK_EQUAL(received.load(), 30);
+    node->stop();
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPRouteTopicSync)
+{
+    auto node = std::make_shared<AMOPNodeFake>();
+    auto subscriber = node->connect("subscriber");
+    AMOPTopicSync::Settings settings;
+    settings.incremental = true;
+    subscriber->setTopicSync(settings);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        subscriber->subscribe(std::set<std::string>{"topic" + std::to_string(i)});
+    }
+    subscriber->unsubscribe(std::set<std::string>{"topic0", "topic1"});
+
+    std::set<std::string> topics;
+    subscriber->querySubTopics(topics);
+    BOOST_CHECK(node->waitFor([&]() { return node->topics("subscriber") == topics; }));
+    BOOST_CHECK(node->waitFor([&]() {
+        return subscriber->topicSync()->syncedVersion("127.0.0.1:20200") ==
+               node->topicVersion("subscriber");
+    }));
+    BOOST_CHECK_EQUAL(subscriber->topicSync()->deltas(), 101);
+
+    node->disconnect("subscriber");
+    BOOST_CHECK_EQUAL(subscriber->topicSync()->syncedVersion("127.0.0.1:20200"), 0);
+    node->stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
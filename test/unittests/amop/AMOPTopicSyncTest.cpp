@@ -0,0 +1,415 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the amop topic sync
+ * @file AMOPTopicSyncTest.cpp
+ * @author: octopus
+ * @date 2023-04-03
+ */
+#include <bcos-cpp-sdk/amop/AMOPTopicSync.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <json/json.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+
+using namespace bcos;
+using namespace bcos::cppsdk::amop;
+using namespace bcos::test;
+
+namespace
+{
+// the topics of the clients kept by the node
+class FakeNode
+{
+public:
+    struct Request
+    {
+        std::string endPoint;
+        std::string request;
+        AMOPTopicSync::RespFunc respFunc;
+    };
+
+    AMOPTopicSync::SendFunc sendFunc()
+    {
+        return [this](const std::string& _endPoint, const std::string& _request,
+                   AMOPTopicSync::RespFunc _respFunc) {
+            // responded later for the sync calls back not on the sending thread
+            m_requests.push_back(Request{_endPoint, _request, _respFunc});
+        };
+    }
+
+    AMOPTopicSync::EndPointsFunc endPointsFunc()
+    {
+        return [this]() { return m_endPoints; };
+    }
+
+    void connect(const std::string& _endPoint)
+    {
+        m_endPoints.push_back(_endPoint);
+        m_topics[_endPoint].clear();
+        m_versions[_endPoint] = 0;
+    }
+
+    void disconnect(const std::string& _endPoint)
+    {
+        m_endPoints.erase(std::remove(m_endPoints.begin(), m_endPoints.end(), _endPoint),
+            m_endPoints.end());
+        m_topics.erase(_endPoint);
+        m_versions.erase(_endPoint);
+    }
+
+    // handle the requests, the lost ones are not applied and responded with the timeout
+    std::size_t pump(double _lossRate = 0)
+    {
+        std::size_t handled = 0;
+        while (!m_requests.empty())
+        {
+            auto requests = std::move(m_requests);
+            m_requests.clear();
+            for (auto& request : requests)
+            {
+                handled++;
+                auto lost = std::uniform_real_distribution<double>(0, 1)(m_random) < _lossRate;
+                if (lost || !m_versions.count(request.endPoint))
+                {
+                    if (request.respFunc)
+                    {
+                        request.respFunc(std::make_shared<Error>(-1, "timeout"), "");
+                    }
+                    continue;
+                }
+
+                auto version = apply(request.endPoint, request.request);
+                if (request.respFunc)
+                {
+                    Json::Value jResp;
+                    jResp["version"] = (Json::UInt64)version;
+                    request.respFunc(nullptr, Json::FastWriter().write(jResp));
+                }
+            }
+        }
+        return handled;
+    }
+
+    std::set<std::string> topics(const std::string& _endPoint) { return m_topics[_endPoint]; }
+    uint64_t version(const std::string& _endPoint) { return m_versions[_endPoint]; }
+
+    std::vector<Request> m_requests;
+    bool m_ignoreDelta = false;
+
+private:
+    uint64_t apply(const std::string& _endPoint, const std::string& _request)
+    {
+        Json::Value root;
+        BOOST_CHECK(Json::Reader().parse(_request, root));
+        auto& topics = m_topics[_endPoint];
+        auto& version = m_versions[_endPoint];
+        if (root.isMember("topics"))
+        {
+            topics.clear();
+            for (const auto& topic : root["topics"])
+            {
+                topics.insert(topic.asString());
+            }
+            version = root["version"].asUInt64();
+            return version;
+        }
+
+        if (m_ignoreDelta || root["baseVersion"].asUInt64() != version)
+        {
+            return version;
+        }
+        for (const auto& topic : root["add"])
+        {
+            topics.insert(topic.asString());
+        }
+        for (const auto& topic : root["remove"])
+        {
+            topics.erase(topic.asString());
+        }
+        version = root["version"].asUInt64();
+        return version;
+    }
+
+    std::vector<std::string> m_endPoints;
+    std::unordered_map<std::string, std::set<std::string>> m_topics;
+    std::unordered_map<std::string, uint64_t> m_versions;
+    std::mt19937 m_random{12345};
+};
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(AMOPTopicSyncTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_AMOPTopicSyncCodec)
+{
+    auto full = AMOPTopicSync::encodeFull({"a", "b"}, 7);
+    Json::Value root;
+    BOOST_CHECK(Json::Reader().parse(full, root));
+    BOOST_CHECK_EQUAL(root["topics"].size(), 2);
+    BOOST_CHECK_EQUAL(root["version"].asUInt64(), 7);
+
+    auto delta = AMOPTopicSync::encodeDelta(7, 8, {"c"}, {"a"});
+    BOOST_CHECK(Json::Reader().parse(delta, root));
+    BOOST_CHECK_EQUAL(root["baseVersion"].asUInt64(), 7);
+    BOOST_CHECK_EQUAL(root["version"].asUInt64(), 8);
+    BOOST_CHECK_EQUAL(root["add"][0].asString(), "c");
+    BOOST_CHECK_EQUAL(root["remove"][0].asString(), "a");
+
+    uint64_t version = 0;
+    BOOST_CHECK(AMOPTopicSync::decodeResponse("{\"version\":9}", version));
+    BOOST_CHECK_EQUAL(version, 9);
+    BOOST_CHECK(!AMOPTopicSync::decodeResponse("", version));
+    BOOST_CHECK(!AMOPTopicSync::decodeResponse("{\"code\":0}", version));
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPTopicSyncDelta)
+{
+    FakeNode node;
+    node.connect("n0");
+    auto topicManager = std::make_shared<TopicManager>();
+    AMOPTopicSync::Settings settings;
+    settings.incremental = true;
+    auto sync = std::make_shared<AMOPTopicSync>(
+        settings, topicManager, node.sendFunc(), node.endPointsFunc());
+
+    sync->resync("n0");
+    BOOST_CHECK_EQUAL(node.pump(), 1);
+    BOOST_CHECK_EQUAL(sync->fullSyncs(), 1);
+
+    topicManager->addTopics({"a", "b"});
+    sync->onTopicsChanged({"a", "b"});
+    topicManager->removeTopic("a");
+    sync->onTopicsChanged({"a"});
+    BOOST_CHECK_EQUAL(node.pump(), 2);
+    BOOST_CHECK_EQUAL(sync->deltas(), 2);
+    BOOST_CHECK_EQUAL(sync->fullSyncs(), 1);
+    BOOST_CHECK(node.topics("n0") == topicManager->topics());
+    BOOST_CHECK_EQUAL(node.version("n0"), sync->version());
+    BOOST_CHECK_EQUAL(sync->syncedVersion("n0"), sync->version());
+
+    // the node not applying the delta is resynced
+    node.m_ignoreDelta = true;
+    topicManager->addTopic("c");
+    sync->onTopicsChanged({"c"});
+    node.pump();
+    node.m_ignoreDelta = false;
+    BOOST_CHECK_EQUAL(sync->fullSyncs(), 2);
+    BOOST_CHECK(node.topics("n0") == topicManager->topics());
+    BOOST_CHECK_EQUAL(node.version("n0"), sync->version());
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPTopicSyncBatch)
+{
+    FakeNode node;
+    node.connect("n0");
+    auto topicManager = std::make_shared<TopicManager>();
+    AMOPTopicSync::Settings settings;
+    settings.incremental = true;
+    // flushed by hand, the timer is not started
+    settings.batchDelayMs = 1000;
+    auto sync = std::make_shared<AMOPTopicSync>(
+        settings, topicManager, node.sendFunc(), node.endPointsFunc());
+    sync->resync("n0");
+    node.pump();
+
+    topicManager->addTopic("a");
+    sync->onTopicsChanged({"a"});
+    topicManager->removeTopic("a");
+    sync->onTopicsChanged({"a"});
+    for (int i = 0; i < 100; ++i)
+    {
+        topicManager->addTopic("t" + std::to_string(i));
+        sync->onTopicsChanged({"t" + std::to_string(i)});
+    }
+    BOOST_CHECK(node.m_requests.empty());
+
+    sync->flush();
+    BOOST_CHECK_EQUAL(node.m_requests.size(), 1);
+    Json::Value root;
+    BOOST_CHECK(Json::Reader().parse(node.m_requests[0].request, root));
+    BOOST_CHECK_EQUAL(root["add"].size(), 100);
+    BOOST_CHECK_EQUAL(root["remove"].size(), 0);
+    node.pump();
+    BOOST_CHECK(node.topics("n0") == topicManager->topics());
+
+    // nothing changed
+    topicManager->addTopic("b");
+    topicManager->removeTopic("b");
+    sync->onTopicsChanged({"b"});
+    sync->flush();
+    BOOST_CHECK(node.m_requests.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPTopicSyncLegacy)
+{
+    FakeNode legacyNode;
+    FakeNode node;
+    legacyNode.connect("n0");
+    node.connect("n0");
+    auto legacyTopicManager = std::make_shared<TopicManager>();
+    auto topicManager = std::make_shared<TopicManager>();
+    AMOPTopicSync::Settings settings;
+    auto legacySync = std::make_shared<AMOPTopicSync>(
+        settings, legacyTopicManager, legacyNode.sendFunc(), legacyNode.endPointsFunc());
+    settings.incremental = true;
+    auto sync = std::make_shared<AMOPTopicSync>(
+        settings, topicManager, node.sendFunc(), node.endPointsFunc());
+    legacySync->resync("n0");
+    sync->resync("n0");
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto topic = "topic" + std::to_string(i);
+        legacyTopicManager->addTopic(topic);
+        legacySync->onTopicsChanged({topic});
+        topicManager->addTopic(topic);
+        sync->onTopicsChanged({topic});
+    }
+    for (const auto& request : legacyNode.m_requests)
+    {
+        // no response expected
+        BOOST_CHECK(!request.respFunc);
+    }
+    legacyNode.pump();
+    node.pump();
+
+    BOOST_CHECK_EQUAL(legacySync->fullSyncs(), 1001);
+    BOOST_CHECK_EQUAL(sync->fullSyncs(), 1);
+    BOOST_CHECK_EQUAL(sync->deltas(), 1000);
+    BOOST_CHECK(legacyNode.topics("n0") == legacyTopicManager->topics());
+    BOOST_CHECK(node.topics("n0") == topicManager->topics());
+    // the full set is sent on every change without the delta
+    BOOST_CHECK(legacySync->sentBytes() > sync->sentBytes() * 50);
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPTopicSyncSessionNotFound)
+{
+    // responds on the sending thread as AMOP does, the error if the session not found
+    bool connected = true;
+    std::size_t sent = 0;
+    auto sendFunc = [&connected, &sent](const std::string&, const std::string& _request,
+                        AMOPTopicSync::RespFunc _respFunc) {
+        sent++;
+        if (!connected)
+        {
+            _respFunc(std::make_shared<Error>(-1, "the session not found"), "");
+            return;
+        }
+        Json::Value root;
+        BOOST_CHECK(Json::Reader().parse(_request, root));
+        Json::Value jResp;
+        jResp["version"] = root["version"];
+        _respFunc(nullptr, Json::FastWriter().write(jResp));
+    };
+    auto topicManager = std::make_shared<TopicManager>();
+    AMOPTopicSync::Settings settings;
+    settings.incremental = true;
+    auto sync = std::make_shared<AMOPTopicSync>(settings, topicManager, sendFunc,
+        []() { return std::vector<std::string>{"n0"}; });
+
+    sync->resync("n0");
+    BOOST_CHECK_EQUAL(sent, 1);
+    BOOST_CHECK_EQUAL(sync->syncedVersion("n0"), sync->version());
+
+    // the delta fails and the full sync sent in its response fails too
+    connected = false;
+    topicManager->addTopic("a");
+    sync->onTopicsChanged({"a"});
+    BOOST_CHECK_EQUAL(sent, 3);
+    BOOST_CHECK_EQUAL(sync->deltas(), 1);
+    BOOST_CHECK_EQUAL(sync->fullSyncs(), 2);
+    BOOST_CHECK_EQUAL(sync->syncedVersion("n0"), 0);
+    sync->resync("n0");
+    BOOST_CHECK_EQUAL(sent, 4);
+    BOOST_CHECK_EQUAL(sync->syncedVersion("n0"), 0);
+
+    // synced by the next change
+    connected = true;
+    topicManager->addTopic("b");
+    sync->onTopicsChanged({"b"});
+    BOOST_CHECK_EQUAL(sent, 5);
+    BOOST_CHECK_EQUAL(sync->fullSyncs(), 4);
+    BOOST_CHECK_EQUAL(sync->syncedVersion("n0"), sync->version());
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOPTopicSyncConvergence)
+{
+    FakeNode node;
+    std::vector<std::string> endPoints = {"n0", "n1", "n2"};
+    auto topicManager = std::make_shared<TopicManager>();
+    AMOPTopicSync::Settings settings;
+    settings.incremental = true;
+    settings.batchDelayMs = 1000;
+    auto sync = std::make_shared<AMOPTopicSync>(
+        settings, topicManager, node.sendFunc(), node.endPointsFunc());
+    for (const auto& endPoint : endPoints)
+    {
+        node.connect(endPoint);
+        sync->resync(endPoint);
+    }
+    node.pump();
+
+    std::mt19937 random(54321);
+    for (int round = 0; round < 500; ++round)
+    {
+        // the subscribe and unsubscribe calls of the round
+        auto count = random() % 8;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto topic = "topic" + std::to_string(random() % 200);
+            if (random() % 3 == 0)
+            {
+                topicManager->removeTopic(topic);
+            }
+            else
+            {
+                topicManager->addTopic(topic);
+            }
+            sync->onTopicsChanged({topic});
+        }
+        sync->flush();
+
+        // reconnect
+        if (random() % 50 == 0)
+        {
+            auto endPoint = endPoints[random() % endPoints.size()];
+            node.disconnect(endPoint);
+            sync->onDisconnect(endPoint);
+            node.connect(endPoint);
+            sync->resync(endPoint);
+        }
+        // the messages lost are resynced
+        node.pump(0.05);
+    }
+
+    // the endpoints with the full sync lost are synced by the next change
+    topicManager->addTopic("last");
+    sync->onTopicsChanged({"last"});
+    sync->flush();
+    node.pump();
+
+    for (const auto& endPoint : endPoints)
+    {
+        BOOST_CHECK(node.topics(endPoint) == topicManager->topics());
+        BOOST_CHECK_EQUAL(node.version(endPoint), sync->version());
+        BOOST_CHECK_EQUAL(sync->syncedVersion(endPoint), sync->version());
+    }
+    BOOST_CHECK(sync->deltas() > sync->fullSyncs());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
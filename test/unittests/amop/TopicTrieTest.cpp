@@ -0,0 +1,169 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for TopicTrie
+ * @file TopicTrieTest.cpp
+ * @author: octopus
+ * @date 2023-03-24
+ */
+#include <bcos-cpp-sdk/amop/AMOP.h>
+#include <bcos-cpp-sdk/amop/TopicTrie.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::cppsdk::amop;
+using namespace bcos::test;
+
+BOOST_FIXTURE_TEST_SUITE(TopicTrieTest, TestPromptFixture)
+
+// the callback reports the filter it is registered with through the endpoint
+static SubCallback buildCallback(const std::string& _filter, std::string& _matched)
+{
+    return [_filter, &_matched](bcos::Error::Ptr, const std::string&, const std::string&,
+               bcos::bytesConstRef, std::shared_ptr<bcos::boostssl::ws::WsSession>) {
+        _matched = _filter;
+    };
+}
+
+BOOST_AUTO_TEST_CASE(test_TopicTrie_match)
+{
+    std::string matched;
+    std::unordered_map<std::string, SubCallback> topic2Callback;
+    for (const auto& filter : {"orders/+/created", "orders/1/created", "prices/#", "prices/cny",
+             "+", "a/+/+/d", "a/#", "testAMOPRequest+-@topic"})
+    {
+        topic2Callback[filter] = buildCallback(filter, matched);
+    }
+
+    auto check = [&matched](TopicTrie::ConstPtr _trie, const std::string& _topic,
+                     const std::string& _filter) {
+        matched.clear();
+        auto callback = _trie->match(_topic);
+        if (callback)
+        {
+            (*callback)(nullptr, "", "", bcos::bytesConstRef(), nullptr);
+        }
+        BOOST_CHECK_MESSAGE(matched == _filter, _topic + " => " + matched + ", not " + _filter);
+    };
+
+    auto built = TopicTrie::build(topic2Callback);
+    TopicTrie::ConstPtr inserted = std::make_shared<TopicTrie>();
+    for (const auto& [filter, callback] : topic2Callback)
+    {
+        inserted = inserted->insert(filter, callback);
+    }
+    BOOST_CHECK_EQUAL(built->size(), topic2Callback.size());
+    BOOST_CHECK_EQUAL(inserted->size(), topic2Callback.size());
+
+    for (const auto& trie : {built, inserted})
+    {
+        check(trie, "orders/1/created", "orders/1/created");
+        check(trie, "orders/2/created", "orders/+/created");
+        check(trie, "orders/2/deleted", "");
+        check(trie, "orders/2/created/x", "");
+        check(trie, "prices", "prices/#");
+        check(trie, "prices/cny", "prices/cny");
+        check(trie, "prices/usd/spot", "prices/#");
+        check(trie, "orders", "+");
+        check(trie, "a/b/c/d", "a/+/+/d");
+        check(trie, "a/b/c/e", "a/#");
+        check(trie, "a", "a/#");
+        check(trie, "b/c", "");
+        check(trie, "testAMOPRequest+-@topic", "testAMOPRequest+-@topic");
+    }
+
+    BOOST_CHECK(TopicTrie::isWildcard("orders/+/created"));
+    BOOST_CHECK(TopicTrie::isWildcard("#"));
+    BOOST_CHECK(!TopicTrie::isWildcard("testAMOPRequest+-@topic"));
+    BOOST_CHECK(!TopicTrie::isWildcard("orders/1/created"));
+}
+
+BOOST_AUTO_TEST_CASE(test_TopicTrie_snapshot)
+{
+    std::string matched;
+    auto trie = std::make_shared<TopicTrie>()->insert("a/b", buildCallback("a/b", matched));
+    auto newTrie = trie->insert("a/+", buildCallback("a/+", matched));
+    auto replaced = newTrie->insert("a/b", buildCallback("a/b/new", matched));
+
+    // the original trie is not changed by the insert
+    BOOST_CHECK_EQUAL(trie->size(), 1);
+    BOOST_CHECK(trie->match("a/c") == nullptr);
+    BOOST_CHECK_EQUAL(newTrie->size(), 2);
+    BOOST_CHECK(newTrie->match("a/c") != nullptr);
+    BOOST_CHECK_EQUAL(replaced->size(), 2);
+
+    (*newTrie->match("a/b"))(nullptr, "", "", bcos::bytesConstRef(), nullptr);
+    BOOST_CHECK_EQUAL(matched, "a/b");
+    (*replaced->match("a/b"))(nullptr, "", "", bcos::bytesConstRef(), nullptr);
+    BOOST_CHECK_EQUAL(matched, "a/b/new");
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOP_topicCallback)
+{
+    std::string matched;
+    AMOP amop;
+    BOOST_CHECK(!amop.getCallbackByTopic("orders/1/created"));
+
+    auto trie = amop.topicTrie();
+    amop.addTopicCallback("orders/+/created", buildCallback("orders/+/created", matched));
+    BOOST_CHECK(amop.topicTrie() != trie);
+    BOOST_CHECK(amop.topicTrie() == amop.topicTrie());
+    BOOST_CHECK(amop.getCallbackByTopic("orders/1/created"));
+
+    std::unordered_map<std::string, SubCallback> topic2Callback;
+    topic2Callback["prices/#"] = buildCallback("prices/#", matched);
+    topic2Callback["orders/1/created"] = buildCallback("orders/1/created", matched);
+    amop.addTopicCallbacks(topic2Callback);
+    BOOST_CHECK_EQUAL(amop.topicTrie()->size(), 3);
+
+    amop.getCallbackByTopic("orders/1/created")(nullptr, "", "", bcos::bytesConstRef(), nullptr);
+    BOOST_CHECK_EQUAL(matched, "orders/1/created");
+    amop.getCallbackByTopic("orders/2/created")(nullptr, "", "", bcos::bytesConstRef(), nullptr);
+    BOOST_CHECK_EQUAL(matched, "orders/+/created");
+    amop.getCallbackByTopic("prices/cny")(nullptr, "", "", bcos::bytesConstRef(), nullptr);
+    BOOST_CHECK_EQUAL(matched, "prices/#");
+}
+
+BOOST_AUTO_TEST_CASE(test_AMOP_topicCallbackInstances)
+{
+    std::string matched;
+    auto amop0 = std::make_shared<AMOP>();
+    auto amop1 = std::make_shared<AMOP>();
+    amop0->setTopicManager(std::make_shared<TopicManager>());
+
+    // the filter is kept locally, not subscribed to the node
+    amop0->subscribe("orders/+/created", buildCallback("orders/+/created", matched));
+    BOOST_CHECK(amop0->topicManager()->topics().empty());
+    amop1->addTopicCallback("orders/#", buildCallback("orders/#", matched));
+
+    // the instances on the same thread see their own tries
+    amop0->getCallbackByTopic("orders/1/created")(
+        nullptr, "", "", bcos::bytesConstRef(), nullptr);
+    BOOST_CHECK_EQUAL(matched, "orders/+/created");
+    amop1->getCallbackByTopic("orders/1/created")(
+        nullptr, "", "", bcos::bytesConstRef(), nullptr);
+    BOOST_CHECK_EQUAL(matched, "orders/#");
+    BOOST_CHECK(!amop0->getCallbackByTopic("orders/1"));
+    BOOST_CHECK(amop1->getCallbackByTopic("orders/1"));
+
+    // no trie is kept alive after the instance destroyed
+    std::weak_ptr<const TopicTrie> trie = amop1->topicTrie();
+    amop1.reset();
+    BOOST_CHECK(trie.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
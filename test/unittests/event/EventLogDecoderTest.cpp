@@ -0,0 +1,109 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventLogDecoderTest.cpp
+ * @author: octopus
+ * @date 2023-03-08
+ */
+
+#include <bcos-cpp-sdk/event/EventLogDecoder.h>
+#include <bcos-cpp-sdk/utilities/abi/ContractABITypeCodec.h>
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <string>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::event;
+using namespace bcos::test;
+
+BOOST_FIXTURE_TEST_SUITE(EventLogDecoderTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_EventLogDecoder)
+{
+    // event Set(uint256 indexed id, string indexed name, uint256 count, string memo)
+    std::string abi =
+        R"([{"anonymous":false,"inputs":[{"indexed":true,"name":"id","type":"uint256"},)"
+        R"({"indexed":true,"name":"name","type":"string"},)"
+        R"({"indexed":false,"name":"count","type":"uint256"},)"
+        R"({"indexed":false,"name":"memo","type":"string"}],"name":"Set","type":"event"}])";
+
+    auto hashImpl = std::make_shared<bcos::crypto::Keccak256>();
+    auto codec = std::make_shared<bcos::cppsdk::abi::ContractABITypeCodecSolImpl>();
+    auto decoder = std::make_shared<EventLogDecoder>(abi, hashImpl, codec);
+    BOOST_CHECK_EQUAL(decoder->eventCount(), 1);
+
+    std::string sig = "Set(uint256,string,uint256,string)";
+    auto topic0 = hashImpl->hash(bcos::bytesConstRef((bcos::byte*)sig.data(), sig.size())).hex();
+    BOOST_CHECK(decoder->hasEvent(topic0));
+    BOOST_CHECK(decoder->hasEvent("0x" + topic0));
+
+    std::string nameTopic = "0x1111111111111111111111111111111111111111111111111111111111111111";
+
+    Json::Value jLog;
+    jLog["address"] = "0x6849f21d1e455e9f0712b1e99fa4fcd23758e8f1";
+    jLog["blockNumber"] = 111;
+    jLog["transactionHash"] = "0x0359a5588c5e9c9dcfd2f4ece850d6f4c41bc88e2c27cc051890f26ef0ef118f";
+    jLog["transactionIndex"] = 2;
+    jLog["logIndex"] = 3;
+    jLog["data"] =
+        "0x0000000000000000000000000000000000000000000000000000000000000007"
+        "0000000000000000000000000000000000000000000000000000000000000040"
+        "0000000000000000000000000000000000000000000000000000000000000002"
+        "6869000000000000000000000000000000000000000000000000000000000000";
+    jLog["topics"].append("0x" + topic0);
+    jLog["topics"].append("0x0000000000000000000000000000000000000000000000000000000000000005");
+    jLog["topics"].append(nameTopic);
+
+    Json::Value jLogs(Json::arrayValue);
+    jLogs.append(jLog);
+
+    // unknown event
+    Json::Value jUnknownLog = jLog;
+    jUnknownLog["topics"][0] = nameTopic;
+    jLogs.append(jUnknownLog);
+
+    auto logs = decoder->decodeLogs(jLogs);
+    BOOST_CHECK_EQUAL(logs.size(), 2);
+
+    auto log = logs[0];
+    BOOST_CHECK(log->decoded());
+    BOOST_CHECK_EQUAL(log->blockNumber(), 111);
+    BOOST_CHECK_EQUAL(log->transactionIndex(), 2);
+    BOOST_CHECK_EQUAL(log->logIndex(), 3);
+    BOOST_CHECK_EQUAL(log->transactionHash(), jLog["transactionHash"].asString());
+    BOOST_CHECK_EQUAL(log->eventName(), "Set");
+    BOOST_CHECK_EQUAL(log->eventSignature(), sig);
+    BOOST_CHECK_EQUAL(log->topics().size(), 3);
+    BOOST_CHECK_EQUAL(log->paramNames().size(), 4);
+    BOOST_CHECK_EQUAL(log->paramNames()[2], "count");
+
+    const auto& params = log->params();
+    BOOST_CHECK_EQUAL(params.size(), 4);
+    BOOST_CHECK_EQUAL(params[0].asString(), "5");
+    // only the hash of the dynamic indexed param is logged
+    BOOST_CHECK_EQUAL(params[1].asString(), nameTopic);
+    BOOST_CHECK_EQUAL(params[2].asString(), "7");
+    BOOST_CHECK_EQUAL(params[3].asString(), "hi");
+
+    BOOST_CHECK(!logs[1]->decoded());
+    BOOST_CHECK_EQUAL(logs[1]->logIndex(), 3);
+    BOOST_CHECK(logs[1]->params().isNull());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,335 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for EventSubBackfill
+ * @file EventSubBackfillTest.cpp
+ * @author: octopus
+ * @date 2023-03-15
+ */
+#include <bcos-cpp-sdk/event/EventSubBackfill.h>
+#include <bcos-cpp-sdk/event/EventSubResponse.h>
+#include <bcos-cpp-sdk/event/EventSubStatus.h>
+#include <bcos-cpp-sdk/multigroup/JsonGroupInfoCodec.h>
+#include <bcos-cpp-sdk/ws/Service.h>
+#include <bcos-framework/interfaces/multigroup/GroupInfoFactory.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+#include <json/writer.h>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::event;
+using namespace bcos::test;
+
+namespace
+{
+Json::Value buildLogs(int64_t _blockNumber, std::size_t _count)
+{
+    Json::Value jLogs(Json::arrayValue);
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+        Json::Value jLog;
+        jLog["blockNumber"] = (Json::Int64)_blockNumber;
+        jLog["logIndex"] = (Json::UInt64)i;
+        jLogs.append(jLog);
+    }
+    return jLogs;
+}
+
+// the subs are kept and responded by the test
+class FakeEventSub : public EventSub
+{
+public:
+    using EventSub::subscribeEvent;
+
+    struct Sub
+    {
+        std::string id;
+        EventSubParams::Ptr params;
+        std::string endPoint;
+        Callback callback;
+    };
+
+    FakeEventSub()
+    {
+        setMessageFactory(std::make_shared<bcos::boostssl::ws::WsMessageFactory>());
+        setService(std::make_shared<service::Service>(
+            std::make_shared<bcos::group::JsonGroupInfoCodec>(),
+            std::make_shared<bcos::group::GroupInfoFactory>(), "SDK"));
+    }
+
+    std::string subscribeEventByEndPoint(const std::string&, EventSubParams::Ptr _params,
+        const std::string& _endPoint, Callback _callback) override
+    {
+        subs.push_back(Sub{"sub" + std::to_string(subs.size()), _params, _endPoint, _callback});
+        return subs.back().id;
+    }
+
+    std::string subscribeEvent(
+        const std::string& _group, EventSubParams::Ptr _params, Callback _callback) override
+    {
+        return subscribeEventByEndPoint(_group, _params, "", std::move(_callback));
+    }
+
+    void unsubscribeEvent(const std::string& _id) override { unsubscribed.insert(_id); }
+
+    void respond(std::size_t _sub, int _status, const Json::Value& _jLogs = Json::Value())
+    {
+        Json::Value jResp;
+        jResp["id"] = subs[_sub].id;
+        jResp["status"] = _status;
+        if (!_jLogs.isNull())
+        {
+            jResp["result"] = _jLogs;
+        }
+        // the callback may subscribe more
+        auto callback = subs[_sub].callback;
+        callback(nullptr, Json::FastWriter().write(jResp));
+    }
+    void ack(std::size_t _sub) { respond(_sub, StatusCode::Success); }
+    void push(std::size_t _sub, int64_t _blockNumber, std::size_t _count = 1)
+    {
+        respond(_sub, StatusCode::Success, buildLogs(_blockNumber, _count));
+    }
+    void end(std::size_t _sub) { respond(_sub, StatusCode::EndOfPush); }
+
+    std::vector<Sub> subs;
+    std::set<std::string> unsubscribed;
+};
+
+// the responses of the backfill sub
+struct Received
+{
+    Callback callback()
+    {
+        return [this](Error::Ptr _error, const std::string& _resp) {
+            if (_error && _error->errorCode() != 0)
+            {
+                error = _error;
+                return;
+            }
+            EventSubResponse resp;
+            BOOST_CHECK(resp.fromJson(_resp));
+            ids.insert(resp.id());
+            statuses.push_back(resp.status());
+            for (const auto& jLog : resp.jResp()["result"])
+            {
+                blocks.push_back(jLog["blockNumber"].asInt64());
+            }
+        };
+    }
+
+    Error::Ptr error;
+    std::set<std::string> ids;
+    std::vector<int> statuses;
+    std::vector<int64_t> blocks;
+};
+
+EventSubParams::Ptr buildParams(int64_t _fromBlock, int64_t _toBlock)
+{
+    auto params = std::make_shared<EventSubParams>();
+    params->setFromBlock(_fromBlock);
+    params->setToBlock(_toBlock);
+    return params;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(EventSubBackfillTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_EventSubBackfill_splitRange)
+{
+    auto ranges = EventSubBackfill::splitRange(0, 99, 10);
+    BOOST_CHECK_EQUAL(ranges.size(), 10);
+    BOOST_CHECK_EQUAL(ranges[0].first, 0);
+    BOOST_CHECK_EQUAL(ranges[0].second, 9);
+    BOOST_CHECK_EQUAL(ranges[9].first, 90);
+    BOOST_CHECK_EQUAL(ranges[9].second, 99);
+
+    ranges = EventSubBackfill::splitRange(5, 25, 10);
+    BOOST_CHECK_EQUAL(ranges.size(), 3);
+    BOOST_CHECK_EQUAL(ranges[2].first, 25);
+    BOOST_CHECK_EQUAL(ranges[2].second, 25);
+
+    BOOST_CHECK(EventSubBackfill::splitRange(-1, 100, 10).empty());
+    BOOST_CHECK(EventSubBackfill::splitRange(100, 99, 10).empty());
+    BOOST_CHECK(EventSubBackfill::splitRange(0, 99, 0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_EventSubChunkReorder)
+{
+    EventSubChunkReorder reorder(3);
+    Json::Value jOut(Json::arrayValue);
+
+    // the later chunks are buffered
+    auto jLogs = buildLogs(20, 2);
+    reorder.append(2, jLogs, jOut);
+    jLogs = buildLogs(10, 3);
+    reorder.append(1, jLogs, jOut);
+    BOOST_CHECK(jOut.empty());
+    BOOST_CHECK_EQUAL(reorder.bufferedLogs(), 5);
+
+    // the first chunk is delivered at once
+    jLogs = buildLogs(0, 1);
+    reorder.append(0, jLogs, jOut);
+    BOOST_CHECK_EQUAL(jOut.size(), 1);
+
+    // chunk 2 finished before chunk 1
+    jOut = Json::Value(Json::arrayValue);
+    reorder.complete(2, jOut);
+    BOOST_CHECK(jOut.empty());
+    BOOST_CHECK_EQUAL(reorder.next(), 0);
+
+    // chunk 1 flushed when chunk 0 finished
+    reorder.complete(0, jOut);
+    BOOST_CHECK_EQUAL(jOut.size(), 3);
+    BOOST_CHECK_EQUAL(jOut[0]["blockNumber"].asInt64(), 10);
+    BOOST_CHECK_EQUAL(reorder.next(), 1);
+    BOOST_CHECK(!reorder.finished());
+
+    // chunk 1 is being delivered
+    jOut = Json::Value(Json::arrayValue);
+    jLogs = buildLogs(11, 1);
+    reorder.append(1, jLogs, jOut);
+    BOOST_CHECK_EQUAL(jOut.size(), 1);
+
+    // chunk 2 flushed and all finished
+    jOut = Json::Value(Json::arrayValue);
+    reorder.complete(1, jOut);
+    BOOST_CHECK_EQUAL(jOut.size(), 2);
+    BOOST_CHECK_EQUAL(jOut[0]["blockNumber"].asInt64(), 20);
+    BOOST_CHECK_EQUAL(jOut[1]["logIndex"].asUInt64(), 1);
+    BOOST_CHECK(reorder.finished());
+    BOOST_CHECK_EQUAL(reorder.bufferedLogs(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_EventSubBackfill_orderedDelivery)
+{
+    auto eventSub = std::make_shared<FakeEventSub>();
+    auto backfill = std::make_shared<EventSubBackfill>(eventSub);
+    backfill->setChunkSize(10);
+    backfill->setMaxParallelChunks(2);
+
+    Received received;
+    auto id = backfill->subscribeEvent("group0", buildParams(0, 49), received.callback());
+    BOOST_CHECK_EQUAL(backfill->jobCount(), 1);
+    BOOST_CHECK_EQUAL(eventSub->subs.size(), 2);
+    BOOST_CHECK_EQUAL(eventSub->subs[1].params->fromBlock(), 10);
+    BOOST_CHECK_EQUAL(eventSub->subs[1].params->toBlock(), 19);
+
+    // chunk 1 finished ahead of chunk 0, buffered and holding its slot
+    eventSub->ack(1);
+    eventSub->push(1, 10, 2);
+    eventSub->end(1);
+    BOOST_CHECK((received.statuses == std::vector<int>{StatusCode::Success}));
+    BOOST_CHECK(received.blocks.empty());
+    BOOST_CHECK_EQUAL(eventSub->subs.size(), 2);
+
+    // chunk 0 is delivered at once, the window moves when it finished
+    eventSub->ack(0);
+    eventSub->push(0, 0);
+    BOOST_CHECK((received.blocks == std::vector<int64_t>{0}));
+    eventSub->end(0);
+    BOOST_CHECK((received.blocks == std::vector<int64_t>{0, 10, 10}));
+    BOOST_CHECK_EQUAL(eventSub->subs.size(), 4);
+
+    // chunk 3 finished ahead of chunk 2
+    eventSub->end(3);
+    BOOST_CHECK_EQUAL(eventSub->subs.size(), 4);
+    eventSub->push(2, 20);
+    eventSub->end(2);
+    BOOST_CHECK_EQUAL(eventSub->subs.size(), 5);
+    BOOST_CHECK_EQUAL(eventSub->subs[4].params->fromBlock(), 40);
+    BOOST_CHECK_EQUAL(eventSub->subs[4].params->toBlock(), 49);
+
+    eventSub->push(4, 40);
+    eventSub->end(4);
+    BOOST_CHECK((received.blocks == std::vector<int64_t>{0, 10, 10, 20, 40}));
+    BOOST_CHECK_EQUAL(received.statuses.back(), StatusCode::EndOfPush);
+    BOOST_CHECK((received.ids == std::set<std::string>{id}));
+    BOOST_CHECK(!received.error);
+    BOOST_CHECK_EQUAL(backfill->jobCount(), 0);
+    BOOST_CHECK(eventSub->unsubscribed.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_EventSubBackfill_chunkFailed)
+{
+    auto eventSub = std::make_shared<FakeEventSub>();
+    auto backfill = std::make_shared<EventSubBackfill>(eventSub);
+    backfill->setChunkSize(10);
+    backfill->setMaxParallelChunks(2);
+
+    Received received;
+    backfill->subscribeEvent("group0", buildParams(0, 29), received.callback());
+    BOOST_CHECK_EQUAL(eventSub->subs.size(), 2);
+
+    // the job fails with the chunk, the other running chunk is unsubscribed
+    eventSub->subs[1].callback(std::make_shared<Error>(-1, "chunk failed"), "");
+    BOOST_CHECK(received.error);
+    BOOST_CHECK_EQUAL(backfill->jobCount(), 0);
+    BOOST_CHECK((eventSub->unsubscribed == std::set<std::string>{eventSub->subs[0].id}));
+
+    // the responses after the failure are dropped
+    eventSub->push(0, 0);
+    eventSub->end(0);
+    BOOST_CHECK(received.statuses.empty());
+    BOOST_CHECK(received.blocks.empty());
+    BOOST_CHECK_EQUAL(eventSub->subs.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_EventSubBackfill_liveTail)
+{
+    auto eventSub = std::make_shared<FakeEventSub>();
+    eventSub->service()->updateGroupBlockNumber("group0", 19);
+    auto backfill = std::make_shared<EventSubBackfill>(eventSub);
+    backfill->setChunkSize(10);
+
+    // the history to the head 19 in chunks, the live tail from 20
+    Received received;
+    auto id = backfill->subscribeEvent("group0", buildParams(0, -1), received.callback());
+    BOOST_CHECK_EQUAL(eventSub->subs.size(), 2);
+    BOOST_CHECK_EQUAL(eventSub->subs[1].params->toBlock(), 19);
+
+    eventSub->ack(0);
+    eventSub->push(1, 15);
+    eventSub->end(1);
+    eventSub->push(0, 5);
+    BOOST_CHECK_EQUAL(eventSub->subs.size(), 2);
+    eventSub->end(0);
+
+    // the tail starts after all the chunks delivered, the end of the chunks is not delivered
+    BOOST_CHECK_EQUAL(eventSub->subs.size(), 3);
+    BOOST_CHECK_EQUAL(eventSub->subs[2].params->fromBlock(), 20);
+    BOOST_CHECK_EQUAL(eventSub->subs[2].params->toBlock(), -1);
+    BOOST_CHECK((received.statuses == std::vector<int>{StatusCode::Success, StatusCode::Success,
+                     StatusCode::Success}));
+
+    // the ack of the tail is not delivered twice, its logs are delivered with the job id
+    eventSub->ack(2);
+    eventSub->push(2, 21);
+    BOOST_CHECK_EQUAL(received.statuses.size(), 4);
+    BOOST_CHECK((received.blocks == std::vector<int64_t>{5, 15, 21}));
+    BOOST_CHECK((received.ids == std::set<std::string>{id}));
+
+    backfill->unsubscribeEvent(id);
+    BOOST_CHECK_EQUAL(backfill->jobCount(), 0);
+    BOOST_CHECK((eventSub->unsubscribed == std::set<std::string>{eventSub->subs[2].id}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
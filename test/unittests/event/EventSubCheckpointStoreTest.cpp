@@ -0,0 +1,192 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file EventSubCheckpointStoreTest.cpp
+ * @author: octopus
+ * @date 2023-03-10
+ */
+
+#include <bcos-cpp-sdk/event/EventSubCheckpointStore.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/filesystem.hpp>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::event;
+using namespace bcos::test;
+
+BOOST_FIXTURE_TEST_SUITE(EventSubCheckpointStoreTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_EventSubCheckpointStore)
+{
+    auto path = (boost::filesystem::temp_directory_path() /
+                 boost::filesystem::unique_path("event_checkpoint_%%%%%%%%"))
+                    .string();
+
+    auto params = std::make_shared<EventSubParams>();
+    params->setFromBlock(1);
+    params->addAddress("0x1111");
+    params->addTopic(0, "topic");
+    auto paramsHash = EventSubCheckpointStore::paramsHash(*params);
+    BOOST_CHECK_EQUAL(paramsHash, EventSubCheckpointStore::paramsHash(*params));
+
+    {
+        // no timer, flush by batch size and stop
+        auto store = std::make_shared<EventSubCheckpointStore>(path, 0, 2);
+        store->start();
+        BOOST_CHECK_EQUAL(store->size(), 0);
+
+        store->update(EventSubCheckpoint{"id0", paramsHash, 10, 0, 1});
+        store->update(EventSubCheckpoint{"id0", paramsHash, 11, 2, 3});
+        store->update(EventSubCheckpoint{"id1", paramsHash, 5, 0, 0});
+        store->update(EventSubCheckpoint{"id2", paramsHash, 6, 0, 0});
+        store->remove("id2");
+        BOOST_CHECK_EQUAL(store->size(), 2);
+
+        EventSubCheckpoint checkpoint;
+        BOOST_CHECK(store->get("id0", checkpoint));
+        BOOST_CHECK_EQUAL(checkpoint.blockNumber, 11);
+        BOOST_CHECK(!store->get("id2", checkpoint));
+        store->stop();
+    }
+
+    {
+        // reload after restart
+        auto store = std::make_shared<EventSubCheckpointStore>(path, 0, 100);
+        store->start();
+        BOOST_CHECK_EQUAL(store->size(), 2);
+
+        EventSubCheckpoint checkpoint;
+        BOOST_CHECK(store->get("id0", checkpoint));
+        BOOST_CHECK_EQUAL(checkpoint.paramsHash, paramsHash);
+        BOOST_CHECK_EQUAL(checkpoint.blockNumber, 11);
+        BOOST_CHECK_EQUAL(checkpoint.transactionIndex, 2);
+        BOOST_CHECK_EQUAL(checkpoint.logIndex, 3);
+        BOOST_CHECK(store->get("id1", checkpoint));
+        BOOST_CHECK_EQUAL(checkpoint.blockNumber, 5);
+        BOOST_CHECK(!store->get("id2", checkpoint));
+
+        store->remove("id1");
+        BOOST_CHECK_EQUAL(store->flush(), 1);
+        BOOST_CHECK_EQUAL(store->flush(), 0);
+        store->stop();
+    }
+
+    {
+        auto store = std::make_shared<EventSubCheckpointStore>(path, 0, 100);
+        store->start();
+        BOOST_CHECK_EQUAL(store->size(), 1);
+        store->stop();
+    }
+
+    boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(test_EventSubCheckpointStore_tornFile)
+{
+    auto path = (boost::filesystem::temp_directory_path() /
+                 boost::filesystem::unique_path("event_checkpoint_%%%%%%%%"))
+                    .string();
+
+    {
+        // the last update of id0 is torn in its log index, 35 written as 3
+        std::ofstream out(path, std::ios::binary);
+        out << "U id0 hash 10 0 1\n"
+            << "U id1 hash 5 0 0\n"
+            << "U id2 hash\n"
+            << "D id1\n"
+            << "U id0 hash 11 2 3";
+    }
+
+    {
+        auto store = std::make_shared<EventSubCheckpointStore>(path, 0, 100);
+        store->start();
+        BOOST_CHECK_EQUAL(store->size(), 1);
+
+        EventSubCheckpoint checkpoint;
+        BOOST_CHECK(store->get("id0", checkpoint));
+        BOOST_CHECK_EQUAL(checkpoint.blockNumber, 10);
+        BOOST_CHECK_EQUAL(checkpoint.logIndex, 1);
+        BOOST_CHECK(!store->get("id1", checkpoint));
+        BOOST_CHECK(!store->get("id2", checkpoint));
+
+        // appended after the compacted lines, not to the torn one
+        store->update(EventSubCheckpoint{"id0", "hash", 12, 0, 0});
+        store->stop();
+    }
+
+    {
+        auto store = std::make_shared<EventSubCheckpointStore>(path, 0, 100);
+        store->start();
+        EventSubCheckpoint checkpoint;
+        BOOST_CHECK(store->get("id0", checkpoint));
+        BOOST_CHECK_EQUAL(checkpoint.blockNumber, 12);
+        store->stop();
+    }
+
+    boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(test_EventSubCheckpointStore_concurrentFlush)
+{
+    auto path = (boost::filesystem::temp_directory_path() /
+                 boost::filesystem::unique_path("event_checkpoint_%%%%%%%%"))
+                    .string();
+
+    {
+        // the flushes by the batch size race with the explicit ones, the last update wins on
+        // reload
+        auto store = std::make_shared<EventSubCheckpointStore>(path, 0, 1);
+        store->start();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([store]() {
+                for (int i = 0; i < 200; ++i)
+                {
+                    store->flush();
+                }
+            });
+        }
+        for (int64_t i = 0; i < 1000; ++i)
+        {
+            store->update(EventSubCheckpoint{"id0", "hash", i, 0, 0});
+        }
+        store->remove("id0");
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        store->stop();
+    }
+
+    {
+        auto store = std::make_shared<EventSubCheckpointStore>(path, 0, 100);
+        store->start();
+        BOOST_CHECK_EQUAL(store->size(), 0);
+        store->stop();
+    }
+
+    boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
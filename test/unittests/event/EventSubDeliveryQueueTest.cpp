@@ -0,0 +1,184 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for EventSubDeliveryQueue
+ * @file EventSubDeliveryQueueTest.cpp
+ * @author: octopus
+ * @date 2023-03-17
+ */
+#include <bcos-cpp-sdk/event/EventSubDeliveryQueue.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::event;
+using namespace bcos::test;
+
+BOOST_FIXTURE_TEST_SUITE(EventSubDeliveryQueueTest, TestPromptFixture)
+
+// the first push blocks the executor until released
+struct BlockedQueue
+{
+    BlockedQueue(std::size_t _capacity, DeliveryPolicy _policy)
+    {
+        queue = std::make_shared<EventSubDeliveryQueue>(
+            _capacity, _policy, std::make_shared<bcos::ThreadPool>("t_test_deliver", 1));
+
+        auto released = release.get_future().share();
+        queue->push(0, 1, [this, released]() {
+            started.set_value();
+            released.wait();
+            record(0);
+        });
+        started.get_future().wait();
+    }
+
+    void push(int64_t _blockNumber, bool _control = false)
+    {
+        queue->push(_blockNumber, 1, [this, _blockNumber]() { record(_blockNumber); }, _control);
+    }
+
+    void record(int64_t _blockNumber)
+    {
+        std::lock_guard<std::mutex> lock(x_delivered);
+        delivered.push_back(_blockNumber);
+    }
+
+    std::vector<int64_t> waitDelivered(std::size_t _count)
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            {
+                std::lock_guard<std::mutex> lock(x_delivered);
+                if (delivered.size() >= _count)
+                {
+                    return delivered;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        std::lock_guard<std::mutex> lock(x_delivered);
+        return delivered;
+    }
+
+    EventSubDeliveryQueue::Ptr queue;
+    std::promise<void> started;
+    std::promise<void> release;
+    std::mutex x_delivered;
+    std::vector<int64_t> delivered;
+};
+
+BOOST_AUTO_TEST_CASE(test_EventSubDeliveryQueue_dropOldest)
+{
+    BlockedQueue q(2, DeliveryPolicy::DropOldest);
+    q.push(1);
+    q.push(2);
+    BOOST_CHECK(q.queue->full());
+    q.push(3);
+    // the control push is never dropped
+    q.push(4, true);
+
+    auto stats = q.queue->stats();
+    BOOST_CHECK_EQUAL(stats.depth, 3);
+    BOOST_CHECK_EQUAL(stats.dropped, 1);
+    BOOST_CHECK_EQUAL(stats.lagBlocks, 3);
+
+    q.release.set_value();
+    auto delivered = q.waitDelivered(4);
+    BOOST_CHECK((delivered == std::vector<int64_t>{0, 2, 3, 4}));
+
+    stats = q.queue->stats();
+    BOOST_CHECK_EQUAL(stats.depth, 0);
+    BOOST_CHECK_EQUAL(stats.delivered, 4);
+    BOOST_CHECK_EQUAL(stats.lagBlocks, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_EventSubDeliveryQueue_block)
+{
+    BlockedQueue q(1, DeliveryPolicy::Block);
+    q.push(1);
+
+    std::atomic<bool> pushed{false};
+    std::thread producer([&q, &pushed]() {
+        q.push(2);
+        pushed = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    BOOST_CHECK(!pushed);
+
+    q.release.set_value();
+    producer.join();
+    BOOST_CHECK(pushed);
+
+    auto delivered = q.waitDelivered(3);
+    BOOST_CHECK((delivered == std::vector<int64_t>{0, 1, 2}));
+    BOOST_CHECK_EQUAL(q.queue->stats().dropped, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_EventSubDeliveryQueue_suspend)
+{
+    BlockedQueue q(4, DeliveryPolicy::Suspend);
+
+    // not full, not suspended
+    q.push(1);
+    BOOST_CHECK(!q.queue->suspend());
+
+    std::promise<void> resumed;
+    q.queue->setResumeHandler([&resumed]() { resumed.set_value(); });
+
+    q.push(2);
+    q.push(3);
+    q.push(4);
+    BOOST_CHECK(q.queue->full());
+    BOOST_CHECK(q.queue->suspend());
+    // the pushes in flight are kept
+    q.push(5);
+
+    auto stats = q.queue->stats();
+    BOOST_CHECK(stats.suspended);
+    BOOST_CHECK_EQUAL(stats.suspendCount, 1);
+    BOOST_CHECK_EQUAL(stats.depth, 5);
+
+    q.release.set_value();
+    BOOST_CHECK(resumed.get_future().wait_for(std::chrono::seconds(5)) ==
+                std::future_status::ready);
+
+    auto delivered = q.waitDelivered(6);
+    BOOST_CHECK_EQUAL(delivered.size(), 6);
+    BOOST_CHECK(!q.queue->stats().suspended);
+}
+
+BOOST_AUTO_TEST_CASE(test_EventSubDeliveryQueue_close)
+{
+    BlockedQueue q(2, DeliveryPolicy::Block);
+    q.push(1);
+    q.push(2);
+
+    q.queue->close();
+    BOOST_CHECK(q.queue->closed());
+    BOOST_CHECK(!q.queue->push(3, 1, []() {}));
+
+    q.release.set_value();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    BOOST_CHECK_EQUAL(q.waitDelivered(1).size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,273 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for EventSubIndex and EventSubMultiplexer params merging
+ * @file EventSubIndexTest.cpp
+ * @author: octopus
+ * @date 2023-03-13
+ */
+#include <bcos-cpp-sdk/event/EventSubIndex.h>
+#include <bcos-cpp-sdk/event/EventSubMultiplexer.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::event;
+using namespace bcos::test;
+
+BOOST_FIXTURE_TEST_SUITE(EventSubIndexTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_EventSubIndex_normalize)
+{
+    BOOST_CHECK_EQUAL(EventSubIndex::normalize("0xABcd12"), "abcd12");
+    BOOST_CHECK_EQUAL(EventSubIndex::normalize("0XABcd12"), "abcd12");
+    BOOST_CHECK_EQUAL(EventSubIndex::normalize("abcd12"), "abcd12");
+    BOOST_CHECK_EQUAL(EventSubIndex::normalize(""), "");
+}
+
+BOOST_AUTO_TEST_CASE(test_EventSubIndex_match)
+{
+    EventSubIndex index;
+
+    // address + topic0
+    EventSubParams p0;
+    p0.addAddress("0xAA");
+    p0.addTopic(0, "0x01");
+    index.add("s0", p0);
+
+    // address only
+    EventSubParams p1;
+    p1.addAddress("0xaa");
+    index.add("s1", p1);
+
+    // topic0 only
+    EventSubParams p2;
+    p2.addTopic(0, "0x01");
+    index.add("s2", p2);
+
+    // all logs
+    EventSubParams p3;
+    index.add("s3", p3);
+
+    // address + topic0 + topic1
+    EventSubParams p4;
+    p4.addAddress("0xbb");
+    p4.addTopic(0, "0x01");
+    p4.addTopic(1, "0x02");
+    index.add("s4", p4);
+
+    BOOST_CHECK_EQUAL(index.size(), 5);
+
+    auto match = [&index](const std::string& _address, const std::vector<std::string>& _topics) {
+        std::vector<std::string> ids;
+        index.match(EventSubIndex::normalize(_address), _topics, ids);
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    };
+
+    {
+        auto ids = match("0xaa", {"01"});
+        BOOST_CHECK((ids == std::vector<std::string>{"s0", "s1", "s2", "s3"}));
+    }
+
+    {
+        auto ids = match("0xaa", {"03"});
+        BOOST_CHECK((ids == std::vector<std::string>{"s1", "s3"}));
+    }
+
+    {
+        auto ids = match("0xbb", {"01", "02"});
+        BOOST_CHECK((ids == std::vector<std::string>{"s2", "s3", "s4"}));
+    }
+
+    {
+        auto ids = match("0xbb", {"01", "03"});
+        BOOST_CHECK((ids == std::vector<std::string>{"s2", "s3"}));
+    }
+
+    {
+        // no topics
+        auto ids = match("0xaa", {});
+        BOOST_CHECK((ids == std::vector<std::string>{"s1", "s3"}));
+    }
+
+    BOOST_CHECK(index.remove("s3"));
+    BOOST_CHECK(!index.remove("s3"));
+    BOOST_CHECK(index.remove("s1"));
+    BOOST_CHECK_EQUAL(index.size(), 3);
+
+    {
+        auto ids = match("0xaa", {"01"});
+        BOOST_CHECK((ids == std::vector<std::string>{"s0", "s2"}));
+    }
+
+    {
+        auto ids = match("0xcc", {"03"});
+        BOOST_CHECK(ids.empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_EventSubIndex_matchTopics)
+{
+    EventSubIndex index;
+
+    // topic2 only
+    EventSubParams p0;
+    p0.addTopic(2, "0x0A");
+    index.add("s0", p0);
+
+    // topic1 and topic3
+    EventSubParams p1;
+    p1.addTopic(1, "0x01");
+    p1.addTopic(3, "0x03");
+    p1.addTopic(3, "0x04");
+    index.add("s1", p1);
+
+    // the same address in two forms is indexed once
+    EventSubParams p2;
+    p2.addAddress("0xCC");
+    p2.addAddress("cc");
+    index.add("s2", p2);
+    // the buckets of (any, any) and (cc, any)
+    BOOST_CHECK_EQUAL(index.keyCount(), 2);
+
+    auto match = [&index](const std::string& _address, const std::vector<std::string>& _topics) {
+        std::vector<std::string> ids;
+        index.match(_address, _topics, ids);
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    };
+
+    BOOST_CHECK((match("aa", {"00", "00", "0a"}) == std::vector<std::string>{"s0"}));
+    BOOST_CHECK((match("aa", {"00", "01", "0a", "04"}) == std::vector<std::string>{"s0", "s1"}));
+    BOOST_CHECK((match("cc", {"00", "01", "0b", "03"}) == std::vector<std::string>{"s1", "s2"}));
+    // topic3 missing
+    BOOST_CHECK(match("aa", {"00", "01", "0b"}).empty());
+    BOOST_CHECK((match("cc", {}) == std::vector<std::string>{"s2"}));
+
+    BOOST_CHECK(index.remove("s1"));
+    BOOST_CHECK(match("aa", {"00", "01", "0a", "04"}) == std::vector<std::string>{"s0"});
+    BOOST_CHECK_EQUAL(index.keyCount(), 2);
+    BOOST_CHECK(index.remove("s0"));
+    BOOST_CHECK(index.remove("s2"));
+    BOOST_CHECK_EQUAL(index.keyCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_EventSubIndex_matchOneAddress)
+{
+    EventSubIndex index;
+
+    // the subs of one address on different topics, the candidates of a log are the subs of its
+    // topic0 only
+    const std::size_t count = 10000;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        EventSubParams params;
+        params.addAddress("0xaa");
+        params.addTopic(0, "0x" + std::to_string(i));
+        if (i % 2 == 0)
+        {
+            params.addTopic(1, "0x01");
+        }
+        index.add("s" + std::to_string(i), params);
+    }
+    // the address and topic1 only
+    EventSubParams p0;
+    p0.addAddress("0xAA");
+    p0.addTopic(1, "0x02");
+    index.add("p0", p0);
+    BOOST_CHECK_EQUAL(index.keyCount(), count + 1);
+
+    std::vector<std::string> ids;
+    BOOST_CHECK_EQUAL(index.match("aa", {"7", "01"}, ids), 2);
+    BOOST_CHECK((ids == std::vector<std::string>{"s7"}));
+
+    ids.clear();
+    BOOST_CHECK_EQUAL(index.match("aa", {"8", "02"}, ids), 2);
+    BOOST_CHECK((ids == std::vector<std::string>{"p0"}));
+
+    ids.clear();
+    BOOST_CHECK_EQUAL(index.match("aa", {"8", "01"}, ids), 2);
+    BOOST_CHECK((ids == std::vector<std::string>{"s8"}));
+
+    ids.clear();
+    BOOST_CHECK_EQUAL(index.match("bb", {"8", "01"}, ids), 0);
+    BOOST_CHECK(ids.empty());
+
+    BOOST_CHECK(index.remove("s8"));
+    ids.clear();
+    BOOST_CHECK_EQUAL(index.match("aa", {"8", "01"}, ids), 1);
+    BOOST_CHECK(ids.empty());
+    BOOST_CHECK_EQUAL(index.keyCount(), count);
+}
+
+BOOST_AUTO_TEST_CASE(test_EventSubMultiplexer_mergeParams)
+{
+    auto p0 = std::make_shared<EventSubParams>();
+    p0->setFromBlock(10);
+    p0->addAddress("0xaa");
+    p0->addTopic(0, "0x01");
+    p0->addTopic(1, "0x02");
+
+    auto p1 = std::make_shared<EventSubParams>();
+    p1->setFromBlock(10);
+    p1->addAddress("0xbb");
+    p1->addTopic(0, "0x03");
+
+    auto merged = EventSubMultiplexer::mergeParams({p0, p1});
+    BOOST_CHECK_EQUAL(merged->fromBlock(), 10);
+    BOOST_CHECK_EQUAL(merged->addresses().size(), 2);
+    // topic1 is the wildcard for p1
+    BOOST_CHECK_EQUAL(merged->topics().size(), 1);
+    BOOST_CHECK_EQUAL(merged->topics()[0].size(), 2);
+
+    BOOST_CHECK(EventSubMultiplexer::covers(*merged, *p0));
+    BOOST_CHECK(EventSubMultiplexer::covers(*merged, *p1));
+
+    auto p2 = std::make_shared<EventSubParams>();
+    p2->setFromBlock(10);
+    p2->addAddress("0xcc");
+    BOOST_CHECK(!EventSubMultiplexer::covers(*merged, *p2));
+
+    // all addresses
+    auto p3 = std::make_shared<EventSubParams>();
+    p3->setFromBlock(10);
+    p3->addTopic(0, "0x01");
+    BOOST_CHECK(!EventSubMultiplexer::covers(*merged, *p3));
+
+    // the equivalent forms are merged
+    auto p4 = std::make_shared<EventSubParams>();
+    p4->setFromBlock(10);
+    p4->addAddress("AA");
+    p4->addTopic(0, "0X01");
+    BOOST_CHECK(EventSubMultiplexer::covers(*merged, *p4));
+    auto mergedEquivalent = EventSubMultiplexer::mergeParams({p0, p4});
+    BOOST_CHECK_EQUAL(mergedEquivalent->addresses().size(), 1);
+    BOOST_CHECK_EQUAL(*mergedEquivalent->addresses().begin(), "0xaa");
+    BOOST_CHECK_EQUAL(mergedEquivalent->topics()[0].size(), 1);
+
+    merged = EventSubMultiplexer::mergeParams({p0, p1, p2, p3});
+    BOOST_CHECK(merged->addresses().empty());
+    BOOST_CHECK(merged->topics().empty());
+    for (const auto& p : {p0, p1, p2, p3})
+    {
+        BOOST_CHECK(EventSubMultiplexer::covers(*merged, *p));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
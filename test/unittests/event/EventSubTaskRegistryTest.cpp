@@ -0,0 +1,134 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for EventSubTaskRegistry
+ * @file EventSubTaskRegistryTest.cpp
+ * @author: octopus
+ * @date 2023-03-22
+ */
+#include <bcos-cpp-sdk/event/EventSubTaskRegistry.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::event;
+using namespace bcos::test;
+
+BOOST_FIXTURE_TEST_SUITE(EventSubTaskRegistryTest, TestPromptFixture)
+
+static EventSubTask::Ptr buildTask(const std::string& _id)
+{
+    auto task = std::make_shared<EventSubTask>();
+    task->setId(_id);
+    return task;
+}
+
+BOOST_AUTO_TEST_CASE(test_EventSubTaskRegistry_suspendTasks)
+{
+    EventSubTaskRegistry registry(4);
+    BOOST_CHECK_EQUAL(registry.shardCount(), 4);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        auto endPoint = (i % 2 == 0) ? "127.0.0.1:20200" : "127.0.0.1:20201";
+        BOOST_CHECK(registry.addTask(buildTask(std::to_string(i)), endPoint));
+    }
+    // no session
+    BOOST_CHECK(registry.addTask(buildTask("nosession")));
+    BOOST_CHECK(!registry.addTask(buildTask("nosession")));
+    BOOST_CHECK_EQUAL(registry.workingTasksCount(), 101);
+
+    auto tasks = registry.suspendTasks("127.0.0.1:20200");
+    BOOST_CHECK_EQUAL(tasks.size(), 51);
+    BOOST_CHECK_EQUAL(registry.workingTasksCount(), 50);
+    BOOST_CHECK_EQUAL(registry.suspendTasksCount(), 51);
+
+    BOOST_CHECK(!registry.getTask("0", false));
+    BOOST_CHECK(registry.getTask("0"));
+    BOOST_CHECK(registry.getTask("1", false));
+
+    // suspended already
+    tasks = registry.suspendTasks("127.0.0.1:20200");
+    BOOST_CHECK(tasks.empty());
+
+    // resubscribed on the other endpoint
+    BOOST_CHECK(registry.addTask(registry.getTask("0"), "127.0.0.1:20201"));
+    BOOST_CHECK_EQUAL(registry.suspendTasksCount(), 50);
+    BOOST_CHECK_EQUAL(registry.suspendTasksSnapshot(10).size(), 10);
+
+    tasks = registry.suspendTasks("127.0.0.1:20201");
+    BOOST_CHECK_EQUAL(tasks.size(), 51);
+    BOOST_CHECK_EQUAL(registry.workingTasksCount(), 0);
+    BOOST_CHECK_EQUAL(registry.suspendTasksCount(), 101);
+    BOOST_CHECK(registry.workingTasksSnapshot().empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_EventSubTaskRegistry_resubscribe)
+{
+    EventSubTaskRegistry registry;
+    auto task = buildTask("123");
+    BOOST_CHECK(registry.addTask(task, "127.0.0.1:20200"));
+
+    // resubscribed on the second endpoint while working
+    BOOST_CHECK(!registry.addTask(task, "127.0.0.1:20201"));
+    BOOST_CHECK_EQUAL(registry.workingTasksCount(), 1);
+
+    // the disconnect of the first endpoint leaves the task working
+    BOOST_CHECK(registry.suspendTasks("127.0.0.1:20200").empty());
+    BOOST_CHECK(registry.getTask("123", false));
+
+    // the disconnect of the second one suspends it
+    auto tasks = registry.suspendTasks("127.0.0.1:20201");
+    BOOST_CHECK_EQUAL(tasks.size(), 1);
+    BOOST_CHECK(!registry.getTask("123", false));
+    BOOST_CHECK_EQUAL(registry.suspendTasksCount(), 1);
+
+    // resubscribed back on the first endpoint
+    BOOST_CHECK(registry.addTask(task, "127.0.0.1:20200"));
+    BOOST_CHECK(!registry.addTask(task, "127.0.0.1:20200"));
+    BOOST_CHECK(registry.suspendTasks("127.0.0.1:20201").empty());
+    BOOST_CHECK_EQUAL(registry.suspendTasks("127.0.0.1:20200").size(), 1);
+    BOOST_CHECK_EQUAL(registry.workingTasksCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_EventSubTaskRegistry_remove)
+{
+    EventSubTaskRegistry registry;
+    auto task = buildTask("123");
+
+    BOOST_CHECK(registry.addTask(task, "127.0.0.1:20200"));
+    BOOST_CHECK(registry.suspendTask("123"));
+    BOOST_CHECK(!registry.suspendTask("123"));
+    BOOST_CHECK_EQUAL(registry.suspendTasksCount(), 1);
+
+    BOOST_CHECK(!registry.getTaskAndRemove("123", false));
+    BOOST_CHECK(registry.getTaskAndRemove("123"));
+    BOOST_CHECK(!registry.getTask("123"));
+    BOOST_CHECK_EQUAL(registry.suspendTasksCount(), 0);
+
+    // the removed task is not suspended by its endpoint
+    BOOST_CHECK(registry.addTask(task, "127.0.0.1:20200"));
+    BOOST_CHECK(registry.getTaskAndRemove("123"));
+    BOOST_CHECK(registry.suspendTasks("127.0.0.1:20200").empty());
+
+    BOOST_CHECK(registry.addWaitResp("123"));
+    BOOST_CHECK(!registry.addWaitResp("123"));
+    BOOST_CHECK(registry.removeWaitResp("123"));
+    BOOST_CHECK(!registry.removeWaitResp("123"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
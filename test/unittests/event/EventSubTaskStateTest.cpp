@@ -37,4 +37,31 @@ BOOST_AUTO_TEST_CASE(test_EventSubTaskStateTest)
     BOOST_CHECK_EQUAL(state->currentBlockNumber(), blockNumber);
 }
 
+BOOST_AUTO_TEST_CASE(test_EventSubTaskStateLogPosition)
+{
+    auto state = std::make_shared<bcos::cppsdk::event::EventSubTaskState>();
+    BOOST_CHECK(!state->hasLogPosition());
+
+    BOOST_CHECK(state->advanceLogPosition(10, 0, 0));
+    BOOST_CHECK(state->advanceLogPosition(10, 0, 1));
+    BOOST_CHECK(state->advanceLogPosition(10, 1, 0));
+    BOOST_CHECK(state->hasLogPosition());
+    BOOST_CHECK_EQUAL(state->currentBlockNumber(), 10);
+    BOOST_CHECK_EQUAL(state->currentTransactionIndex(), 1);
+    BOOST_CHECK_EQUAL(state->currentLogIndex(), 0);
+
+    // received already
+    BOOST_CHECK(!state->advanceLogPosition(10, 0, 1));
+    BOOST_CHECK(!state->advanceLogPosition(10, 1, 0));
+    BOOST_CHECK(!state->advanceLogPosition(9, 5, 5));
+
+    BOOST_CHECK(state->advanceLogPosition(11, 0, 0));
+    BOOST_CHECK_EQUAL(state->currentBlockNumber(), 11);
+
+    state->setLogPosition(20, 3, 4);
+    BOOST_CHECK_EQUAL(state->currentBlockNumber(), 20);
+    BOOST_CHECK(!state->advanceLogPosition(20, 3, 4));
+    BOOST_CHECK(state->advanceLogPosition(20, 3, 5));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,502 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file AMOPNodeFake.h
+ * @author: octopus
+ * @date 2023-04-04
+ */
+#pragma once
+#include "WsServiceFake.h"
+#include "WsSessionFake.h"
+#include <bcos-boostssl/websocket/WsMessage.h>
+#include <bcos-cpp-sdk/amop/AMOP.h>
+#include <bcos-cpp-sdk/amop/AMOPRequest.h>
+#include <bcos-cpp-sdk/amop/Common.h>
+#include <bcos-cpp-sdk/amop/TopicManager.h>
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/ThreadPool.h>
+#include <json/json.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos
+{
+namespace cppsdk
+{
+namespace test
+{
+class AMOPNodeFake;
+
+// the connection of the client to the node, the messages sent are routed by the node
+class AMOPSessionFake : public WsSessionFake
+{
+public:
+    using Ptr = std::shared_ptr<AMOPSessionFake>;
+    AMOPSessionFake(std::weak_ptr<AMOPNodeFake> _node, std::string _clientEndPoint,
+        const std::string& _nodeEndPoint)
+      : WsSessionFake("AMOPSessionFake"),
+        m_node(std::move(_node)),
+        m_clientEndPoint(std::move(_clientEndPoint))
+    {
+        setEndPoint(_nodeEndPoint);
+    }
+
+public:
+    void asyncSendMessage(std::shared_ptr<bcos::boostssl::MessageFace> _msg,
+        bcos::boostssl::ws::Options _options = bcos::boostssl::ws::Options(-1),
+        bcos::boostssl::ws::RespCallBack _respCallback =
+            bcos::boostssl::ws::RespCallBack()) override;
+
+    const std::string& clientEndPoint() const { return m_clientEndPoint; }
+
+private:
+    std::weak_ptr<AMOPNodeFake> m_node;
+    std::string m_clientEndPoint;
+};
+
+// the websocket service of the client with one session to the node
+class AMOPServiceFake : public WsServiceFake
+{
+public:
+    using Ptr = std::shared_ptr<AMOPServiceFake>;
+    explicit AMOPServiceFake(AMOPSessionFake::Ptr _session) : m_session(std::move(_session))
+    {
+        setSession(m_session);
+    }
+
+public:
+    void asyncSendMessage(std::shared_ptr<bcos::boostssl::MessageFace> _msg,
+        bcos::boostssl::ws::Options _options = bcos::boostssl::ws::Options(-1),
+        bcos::boostssl::ws::RespCallBack _respFunc = bcos::boostssl::ws::RespCallBack()) override
+    {
+        m_session->asyncSendMessage(_msg, _options, _respFunc);
+    }
+
+    void asyncSendMessageByEndPoint(const std::string& _endPoint,
+        std::shared_ptr<bcos::boostssl::MessageFace> _msg,
+        bcos::boostssl::ws::Options _options = bcos::boostssl::ws::Options(-1),
+        bcos::boostssl::ws::RespCallBack _respFunc = bcos::boostssl::ws::RespCallBack()) override
+    {
+        (void)_endPoint;
+        m_session->asyncSendMessage(_msg, _options, _respFunc);
+    }
+
+    void broadcastMessage(std::shared_ptr<bcos::boostssl::MessageFace> _msg) override
+    {
+        m_session->asyncSendMessage(_msg);
+    }
+
+    bcos::boostssl::ws::WsSessions sessions() override { return {m_session}; }
+
+private:
+    AMOPSessionFake::Ptr m_session;
+};
+
+/**
+ * @brief the node routing the AMOP messages between the clients connected in process: the
+ * requests to one subscriber of the topic round robin, the broadcasts to all the subscribers and
+ * the responses back to the publisher. The messages to each client are delivered in order on its
+ * own thread as a websocket connection does. The AMOP_SUBTOPIC full sync and delta are applied as
+ * described in AMOPTopicSync.
+ */
+class AMOPNodeFake : public std::enable_shared_from_this<AMOPNodeFake>
+{
+public:
+    using Ptr = std::shared_ptr<AMOPNodeFake>;
+    // the status of the response when no subscriber of the topic
+    static constexpr int16_t NO_SUBSCRIBER = 100;
+
+    explicit AMOPNodeFake(std::string _endPoint = "127.0.0.1:20200")
+      : m_endPoint(std::move(_endPoint))
+    {}
+    ~AMOPNodeFake() { stop(); }
+
+public:
+    // the amop client connected to the node, synced its topics as the handshake does
+    bcos::cppsdk::amop::AMOP::Ptr connect(const std::string& _clientEndPoint)
+    {
+        auto session =
+            std::make_shared<AMOPSessionFake>(weak_from_this(), _clientEndPoint, m_endPoint);
+        auto service = std::make_shared<AMOPServiceFake>(session);
+
+        auto amop = std::make_shared<bcos::cppsdk::amop::AMOP>();
+        amop->setTopicManager(std::make_shared<bcos::cppsdk::amop::TopicManager>());
+        amop->setRequestFactory(std::make_shared<bcos::protocol::AMOPRequestFactory>());
+        amop->setMessageFactory(std::make_shared<bcos::boostssl::ws::WsMessageFactory>());
+        amop->setService(service);
+
+        auto client = std::make_shared<Client>();
+        client->endPoint = _clientEndPoint;
+        client->amop = amop;
+        client->session = session;
+        client->worker = std::make_shared<bcos::ThreadPool>("fakeNode", 1);
+        {
+            std::lock_guard<std::mutex> lock(x_clients);
+            m_clients[_clientEndPoint] = client;
+        }
+
+        amop->updateTopicsToRemote(session);
+        return amop;
+    }
+
+    void disconnect(const std::string& _clientEndPoint)
+    {
+        std::shared_ptr<Client> client;
+        {
+            std::lock_guard<std::mutex> lock(x_clients);
+            auto it = m_clients.find(_clientEndPoint);
+            if (it == m_clients.end())
+            {
+                return;
+            }
+            client = it->second;
+            m_clients.erase(it);
+        }
+        auto amop = client->amop.lock();
+        if (amop)
+        {
+            amop->onDisconnect(client->session);
+        }
+    }
+
+    void stop()
+    {
+        std::unordered_map<std::string, std::shared_ptr<Client>> clients;
+        {
+            std::lock_guard<std::mutex> lock(x_clients);
+            clients.swap(m_clients);
+        }
+        for (auto& [endPoint, client] : clients)
+        {
+            client->worker->stop();
+        }
+    }
+
+    std::set<std::string> topics(const std::string& _clientEndPoint) const
+    {
+        std::lock_guard<std::mutex> lock(x_clients);
+        auto it = m_clients.find(_clientEndPoint);
+        return it != m_clients.end() ? it->second->topics : std::set<std::string>();
+    }
+
+    uint64_t topicVersion(const std::string& _clientEndPoint) const
+    {
+        std::lock_guard<std::mutex> lock(x_clients);
+        auto it = m_clients.find(_clientEndPoint);
+        return it != m_clients.end() ? it->second->version : 0;
+    }
+
+    // wait until _done holds, checked every time a message delivered to the clients
+    bool waitFor(std::function<bool()> _done,
+        std::chrono::milliseconds _timeout = std::chrono::milliseconds(10000))
+    {
+        std::unique_lock<std::mutex> lock(x_delivered);
+        return m_delivered.wait_for(lock, _timeout, std::move(_done));
+    }
+
+    uint64_t routed() const { return m_routed.load(); }
+    std::size_t pending() const
+    {
+        std::lock_guard<std::mutex> lock(x_clients);
+        return m_pending.size();
+    }
+
+    // the message sent by the client
+    void onMessage(const std::string& _clientEndPoint,
+        std::shared_ptr<bcos::boostssl::MessageFace> _msg,
+        bcos::boostssl::ws::RespCallBack _respFunc)
+    {
+        switch (_msg->packetType())
+        {
+        case bcos::cppsdk::amop::MessageType::AMOP_SUBTOPIC:
+            onSubTopic(_clientEndPoint, _msg, _respFunc);
+            break;
+        case bcos::cppsdk::amop::MessageType::AMOP_REQUEST:
+            onRequest(_clientEndPoint, _msg, _respFunc);
+            break;
+        case bcos::cppsdk::amop::MessageType::AMOP_RESPONSE:
+            onResponse(_msg);
+            break;
+        case bcos::cppsdk::amop::MessageType::AMOP_BROADCAST:
+            onBroadcast(_msg);
+            break;
+        default:
+            break;
+        }
+    }
+
+private:
+    struct Client
+    {
+        std::string endPoint;
+        std::weak_ptr<bcos::cppsdk::amop::AMOP> amop;
+        AMOPSessionFake::Ptr session;
+        std::shared_ptr<bcos::ThreadPool> worker;
+        std::set<std::string> topics;
+        uint64_t version = 0;
+    };
+
+    struct Pending
+    {
+        std::shared_ptr<Client> publisher;
+        bcos::boostssl::ws::RespCallBack respFunc;
+    };
+
+    std::shared_ptr<Client> client(const std::string& _clientEndPoint) const
+    {
+        auto it = m_clients.find(_clientEndPoint);
+        return it != m_clients.end() ? it->second : nullptr;
+    }
+
+    static std::string topicOf(std::shared_ptr<bcos::boostssl::MessageFace> _msg)
+    {
+        bcos::protocol::AMOPRequest request;
+        if (request.decode(bcos::bytesConstRef(_msg->payload()->data(), _msg->payload()->size())) <
+            0)
+        {
+            return std::string();
+        }
+        return request.topic();
+    }
+
+    // run on the thread of the client, the waiters are notified after that
+    void deliver(std::shared_ptr<Client> _client, std::function<void()> _task)
+    {
+        std::weak_ptr<AMOPNodeFake> weakNode = weak_from_this();
+        _client->worker->enqueue([weakNode, _task]() {
+            _task();
+            auto node = weakNode.lock();
+            if (node)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(node->x_delivered);
+                }
+                node->m_delivered.notify_all();
+            }
+        });
+    }
+
+    void respond(std::shared_ptr<Client> _client, bcos::boostssl::ws::RespCallBack _respFunc,
+        std::shared_ptr<bcos::boostssl::ws::WsMessage> _resp)
+    {
+        deliver(_client, [_client, _respFunc, _resp]() {
+            _respFunc(nullptr, _resp, _client->session);
+        });
+    }
+
+    void onSubTopic(const std::string& _clientEndPoint,
+        std::shared_ptr<bcos::boostssl::MessageFace> _msg,
+        bcos::boostssl::ws::RespCallBack _respFunc)
+    {
+        Json::Value root;
+        Json::Reader reader;
+        if (!reader.parse(std::string(_msg->payload()->begin(), _msg->payload()->end()), root))
+        {
+            return;
+        }
+
+        std::shared_ptr<Client> target;
+        uint64_t version = 0;
+        {
+            std::lock_guard<std::mutex> lock(x_clients);
+            target = client(_clientEndPoint);
+            if (!target)
+            {
+                return;
+            }
+            if (root.isMember("topics"))
+            {
+                target->topics.clear();
+                for (const auto& topic : root["topics"])
+                {
+                    target->topics.insert(topic.asString());
+                }
+                target->version = root.get("version", 0).asUInt64();
+            }
+            else if (root["baseVersion"].asUInt64() == target->version)
+            {
+                for (const auto& topic : root["add"])
+                {
+                    target->topics.insert(topic.asString());
+                }
+                for (const auto& topic : root["remove"])
+                {
+                    target->topics.erase(topic.asString());
+                }
+                target->version = root["version"].asUInt64();
+            }
+            version = target->version;
+        }
+
+        if (_respFunc)
+        {
+            Json::Value jResp;
+            jResp["version"] = (Json::UInt64)version;
+            auto strResp = Json::FastWriter().write(jResp);
+            auto resp = std::make_shared<bcos::boostssl::ws::WsMessage>();
+            resp->setSeq(_msg->seq());
+            resp->setPacketType(bcos::cppsdk::amop::MessageType::AMOP_SUBTOPIC);
+            resp->setPayload(std::make_shared<bcos::bytes>(strResp.begin(), strResp.end()));
+            respond(target, _respFunc, resp);
+        }
+    }
+
+    void onRequest(const std::string& _clientEndPoint,
+        std::shared_ptr<bcos::boostssl::MessageFace> _msg,
+        bcos::boostssl::ws::RespCallBack _respFunc)
+    {
+        auto topic = topicOf(_msg);
+        std::shared_ptr<Client> publisher;
+        std::shared_ptr<Client> subscriber;
+        {
+            std::lock_guard<std::mutex> lock(x_clients);
+            publisher = client(_clientEndPoint);
+            if (!publisher)
+            {
+                return;
+            }
+            std::vector<std::shared_ptr<Client>> subscribers;
+            for (const auto& [endPoint, c] : m_clients)
+            {
+                if (c->topics.count(topic))
+                {
+                    subscribers.push_back(c);
+                }
+            }
+            if (!subscribers.empty())
+            {
+                subscriber = subscribers[m_roundRobin++ % subscribers.size()];
+                if (_respFunc)
+                {
+                    m_pending[_msg->seq()] = Pending{publisher, _respFunc};
+                }
+            }
+        }
+
+        if (!subscriber)
+        {
+            if (_respFunc)
+            {
+                std::string error = "no subscriber of the topic: " + topic;
+                auto resp = std::make_shared<bcos::boostssl::ws::WsMessage>();
+                resp->setSeq(_msg->seq());
+                resp->setStatus(NO_SUBSCRIBER);
+                resp->setPacketType(bcos::cppsdk::amop::MessageType::AMOP_RESPONSE);
+                resp->setPayload(std::make_shared<bcos::bytes>(error.begin(), error.end()));
+                respond(publisher, _respFunc, resp);
+            }
+            return;
+        }
+
+        m_routed++;
+        deliver(subscriber, [subscriber, _msg]() {
+            auto amop = subscriber->amop.lock();
+            if (amop)
+            {
+                amop->onRecvAMOPRequest(_msg, subscriber->session);
+            }
+        });
+    }
+
+    void onResponse(std::shared_ptr<bcos::boostssl::MessageFace> _msg)
+    {
+        Pending pending;
+        {
+            std::lock_guard<std::mutex> lock(x_clients);
+            auto it = m_pending.find(_msg->seq());
+            if (it == m_pending.end())
+            {
+                return;
+            }
+            pending = std::move(it->second);
+            m_pending.erase(it);
+        }
+
+        auto resp = std::dynamic_pointer_cast<bcos::boostssl::ws::WsMessage>(_msg);
+        if (!resp)
+        {
+            resp = std::make_shared<bcos::boostssl::ws::WsMessage>();
+            resp->setSeq(_msg->seq());
+            resp->setPacketType(_msg->packetType());
+            resp->setPayload(_msg->payload());
+        }
+        respond(pending.publisher, pending.respFunc, resp);
+    }
+
+    void onBroadcast(std::shared_ptr<bcos::boostssl::MessageFace> _msg)
+    {
+        auto topic = topicOf(_msg);
+        std::vector<std::shared_ptr<Client>> subscribers;
+        {
+            std::lock_guard<std::mutex> lock(x_clients);
+            for (const auto& [endPoint, c] : m_clients)
+            {
+                if (c->topics.count(topic))
+                {
+                    subscribers.push_back(c);
+                }
+            }
+        }
+
+        for (auto& subscriber : subscribers)
+        {
+            m_routed++;
+            deliver(subscriber, [subscriber, _msg]() {
+                auto amop = subscriber->amop.lock();
+                if (amop)
+                {
+                    amop->onRecvAMOPBroadcast(_msg, subscriber->session);
+                }
+            });
+        }
+    }
+
+private:
+    std::string m_endPoint;
+
+    mutable std::mutex x_clients;
+    std::unordered_map<std::string, std::shared_ptr<Client>> m_clients;
+    // seq => the publisher waiting for the response
+    std::unordered_map<std::string, Pending> m_pending;
+    uint64_t m_roundRobin = 0;
+
+    std::mutex x_delivered;
+    std::condition_variable m_delivered;
+
+    std::atomic<uint64_t> m_routed{0};
+};
+
+inline void AMOPSessionFake::asyncSendMessage(std::shared_ptr<bcos::boostssl::MessageFace> _msg,
+    bcos::boostssl::ws::Options _options, bcos::boostssl::ws::RespCallBack _respCallback)
+{
+    (void)_options;
+    auto node = m_node.lock();
+    if (node)
+    {
+        node->onMessage(m_clientEndPoint, _msg, _respCallback);
+    }
+}
+
+}  // namespace test
+}  // namespace cppsdk
+}  // namespace bcos
@@ -0,0 +1,288 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the pipelined asyncSendTransaction
+ * @file JsonRpcServiceImplTest.cpp
+ * @author: octopus
+ * @date 2023-04-10
+ */
+#include <bcos-cpp-sdk/multigroup/JsonGroupInfoCodec.h>
+#include <bcos-cpp-sdk/rpc/JsonRpcServiceImpl.h>
+#include <bcos-cpp-sdk/utilities/crypto/KeyPairBuilder.h>
+#include <bcos-cpp-sdk/utilities/tx/TransactionBuilder.h>
+#include <bcos-cpp-sdk/ws/Service.h>
+#include <bcos-framework/interfaces/multigroup/GroupInfoFactory.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::jsonrpc;
+using namespace bcos::cppsdk::utilities;
+using namespace bcos::test;
+
+namespace
+{
+// the transactions sent are kept and responded by the test
+class FakeJsonRpc : public JsonRpcImpl
+{
+public:
+    struct Sent
+    {
+        std::string data;
+        RespFunc respFunc;
+    };
+
+    FakeJsonRpc() : JsonRpcImpl(std::make_shared<bcos::group::JsonGroupInfoCodec>()) {}
+
+    void sendTransaction(const std::string&, const std::string&, const std::string& _data, bool,
+        RespFunc _respFunc) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(x_sent);
+            m_sent.push_back(Sent{_data, std::move(_respFunc)});
+        }
+        m_cv.notify_all();
+    }
+
+    bool waitSent(std::size_t _count)
+    {
+        std::unique_lock<std::mutex> lock(x_sent);
+        return m_cv.wait_for(lock, std::chrono::seconds(10),
+            [this, _count]() { return m_sent.size() >= _count; });
+    }
+
+    std::vector<std::string> sentData()
+    {
+        std::lock_guard<std::mutex> lock(x_sent);
+        std::vector<std::string> data;
+        for (const auto& sent : m_sent)
+        {
+            data.push_back(sent.data);
+        }
+        return data;
+    }
+
+    void respond(std::size_t _index, bcos::Error::Ptr _error = nullptr)
+    {
+        RespFunc respFunc;
+        {
+            std::lock_guard<std::mutex> lock(x_sent);
+            respFunc = m_sent[_index].respFunc;
+        }
+        respFunc(std::move(_error), std::make_shared<bcos::bytes>());
+    }
+
+private:
+    std::mutex x_sent;
+    std::condition_variable m_cv;
+    std::vector<Sent> m_sent;
+};
+
+// the data is the signed transaction and its hash, the empty data fails to sign
+class FakeTransactionBuilder : public TransactionBuilder
+{
+public:
+    using TransactionBuilder::createSignedTransaction;
+
+    std::pair<std::string, std::string> createSignedTransaction(
+        const bcos::crypto::KeyPairInterface&, const std::string&, const std::string&,
+        const std::string&, const bcos::bytes& _data, const std::string&, int64_t, int32_t,
+        const std::string& = "") override
+    {
+        if (_data.empty())
+        {
+            throw std::runtime_error("sign failed");
+        }
+        auto data = std::string(_data.begin(), _data.end());
+        return {"hash-" + data, data};
+    }
+};
+
+struct AsyncSendFixture
+{
+    AsyncSendFixture()
+    {
+        auto service = std::make_shared<service::Service>(
+            std::make_shared<bcos::group::JsonGroupInfoCodec>(),
+            std::make_shared<bcos::group::GroupInfoFactory>(), "SDK");
+        service->updateGroupInfo(
+            "127.0.0.1:20200", std::make_shared<bcos::group::GroupInfo>("chain0", "group0"));
+        rpc = std::make_shared<FakeJsonRpc>();
+        rpc->setService(service);
+        rpcService =
+            std::make_shared<JsonRpcServiceImpl>(rpc, std::make_shared<FakeTransactionBuilder>());
+        keyPair = KeyPairBuilder().genKeyPair(CryptoType::Secp256K1);
+    }
+
+    std::future<std::string> send(const std::string& _data,
+        std::function<void(bcos::Error::Ptr)> _onResp = std::function<void(bcos::Error::Ptr)>())
+    {
+        return rpcService->asyncSendTransaction(keyPair, "group0", "", "0x01",
+            bcos::bytes(_data.begin(), _data.end()), "", 0, "",
+            [_onResp](bcos::Error::Ptr _error, std::shared_ptr<bcos::bytes>) {
+                if (_onResp)
+                {
+                    _onResp(std::move(_error));
+                }
+            });
+    }
+
+    void setAsyncSettings(std::size_t _maxInFlight, std::size_t _maxQueued = 100000)
+    {
+        JsonRpcServiceImpl::AsyncSettings settings;
+        settings.signThreadCount = 1;
+        settings.maxInFlight = _maxInFlight;
+        settings.maxQueued = _maxQueued;
+        rpcService->setAsyncSettings(settings);
+    }
+
+    std::shared_ptr<FakeJsonRpc> rpc;
+    JsonRpcServiceImpl::Ptr rpcService;
+    std::shared_ptr<bcos::crypto::KeyPairInterface> keyPair;
+};
+
+template <typename T>
+bool ready(std::future<T>& _future)
+{
+    return _future.wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(JsonRpcServiceImplTest, TestPromptFixture)
+
+BOOST_FIXTURE_TEST_CASE(test_asyncSendTransaction_inFlight, AsyncSendFixture)
+{
+    setAsyncSettings(2);
+
+    std::vector<std::future<std::string>> futures;
+    for (int i = 0; i < 5; ++i)
+    {
+        futures.push_back(send("tx" + std::to_string(i)));
+    }
+    // the caller is not blocked, the ones beyond maxInFlight are queued
+    BOOST_CHECK(rpc->waitSent(2));
+    BOOST_CHECK(ready(futures[1]));
+    BOOST_CHECK_EQUAL(rpc->sentData().size(), 2);
+    BOOST_CHECK_EQUAL(rpcService->inFlight(), 2);
+    BOOST_CHECK_EQUAL(rpcService->queued(), 3);
+
+    // signed and sent in order as the slots released
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        rpc->respond(i);
+        BOOST_CHECK(rpc->waitSent(i + 3));
+    }
+    BOOST_CHECK(rpc->sentData() == std::vector<std::string>({"tx0", "tx1", "tx2", "tx3", "tx4"}));
+    for (int i = 0; i < 5; ++i)
+    {
+        BOOST_CHECK(ready(futures[i]));
+        BOOST_CHECK_EQUAL(futures[i].get(), "hash-tx" + std::to_string(i));
+    }
+    rpc->respond(3);
+    rpc->respond(4);
+    BOOST_CHECK_EQUAL(rpcService->inFlight(), 0);
+    BOOST_CHECK_EQUAL(rpcService->queued(), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_asyncSendTransaction_error, AsyncSendFixture)
+{
+    setAsyncSettings(1, 1);
+
+    // the signing failure
+    std::promise<bcos::Error::Ptr> signError;
+    auto signErrorFuture = signError.get_future();
+    auto failed = send("", [&signError](bcos::Error::Ptr _error) { signError.set_value(_error); });
+    BOOST_CHECK(ready(failed));
+    BOOST_CHECK_THROW(failed.get(), std::runtime_error);
+    BOOST_CHECK(ready(signErrorFuture));
+    BOOST_CHECK(signErrorFuture.get() != nullptr);
+
+    // the error of the node
+    std::promise<bcos::Error::Ptr> nodeError;
+    auto nodeErrorFuture = nodeError.get_future();
+    auto sent = send("tx0", [&nodeError](bcos::Error::Ptr _error) { nodeError.set_value(_error); });
+    BOOST_CHECK(rpc->waitSent(1));
+    BOOST_CHECK_EQUAL(rpcService->inFlight(), 1);
+
+    // the pipeline full beyond maxQueued, responded at once
+    auto queued = send("tx1");
+    bcos::Error::Ptr fullError;
+    auto full = send("tx2", [&fullError](bcos::Error::Ptr _error) { fullError = _error; });
+    BOOST_CHECK(fullError != nullptr);
+    BOOST_CHECK(ready(full));
+    BOOST_CHECK_EQUAL(full.get(), "");
+
+    rpc->respond(0, std::make_shared<Error>(-1, "node error"));
+    BOOST_CHECK(ready(nodeErrorFuture));
+    auto error = nodeErrorFuture.get();
+    BOOST_CHECK(error && error->errorMessage() == "node error");
+    BOOST_CHECK(rpc->waitSent(2));
+    BOOST_CHECK_EQUAL(queued.get(), "hash-tx1");
+
+    // the group not exist
+    bcos::Error::Ptr groupError;
+    auto noGroup = rpcService->asyncSendTransaction(keyPair, "group1", "", "0x01",
+        bcos::bytes{1}, "", 0, "",
+        [&groupError](bcos::Error::Ptr _error, std::shared_ptr<bcos::bytes>) {
+            groupError = _error;
+        });
+    BOOST_CHECK(groupError != nullptr);
+    BOOST_CHECK_EQUAL(noGroup.get(), "");
+}
+
+BOOST_FIXTURE_TEST_CASE(test_asyncSendTransaction_destroy, AsyncSendFixture)
+{
+    setAsyncSettings(1);
+
+    std::promise<bcos::Error::Ptr> sentResp;
+    auto sentRespFuture = sentResp.get_future();
+    auto sent = send("tx0", [&sentResp](bcos::Error::Ptr _error) { sentResp.set_value(_error); });
+    BOOST_CHECK(rpc->waitSent(1));
+
+    std::vector<std::future<std::string>> futures;
+    std::vector<bcos::Error::Ptr> errors(2);
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        futures.push_back(send("queued" + std::to_string(i),
+            [&errors, i](bcos::Error::Ptr _error) { errors[i] = _error; }));
+    }
+    BOOST_CHECK_EQUAL(rpcService->queued(), 2);
+
+    // the queued ones fail with the error, the one sent is still responded
+    rpcService.reset();
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        BOOST_CHECK(errors[i] != nullptr);
+        BOOST_CHECK(ready(futures[i]));
+        BOOST_CHECK_EQUAL(futures[i].get(), "");
+    }
+    BOOST_CHECK_EQUAL(rpc->sentData().size(), 1);
+    BOOST_CHECK_EQUAL(sent.get(), "hash-tx0");
+
+    rpc->respond(0);
+    BOOST_CHECK(ready(sentRespFuture));
+    BOOST_CHECK(sentRespFuture.get() == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -17,10 +17,20 @@
  * @author: yujiechen
  * @date 2022-05-31
  */
+#include <bcos-cpp-sdk/utilities/crypto/KeyPairBuilder.h>
 #include <bcos-cpp-sdk/utilities/receipt/ReceiptBuilder.h>
+#include <bcos-cpp-sdk/utilities/receipt/ReceiptView.h>
+#include <bcos-cpp-sdk/utilities/tx/PreparedTransaction.h>
+#include <bcos-cpp-sdk/utilities/tx/PresignedTxPool.h>
 #include <bcos-cpp-sdk/utilities/tx/TransactionBuilder.h>
+#include <bcos-cpp-sdk/utilities/tx/TransactionView.h>
 #include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
 #include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
 
 using namespace bcostars;
 using namespace bcos;
@@ -71,6 +81,295 @@ BOOST_AUTO_TEST_CASE(test_transaction)
     BOOST_CHECK_EQUAL(hash3, "0359a5588c5e9c9dcfd2f4ece850d6f4c41bc88e2c27cc051890f26ef0ef118f");
 }
 
+BOOST_AUTO_TEST_CASE(test_transaction_batch)
+{
+    auto txBuilder = std::make_unique<TransactionBuilder>();
+    auto keyPairBuilder = std::make_unique<KeyPairBuilder>();
+    auto ecdsaKeyPair = keyPairBuilder->genKeyPair(CryptoType::Secp256K1);
+    auto smKeyPair = keyPairBuilder->genKeyPair(CryptoType::SM2);
+
+    const std::size_t count = 100;
+    std::vector<TransactionSpec> specs(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto& spec = specs[i];
+        spec.keyPair = (i % 2 == 0) ? ecdsaKeyPair.get() : smKeyPair.get();
+        spec.groupID = "group0";
+        spec.chainID = "chain0";
+        spec.to = "0x6849f21d1e455e9f0712b1e99fa4fcd23758e8f1";
+        spec.input = bcos::bytes(i + 1, (bcos::byte)i);
+        spec.blockLimit = 501 + i;
+        spec.attribute = i;
+        spec.extraData = "extra" + std::to_string(i);
+    }
+
+    for (auto threadCount : {1, 4})
+    {
+        auto results = txBuilder->createSignedTransactions(specs, threadCount);
+        BOOST_CHECK_EQUAL(results.size(), count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto txBytes = fromHex(results[i].second);
+            tars::TarsInputStream<tars::BufferReader> inputStream;
+            inputStream.setBuffer((const char*)txBytes.data(), txBytes.size());
+            Transaction tx;
+            tx.readFrom(inputStream);
+
+            BOOST_CHECK_EQUAL(tx.data.blockLimit, specs[i].blockLimit);
+            BOOST_CHECK(bcos::bytes(tx.data.input.begin(), tx.data.input.end()) == specs[i].input);
+            BOOST_CHECK_EQUAL(tx.attribute, specs[i].attribute);
+            BOOST_CHECK_EQUAL(tx.extraData, specs[i].extraData);
+
+            auto& cryptoSuite =
+                (i % 2 == 0) ? txBuilder->ecdsaCryptoSuite() : txBuilder->smCryptoSuite();
+            auto hash = tx.data.hash(cryptoSuite->hashImpl());
+            BOOST_CHECK_EQUAL(toHexStringWithPrefix(hash), results[i].first);
+            BOOST_CHECK(bcos::bytes(tx.dataHash.begin(), tx.dataHash.end()) ==
+                        bcos::bytes(hash.begin(), hash.end()));
+            BOOST_CHECK(cryptoSuite->signatureImpl()->verify(specs[i].keyPair->publicKey(), hash,
+                bcos::bytesConstRef((const bcos::byte*)tx.signature.data(), tx.signature.size())));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_prepared_transaction)
+{
+    auto txBuilder = std::make_shared<TransactionBuilder>();
+    auto keyPairBuilder = std::make_unique<KeyPairBuilder>();
+
+    for (auto cryptoType : {CryptoType::Secp256K1, CryptoType::SM2})
+    {
+        auto keyPair = keyPairBuilder->genKeyPair(cryptoType);
+        auto& cryptoSuite = (cryptoType == CryptoType::SM2) ? txBuilder->smCryptoSuite() :
+                                                              txBuilder->ecdsaCryptoSuite();
+        // the optional fields set and unset
+        std::vector<PreparedTransaction> prepareds{
+            PreparedTransaction(txBuilder, cryptoType, "group0", "chain0",
+                "0x6849f21d1e455e9f0712b1e99fa4fcd23758e8f1", "[]", 1, "extra"),
+            PreparedTransaction(txBuilder, cryptoType, "group0", "chain0", "", "")};
+        for (const auto& prepared : prepareds)
+        {
+            for (std::size_t i = 0; i < 10; ++i)
+            {
+                bcos::bytes input(i * 100, (bcos::byte)i);
+                int64_t blockLimit = 501 + (int64_t)i * 1000000000;
+                auto nonce = TransactionBuilder::generateRandomStr();
+
+                auto txData = prepared.createTransactionData(bcos::ref(input), blockLimit, nonce);
+                auto expectedHash = txData->hash(cryptoSuite->hashImpl());
+                auto hash = prepared.hash(bcos::ref(input), blockLimit, nonce);
+                BOOST_CHECK_EQUAL(hash.hex(), expectedHash.hex());
+
+                auto signData = txBuilder->signTransactionDataHash(*keyPair, hash);
+                auto expectedTx = txBuilder->createSignedTransaction(
+                    *txData, *signData, hash, prepared.attribute(), prepared.extraData());
+                tars::TarsOutputStream<tars::BufferWriter> output;
+                prepared.encode(output, bcos::ref(input), blockLimit, nonce, hash,
+                    bcos::ref(*signData));
+                BOOST_CHECK(bcos::bytes(output.getBuffer(),
+                                output.getBuffer() + output.getLength()) == *expectedTx);
+            }
+
+            bcos::bytes input(32, 0x1f);
+            auto result = prepared.createSignedTransaction(*keyPair, bcos::ref(input), 501);
+            auto txBytes = fromHex(result.second);
+            tars::TarsInputStream<tars::BufferReader> inputStream;
+            inputStream.setBuffer((const char*)txBytes.data(), txBytes.size());
+            Transaction tx;
+            tx.readFrom(inputStream);
+            BOOST_CHECK(bcos::bytes(tx.dataHash.begin(), tx.dataHash.end()) ==
+                        fromHex(result.first));
+            BOOST_CHECK_EQUAL(tx.data.to, prepared.to());
+            BOOST_CHECK_EQUAL(tx.data.abi, prepared.abi());
+            BOOST_CHECK_EQUAL(tx.extraData, prepared.extraData());
+            BOOST_CHECK_EQUAL(tx.data.hash(cryptoSuite->hashImpl()).hex(),
+                prepared.hash(bcos::ref(input), 501, tx.data.nonce).hex());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_nonce)
+{
+    const int threadCount = 4;
+    const int count = 10000;
+    std::vector<std::vector<std::string>> nonces(threadCount);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back([&nonces, i]() {
+            for (int j = 0; j < count; ++j)
+            {
+                nonces[i].push_back(TransactionBuilder::generateRandomStr());
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::set<std::string> uniqueNonces;
+    for (const auto& threadNonces : nonces)
+    {
+        for (const auto& nonce : threadNonces)
+        {
+            BOOST_CHECK(std::all_of(nonce.begin(), nonce.end(), ::isdigit));
+            uniqueNonces.insert(nonce);
+        }
+    }
+    BOOST_CHECK_EQUAL(uniqueNonces.size(), threadCount * count);
+}
+
+BOOST_AUTO_TEST_CASE(test_pooled_encode)
+{
+    auto txBuilder = std::make_unique<TransactionBuilder>();
+    auto& pool = txBuilder->bytesPool();
+    for (std::size_t inputSize : {0, 10, 1000, 100000})
+    {
+        auto txData = txBuilder->createTransactionData("group0", "chain0",
+            "0x6849f21d1e455e9f0712b1e99fa4fcd23758e8f1", bcos::bytes(inputSize, 0x11), "[]", 501);
+        auto tx = txBuilder->createTransaction(
+            *txData, bcos::bytes(65, 0x22), HashType(), (int32_t)inputSize, "extra");
+
+        tars::TarsOutputStream<tars::BufferWriter> expected;
+        tx->writeTo(expected);
+        auto encoded = txBuilder->encodeTransaction(*tx);
+        BOOST_CHECK(*encoded ==
+                    bcos::bytes(expected.getBuffer(), expected.getBuffer() + expected.getLength()));
+
+        tars::TarsOutputStream<tars::BufferWriter> expectedData;
+        txData->writeTo(expectedData);
+        auto encodedData = txBuilder->encodeTransactionData(*txData);
+        BOOST_CHECK(*encodedData == bcos::bytes(expectedData.getBuffer(),
+                                        expectedData.getBuffer() + expectedData.getLength()));
+    }
+
+    // the released buffers are reused
+    BOOST_CHECK_EQUAL(pool->size(), 2);
+    auto reused = pool->reused();
+    auto encoded = txBuilder->encodeTransaction(Transaction());
+    BOOST_CHECK_EQUAL(pool->reused(), reused + 1);
+    BOOST_CHECK_EQUAL(pool->size(), 1);
+    encoded.reset();
+    BOOST_CHECK_EQUAL(pool->size(), 2);
+
+    // the buffers outlive the pool
+    encoded = txBuilder->encodeTransaction(Transaction());
+    txBuilder.reset();
+    BOOST_CHECK(!encoded->empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_bytes_pool_bounded)
+{
+    auto pool = std::make_shared<BytesPool>(4, 1000, 2500);
+
+    // too large to recycle
+    bcos::bytes large;
+    large.reserve(1001);
+    pool->release(std::move(large));
+    BOOST_CHECK_EQUAL(pool->size(), 0);
+
+    // the capacity retained is bounded
+    for (int i = 0; i < 4; ++i)
+    {
+        bcos::bytes buffer;
+        buffer.reserve(1000);
+        pool->release(std::move(buffer));
+    }
+    BOOST_CHECK_EQUAL(pool->size(), 2);
+    BOOST_CHECK_EQUAL(pool->retainedBytes(), 2000);
+
+    // the count is bounded
+    for (int i = 0; i < 4; ++i)
+    {
+        bcos::bytes buffer;
+        buffer.reserve(10);
+        pool->release(std::move(buffer));
+    }
+    BOOST_CHECK_EQUAL(pool->size(), 4);
+    BOOST_CHECK_EQUAL(pool->retainedBytes(), 2020);
+
+    auto buffer = pool->acquire();
+    BOOST_CHECK_EQUAL(pool->retainedBytes(), 2010);
+    BOOST_CHECK_EQUAL(pool->reused(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_presigned_tx_pool)
+{
+    auto txBuilder = std::make_shared<TransactionBuilder>();
+    auto keyPairBuilder = std::make_unique<KeyPairBuilder>();
+    KeyPairInterface::Ptr keyPair = keyPairBuilder->genKeyPair(CryptoType::Secp256K1);
+    auto prepared = std::make_shared<PreparedTransaction>(txBuilder, CryptoType::Secp256K1,
+        "group0", "chain0", "0x6849f21d1e455e9f0712b1e99fa4fcd23758e8f1", "");
+    bcos::bytes input(100, 0x33);
+
+    std::atomic<int64_t> blockNumber{0};
+    PresignedTxPool::Settings settings;
+    settings.depth = 8;
+    settings.refreshBlocks = 100;
+    auto pool = std::make_shared<PresignedTxPool>(settings, [&blockNumber](int64_t& _blockLimit) {
+        _blockLimit = blockNumber + 500;
+        return true;
+    });
+    auto waitForDepth = [&pool](std::size_t _id, std::size_t _depth) {
+        return pool->waitForDepth(_id, _depth, std::chrono::seconds(10));
+    };
+    auto decode = [](const PresignedTxPool::SignedTransaction& _signed) {
+        auto txBytes = fromHex(_signed.second);
+        tars::TarsInputStream<tars::BufferReader> inputStream;
+        inputStream.setBuffer((const char*)txBytes.data(), txBytes.size());
+        Transaction tx;
+        tx.readFrom(inputStream);
+        BOOST_CHECK(bcos::bytes(tx.dataHash.begin(), tx.dataHash.end()) == fromHex(_signed.first));
+        return tx;
+    };
+
+    // not signed before start
+    auto id = pool->addEntry(keyPair, prepared, input);
+    PresignedTxPool::SignedTransaction signedTx;
+    BOOST_CHECK(!pool->tryPop(id, signedTx));
+
+    pool->start();
+    BOOST_CHECK(waitForDepth(id, settings.depth));
+    std::set<std::string> hashes;
+    for (std::size_t i = 0; i < settings.depth; ++i)
+    {
+        BOOST_CHECK(pool->tryPop(id, signedTx));
+        auto tx = decode(signedTx);
+        BOOST_CHECK_EQUAL(tx.data.blockLimit, 500);
+        BOOST_CHECK(bcos::bytes(tx.data.input.begin(), tx.data.input.end()) == input);
+        hashes.insert(signedTx.first);
+    }
+    BOOST_CHECK_EQUAL(hashes.size(), settings.depth);
+    BOOST_CHECK(waitForDepth(id, settings.depth));
+
+    // close to expiry, re-signed with the new block limit
+    blockNumber = 450;
+    pool->onBlockNumber(450);
+    BOOST_CHECK_EQUAL(pool->metrics().lastRefreshed, settings.depth);
+    BOOST_CHECK(waitForDepth(id, settings.depth));
+    BOOST_CHECK_EQUAL(decode(pool->pop(id)).data.blockLimit, 950);
+    BOOST_CHECK(waitForDepth(id, settings.depth));
+    pool->onBlockNumber(460);
+    BOOST_CHECK_EQUAL(pool->metrics().lastRefreshed, 0);
+    BOOST_CHECK_EQUAL(pool->depth(id), settings.depth);
+
+    // signed on the calling thread if none ready
+    pool->stop();
+    while (pool->tryPop(id, signedTx))
+    {
+    }
+    BOOST_CHECK_EQUAL(decode(pool->pop(id)).data.blockLimit, 950);
+    auto metrics = pool->metrics();
+    BOOST_CHECK_EQUAL(metrics.depth, 0);
+    BOOST_CHECK_EQUAL(metrics.signedCount, settings.depth * 3 + 1);
+    BOOST_CHECK_EQUAL(metrics.refreshed, settings.depth);
+    BOOST_CHECK_EQUAL(metrics.hits, settings.depth * 2 + 1);
+    BOOST_CHECK_EQUAL(metrics.misses, 1);
+    BOOST_CHECK_EQUAL(metrics.blockNumber, 460);
+    BOOST_CHECK_THROW(pool->pop(id + 1), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_CASE(test_receipt)
 {
     auto receiptBuilder = std::make_unique<ReceiptBuilder>();
@@ -104,5 +403,152 @@ BOOST_AUTO_TEST_CASE(test_receipt)
     auto hash4 = newJsonReceipt->hash(cryptoSuite->hashImpl()).hex();
     BOOST_CHECK_EQUAL(hash4, "b59cfe6ef607b72a6bab515042e0882213d179bd421afba353e2259b2a6396e4");
 }
+
+BOOST_AUTO_TEST_CASE(test_json_stream)
+{
+    Transaction tx;
+    tx.data.version = 1;
+    tx.data.chainID = "chain0";
+    tx.data.groupID = "group\"0\\\n\x01/";
+    tx.data.blockLimit = -501;
+    tx.data.nonce = "123456";
+    tx.data.to = "0x6849f21d1e455e9f0712b1e99fa4fcd23758e8f1";
+    tx.data.input = {0x12, -0x34, 0x7f, -0x80};
+    tx.dataHash = {0x01, 0x02};
+    tx.signature = {-0x01, 0x00};
+    tx.importTime = 1670467885565;
+    tx.attribute = 7;
+    tx.sender = {0x3d};
+    tx.extraData = "extra\tdata";
+
+    // the same bytes as the json dom
+    auto json = tx.writeToJsonString();
+    BOOST_CHECK_EQUAL(json, tars::TC_Json::writeValue(tx.writeToJson()));
+    BOOST_CHECK_EQUAL(
+        tx.data.writeToJsonString(), tars::TC_Json::writeValue(tx.data.writeToJson()));
+
+    Transaction decodedTx;
+    decodedTx.readFromJsonString(json);
+    BOOST_CHECK(decodedTx == tx);
+
+    LogEntry logEntry;
+    logEntry.address = "6849f21d1e455e9f0712b1e99fa4fcd23758e8f1";
+    logEntry.topic = {{0x0c, 0x57}, {-0x01}};
+    logEntry.data = {0x01};
+    TransactionReceiptData receipt;
+    receipt.version = 0;
+    receipt.gasUsed = "19413";
+    receipt.contractAddress = "";
+    receipt.status = -1;
+    receipt.output = {0x00, 0x01};
+    receipt.logEntries = {logEntry, logEntry};
+    receipt.blockNumber = 2;
+
+    auto receiptJson = receipt.writeToJsonString();
+    BOOST_CHECK_EQUAL(receiptJson, tars::TC_Json::writeValue(receipt.writeToJson()));
+    TransactionReceiptData decodedReceipt;
+    TransactionReceiptData domReceipt;
+    decodedReceipt.readFromJsonString(receiptJson);
+    domReceipt.readFromJson(tars::TC_Json::getValue(receiptJson));
+    BOOST_CHECK(decodedReceipt == domReceipt);
+
+    // whitespace, escapes and the unknown fields
+    auto rawJson =
+        R"( { "version" : 0, "chainID" : "c中\n", "groupID" : "g", "blockLimit" : 5,)"
+        R"( "nonce" : "n", "input" : "0x0A0b", "from" : null, "x" : [true, {"y" : 1.5e3}] } )";
+    TransactionData txData;
+    TransactionData domTxData;
+    txData.readFromJsonString(rawJson);
+    domTxData.readFromJson(tars::TC_Json::getValue(rawJson));
+    BOOST_CHECK(txData == domTxData);
+    BOOST_CHECK_EQUAL(txData.chainID, "c\xe4\xb8\xad\n");
+
+    // the required field missing
+    BOOST_CHECK_THROW(txData.readFromJsonString(R"({"version":0})"), tars::TC_Json_Exception);
+    BOOST_CHECK_THROW(txData.readFromJsonString("[]"), tars::TC_Json_Exception);
+}
+
+BOOST_AUTO_TEST_CASE(test_transaction_view)
+{
+    auto txBuilder = std::make_unique<TransactionBuilder>();
+    auto keyPair = KeyPairBuilder().genKeyPair(CryptoType::Secp256K1);
+    std::vector<bcos::bytes> encodedTxs;
+    for (std::size_t inputSize : {0, 10, 1000})
+    {
+        auto result = txBuilder->createSignedTransaction(*keyPair, "group0", "chain0",
+            "0x6849f21d1e455e9f0712b1e99fa4fcd23758e8f1", bcos::bytes(inputSize, 0x11), "[]", 501,
+            (int32_t)inputSize, "extra");
+        encodedTxs.push_back(fromHex(result.second));
+        auto& txBytes = encodedTxs.back();
+
+        tars::TarsInputStream<tars::BufferReader> inputStream;
+        inputStream.setBuffer((const char*)txBytes.data(), txBytes.size());
+        Transaction tx;
+        tx.readFrom(inputStream);
+
+        // the fields are the views of the encoded bytes
+        TransactionView view(bcos::ref(txBytes));
+        BOOST_CHECK_EQUAL(view.data.blockLimit, 501);
+        BOOST_CHECK_EQUAL(view.data.nonce, tx.data.nonce);
+        BOOST_CHECK_EQUAL(view.data.to, "0x6849f21d1e455e9f0712b1e99fa4fcd23758e8f1");
+        BOOST_CHECK_EQUAL(toHexStringWithPrefix(view.hash()), result.first);
+        BOOST_CHECK_EQUAL(view.data.input.size(), inputSize);
+        BOOST_CHECK(view.data.input.size() == 0 ||
+                    (view.data.input.data() >= txBytes.data() &&
+                        view.data.input.data() + inputSize <= txBytes.data() + txBytes.size()));
+        BOOST_CHECK(view.verifyHash(txBuilder->ecdsaCryptoSuite()->hashImpl()));
+
+        Transaction copied;
+        view.toTransaction(copied);
+        BOOST_CHECK(copied == tx);
+        BOOST_CHECK_EQUAL(view.writeToJsonString(), tx.writeToJsonString());
+        BOOST_CHECK_EQUAL(txBuilder->decodeTransactionToJsonObj(txBytes), tx.writeToJsonString());
+        auto txDataBytes = txBuilder->encodeTransactionData(tx.data);
+        BOOST_CHECK_EQUAL(txBuilder->decodeTransactionDataToJsonObj(*txDataBytes),
+            tx.data.writeToJsonString());
+    }
+
+    // the truncated and the tampered transactions
+    auto truncated = encodedTxs[1];
+    truncated.resize(20);
+    BOOST_CHECK_THROW(TransactionView{bcos::ref(truncated)}, tars::TarsDecodeException);
+    auto tampered = encodedTxs[2];
+    tampered[tampered.size() / 2] ^= 0x01;
+    std::vector<bcos::bytesConstRef> txs;
+    for (const auto& txBytes : encodedTxs)
+    {
+        txs.push_back(bcos::ref(txBytes));
+    }
+    txs.push_back(bcos::ref(truncated));
+    txs.push_back(bcos::ref(tampered));
+    auto failed = txBuilder->verifyTransactionHashes(CryptoType::Secp256K1, txs);
+    BOOST_CHECK(failed == std::vector<std::size_t>({3, 4}));
+
+    // the nested containers of the malformed input
+    bcos::bytes nested(100000, 0x0a);
+    BOOST_CHECK_THROW(TransactionView{bcos::ref(nested)}, tars::TarsDecodeException);
+
+    auto receiptBuilder = std::make_unique<ReceiptBuilder>();
+    auto receiptData = receiptBuilder->createReceiptData(
+        "24363", "0102e8b6fc8cdf9626fddc1c3ea8c1e79b3fce94", bcos::bytes(32, 0x01), 9);
+    LogEntry logEntry;
+    logEntry.address = "6849f21d1e455e9f0712b1e99fa4fcd23758e8f1";
+    logEntry.topic = {std::vector<tars::Char>(32, 0x0c), std::vector<tars::Char>(32, 0x0d)};
+    logEntry.data = std::vector<tars::Char>(64, 0x01);
+    receiptData->logEntries = {logEntry, logEntry};
+    auto receiptBytes = receiptBuilder->encodeReceipt(*receiptData);
+
+    ReceiptDataView receiptView(bcos::ref(*receiptBytes));
+    BOOST_CHECK_EQUAL(receiptView.blockNumber, 9);
+    BOOST_CHECK_EQUAL(receiptView.logEntries.size(), 2);
+    BOOST_CHECK_EQUAL(receiptView.logEntries[1].topic.size(), 2);
+    TransactionReceiptData copiedReceipt;
+    receiptView.toReceiptData(copiedReceipt);
+    BOOST_CHECK(copiedReceipt == *receiptData);
+    auto hashImpl = txBuilder->ecdsaCryptoSuite()->hashImpl();
+    BOOST_CHECK_EQUAL(receiptView.hash(hashImpl).hex(), receiptData->hash(hashImpl).hex());
+    BOOST_CHECK_EQUAL(receiptBuilder->decodeReceiptDataToJsonObj(*receiptBytes),
+        receiptData->writeToJsonString());
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace bcos::test
\ No newline at end of file
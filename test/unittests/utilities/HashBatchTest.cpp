@@ -0,0 +1,177 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the batch hash kernels
+ * @file HashBatchTest.cpp
+ * @author: octopus
+ * @date 2023-04-12
+ */
+#include <bcos-cpp-sdk/utilities/crypto/HashBatch.h>
+#include <bcos-cpp-sdk/utilities/receipt/TransactionReceipt.h>
+#include <bcos-cpp-sdk/utilities/tx/Transaction.h>
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/hash/SM3.h>
+#include <bcos-utilities/DataConvertUtility.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+#include <deque>
+#include <memory>
+#include <random>
+
+using namespace bcos;
+using namespace bcos::cppsdk::utilities;
+using namespace bcos::test;
+
+BOOST_FIXTURE_TEST_SUITE(HashBatchTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_HashBatchKernels)
+{
+    std::mt19937 generator(0);
+    std::vector<bcos::crypto::Hash::Ptr> hashImpls{
+        std::make_shared<bcos::crypto::Keccak256>(), std::make_shared<bcos::crypto::SM3>()};
+    for (const auto& hashImpl : hashImpls)
+    {
+        // all the tails of the 64 bytes sm3 blocks and the 136 bytes keccak blocks, the batch
+        // sizes not the multiple of the lanes
+        for (std::size_t batchSize : {1, 3, 17, 301})
+        {
+            std::deque<bcos::bytes> pieces;
+            std::vector<bcos::bytes> expectedData;
+            HashBatchMessages messages;
+            for (std::size_t i = 0; i < batchSize; ++i)
+            {
+                auto size = batchSize == 301 ? i : generator() % 1000;
+                bcos::bytes data(size);
+                for (auto& byte : data)
+                {
+                    byte = (bcos::byte)generator();
+                }
+                // split into the pieces of the random sizes, the empty ones included
+                std::size_t offset = 0;
+                while (offset < size)
+                {
+                    auto pieceSize = std::min<std::size_t>(generator() % 150, size - offset);
+                    const auto& piece = pieces.emplace_back(
+                        data.begin() + offset, data.begin() + offset + pieceSize);
+                    messages.add(bcos::ref(piece));
+                    offset += pieceSize;
+                }
+                if (i % 3 == 0)
+                {
+                    messages.addBigEndian((int64_t)0x0102030405060708);
+                    for (bcos::byte byte = 1; byte <= 8; ++byte)
+                    {
+                        data.push_back(byte);
+                    }
+                }
+                messages.endMessage();
+                expectedData.push_back(std::move(data));
+            }
+            BOOST_CHECK_EQUAL(messages.size(), batchSize);
+
+            for (const auto& kernel : supportedHashBatchKernels())
+            {
+                std::vector<bcos::crypto::HashType> hashes(batchSize);
+                hashBatch(hashImpl, messages, hashes.data(), kernel);
+                for (std::size_t i = 0; i < batchSize; ++i)
+                {
+                    BOOST_CHECK_EQUAL(
+                        hashes[i].hex(), hashImpl->hash(bcos::ref(expectedData[i])).hex());
+                }
+            }
+        }
+    }
+
+    // the known answers
+    HashBatchMessages messages;
+    messages.endMessage();
+    messages.add(std::string_view("abc"));
+    messages.endMessage();
+    for (const auto& kernel : supportedHashBatchKernels())
+    {
+        std::vector<bcos::crypto::HashType> hashes(2);
+        hashBatch(hashImpls[0], messages, hashes.data(), kernel);
+        BOOST_CHECK_EQUAL(hashes[0].hex(),
+            "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+        hashBatch(hashImpls[1], messages, hashes.data(), kernel);
+        BOOST_CHECK_EQUAL(hashes[1].hex(),
+            "66c7f0f462eeedd9d1f2d46bdc10e4e24167c4875cf2f7a2297da02b8f4ba8e0");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_HashBatchTransactionAndReceipt)
+{
+    std::vector<bcos::crypto::Hash::Ptr> hashImpls{
+        std::make_shared<bcos::crypto::Keccak256>(), std::make_shared<bcos::crypto::SM3>()};
+
+    std::vector<bcostars::TransactionData> transactionData(13);
+    std::vector<const bcostars::TransactionData*> transactionItems;
+    for (std::size_t i = 0; i < transactionData.size(); ++i)
+    {
+        auto& data = transactionData[i];
+        data.version = (tars::Int32)(i % 2);
+        data.chainID = "chain0";
+        data.groupID = "group0";
+        data.blockLimit = (tars::Int64)(500 + i);
+        data.nonce = std::to_string(i * 7919);
+        data.to = i % 4 ? "0x1f9840a85d5af5bf1d1762f925bdaddc4201f984" : "";
+        data.input.assign(i * 37, (tars::Char)i);
+        data.abi = i % 5 ? "" : "[]";
+        transactionItems.push_back(&data);
+    }
+
+    std::vector<bcostars::TransactionReceiptData> receiptData(7);
+    std::vector<const bcostars::TransactionReceiptData*> receiptItems;
+    for (std::size_t i = 0; i < receiptData.size(); ++i)
+    {
+        auto& data = receiptData[i];
+        data.version = 0;
+        data.gasUsed = std::to_string(21000 + i);
+        data.contractAddress = i % 2 ? "0x1f9840a85d5af5bf1d1762f925bdaddc4201f984" : "";
+        data.status = (tars::Int32)(i % 3);
+        data.output.assign(i * 32, (tars::Char)i);
+        data.logEntries.resize(i % 3);
+        for (auto& log : data.logEntries)
+        {
+            log.address = "0x1f9840a85d5af5bf1d1762f925bdaddc4201f984";
+            log.topic.assign(2, std::vector<tars::Char>(32, (tars::Char)i));
+            log.data.assign(64, (tars::Char)i);
+        }
+        data.blockNumber = (tars::Int64)i;
+        receiptItems.push_back(&data);
+    }
+
+    for (const auto& hashImpl : hashImpls)
+    {
+        auto transactionHashes = hashBatch(
+            hashImpl, std::span<const bcostars::TransactionData* const>(transactionItems));
+        BOOST_CHECK_EQUAL(transactionHashes.size(), transactionData.size());
+        for (std::size_t i = 0; i < transactionData.size(); ++i)
+        {
+            BOOST_CHECK_EQUAL(transactionHashes[i].hex(), transactionData[i].hash(hashImpl).hex());
+        }
+
+        auto receiptHashes = hashBatch(
+            hashImpl, std::span<const bcostars::TransactionReceiptData* const>(receiptItems));
+        BOOST_CHECK_EQUAL(receiptHashes.size(), receiptData.size());
+        for (std::size_t i = 0; i < receiptData.size(); ++i)
+        {
+            BOOST_CHECK_EQUAL(receiptHashes[i].hex(), receiptData[i].hash(hashImpl).hex());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
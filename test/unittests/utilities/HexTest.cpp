@@ -0,0 +1,127 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the hex kernels
+ * @file HexTest.cpp
+ * @author: octopus
+ * @date 2023-04-10
+ */
+#include <bcos-cpp-sdk/utilities/Hex.h>
+#include <bcos-utilities/DataConvertUtility.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cctype>
+#include <random>
+
+using namespace bcos;
+using namespace bcos::cppsdk::utilities;
+using namespace bcos::test;
+
+BOOST_FIXTURE_TEST_SUITE(HexTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_HexKernels)
+{
+    std::mt19937 generator(0);
+    for (const auto& kernel : supportedHexKernels())
+    {
+        // all the tails of the 16 and 32 bytes rounds
+        for (std::size_t size = 0; size < 200; ++size)
+        {
+            bcos::bytes data(size);
+            for (auto& byte : data)
+            {
+                byte = (bcos::byte)generator();
+            }
+            auto expected = bcos::toHex(data);
+
+            std::string hex(size * 2, ' ');
+            kernel.encode(data.data(), data.size(), hex.data());
+            BOOST_CHECK_EQUAL(hex, expected);
+
+            // mixed case
+            for (auto& c : hex)
+            {
+                c = (generator() % 2) ? (char)std::toupper(c) : c;
+            }
+            bcos::bytes decoded(size);
+            BOOST_CHECK(kernel.decode(hex.data(), hex.size(), decoded.data()));
+            BOOST_CHECK(decoded == data);
+
+            if (size > 0)
+            {
+                hex[generator() % hex.size()] = 'g';
+                BOOST_CHECK(!kernel.decode(hex.data(), hex.size(), decoded.data()));
+            }
+        }
+
+        // every char at a position of a SIMD round
+        for (int c = 0; c < 256; ++c)
+        {
+            std::string hex(128, '0');
+            hex[77] = (char)c;
+            bcos::bytes decoded(64);
+            BOOST_CHECK_EQUAL(
+                kernel.decode(hex.data(), hex.size(), decoded.data()), std::isxdigit(c) != 0);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_HexEncodeDecode)
+{
+    bcos::bytes data{0x01, 0xab, 0xff, 0x00};
+    BOOST_CHECK_EQUAL(hexEncode(data), "01abff00");
+    BOOST_CHECK_EQUAL(hexEncode(data, true), "0x01abff00");
+    BOOST_CHECK_EQUAL(hexEncode(bcos::bytes()), "");
+    BOOST_CHECK_EQUAL(hexEncode(bcos::bytes(), true), "0x");
+
+    std::string out = "hex://";
+    hexEncodeAppend(bcos::ref(data), out);
+    BOOST_CHECK_EQUAL(out, "hex://01abff00");
+
+    bcos::h256 hash;
+    BOOST_CHECK_EQUAL(hexEncode(hash, true), hash.hexPrefixed());
+
+    BOOST_CHECK(hexDecode("01abff00") == data);
+    BOOST_CHECK(hexDecode("0x01ABff00") == data);
+    BOOST_CHECK(hexDecode("0X01abFF00") == data);
+    BOOST_CHECK(hexDecode("") == bcos::bytes());
+    BOOST_CHECK(hexDecode("0x") == bcos::bytes());
+    // the odd leading char is a byte, the same as fromHexString
+    BOOST_CHECK(hexDecode("0xabc") == *bcos::fromHexString("0xabc"));
+    BOOST_CHECK(hexDecode("abc") == (bcos::bytes{0x0a, 0xbc}));
+    BOOST_CHECK_EQUAL(hexDecodedSize("0xabc"), 2);
+
+    BOOST_CHECK_THROW(hexDecode("0x0g"), InvalidHexString);
+    BOOST_CHECK_THROW(hexDecode("0x 1"), InvalidHexString);
+
+    std::vector<char> appended{'a'};
+    hexDecodeAppend("0x6263", appended);
+    BOOST_CHECK(appended == (std::vector<char>{'a', 'b', 'c'}));
+    BOOST_CHECK_THROW(hexDecodeAppend("0xzz", appended), InvalidHexString);
+    BOOST_CHECK_EQUAL(appended.size(), 3);
+
+    // large inputs run the SIMD rounds
+    bcos::bytes large(100000);
+    for (std::size_t i = 0; i < large.size(); ++i)
+    {
+        large[i] = (bcos::byte)(i * 31);
+    }
+    auto largeHex = hexEncode(large, true);
+    BOOST_CHECK_EQUAL(largeHex, bcos::toHexStringWithPrefix(large));
+    BOOST_CHECK(hexDecode(largeHex) == large);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
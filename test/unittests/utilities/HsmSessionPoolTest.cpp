@@ -0,0 +1,160 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the hsm session pool, the software sm2 stands in for the hsm
+ * @file HsmSessionPoolTest.cpp
+ * @author: octopus
+ * @date 2023-04-13
+ */
+#include <bcos-cpp-sdk/utilities/crypto/HsmSessionPool.h>
+#include <bcos-cpp-sdk/utilities/crypto/KeyPairBuilder.h>
+#include <bcos-crypto/hash/SM3.h>
+#include <bcos-crypto/signature/sm2/SM2Crypto.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::cppsdk::utilities;
+using namespace bcos::test;
+
+BOOST_FIXTURE_TEST_SUITE(HsmSessionPoolTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_HsmSessionPoolReuse)
+{
+    std::atomic<std::size_t> opened{0};
+    HsmSessionPool pool(3, [&opened](const std::string&) {
+        ++opened;
+        return std::make_shared<bcos::crypto::SM2Crypto>();
+    });
+    BOOST_CHECK_EQUAL(pool.sessionCount(), 3);
+
+    auto keyPair = KeyPairBuilder().genKeyPair(CryptoType::SM2);
+    std::string data = "hsm session pool";
+    auto hash = bcos::crypto::SM3().hash(
+        bcos::bytesConstRef((const bcos::byte*)data.data(), data.size()));
+    auto verifier = std::make_shared<bcos::crypto::SM2Crypto>();
+
+    // the one session is reused by the calls in turn
+    for (int i = 0; i < 10; ++i)
+    {
+        auto signature = pool.sign(*keyPair, hash, "soft0");
+        BOOST_CHECK(verifier->verify(keyPair->publicKey(), hash, bcos::ref(*signature)));
+    }
+    BOOST_CHECK_EQUAL(opened.load(), 1);
+    BOOST_CHECK_EQUAL(pool.openedSessions("soft0"), 1);
+    BOOST_CHECK_EQUAL(pool.openedSessions("soft1"), 0);
+
+    // the libraries are pooled apart, at most the session count of each opened
+    std::atomic<int> verified{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&pool, &keyPair, &hash, &verifier, &verified, t]() {
+            for (int i = 0; i < 20; ++i)
+            {
+                auto signature = pool.sign(*keyPair, hash, t % 2 ? "soft1" : "soft0");
+                verified += verifier->verify(keyPair->publicKey(), hash, bcos::ref(*signature));
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    BOOST_CHECK_EQUAL(verified.load(), 8 * 20);
+    BOOST_CHECK_LE(pool.openedSessions("soft0"), 3);
+    BOOST_CHECK_LE(pool.openedSessions("soft1"), 3);
+    BOOST_CHECK_EQUAL(opened.load(), pool.openedSessions("soft0") + pool.openedSessions("soft1"));
+
+    // the idle sessions over the count are closed
+    pool.setSessionCount(1);
+    BOOST_CHECK_EQUAL(pool.openedSessions("soft0"), 1);
+    BOOST_CHECK_EQUAL(pool.openedSessions("soft1"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_HsmSessionPoolWait)
+{
+    HsmSessionPool pool(2, [](const std::string&) {
+        return std::make_shared<bcos::crypto::SM2Crypto>();
+    });
+
+    auto first = std::make_unique<HsmSessionPool::Session>(pool.acquire("soft"));
+    auto second = pool.acquire("soft");
+    std::atomic<bool> acquired{false};
+    std::thread waiter([&pool, &acquired]() {
+        auto third = pool.acquire("soft");
+        acquired = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    BOOST_CHECK(!acquired);
+
+    // the waiter gets the session returned
+    first.reset();
+    waiter.join();
+    BOOST_CHECK(acquired);
+    BOOST_CHECK_EQUAL(pool.openedSessions("soft"), 2);
+
+    // the slot of the session failed to open is given back
+    std::atomic<int> failures{1};
+    HsmSessionPool failingPool(1, [&failures](const std::string&) {
+        if (failures-- > 0)
+        {
+            throw std::runtime_error("open session failed");
+        }
+        return std::make_shared<bcos::crypto::SM2Crypto>();
+    });
+    BOOST_CHECK_THROW(failingPool.acquire("soft"), std::runtime_error);
+    BOOST_CHECK_EQUAL(failingPool.openedSessions("soft"), 0);
+    failingPool.acquire("soft");
+    BOOST_CHECK_EQUAL(failingPool.openedSessions("soft"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_HsmSessionPoolSignBatch)
+{
+    std::atomic<std::size_t> opened{0};
+    HsmSessionPool pool(4, [&opened](const std::string&) {
+        ++opened;
+        return std::make_shared<bcos::crypto::SM2Crypto>();
+    });
+
+    auto keyPair = KeyPairBuilder().genKeyPair(CryptoType::SM2);
+    bcos::crypto::SM3 hashImpl;
+    std::vector<bcos::crypto::HashType> hashes;
+    for (int i = 0; i < 200; ++i)
+    {
+        auto data = std::to_string(i);
+        hashes.push_back(
+            hashImpl.hash(bcos::bytesConstRef((const bcos::byte*)data.data(), data.size())));
+    }
+
+    auto verifier = std::make_shared<bcos::crypto::SM2Crypto>();
+    auto signatures = pool.signBatch(*keyPair, hashes, "soft", true);
+    BOOST_CHECK_EQUAL(signatures.size(), hashes.size());
+    for (std::size_t i = 0; i < hashes.size(); ++i)
+    {
+        BOOST_CHECK(verifier->verify(keyPair->publicKey(), hashes[i], bcos::ref(*signatures[i])));
+    }
+    BOOST_CHECK_LE(opened.load(), 4);
+    BOOST_CHECK_EQUAL(opened.load(), pool.openedSessions("soft"));
+
+    BOOST_CHECK(pool.signBatch(*keyPair, {}, "soft").empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,103 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the chunks run in parallel
+ * @file ParallelChunksTest.cpp
+ * @author: octopus
+ * @date 2023-04-14
+ */
+#include <bcos-cpp-sdk/utilities/ParallelChunks.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::cppsdk::utilities;
+using namespace bcos::test;
+
+BOOST_FIXTURE_TEST_SUITE(ParallelChunksTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_parallelChunks)
+{
+    for (std::size_t threadCount : {1, 4, 0})
+    {
+        // each item is run once
+        std::vector<std::atomic<int>> runs(1001);
+        parallelChunks(runs.size(), 64, threadCount, [&runs](std::size_t _begin, std::size_t _end) {
+            BOOST_CHECK(_begin < _end && _end - _begin <= 64);
+            for (auto i = _begin; i < _end; ++i)
+            {
+                ++runs[i];
+            }
+        });
+        for (const auto& run : runs)
+        {
+            BOOST_CHECK_EQUAL(run, 1);
+        }
+    }
+
+    // nothing to run
+    parallelChunks(0, 64, 4, [](std::size_t, std::size_t) { BOOST_FAIL("unexpected chunk"); });
+}
+
+BOOST_AUTO_TEST_CASE(test_parallelChunksThreadInit)
+{
+    // at most one thread per chunk, each inits once on its own thread
+    std::mutex x_threads;
+    std::set<std::thread::id> threads;
+    std::atomic<std::size_t> inits{0};
+    std::atomic<std::size_t> count{0};
+    parallelChunks(3, 1, 8, [&]() -> ChunkFunc {
+        ++inits;
+        {
+            std::lock_guard<std::mutex> lock(x_threads);
+            threads.insert(std::this_thread::get_id());
+        }
+        return [&count](std::size_t _begin, std::size_t _end) { count += _end - _begin; };
+    });
+    BOOST_CHECK_EQUAL(count, 3);
+    BOOST_CHECK_EQUAL(inits, 3);
+    BOOST_CHECK_EQUAL(threads.size(), 3);
+    BOOST_CHECK(threads.count(std::this_thread::get_id()));
+}
+
+BOOST_AUTO_TEST_CASE(test_parallelChunksException)
+{
+    // the first exception is rethrown, the rest are not claimed after it
+    std::atomic<std::size_t> chunks{0};
+    BOOST_CHECK_THROW(parallelChunks(1000, 1, 4,
+                          [&chunks](std::size_t _begin, std::size_t) {
+                              ++chunks;
+                              if (_begin == 10)
+                              {
+                                  throw std::runtime_error("chunk failed");
+                              }
+                          }),
+        std::runtime_error);
+    BOOST_CHECK(chunks < 1000);
+
+    // the failure of the thread init
+    BOOST_CHECK_THROW(parallelChunks(10, 1, 2,
+                          []() -> ChunkFunc { throw std::runtime_error("init failed"); }),
+        std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
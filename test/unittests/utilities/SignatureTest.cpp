@@ -0,0 +1,149 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the batch verification and address recovery
+ * @file SignatureTest.cpp
+ * @author: octopus
+ * @date 2023-04-14
+ */
+#include <bcos-cpp-sdk/utilities/crypto/KeyPairBuilder.h>
+#include <bcos-cpp-sdk/utilities/crypto/Signature.h>
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/hash/SM3.h>
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
+#include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
+#include <bcos-crypto/signature/sm2/SM2Crypto.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+
+using namespace bcos;
+using namespace bcos::cppsdk::utilities;
+using namespace bcos::test;
+
+BOOST_FIXTURE_TEST_SUITE(SignatureTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_SignatureVerifyAndRecoverBatch)
+{
+    for (auto cryptoType : {CryptoType::Secp256K1, CryptoType::SM2})
+    {
+        bcos::crypto::Hash::Ptr hashImpl;
+        bcos::crypto::SignatureCrypto::Ptr signatureImpl;
+        if (cryptoType == CryptoType::SM2)
+        {
+            hashImpl = std::make_shared<bcos::crypto::SM3>();
+            signatureImpl = std::make_shared<bcos::crypto::SM2Crypto>();
+        }
+        else
+        {
+            hashImpl = std::make_shared<bcos::crypto::Keccak256>();
+            signatureImpl = std::make_shared<bcos::crypto::Secp256k1Crypto>();
+        }
+        auto cryptoSuite =
+            std::make_shared<bcos::crypto::CryptoSuite>(hashImpl, signatureImpl, nullptr);
+
+        std::vector<bcos::crypto::KeyPairInterface::UniquePtr> keyPairs;
+        for (int i = 0; i < 3; ++i)
+        {
+            keyPairs.push_back(KeyPairBuilder().genKeyPair(cryptoType));
+        }
+
+        // the valid ones, the tampered hashes, the wrong public keys and the truncated signatures
+        const std::size_t count = 100;
+        std::vector<bcos::bytes> signatures;
+        std::vector<SignatureItem> items;
+        std::vector<bool> expectedVerified;
+        std::vector<bool> expectedRecovered;
+        std::vector<bcos::bytes> expectedAddresses;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto& keyPair = keyPairs[i % keyPairs.size()];
+            auto data = std::to_string(i);
+            auto hash =
+                hashImpl->hash(bcos::bytesConstRef((const bcos::byte*)data.data(), data.size()));
+            signatures.push_back(*signatureImpl->sign(*keyPair, hash, true));
+
+            SignatureItem item;
+            item.hash = hash;
+            item.publicKey = std::make_shared<bcos::bytes const>(keyPair->publicKey()->data());
+            auto address = cryptoSuite->calculateAddress(keyPair->publicKey()).asBytes();
+            bool verified = true;
+            bool recovered = true;
+            switch (i % 10)
+            {
+            case 3:
+                item.hash = hashImpl->hash(bcos::bytesConstRef((const bcos::byte*)"x", 1));
+                verified = false;
+                // another key is recovered from the secp256k1 signature of another hash
+                recovered = cryptoType == CryptoType::Secp256K1;
+                address.clear();
+                break;
+            case 5:
+                item.publicKey = std::make_shared<bcos::bytes const>(
+                    keyPairs[(i + 1) % keyPairs.size()]->publicKey()->data());
+                verified = false;
+                break;
+            case 7:
+                signatures.back().resize(16);
+                verified = false;
+                recovered = false;
+                address.clear();
+                break;
+            default:
+                break;
+            }
+            items.push_back(item);
+            expectedVerified.push_back(verified);
+            expectedRecovered.push_back(recovered);
+            expectedAddresses.push_back(address);
+        }
+        // the signatures are not moved any more
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            items[i].signature = bcos::ref(signatures[i]);
+        }
+
+        Signature signature;
+        for (std::size_t threadCount : {1, 4, 0})
+        {
+            auto verified = signature.verifyBatch(cryptoType, items, threadCount);
+            BOOST_CHECK_EQUAL(verified.size(), count);
+            auto recovered =
+                signature.recoverAddressBatch(cryptoType, hashImpl, items, threadCount);
+            BOOST_CHECK_EQUAL(recovered.size(), count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                BOOST_CHECK_EQUAL(verified[i], expectedVerified[i]);
+                BOOST_CHECK_EQUAL(recovered[i].first, expectedRecovered[i]);
+                if (!expectedAddresses[i].empty())
+                {
+                    BOOST_CHECK(recovered[i].second == expectedAddresses[i]);
+                }
+            }
+        }
+
+        // the item without the public key fails
+        std::vector<SignatureItem> noPublicKey{items[0]};
+        noPublicKey[0].publicKey = nullptr;
+        BOOST_CHECK(!signature.verifyBatch(cryptoType, noPublicKey)[0]);
+        BOOST_CHECK(signature.verifyBatch(cryptoType, {}).empty());
+    }
+
+    Signature signature;
+    BOOST_CHECK_THROW(signature.verifyBatch(CryptoType::Ed25519, {}), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,70 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for TokenBucketRateLimiter
+ * @file TokenBucketRateLimiterTest.cpp
+ * @author: octopus
+ * @date 2023-03-20
+ */
+#include <bcos-cpp-sdk/utilities/TokenBucketRateLimiter.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::ratelimiter;
+using namespace bcos::test;
+
+BOOST_FIXTURE_TEST_SUITE(TokenBucketRateLimiterTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_TokenBucketRateLimiter)
+{
+    // 100 per second, 10 at once
+    TokenBucketRateLimiter limiter(100, 10);
+    auto now = std::chrono::steady_clock::now();
+
+    BOOST_CHECK_EQUAL(limiter.availablePermits(now), 10);
+    BOOST_CHECK(limiter.tryAcquire(10, now));
+    BOOST_CHECK(!limiter.tryAcquire(1, now));
+    BOOST_CHECK(!limiter.tryAcquire(11, now));
+
+    // 1 permit refilled each 10ms
+    now += std::chrono::milliseconds(35);
+    BOOST_CHECK_EQUAL(limiter.availablePermits(now), 3);
+    BOOST_CHECK(limiter.tryAcquire(3, now));
+    BOOST_CHECK(!limiter.tryAcquire(1, now));
+
+    // not more than the burst size
+    now += std::chrono::seconds(10);
+    BOOST_CHECK_EQUAL(limiter.availablePermits(now), 10);
+
+    BOOST_CHECK(limiter.tryAcquire(5, now));
+    limiter.rollback(10);
+    BOOST_CHECK_EQUAL(limiter.availablePermits(now), 10);
+}
+
+BOOST_AUTO_TEST_CASE(test_TokenBucketRateLimiter_acquire)
+{
+    TokenBucketRateLimiter limiter(1000, 1);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 20; ++i)
+    {
+        BOOST_CHECK(limiter.acquire(1));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    BOOST_CHECK(elapsed >= std::chrono::milliseconds(15));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,107 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file SharedContextTest.cpp
+ * @author: octopus
+ * @date 2023-03-06
+ */
+
+#include <bcos-cpp-sdk/multigroup/JsonGroupInfoCodec.h>
+#include <bcos-cpp-sdk/ws/Service.h>
+#include <bcos-cpp-sdk/ws/SharedContext.h>
+#include <bcos-framework/interfaces/multigroup/GroupInfoFactory.h>
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/test/unit_test.hpp>
+#include <future>
+
+using namespace bcos;
+using namespace bcos::cppsdk;
+using namespace bcos::cppsdk::service;
+using namespace bcos::test;
+
+BOOST_FIXTURE_TEST_SUITE(SharedContextTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(test_SharedContext)
+{
+    auto context = std::make_shared<SharedContext>(0, 4);
+    BOOST_CHECK_EQUAL(context->ioThreadCount(), 1);
+    BOOST_CHECK_EQUAL(context->threadPoolSize(), 4);
+    BOOST_CHECK(context->ioServicePool());
+    BOOST_CHECK(context->threadPool());
+    BOOST_CHECK(context->timerFactory());
+
+    // start is idempotent
+    context->start();
+    context->start();
+
+    context->attach();
+    context->attach();
+    BOOST_CHECK_EQUAL(context->attachedCount(), 2);
+    context->detach();
+    BOOST_CHECK_EQUAL(context->attachedCount(), 1);
+
+    std::promise<bool> p;
+    auto f = p.get_future();
+    context->threadPool()->enqueue([&p]() { p.set_value(true); });
+    BOOST_CHECK(f.get());
+
+    context->stop();
+    context->stop();
+}
+
+BOOST_AUTO_TEST_CASE(test_SharedContextServices)
+{
+    auto context = std::make_shared<SharedContext>(2, 2);
+    auto buildService = [&context]() {
+        return std::make_shared<Service>(std::make_shared<bcos::group::JsonGroupInfoCodec>(),
+            std::make_shared<bcos::group::GroupInfoFactory>(), "SDK", context);
+    };
+    auto service0 = buildService();
+    auto service1 = buildService();
+    BOOST_CHECK_EQUAL(context->attachedCount(), 2);
+    BOOST_CHECK(service0->sharedContext() == context);
+    BOOST_CHECK(service0->ioServicePool() == context->ioServicePool());
+    BOOST_CHECK(service1->threadPool() == context->threadPool());
+    context->start();
+
+    // stopping one instance leaves the executors to the other
+    service0->stop();
+    BOOST_CHECK(!service0->sharedContext());
+    BOOST_CHECK(service0->ioServicePool() != context->ioServicePool());
+    BOOST_CHECK(service0->threadPool() != context->threadPool());
+    BOOST_CHECK_EQUAL(context->attachedCount(), 1);
+    BOOST_CHECK(service1->sharedContext() == context);
+
+    std::promise<bool> threadPoolPromise;
+    service1->threadPool()->enqueue([&threadPoolPromise]() { threadPoolPromise.set_value(true); });
+    BOOST_CHECK(threadPoolPromise.get_future().get());
+
+    std::promise<bool> ioPromise;
+    boost::asio::post(*service1->ioServicePool()->getIOService(),
+        [&ioPromise]() { ioPromise.set_value(true); });
+    BOOST_CHECK(ioPromise.get_future().get());
+
+    // stopping again does not detach twice
+    service0->stop();
+    BOOST_CHECK_EQUAL(context->attachedCount(), 1);
+    service1->stop();
+    BOOST_CHECK_EQUAL(context->attachedCount(), 0);
+    context->stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()